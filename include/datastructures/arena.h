@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct _arena arena;
+
+/*
+Creates a new bump pointer arena.
+
+An arena hands out memory by moving a pointer forward through a single block. Nothing allocated
+from an arena is freed individually; everything is released at once by reset_arena(). This makes
+an arena a good fit for scratch memory that only lives for a short, well defined time, such as a single frame.
+
+Arguments
+    size_t capacity: The initial capacity in bytes of the arena. The arena grows as needed.
+
+Returns
+    Returns the new arena or NULL if capacity is 0 or memory allocation failed
+*/
+arena* create_arena(size_t capacity);
+
+/*
+Frees an arena and all memory allocated from it
+
+Arguments
+    arena* a: The arena to free
+
+Returns
+    Returns false if a is NULL
+*/
+bool free_arena(arena* a);
+
+/*
+Allocates memory from the arena. The memory is suitably aligned for any type.
+
+If the arena's block is full, an overflow block is allocated. On the next reset_arena() the arena
+grows so the same amount of memory fits in a single block.
+
+Runs in O(1) time.
+
+Arguments
+    arena* a: The arena to allocate from
+
+    size_t size: The number of bytes to allocate
+
+Returns
+    Returns uninitialized memory, or NULL if a is NULL, size is 0 or memory allocation failed
+*/
+void* alloc_arena(arena* a, size_t size);
+
+/*
+Releases everything allocated from the arena at once
+
+Arguments
+    arena* a: The arena to reset
+*/
+void reset_arena(arena* a);
+
+/*
+Returns the number of bytes allocated from the arena since the last reset
+
+Arguments
+    arena* a: The arena to get the used bytes from
+*/
+size_t getUsed_arena(arena* a);
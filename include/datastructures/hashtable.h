@@ -108,6 +108,20 @@ Returns
 */
 void** getAll_hashtable(hashtable* table);
 
+/*
+Copies all of the values inserted into the hash table into a caller provided array. No order is guaranteed.
+This is the same as getAll_hashtable(), except no memory is allocated.
+
+Arguments
+    hashtable* table: The hash table to retrieve all of the values from
+
+    void** out: An array with room for at least getCount_hashtable() values
+
+Returns
+    Returns the number of values copied into out
+*/
+size_t copyAll_hashtable(hashtable* table, void** out);
+
 /*
 Returns the number of values inserted in the hash table
 
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct _pool pool;
+
+/*
+Creates a new pool of fixed size elements.
+
+A pool hands out memory in slabs of slabCapacity elements. Elements allocated one after the other
+sit next to each other in memory, and released elements are kept on a free list so they can be
+reused without calling the system allocator.
+
+Arguments
+    size_t elementSize: The size in bytes of a single element
+
+    size_t slabCapacity: The number of elements stored in a single slab
+
+Returns
+    Returns the new pool or NULL if either argument is 0 or if memory allocation failed
+*/
+pool* create_pool(size_t elementSize, size_t slabCapacity);
+
+/*
+Frees a pool and every slab it owns. Every element allocated from the pool becomes invalid.
+
+Arguments
+    pool* p: The pool to free
+
+Returns
+    Returns false if p is NULL
+*/
+bool free_pool(pool* p);
+
+/*
+Allocates a single element from the pool. Released elements are reused first, then the
+current slab is filled in order. A new slab is only requested from the system allocator once
+every existing slab is full.
+
+Runs in O(1) time.
+
+Arguments
+    pool* p: The pool to allocate from
+
+Returns
+    Returns uninitialized memory of the pool's element size, or NULL if p is NULL or memory allocation failed
+*/
+void* alloc_pool(pool* p);
+
+/*
+Releases an element back to the pool so it can be reused by alloc_pool()
+
+Runs in O(1) time.
+
+Arguments
+    pool* p: The pool the element was allocated from
+
+    void* element: The element to release
+
+Preconditions
+    element was allocated by p and has not already been released
+
+Returns
+    Returns false if any of the arguments are NULL
+*/
+bool release_pool(pool* p, void* element);
+
+/*
+Releases every element of the pool at once. The slabs are kept so they can be refilled
+without calling the system allocator.
+
+Runs in O(1) time.
+
+Arguments
+    pool* p: The pool to clear
+*/
+void clear_pool(pool* p);
+
+/*
+Returns the number of elements currently allocated from the pool
+
+Arguments
+    pool* p: The pool to get the count from
+*/
+size_t getCount_pool(pool* p);
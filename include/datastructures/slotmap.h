@@ -0,0 +1,162 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+A handle is a 32 bit reference to a value in a slotmap. The low HANDLE_INDEX_BITS bits are the index
+of the handle's slot, and the remaining bits are the generation of the slot. Every time a value is
+removed, the generation of its slot changes, so stale handles never resolve to a newer value.
+*/
+typedef uint32_t handle;
+
+#define HANDLE_INDEX_BITS 20
+#define HANDLE_GENERATION_BITS (32 - HANDLE_INDEX_BITS)
+
+/*
+A handle that never refers to a value
+*/
+#define INVALID_HANDLE ((handle) 0)
+
+typedef struct _slotmap slotmap;
+
+/*
+Creates a new slotmap with a given capacity.
+
+A slotmap stores values densely packed in an array and hands out generational handles to them.
+Resolving a handle is two array lookups, and removing a value moves the last value into the hole,
+so the values are always contiguous.
+
+Arguments
+    size_t capacity: The initial capacity of the slotmap. The slotmap grows as needed.
+
+Returns
+    Returns the new slotmap or NULL if capacity is 0 or memory allocation failed
+*/
+slotmap* create_slotmap(size_t capacity);
+
+/*
+Frees memory associated with the given slotmap. This does not free the individual values inserted into it.
+
+Arguments
+    slotmap* sm: The slotmap to free
+
+Returns
+    Returns false if sm is NULL
+*/
+bool free_slotmap(slotmap* sm);
+
+/*
+Inserts a value at the end of the slotmap's values
+
+Runs in amortized O(1) time.
+
+Arguments
+    slotmap* sm: The slotmap to insert into
+
+    void* value: The value to insert
+
+Returns
+    Returns the handle of the value, or INVALID_HANDLE if any of the arguments are NULL, memory allocation failed,
+    or the slotmap has run out of handle indices
+*/
+handle insert_slotmap(slotmap* sm, void* value);
+
+/*
+Resolves a handle to its value
+
+Runs in O(1) time.
+
+Arguments
+    slotmap* sm: The slotmap to resolve the handle with
+
+    handle h: The handle to resolve
+
+Returns
+    Returns the value of the handle, or NULL if the handle is stale or invalid
+*/
+void* get_slotmap(slotmap* sm, handle h);
+
+/*
+Resolves a handle to the index of its value in getValues_slotmap()
+
+Runs in O(1) time.
+
+Arguments
+    slotmap* sm: The slotmap to resolve the handle with
+
+    handle h: The handle to resolve
+
+    size_t* outIndex: The index of the value
+
+Returns
+    Returns false if the handle is stale or invalid
+*/
+bool getIndex_slotmap(slotmap* sm, handle h, size_t* outIndex);
+
+/*
+Returns the handle of the value at an index of getValues_slotmap()
+
+Arguments
+    slotmap* sm: The slotmap to get the handle from
+
+    size_t index: The index of the value
+
+Returns
+    Returns the handle of the value or INVALID_HANDLE if index is out of bounds
+*/
+handle getHandle_slotmap(slotmap* sm, size_t index);
+
+/*
+Removes a value from the slotmap. The last value is moved into the removed value's index, so
+any data kept in parallel to getValues_slotmap() should do the same.
+
+Runs in O(1) time.
+
+Arguments
+    slotmap* sm: The slotmap to remove from
+
+    handle h: The handle of the value to remove
+
+    size_t* outIndex: The index the value was removed from. May be NULL
+
+Returns
+    Returns the removed value, or NULL if the handle is stale or invalid
+*/
+void* remove_slotmap(slotmap* sm, handle h, size_t* outIndex);
+
+/*
+Swaps the values at two indices of getValues_slotmap(). Handles keep resolving to the same values,
+so values can be reordered (e.g. grouped or sorted) without invalidating any handle.
+
+Runs in O(1) time.
+
+Arguments
+    slotmap* sm: The slotmap to reorder
+
+    size_t i: The index of the first value
+
+    size_t j: The index of the second value
+
+Returns
+    Returns false if sm is NULL or either index is out of bounds
+*/
+bool swap_slotmap(slotmap* sm, size_t i, size_t j);
+
+/*
+Returns the densely packed array of values in the slotmap. The array is owned by the slotmap, and is
+only valid until the next insert or remove.
+
+Arguments
+    slotmap* sm: The slotmap to get the values from
+*/
+void** getValues_slotmap(slotmap* sm);
+
+/*
+Returns the number of values in the slotmap
+
+Arguments
+    slotmap* sm: The slotmap to get the number of values from
+*/
+size_t getCount_slotmap(slotmap* sm);
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(create_arena);
+PROTOTYPE_TEST(alloc_arena);
+PROTOTYPE_TEST(reset_arena);
@@ -2,6 +2,8 @@
 
 #include "util/unit.h"
 
+#include <stdint.h>
+
 typedef struct _hashtable hashtable;
 
 // Don't access these functions directly, as they often have unwritten preconditions
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(create_pool);
+PROTOTYPE_TEST(allocRelease_pool);
+PROTOTYPE_TEST(clear_pool);
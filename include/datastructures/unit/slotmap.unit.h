@@ -0,0 +1,8 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(create_slotmap);
+PROTOTYPE_TEST(insertGet_slotmap);
+PROTOTYPE_TEST(remove_slotmap);
+PROTOTYPE_TEST(swap_slotmap);
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "engine/math/polygon.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ARCHIVE_NAME_SIZE 112
+
+/*
+A single file that holds every resource the engine loads, built ahead of time from the resources directory
+by the packer tool (see src/tools/packArchive.c). The archive is memory mapped when it is opened, so loading
+a resource is a lookup in its index and a pointer into the mapping, instead of opening and reading a file.
+
+The archive starts with an archiveHeader, followed by the archiveEntry index sorted by name, followed by the
+data of every entry. Each entry's data starts on a 16 byte boundary.
+*/
+typedef struct _archive archive;
+
+typedef enum _archiveEntryType
+{
+    ARCHIVE_SHADER = 1, // The null terminated source of a shader
+    ARCHIVE_TEXTURE = 2, // The mip chain of a texture, see rawTexture.h
+    ARCHIVE_POLYGON = 3, // The vertices of a collider shape, as vec2f
+} archiveEntryType;
+
+typedef struct _archiveHeader
+{
+    char magic[4]; // "GEAR"
+    uint32_t version;
+    uint64_t entryCount;
+} archiveHeader;
+
+typedef struct _archiveEntry
+{
+    char name[ARCHIVE_NAME_SIZE]; // The file the entry was packed from, e.g. resources/media/test.png
+    uint32_t type; // An archiveEntryType
+
+    // The size and number of mip levels of a texture, or the vertex count of a polygon in width
+    uint32_t width;
+    uint32_t height;
+    uint32_t levelCount;
+
+    uint64_t offset; // From the start of the archive
+    uint64_t size; // In bytes
+} archiveEntry;
+
+/*
+A resource to write to an archive, see write_archive()
+*/
+typedef struct _archiveSource
+{
+    const char* name;
+    archiveEntryType type;
+
+    uint32_t width;
+    uint32_t height;
+    uint32_t levelCount;
+
+    const void* data;
+    size_t size;
+} archiveSource;
+
+/*
+Opens and memory maps an archive
+
+Arguments
+    const char* fileName: The file name of the archive
+
+Returns
+    Returns the archive, or NULL if it could not be mapped or is not a valid archive
+*/
+archive* open_archive(const char* fileName);
+
+/*
+Unmaps an archive. Every pointer into the archive is invalid afterwards. If the archive is mounted, it is
+unmounted first.
+
+Arguments
+    archive* a: The archive to close
+
+Returns
+    Returns false if a is NULL
+*/
+bool close_archive(archive* a);
+
+/*
+Finds an entry of an archive by name
+
+Runs in O(log(n)) time.
+
+Arguments
+    archive* a: The archive to search
+
+    const char* name: The name of the entry
+
+Returns
+    Returns the entry, or NULL if the archive has no entry by that name
+*/
+const archiveEntry* find_archive(archive* a, const char* name);
+
+/*
+Gets the data of an entry, without copying it
+
+Arguments
+    archive* a: The archive the entry is in
+
+    const archiveEntry* e: The entry, see find_archive()
+
+Returns
+    Returns a pointer into the mapped archive, which lives until the archive is closed
+*/
+const void* getData_archive(archive* a, const archiveEntry* e);
+
+/*
+Mounts an archive, so resources are loaded from it instead of from disk. get_texture(), request_texture() and
+programs look up their file names in the mounted archive first, and only read the file when the archive
+doesn't have it.
+
+The archive must be mounted before any texture is requested, since the texture workers read it.
+
+Arguments
+    archive* a: The archive to mount, or NULL to load every resource from disk
+*/
+void mount_archive(archive* a);
+
+/*
+Gets the mounted archive
+
+Returns
+    Returns the mounted archive, or NULL if none is mounted
+*/
+archive* getMounted_archive();
+
+/*
+Gets the source of a shader from the mounted archive
+
+Arguments
+    const char* fileName: The file name the shader was packed from
+
+Returns
+    Returns the null terminated source, or NULL if no archive is mounted or it has no such shader
+*/
+const char* getShader_archive(const char* fileName);
+
+/*
+Gets the mip chain of a texture from the mounted archive
+
+Arguments
+    const char* fileName: The file name the texture was packed from
+
+    size_t* outWidth: The width of the texture's first level
+
+    size_t* outHeight: The height of the texture's first level
+
+    size_t* outLevelCount: The number of levels in the chain
+
+Returns
+    Returns the mip chain, or NULL if no archive is mounted or it has no such texture
+*/
+const uint8_t* getTexture_archive(const char* fileName, size_t* outWidth, size_t* outHeight, size_t* outLevelCount);
+
+/*
+Gets a collider shape from the mounted archive. The polygon's vertices point into the archive, so the
+polygon must not be modified or freed.
+
+Arguments
+    const char* fileName: The file name the polygon was packed from
+
+    polygon* outPoly: The polygon
+
+Returns
+    Returns false if no archive is mounted or it has no such polygon
+*/
+bool getPolygon_archive(const char* fileName, polygon* outPoly);
+
+/*
+Reads a collider shape from a .poly file, written as one "x y" vertex per line. This is the source of an
+ARCHIVE_POLYGON entry, read by the tools that pack and decompose the shapes.
+
+Arguments
+    const char* fileName: The .poly file
+
+    polygon* outPoly: The polygon, whose vertices are allocated and owned by the caller (see free_polygon())
+
+Returns
+    Returns false if the file could not be read, has fewer than 3 vertices or memory allocation failed
+*/
+bool readPolygon_archive(const char* fileName, polygon* outPoly);
+
+/*
+Writes resources to a new archive, which replaces the file if it exists. Used by the packer tool.
+
+Arguments
+    const char* fileName: The file name of the archive
+
+    const archiveSource* sources: The resources to write. Their names must be unique and shorter than ARCHIVE_NAME_SIZE.
+
+    size_t count: The size of sources
+
+Returns
+    Returns false if the archive could not be written, a name is too long, or memory allocation failed
+*/
+bool write_archive(const char* fileName, const archiveSource* sources, size_t count);
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+Asset handles stand in for the file names of textures, shaders and shapes. A file name is interned once,
+after which its handle can be compared, hashed and used as an array index without touching the string,
+e.g. getByAsset_texture() and getByAssets_program().
+
+Handles are small and dense, starting at 1, and live as long as the program. Interning is not thread safe,
+it must be done by the thread that owns the render backend.
+*/
+typedef uint32_t assetHandle;
+
+// No file name is ever interned as this handle
+#define INVALID_ASSET 0
+
+/*
+Interns a file name. Interning the same file name again returns the same handle.
+
+Arguments
+    const char* fileName: The file name, which is copied
+
+Returns
+    Returns the handle of the file name, or INVALID_ASSET if fileName is NULL or memory allocation failed
+*/
+assetHandle intern_asset(const char* fileName);
+
+/*
+Gets the file name an asset handle was interned from
+
+Arguments
+    assetHandle asset: The handle
+
+Returns
+    Returns the file name, which lives as long as the program, or NULL if the handle was never handed out
+*/
+const char* getFileName_asset(assetHandle asset);
+
+/*
+Gets the number of interned file names. Every handle is less than or equal to it, so arrays indexed by
+handle can be sized from it.
+
+Returns
+    Returns the number of interned file names
+*/
+size_t getCount_asset();
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct _atlas atlas;
+
+/*
+Creates a new rectangle packer for a single atlas page.
+
+The packer uses the skyline bottom left heuristic. It keeps the top edge of everything packed so far
+as a list of horizontal segments, and places each new rectangle where its top edge ends up lowest.
+Only the placement is tracked, no texel data is stored.
+
+Arguments
+    size_t width: The width of the page
+
+    size_t height: The height of the page
+
+Returns
+    Returns the new packer or NULL if either argument is 0 or if memory allocation failed
+*/
+atlas* create_atlas(size_t width, size_t height);
+
+/*
+Frees a packer
+
+Arguments
+    atlas* a: The packer to free
+
+Returns
+    Returns false if a is NULL
+*/
+bool free_atlas(atlas* a);
+
+/*
+Finds space for a rectangle on the page and marks it as used. Rectangles are never rotated.
+
+Runs in O(n^2) time, where n is the number of skyline segments, which is at most the number of
+rectangles packed.
+
+Arguments
+    atlas* a: The packer to pack into
+
+    size_t width: The width of the rectangle
+
+    size_t height: The height of the rectangle
+
+    size_t* outX: The left edge of the rectangle on the page
+
+    size_t* outY: The bottom edge of the rectangle on the page
+
+Returns
+    Returns false if any of the pointers are NULL, either size is 0, the rectangle does not fit
+    in the remaining space, or memory allocation failed
+*/
+bool pack_atlas(atlas* a, size_t width, size_t height, size_t* outX, size_t* outY);
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "engine/math/matrix.h"
+#include "engine/math/vec.h"
+
+/*
+A camera looking at the world. The camera's position is drawn at the center of the screen, and
+the world is rotated so the camera's rotation points up.
+*/
+typedef struct _camera
+{
+    vec2f position;
+    float rotation;
+    float zoom; // 1 shows the world at its actual size, 2 shows half as much of the world twice as large
+} camera;
+
+/*
+Creates a camera at the origin, without any rotation or zoom
+
+Allocates no memory
+
+Returns
+    Returns the new camera
+*/
+camera create_camera();
+
+/*
+Gets the view matrix of a camera, which takes world space into camera space. It is the inverse
+of the camera's transform.
+
+Arguments
+    camera* c: The camera to get the view matrix of
+
+Returns
+    Returns the view matrix
+*/
+MATRIX_TYPE(3, 3) getView_camera(camera* c);
+
+/*
+Gets the matrix that takes world space into clip space for a camera: the projection multiplied by
+the view. It only changes when the camera moves, so it should be computed once per frame and shared by every render.
+
+Arguments
+    camera* c: The camera to get the view projection matrix of
+
+    float aspect: The aspect ratio (height / width) of the screen
+
+Returns
+    Returns the view projection matrix
+*/
+MATRIX_TYPE(3, 3) getViewProjection_camera(camera* c, float aspect);
+
+/*
+Gets the axis aligned bounding box of the part of the world the camera can see. When the camera is
+rotated the box is larger than the screen, so anything outside of it is guaranteed to be off screen.
+
+Allocates no memory
+
+Arguments
+    camera* c: The camera to get the bounds of
+
+    float aspect: The aspect ratio (height / width) of the screen
+
+    vec2f* outMin: The lower left corner of the bounding box
+
+    vec2f* outMax: The upper right corner of the bounding box
+*/
+void getBounds_camera(camera* c, float aspect, vec2f* outMin, vec2f* outMax);
@@ -2,9 +2,12 @@
 
 #include <stdbool.h>
 
+#include "engine/decompositionCache.h"
 #include "engine/math/vec.h"
 
+typedef struct _arena arena;
 typedef struct _polygon polygon;
+typedef struct _pool pool;
 typedef struct _transform transform;
 
 typedef struct _collider collider;
@@ -15,6 +18,23 @@ typedef struct _collision
     vec2f overlap;
 } collision;
 
+/*
+Options for how a collider is built from its polygon, see createWithOptions_collider()
+*/
+typedef struct _colliderOptions
+{
+    // DECOMPOSITION_MINIMUM decomposes the polygon into fewer pieces, which makes every collision test with the
+    // collider cheaper. It is slow to decompose, so it suits shapes that are decomposed ahead of time.
+    decompositionMode decomposition;
+
+    // When greater than 0, the polygon is simplified before it is decomposed (see simplify_polygon()), which
+    // drops vertices that are within this distance of its outline. Fewer vertices mean fewer axes to test.
+    float simplifyTolerance;
+} colliderOptions;
+
+// The options used by create_collider() and createFromPool_collider()
+extern const colliderOptions DEFAULT_COLLIDER_OPTIONS;
+
 /*
 Creates a new collider from a given transform and polygon
 
@@ -23,16 +43,77 @@ Arguments
         of the collider in world space
 
     polygon* poly: The polygon that will be used to create the collider. It can be
-        concave or convex, but it should never cross through itself (i.e. no figure-8s)
+        concave or convex, but it should never cross through itself (i.e. no figure-8s).
+        It is decomposed into convex pieces through the decomposition cache (see
+        decompositionCache.h), so only the first collider of a shape decomposes it
 
 Returns
     Returns a new collider or NULL if any of the arguments were NULL or memory allocation failed
 */
 collider* create_collider(transform* transform, polygon* poly);
 
+/*
+Creates a new collider from a given transform and polygon, with options for how it is built
+
+Arguments
+    transform* transform: See create_collider()
+
+    polygon* poly: See create_collider()
+
+    const colliderOptions* options: How the collider is built, or NULL for DEFAULT_COLLIDER_OPTIONS
+
+Returns
+    Returns a new collider or NULL if any of the arguments were NULL or memory allocation failed
+*/
+collider* createWithOptions_collider(transform* transform, polygon* poly, const colliderOptions* options);
+
+/*
+Creates a new pool that colliders can be allocated from. See createFromPool_collider()
+
+Arguments
+    size_t slabCapacity: The number of colliders stored in a single slab of the pool
+
+Returns
+    Returns the new pool or NULL if memory allocation failed
+*/
+pool* createPool_collider(size_t slabCapacity);
+
+/*
+Creates a new collider from a given transform and polygon, allocated from a pool instead
+of the system allocator. The collider is returned to the pool by free_collider().
+
+Arguments
+    pool* p: The pool to allocate the collider from. It must have been created by createPool_collider()
+
+    transform* transform: See create_collider()
+
+    polygon* poly: See create_collider()
+
+Returns
+    Returns a new collider or NULL if any of the arguments were NULL or memory allocation failed
+*/
+collider* createFromPool_collider(pool* p, transform* transform, polygon* poly);
+
+/*
+Creates a new collider from a pool, with options for how it is built. See createFromPool_collider()
+
+Arguments
+    pool* p: See createFromPool_collider()
+
+    transform* transform: See create_collider()
+
+    polygon* poly: See create_collider()
+
+    const colliderOptions* options: See createWithOptions_collider()
+
+Returns
+    Returns a new collider or NULL if any of the arguments were NULL or memory allocation failed
+*/
+collider* createFromPoolWithOptions_collider(pool* p, transform* transform, polygon* poly, const colliderOptions* options);
+
 /*
 Frees the collider and all associated memory. The source polygon used to create the collider
-is not freed by this function
+is not freed by this function. Colliders created from a pool are released back to that pool
 
 Arguments
     collider* c: The collider to free
@@ -42,6 +123,18 @@ Returns
 */
 bool free_collider(collider* c);
 
+/*
+Returns the radius of the smallest circle centered at the collider's origin that contains
+the whole collider, before the collider's transform is applied
+
+Arguments
+    collider* c: The collider to get the radius from
+
+Returns
+    Returns the radius of the collider or 0 if c is NULL
+*/
+float getRadius_collider(collider* c);
+
 /*
 Detects if two colliders are colliding.
 
@@ -58,3 +151,19 @@ Returns
 */
 collision detectCollision_collider(collider* c1, collider* c2);
 
+/*
+Detects if two colliders are colliding. This is the same as detectCollision_collider(), except
+the temporary transformed polygons are allocated from an arena rather than the system allocator.
+
+Arguments
+    collider* c1: The first collider
+
+    collider* c2: The second collider
+
+    arena* a: The arena to allocate temporary memory from. The memory is not released until the
+        arena is reset. Passing NULL falls back to malloc and free.
+
+Returns
+    Returns false if either colliders are NULL or if a collision was not detected.
+*/
+collision detectCollisionInArena_collider(collider* c1, collider* c2, arena* a);
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "engine/math/transform.h"
+#include "engine/math/vec.h"
+
+typedef struct _collider collider;
+typedef struct _gameObject gameObject;
+typedef struct _render render;
+
+/*
+Structure of arrays storage for the components of every gameObject in a gameEnvironment.
+
+Each array is indexed by the dense index of a gameObject, the same index its handle resolves
+to in the gameEnvironment's slotmap. Every engine phase can stream through just the fields it
+touches (e.g. the broadphase only reads positions and radii) instead of visiting whole gameObjects.
+
+The arrays are kept in sync by the gameObject setters, so they must be treated as read only.
+*/
+typedef struct _components
+{
+    vec2f* positions;
+    float* rotations;
+    vec2f* scales;
+    float* radii; // The bounding radius of the collider in world space, or 0 if there is no collider
+    uint16_t* types;
+    collider** colliders;
+    render** renders; // NULL for static gameObjects whose renders are drawn in static batches, see isBatched_render()
+
+    size_t count;
+    size_t capacity;
+} components;
+
+/*
+Creates the arrays of a components storage
+
+Arguments
+    components* c: The storage to create
+
+    size_t capacity: The initial number of gameObjects the storage can hold. The storage grows as needed.
+
+Returns
+    Returns false if c is NULL, capacity is 0, or memory allocation failed
+*/
+bool create_components(components* c, size_t capacity);
+
+/*
+Frees the arrays of a components storage. The gameObjects stored are not freed.
+
+Arguments
+    components* c: The storage to free
+
+Returns
+    Returns false if c is NULL
+*/
+bool free_components(components* c);
+
+/*
+Appends the components of a gameObject to the end of the storage, and points the gameObject
+at its new index so that later changes to the gameObject are written through.
+
+Runs in amortized O(1) time.
+
+Arguments
+    components* c: The storage to append to
+
+    gameObject* g: The gameObject to append
+
+Returns
+    Returns false if any of the arguments are NULL or memory allocation failed
+*/
+bool push_components(components* c, gameObject* g);
+
+/*
+Removes the components at an index by moving the last components into the hole. This mirrors
+remove_slotmap(), so both stay in the same order.
+
+Runs in O(1) time.
+
+Arguments
+    components* c: The storage to remove from
+
+    size_t index: The index to remove
+
+Returns
+    Returns false if c is NULL or index is out of bounds
+*/
+bool swapRemove_components(components* c, size_t index);
+
+/*
+Swaps the components at two indices. This mirrors swap_slotmap(), so both stay in the same order.
+
+Arguments
+    components* c: The storage to reorder
+
+    size_t i: The first index
+
+    size_t j: The second index
+
+Returns
+    Returns false if c is NULL or either index is out of bounds
+*/
+bool swap_components(components* c, size_t i, size_t j);
+
+/*
+Writes a transform to the components at an index. The bounding radius is rescaled to match.
+
+Arguments
+    components* c: The storage to write to
+
+    size_t index: The index to write to
+
+    transform t: The transform to write
+*/
+void setTransform_components(components* c, size_t index, transform t);
+
+/*
+Writes the collider and render of a gameObject to the components at an index
+
+Arguments
+    components* c: The storage to write to
+
+    size_t index: The index to write to
+
+    gameObject* g: The gameObject to read the collider and render from
+*/
+void setGameObject_components(components* c, size_t index, gameObject* g);
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "engine/math/polygon.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+A cache of convex decompositions, so a collider shape is only decomposed once (see decompose_polygon()).
+Decompositions are kept in memory, keyed by a hash of the polygon's vertices and the decompositionMode, and can be saved to and loaded
+from a single file. The decomposePolygons tool (see src/tools/decomposePolygons.c) builds that file ahead of
+time for every level shape, so large shapes are never decomposed at load.
+
+Every collider is decomposed through the cache, see create_collider(). The cache is not thread safe.
+
+The cache is capped rather than growing with every shape a game makes at runtime. Once it holds
+setCapacity_decompositionCache() decompositions, shapes that miss are still decomposed but no longer cached.
+Decompositions loaded from a file are always cached, since the file is built ahead of time and its size is known.
+*/
+
+// The default of setCapacity_decompositionCache()
+#define DEFAULT_DECOMPOSITION_CACHE_CAPACITY 1024
+
+/*
+How a polygon is decomposed. Each mode is cached separately, so the same shape can be cached both ways.
+*/
+typedef enum _decompositionMode
+{
+    DECOMPOSITION_FAST = 0, // decompose_polygon()
+    DECOMPOSITION_MINIMUM = 1, // decomposeMinimum_polygon(), slower but with fewer pieces to test for collision
+} decompositionMode;
+
+/*
+How the cache has been used, see getStats_decompositionCache()
+*/
+typedef struct _decompositionCacheStats
+{
+    size_t entries; // The number of cached decompositions
+    size_t hits; // The number of decompositions copied from the cache
+    size_t misses; // The number of polygons that had to be decomposed
+} decompositionCacheStats;
+
+/*
+Hashes the vertices of a polygon into the key its decomposition is cached under
+
+Arguments
+    polygon* poly: The polygon
+
+Returns
+    Returns the key
+*/
+uint64_t hash_decompositionCache(polygon* poly);
+
+/*
+Gets the convex decomposition of a polygon, copying it from the cache if the polygon has been decomposed
+before, or decomposing it and adding it to the cache if not. A cached decomposition is copied in
+O(vertices of its pieces), without triangulating the polygon again.
+
+Arguments
+    polygon* in: See decompose_polygon()
+
+    polygon** out: See decompose_polygon()
+
+    int* outCount: See decompose_polygon()
+
+Returns
+    Returns false if any of the arguments are bad or if memory allocation fails
+*/
+bool decompose_decompositionCache(polygon* in, polygon** out, int* outCount);
+
+/*
+Gets the convex decomposition of a polygon for a given mode, the same as decompose_decompositionCache()
+
+Arguments
+    polygon* in: See decompose_polygon()
+
+    decompositionMode mode: How the polygon is decomposed if it isn't cached
+
+    polygon** out: See decompose_polygon()
+
+    int* outCount: See decompose_polygon()
+
+Returns
+    Returns false if any of the arguments are bad or if memory allocation fails
+*/
+bool decomposeWithMode_decompositionCache(polygon* in, decompositionMode mode, polygon** out, int* outCount);
+
+/*
+Loads every decomposition in a cache file into the cache, replacing any cached under the same key
+
+Arguments
+    const char* fileName: The cache file, see save_decompositionCache()
+
+Returns
+    Returns false if the file could not be read or is not a valid cache file, in which case nothing is added.
+    A file saved by a build with a different cache version or layout is not valid, and should be rebuilt
+*/
+bool load_decompositionCache(const char* fileName);
+
+/*
+Saves every cached decomposition to a file
+
+Arguments
+    const char* fileName: The cache file to write
+
+Returns
+    Returns false if the file could not be written
+*/
+bool save_decompositionCache(const char* fileName);
+
+/*
+Removes every cached decomposition and resets the stats
+*/
+void clear_decompositionCache();
+
+/*
+Sets the most decompositions that are cached as polygons are decomposed, see decompose_decompositionCache().
+Decompositions that are already cached are kept even if there are more of them. Tools that build a cache file
+ahead of time should raise the capacity above the number of shapes they decompose.
+
+Arguments
+    size_t maxEntries: The capacity. The default is DEFAULT_DECOMPOSITION_CACHE_CAPACITY
+*/
+void setCapacity_decompositionCache(size_t maxEntries);
+
+/*
+Gets how many decompositions are cached, and how often the cache was hit
+
+Returns
+    Returns the stats
+*/
+decompositionCacheStats getStats_decompositionCache();
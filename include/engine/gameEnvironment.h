@@ -1,12 +1,21 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
+#include "datastructures/slotmap.h"
+
+typedef struct _arena arena;
+typedef struct _camera camera;
+typedef struct _components components;
 typedef struct _gameEnvironment gameEnvironment;
 typedef struct _gameObject gameObject;
 typedef struct _collision collision;
+typedef struct _renderThread renderThread;
 
 typedef void (*onUpdateHandler)(gameEnvironment*, gameObject*);
+typedef void (*onUpdateTypeHandler)(gameEnvironment*, gameObject** gameObjects, size_t first, size_t count);
 typedef void (*onCollisionHandler)(gameEnvironment*, gameObject*, gameObject*, collision* c);
 typedef void (*onRenderStartHandler)(gameEnvironment*);
 typedef void (*onRenderEndHandler)(gameEnvironment*);
@@ -14,6 +23,10 @@ typedef void (*onRemoveGameObjectHandler)(gameEnvironment*, gameObject*);
 
 typedef struct _gameEvents
 {
+    /*
+    The handler called for each gameObject whose type has no update handler set with
+    setUpdateHandler_gameEnvironment(). This is the only optional handler, and may be NULL.
+    */
     onUpdateHandler onUpdate;
 
     /*
@@ -30,6 +43,9 @@ typedef struct _gameEvents
 typedef struct _gameSettings
 {
     float aspect; // height / width
+
+    // The most requested textures uploaded by each run_gameEnvironment(), or 0 for the default of 4. See request_texture()
+    size_t textureUploadsPerStep;
 } gameSettings;
 
 /*
@@ -40,11 +56,11 @@ running side by side without any issue.
 
 Arguments
     gameEvents ge: The global event handlers used by the gameEnvironment. Each event handler
-        is required and should not be NULL
+        except onUpdate is required and should not be NULL
 
 Returns
-    Returns the new gameEnvironment or NULL if memory allocation fails, if ge == NULL, or
-    if any of the fields in ge are NULL
+    Returns the new gameEnvironment or NULL if memory allocation fails, or if any of the
+    required fields in ge are NULL
 */
 gameEnvironment* create_gameEnvironment(gameEvents ge, gameSettings gs);
 
@@ -53,8 +69,9 @@ Frees a gameEnvironment
 
 Deallocates all memory associated with a gameEnvironment, rendering it invalid.
 
-NOTE: Any gameObject added to the gameEnvironment is not freed when calling this method.
-    You must free them yourself
+NOTE: Any gameObject created with create_gameObject() and added to the gameEnvironment is not freed
+    when calling this method. You must free them yourself. gameObjects created with
+    createGameObject_gameEnvironment() are owned by the gameEnvironment and are freed by this method.
 
 Arguments
     gameEnvironment* env: The environment to free
@@ -64,6 +81,24 @@ Returns
 */
 bool free_gameEnvironment(gameEnvironment* env);
 
+/*
+Creates a new gameObject from the pools owned by the gameEnvironment. The collider and render
+set on the gameObject are allocated from the same pools, so creating and freeing gameObjects
+does not touch the system allocator once the pools have grown large enough.
+
+The gameObject is not added to the gameEnvironment. Call addGameObject_gameEnvironment() to add it.
+It can be freed with free_gameObject(), otherwise it is freed along with the gameEnvironment.
+
+Arguments
+    gameEnvironment* env: The gameEnvironment that owns the new gameObject
+
+    uint16_t type: The type of the gameObject. See create_gameObject()
+
+Returns
+    Returns the new gameObject or NULL if env is NULL or memory allocation failed
+*/
+gameObject* createGameObject_gameEnvironment(gameEnvironment* env, uint16_t type);
+
 /*
 Adds a gameObject to the gameEnvironment.
 
@@ -95,13 +130,56 @@ Returns
 */
 gameObject* removeGameObject_gameEnvironment(gameEnvironment* env, gameObject* g);
 
+/*
+Sets the update handler for every gameObject of a type.
+
+Added gameObjects are kept grouped by type, so the handler is called once per run_gameEnvironment()
+with every gameObject of its type in a single contiguous array. This avoids an indirect call and
+a switch on the type for every gameObject, and lets the handler process the whole group at once.
+Types without an update handler fall back to onUpdate.
+
+The components of gameObjects[i] are at index first + i of the arrays in getComponents_gameEnvironment().
+
+Arguments
+    gameEnvironment* env: The gameEnvironment to set the update handler on
+
+    uint16_t type: The type of gameObjects the handler updates
+
+    onUpdateTypeHandler handler: The handler to set, or NULL to unset the handler of the type
+
+Returns
+    Returns false if env is NULL or memory allocation failed
+*/
+bool setUpdateHandler_gameEnvironment(gameEnvironment* env, uint16_t type, onUpdateTypeHandler handler);
+
+/*
+Resolves a gameObject handle. Handles are plain 32 bit values, so unlike gameObject pointers they
+can be stored and compared safely after the gameObject is removed. See getHandle_gameObject()
+
+Runs in O(1) time.
+
+Arguments
+    gameEnvironment* env: The gameEnvironment the gameObject was added to
+
+    handle h: The handle of the gameObject
+
+Returns
+    Returns the gameObject, or NULL if env is NULL or the gameObject has been removed from the gameEnvironment
+*/
+gameObject* getGameObject_gameEnvironment(gameEnvironment* env, handle h);
+
 /*
 Runs the gameEnvironment a single step
 
 The following actions are performed, in this order:
-1. Each gameObject is passed to onUpdate
+0. The frame arena is reset, releasing everything allocated from it during the previous step
+1. Each group of gameObjects with the same type is passed to its update handler, or each
+   gameObject is passed to onUpdate if the type has no update handler
 2. Detect collision between gameObjects, calling onCollsion as necessary
-3. The world is rendered to the screen
+3. Requested textures that have finished decoding are uploaded, up to gameSettings.textureUploadsPerStep
+4. The world is rendered to the screen. The static batches are rebuilt first if a static gameObject
+   was added or removed (see setStatic_gameObject()), and the batches of each layer are drawn just
+   before the other renders of that layer
 */
 void run_gameEnvironment(gameEnvironment* env);
 
@@ -125,3 +203,61 @@ Arguments
     gameEnvironment* g: The gameEnvironment to get the userdata from
 */
 void* getUserdata_gameEnvironment(gameEnvironment* env);
+
+/*
+Returns the camera the gameEnvironment renders the world with. The camera can be moved at any time,
+and the change is picked up by the next run_gameEnvironment().
+
+Arguments
+    gameEnvironment* env: The gameEnvironment to get the camera from
+
+Returns
+    Returns the camera, or NULL if env is NULL
+*/
+camera* getCamera_gameEnvironment(gameEnvironment* env);
+
+/*
+Hands rendering over to a render thread. From the next run_gameEnvironment() on, the visible renders are
+recorded into a frame and submitted to the render thread instead of being drawn, so the next step can
+run while the frame is drawn. onRenderStart and onRenderEnd are still called on the calling thread,
+around recording the frame.
+
+NOTE: The render thread must be set to NULL before it is freed
+
+Arguments
+    gameEnvironment* env: The gameEnvironment to render with the render thread
+
+    renderThread* rt: The render thread, or NULL to draw on the calling thread again
+*/
+void setRenderThread_gameEnvironment(gameEnvironment* env, renderThread* rt);
+
+/*
+Returns the frame arena of the gameEnvironment. The frame arena is scratch memory that is
+reset at the start of every run_gameEnvironment(). Event handlers can allocate temporary data
+from it with alloc_arena() without ever freeing it.
+
+NOTE: Memory allocated from the frame arena must not be used after the current run_gameEnvironment() returns
+
+Arguments
+    gameEnvironment* env: The gameEnvironment to get the frame arena from
+
+Returns
+    Returns the frame arena, or NULL if env is NULL
+*/
+arena* getFrameArena_gameEnvironment(gameEnvironment* env);
+
+/*
+Returns the component storage of the gameEnvironment. The storage holds the transform, bounds,
+type, collider and render of every added gameObject in parallel arrays, in the same order as
+the gameObjects passed to the engine phases. Handlers that only need a few fields of many
+gameObjects can stream through the arrays instead of visiting each gameObject.
+
+NOTE: The storage is read only. Change gameObjects through their setters, which write through to the storage.
+
+Arguments
+    gameEnvironment* env: The gameEnvironment to get the component storage from
+
+Returns
+    Returns the component storage, or NULL if env is NULL
+*/
+const components* getComponents_gameEnvironment(gameEnvironment* env);
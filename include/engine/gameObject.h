@@ -2,12 +2,28 @@
 
 #include <stdint.h>
 
+#include "datastructures/slotmap.h"
 #include "engine/math/transform.h"
 #include "engine/render.h"
 
 typedef struct _collider collider;
+typedef struct _colliderOptions colliderOptions;
+typedef struct _components components;
 typedef struct _gameObject gameObject;
 typedef struct _polygon polygon;
+typedef struct _pool pool;
+
+/*
+The pools a gameObject and its components are allocated from. Creating gameObjects from pools
+keeps gameObjects created together next to each other in memory, and avoids the system allocator
+when gameObjects are frequently created and freed.
+*/
+typedef struct _gameObjectPools
+{
+    pool* gameObjects;
+    pool* colliders;
+    pool* renders;
+} gameObjectPools;
 
 /*
 Creates a new gameObject.
@@ -26,7 +42,63 @@ Returns
 gameObject* create_gameObject(uint16_t type);
 
 /*
-Frees the memory of a gameObject
+Creates a new gameObject allocated from a set of pools. The collider and render set on the
+gameObject are allocated from the same pools. free_gameObject() releases everything back to the pools.
+
+Arguments
+    gameObjectPools* pools: The pools to allocate from. See create_gameObjectPools()
+
+    uint16_t type: See create_gameObject()
+
+Returns
+    Returns the newly created gameObject, or NULL if pools is NULL or memory allocation failed
+*/
+gameObject* createFromPools_gameObject(gameObjectPools* pools, uint16_t type);
+
+/*
+Creates every pool needed to allocate gameObjects, colliders and renders
+
+Arguments
+    gameObjectPools* pools: The pools to create
+
+    size_t slabCapacity: The number of elements stored in a single slab of each pool
+
+Returns
+    Returns false if pools is NULL or memory allocation failed
+*/
+bool create_gameObjectPools(gameObjectPools* pools, size_t slabCapacity);
+
+/*
+Determines if a gameObject was allocated from a given set of pools
+
+Arguments
+    gameObject* g: The gameObject to check
+
+    gameObjectPools* pools: The pools to check against
+
+Returns
+    Returns true if g was created by createFromPools_gameObject() with pools
+*/
+bool isFromPools_gameObject(gameObject* g, gameObjectPools* pools);
+
+/*
+Frees every pool in a set of pools. All gameObjects, colliders and renders allocated from
+the pools are released at once, without visiting each of them.
+
+NOTE: The convex polygons of a pooled collider are not stored in the pools. Free gameObjects
+    with a collider through free_gameObject() to release them.
+
+Arguments
+    gameObjectPools* pools: The pools to free
+
+Returns
+    Returns false if pools is NULL
+*/
+bool free_gameObjectPools(gameObjectPools* pools);
+
+/*
+Frees the memory of a gameObject, along with its collider and render. gameObjects created
+from pools are released back to their pools.
 
 Arguments
     gameObject* g: The gameObject to free.
@@ -47,6 +119,52 @@ Returns
 */
 uint16_t getType_gameObject(gameObject* g);
 
+/*
+Returns the handle of the gameObject in the gameEnvironment it was added to. A handle stays valid
+until the gameObject is removed from the gameEnvironment, and never resolves to a different gameObject.
+See getGameObject_gameEnvironment()
+
+Arguments
+    gameObject* g: The gameObject to get the handle from
+
+Returns
+    Returns the handle of the gameObject, or INVALID_HANDLE if the gameObject is not in a gameEnvironment.
+    Handles are assigned when queued gameObjects are added at the start of run_gameEnvironment()
+*/
+handle getHandle_gameObject(gameObject* g);
+
+/*
+Sets the handle of the gameObject. This is called by the gameEnvironment as gameObjects are added and removed,
+and should not be called otherwise.
+
+Arguments
+    gameObject* g: The gameObject to set the handle on
+
+    handle h: The handle to set
+
+Returns
+    Returns false if g is NULL
+*/
+bool setHandle_gameObject(gameObject* g, handle h);
+
+/*
+Points the gameObject at its entry in a components storage. Any later change to the transform,
+collider or render of the gameObject is written through to the storage. This is called by
+the components storage and gameEnvironment as gameObjects are added, moved and removed, and
+should not be called otherwise.
+
+Arguments
+    gameObject* g: The gameObject to set the storage on
+
+    components* store: The storage holding the gameObject's components, or NULL to detach the gameObject
+
+    size_t index: The index of the gameObject's components in store
+
+Returns
+    Returns false if g is NULL
+*/
+bool setComponents_gameObject(gameObject* g, components* store, size_t index);
+
 /*
 Returns the userdata associated with the game object. Userdata is any arbitrary
 data set by the user, that is only used by the user. No library functions ever modify userdata.
@@ -120,6 +238,22 @@ Returns
 */
 bool setCollider_gameObject(gameObject* g, polygon* p);
 
+/*
+Creates and sets the collider for the gameObject from a given polygon, with options for how it is built.
+
+Arguments
+    gameObject* g: The gameObject for which to set the collider.
+
+    polygon* p: The polygon from which to create and set the collider. See create_collider() for more info.
+
+    const colliderOptions* options: See createWithOptions_collider()
+
+Returns
+    Returns false if the collider was not set. This usually occurs if g == NULL or
+    if internal memory allocation fails
+*/
+bool setColliderWithOptions_gameObject(gameObject* g, polygon* p, const colliderOptions* options);
+
 /*
 Returns the render for the gameObject
 
@@ -140,6 +274,38 @@ Arguments
     renderInfo rI: The render info to create the render from. See create_render() for more info.
 
 Returns
-    Returns false if the render was not set or could not be created.
+    Returns false if the render was not set or could not be created, or if g is static and has already
+    been added to a gameEnvironment (see setStatic_gameObject()).
 */
 bool setRender_gameObject(gameObject* g, renderInfo rI);
+
+/*
+Marks a gameObject as static. Static gameObjects never move, so the gameEnvironment merges their renders
+into prebuilt vertex buffers that are drawn with a single call each, instead of drawing them every frame.
+See staticBatch.h
+
+NOTE: The transform and render of a static gameObject must be set before it is added to a gameEnvironment.
+Later changes are not drawn, and setRender_gameObject() fails once it is added. Only renders created with
+shaders that read batch vertices are batched (see STATIC_VERTEX_SHADER), any other render is drawn every
+frame as if its gameObject weren't static.
+
+Arguments
+    gameObject* g: The gameObject to mark
+
+    bool isStatic: Whether the gameObject is static. gameObjects are not static by default.
+
+Returns
+    Returns false if g is NULL or if g has already been added to a gameEnvironment
+*/
+bool setStatic_gameObject(gameObject* g, bool isStatic);
+
+/*
+Returns whether a gameObject is static, see setStatic_gameObject()
+
+Arguments
+    gameObject* g: The gameObject
+
+Returns
+    Returns true if the gameObject is static, or false if it isn't or g is NULL
+*/
+bool isStatic_gameObject(gameObject* g);
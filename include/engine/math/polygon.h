@@ -70,6 +70,47 @@ Returns
 */
 bool decompose_polygon(polygon* in, polygon** out, int* outCount);
 
+/*
+Decomposes a polygon into as few convex polygons as it can, for shapes that are tested for collision often.
+Bayazit's algorithm splits the polygon at its reflex vertices directly, and the result is compared against
+decompose_polygon(), keeping whichever has fewer polygons. Pieces may have vertices that the source polygon
+doesn't, where a split had no vertex to end at.
+
+This is much slower than decompose_polygon(), O(n^3) in the worst case, so it is meant for decomposing
+ahead of time or while loading (see decompositionCache.h).
+
+Arguments
+    polygon* in: See decompose_polygon()
+
+    polygon** out: See decompose_polygon()
+
+    int* outCount: See decompose_polygon()
+
+Returns
+    Returns false if any of the arguments are bad or if memory allocation fails.
+*/
+bool decomposeMinimum_polygon(polygon* in, polygon** out, int* outCount);
+
+/*
+Simplifies a polygon by dropping the vertices that barely change its shape, such as the nearly collinear
+vertices of a traced outline. Every dropped vertex is within the tolerance of the simplified outline
+(Ramer-Douglas-Peucker). If simplifying would make the sides of the polygon cross, or leave fewer than 3
+vertices, the polygon is copied as it is.
+
+Runs in O(n log n) time on average, plus O(m^2) for m kept vertices to check the sides don't cross.
+
+Arguments
+    polygon* in: The polygon to simplify
+
+    polygon* out: The simplified polygon, which is created by this function and must be freed with free_polygon()
+
+    float tolerance: How far a dropped vertex may be from the simplified outline. 0 only drops collinear vertices.
+
+Returns
+    Returns false if any of the arguments are bad or if memory allocation fails.
+*/
+bool simplify_polygon(polygon* in, polygon* out, float tolerance);
+
 /*
 Projects a polygon onto a line that passes through (0, 0) with a give slope where
 only the two most extreme points are kept
@@ -26,6 +26,23 @@ Returns
 */
 MATRIX_TYPE(3, 3) getMatrix_transform(transform* t);
 
+/*
+Gets the axis aligned bounding box of a rectangle centered around the origin, after a transform
+is applied to it
+
+Allocates no memory
+
+Arguments
+    transform* t: The transform to apply to the rectangle
+
+    vec2f size: The width and height of the rectangle
+
+    vec2f* outMin: The lower left corner of the bounding box
+
+    vec2f* outMax: The upper right corner of the bounding box
+*/
+void getBounds_transform(transform* t, vec2f size, vec2f* outMin, vec2f* outMax);
+
 /*
 Applies a transform to a polygon centered around the origin and returns it
 
@@ -41,3 +58,19 @@ Returns
     Out should be deallocated by calling free_polygon()
 */
 bool applyTransform_polygon(polygon* in, transform* t, polygon* out);
+
+/*
+Applies a transform matrix to a polygon centered around the origin. Unlike applyTransform_polygon(),
+no memory is allocated, so the matrix can be computed once and applied to many polygons.
+
+Arguments:
+    polygon* in: The polygon to apply the matrix to
+
+    MATRIX_TYPE(3, 3)* matrix: The matrix to apply. See getMatrix_transform()
+
+    polygon* out: The resulting transformed polygon. out->vertices must already have room for in->vertexCount vertices
+
+Returns
+    Returns false if any of the arguments are NULL
+*/
+bool applyMatrix_polygon(polygon* in, MATRIX_TYPE(3, 3)* matrix, polygon* out);
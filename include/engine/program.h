@@ -0,0 +1,81 @@
+#pragma once
+
+#include "engine/asset.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The uniform buffer binding the camera's view projection matrix is shared through. Programs that declare
+// a "Camera" uniform block are linked to it, see setViewProjection_render()
+#define CAMERA_BLOCK_BINDING 0
+
+/*
+A linked shader program along with the locations of every uniform the engine sets.
+
+Programs are cached by their shader file names, so every render that uses the same pair of shaders
+shares a single program. The fields are read only.
+*/
+typedef struct _program
+{
+    uint32_t id; // The OpenGL program id
+    uint16_t index; // A small id, unique among the live programs. Indices of released programs are reused.
+
+    bool isInstanced; // The program reads the model, size, color and texture coordinates as per instance attributes
+    bool isBatched; // The program reads the world space vertices of static batches, see batchVertex
+
+    bool hasCameraBlock; // The program reads the view projection matrix from the shared camera uniform block
+    int32_t modelUniform;
+    int32_t mvpUniform;
+    int32_t sizeUniform;
+    int32_t imageUniform;
+    int32_t colorUniform;
+    int32_t uvRectUniform;
+
+    uint64_t key; // The asset handles of the vertex and fragment shaders the program is cached under
+    size_t refCount;
+} program;
+
+/*
+Gets the program linked from a vertex and fragment shader. The shaders are only read, compiled and
+linked the first time the pair is requested, after that the cached program is returned.
+
+Every call must be matched by a call to release_program().
+
+Arguments
+    const char* vertexShader: The file name of the vertex shader
+
+    const char* fragmentShader: The file name of the fragment shader
+
+Returns
+    Returns the program, or NULL if either argument is NULL or the program could not be created
+*/
+program* get_program(const char* vertexShader, const char* fragmentShader);
+
+/*
+Same as get_program(), for shader file names that have already been interned. The cached program is
+found by the pair of handles, without touching either file name.
+
+Every call must be matched by a call to release_program().
+
+Arguments
+    assetHandle vertexShader: The asset handle of the vertex shader's file name, see intern_asset()
+
+    assetHandle fragmentShader: The asset handle of the fragment shader's file name
+
+Returns
+    Returns the program, or NULL if either handle is invalid or the program could not be created
+*/
+program* getByAssets_program(assetHandle vertexShader, assetHandle fragmentShader);
+
+/*
+Releases a program returned by get_program(). The program is deleted once it has been released
+as many times as it was gotten.
+
+Arguments
+    program* p: The program to release
+
+Returns
+    Returns false if p is NULL
+*/
+bool release_program(program* p);
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+An on-disk cache of linked program binaries, so programs are only compiled from source the first time
+they are created on a machine (see loadShaders()). Each binary is stored in its own file in the cache
+directory, named by a hash of the shader sources and the driver that linked it. A driver update or a
+shader edit changes the hash, so stale binaries are simply never loaded again.
+
+The cache is disabled until a directory is set.
+*/
+
+/*
+Sets the directory program binaries are cached in. The directory is created when the first binary is stored.
+
+Arguments
+    const char* directory: The directory, which is copied, or NULL to disable the cache
+
+Returns
+    Returns false if memory allocation failed, in which case the cache is disabled
+*/
+bool setDirectory_programCache(const char* directory);
+
+/*
+Checks whether the cache is enabled
+
+Returns
+    Returns true if a directory has been set
+*/
+bool isEnabled_programCache();
+
+/*
+Hashes the sources of a program and the driver that links it into the key its binary is cached under
+
+Arguments
+    const char** sources: The null terminated source of every shader of the program, in the order they are attached
+
+    size_t count: The size of sources
+
+    const char* driver: Identifies the driver, e.g. its renderer and version strings. Binaries are only valid for the driver that made them.
+
+Returns
+    Returns the key
+*/
+uint64_t hash_programCache(const char** sources, size_t count, const char* driver);
+
+/*
+Loads a cached program binary
+
+Arguments
+    uint64_t key: The key of the binary, see hash_programCache()
+
+    uint32_t* outFormat: The driver specific format of the binary
+
+    size_t* outSize: The size of the binary in bytes
+
+Returns
+    Returns the binary, which must be freed, or NULL if the cache is disabled or has no binary for the key
+*/
+void* load_programCache(uint64_t key, uint32_t* outFormat, size_t* outSize);
+
+/*
+Stores a program binary, replacing any binary already cached under the key
+
+Arguments
+    uint64_t key: The key of the binary, see hash_programCache()
+
+    uint32_t format: The driver specific format of the binary
+
+    const void* binary: The binary
+
+    size_t size: The size of the binary in bytes
+
+Returns
+    Returns false if the cache is disabled or the binary could not be written
+*/
+bool store_programCache(uint64_t key, uint32_t format, const void* binary, size_t size);
+
+/*
+Removes a cached program binary, e.g. one the driver rejected
+
+Arguments
+    uint64_t key: The key of the binary
+
+Returns
+    Returns false if the cache is disabled or it has no binary for the key
+*/
+bool remove_programCache(uint64_t key);
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+The header of a cooked texture (.rtex). Cooked textures are built ahead of time from pngs by the texture
+cooker (see src/tools/cookTexture.c), so loading one is a single read instead of a png decode.
+
+The header is followed by the mip chain: levelCount levels of row-major RGBA texels, largest first. Each
+level is half the size of the level before it, rounded down, but never smaller than 1x1.
+*/
+typedef struct _rawTextureHeader
+{
+    char magic[4]; // "RTEX"
+    uint32_t version;
+    uint32_t width; // The size of the first level
+    uint32_t height;
+    uint32_t levelCount;
+    uint32_t unused;
+} rawTextureHeader;
+
+/*
+Gets the number of levels in a full mip chain, down to 1x1
+
+Arguments
+    size_t width: The width of the first level
+
+    size_t height: The height of the first level
+
+Returns
+    Returns the number of levels
+*/
+size_t getLevelCount_rawTexture(size_t width, size_t height);
+
+/*
+Gets the size of a single level of a mip chain
+
+Arguments
+    size_t width: The width of the first level
+
+    size_t height: The height of the first level
+
+    size_t level: The level, where 0 is the first
+
+    size_t* outWidth: The width of the level
+
+    size_t* outHeight: The height of the level
+*/
+void getLevelSize_rawTexture(size_t width, size_t height, size_t level, size_t* outWidth, size_t* outHeight);
+
+/*
+Gets the size of a mip chain
+
+Arguments
+    size_t width: The width of the first level
+
+    size_t height: The height of the first level
+
+    size_t levelCount: The number of levels in the chain
+
+Returns
+    Returns the size of every level together, in bytes
+*/
+size_t getSize_rawTexture(size_t width, size_t height, size_t levelCount);
+
+/*
+Fills in the missing levels of a mip chain. Each texel is the average of the 2x2 texels it covers in the
+level before it.
+
+Arguments
+    uint8_t* chain: The mip chain, which has room for levelCount levels
+
+    size_t width: The width of the first level
+
+    size_t height: The height of the first level
+
+    size_t firstMissing: The first level to fill in. Every level before it must already be filled in.
+
+    size_t levelCount: The number of levels in the chain
+
+Returns
+    Returns false if chain is NULL or firstMissing is 0
+*/
+bool buildMipmaps_rawTexture(uint8_t* chain, size_t width, size_t height, size_t firstMissing, size_t levelCount);
+
+/*
+Cooks texels into a raw texture file with a full mip chain
+
+Arguments
+    const char* fileName: The file to write, which is replaced if it exists
+
+    const uint8_t* texels: The row-major RGBA texels of the first level
+
+    size_t width: The width of the first level
+
+    size_t height: The height of the first level
+
+Returns
+    Returns false if the file could not be written or memory allocation failed
+*/
+bool write_rawTexture(const char* fileName, const uint8_t* texels, size_t width, size_t height);
+
+/*
+Reads a raw texture file. The whole mip chain is read at once, since it is stored exactly as it is uploaded.
+
+Arguments
+    const char* fileName: The file to read
+
+    size_t* outWidth: The width of the first level
+
+    size_t* outHeight: The height of the first level
+
+    size_t* outLevelCount: The number of levels in the chain
+
+Returns
+    Returns the mip chain, which must be freed, or NULL if the file could not be read or is not a raw texture
+*/
+uint8_t* read_rawTexture(const char* fileName, size_t* outWidth, size_t* outHeight, size_t* outLevelCount);
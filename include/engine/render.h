@@ -1,10 +1,18 @@
 #pragma once
 
+#include "engine/math/matrix.h"
 #include "engine/math/vec.h"
+#include "engine/texture.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 
+typedef struct _arena arena;
+typedef struct _pool pool;
+typedef struct _program program;
 typedef struct _render render;
+typedef struct _renderInstance renderInstance;
+typedef struct _renderQueue renderQueue;
 typedef struct _transform transform;
 
 typedef struct _renderInfo
@@ -14,8 +22,199 @@ typedef struct _renderInfo
     const char* vertexShader;
     const char* fragmentShader;
 
-    uint32_t textureId;
+    textureRegion texture; // See get_texture()
+
+    // A texture from request_texture(). If set, it is drawn instead of texture, and the render shows
+    // the placeholder until the requested texture has been uploaded
+    const textureRegion* textureHandle;
+
+    // The shaders' interned file names, see intern_asset(). If both are set, they are used instead of
+    // vertexShader and fragmentShader, so creating the render never hashes a file name
+    assetHandle vertexShaderAsset;
+    assetHandle fragmentShaderAsset;
 } renderInfo;
 render* create_render(transform* t, renderInfo rI);
 
-void render_render(render* r, float aspect);
+/*
+Creates a new pool that renders can be allocated from. See createFromPool_render()
+
+Arguments
+    size_t slabCapacity: The number of renders stored in a single slab of the pool
+
+Returns
+    Returns the new pool or NULL if memory allocation failed
+*/
+pool* createPool_render(size_t slabCapacity);
+
+/*
+Creates a new render, allocated from a pool instead of the system allocator. The render
+is returned to the pool by free_render().
+
+Arguments
+    pool* p: The pool to allocate the render from. It must have been created by createPool_render()
+
+    transform* t: See create_render()
+
+    renderInfo rI: See create_render()
+
+Returns
+    Returns the new render or NULL if the render could not be created
+*/
+render* createFromPool_render(pool* p, transform* t, renderInfo rI);
+
+/*
+Frees a render. Renders created from a pool are released back to that pool
+
+Arguments
+    render* r: The render to free
+
+Returns
+    Returns false if r is NULL
+*/
+bool free_render(render* r);
+
+/*
+Sets the color the render's texture is multiplied by. Renders are white by default.
+
+Arguments
+    render* r: The render to set the color on
+
+    vec3f color: The rgb color, with each component between 0 and 1
+
+Returns
+    Returns false if r is NULL
+*/
+bool setColor_render(render* r, vec3f color);
+
+/*
+Sets the layer of a render. Lower layers are drawn first, so higher layers are drawn on top.
+Renders are on layer 0 by default.
+
+Arguments
+    render* r: The render to set the layer on
+
+    uint8_t layer: The layer
+
+Returns
+    Returns false if r is NULL
+*/
+bool setLayer_render(render* r, uint8_t layer);
+
+/*
+Sets the depth of a render. Within renders that share a layer, program and texture, lower depths
+are drawn first. Renders have a depth of 0 by default.
+
+Arguments
+    render* r: The render to set the depth on
+
+    float depth: The depth, which is clamped between 0 and 1
+
+Returns
+    Returns false if r is NULL
+*/
+bool setDepth_render(render* r, float depth);
+
+/*
+Gets the axis aligned bounding box of a render in world space, from its size and transform
+
+Arguments
+    render* r: The render to get the bounds of
+
+    vec2f* outMin: The lower left corner of the bounding box
+
+    vec2f* outMax: The upper right corner of the bounding box
+
+Returns
+    Returns false if any of the arguments are NULL
+*/
+bool getBounds_render(render* r, vec2f* outMin, vec2f* outMax);
+
+/*
+Gets the texture id a render is drawn with. For renders that follow a requested texture, this is the
+placeholder's until the texture is uploaded.
+
+Arguments
+    render* r: The render
+
+Returns
+    Returns the texture id, or 0 if r is NULL
+*/
+uint32_t getTextureId_render(render* r);
+
+/*
+Returns whether a render can be drawn in a static batch, which is when its program reads the world space
+vertices of a batch instead of the render's own transform (see resources/shaders/static.vert and staticBatch.h)
+
+Arguments
+    render* r: The render
+
+Returns
+    Returns false if r is NULL or its program can't draw static batches
+*/
+bool isBatched_render(render* r);
+
+/*
+Builds the key a render is sorted by in a renderQueue. The key is made up of, from most to least
+significant, the layer, the program, the texture and the depth of the render. See renderQueue.h
+
+Arguments
+    render* r: The render to build the key of
+
+Returns
+    Returns the sort key of the render, or 0 if r is NULL
+*/
+uint64_t getSortKey_render(render* r);
+
+/*
+Copies everything needed to draw a render, so it can still be drawn after the render has changed or
+been freed. See renderThread.h
+
+Arguments
+    render* r: The render to record
+
+    program** outProgram: The program the render is drawn with
+
+    uint32_t* outTextureId: The texture the render is drawn with
+
+    renderInstance* outInstance: The model matrix, size, color and texture coordinates of the render
+
+Returns
+    Returns false if any of the arguments are NULL
+*/
+bool record_render(render* r, program** outProgram, uint32_t* outTextureId, renderInstance* outInstance);
+
+/*
+Sets the view projection matrix every render is drawn with. The matrix is uploaded once to a uniform
+buffer shared by every program with a "Camera" uniform block, so it should be set once per frame
+before anything is drawn. See getViewProjection_camera()
+
+Arguments
+    MATRIX_TYPE(3, 3)* viewProjection: The matrix that takes world space into clip space
+*/
+void setViewProjection_render(MATRIX_TYPE(3, 3)* viewProjection);
+
+/*
+Draws a single render with the view projection set by setViewProjection_render()
+
+Arguments
+    render* r: The render to draw
+*/
+void render_render(render* r);
+
+/*
+Draws every render in a render queue, in queue order. The program and texture are only changed
+when they differ from the previous render's, so the queue should be sorted first with sort_renderQueue().
+
+Consecutive renders that share a program and texture are drawn together. Textures are packed into
+atlas pages (see get_texture()), so renders with different textures on the same page still share a texture. If their program is
+instanced (see resources/shaders/instanced.vert), the whole batch is drawn with a single instanced
+draw call. The model matrix, size, color and texture coordinates of each render are uploaded as per instance data, so a
+batch costs one buffer upload and one draw no matter its size. Renders with any other program are
+drawn one at a time.
+
+Arguments
+    const renderQueue* q: The renders to draw
+
+    arena* a: Temporary memory used to build the per instance data
+*/
+void renderAll_render(const renderQueue* q, arena* a);
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "engine/math/matrix.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct _program program;
+
+/*
+The data a render is drawn with. Instanced programs read it per instance (see resources/shaders/instanced.vert),
+every other program reads it from uniforms.
+*/
+typedef struct _renderInstance
+{
+    float model[3][3]; // Column-major, as OpenGL expects
+    float size[2];
+    float color[3];
+    float uvRect[4]; // The min and max texture coordinates of the render's atlas region
+} renderInstance;
+
+/*
+A vertex of a static batch, already transformed into world space (see staticBatch.h). Every render in a batch
+is a quad of 6 vertices, in the same order as the unit quad the other renders are drawn with.
+*/
+typedef struct _batchVertex
+{
+    float position[2];
+    float uv[2];
+    float color[3];
+} batchVertex;
+
+/*
+The graphics API the engine draws with. render.c, texture.c, program.c and the gameEnvironment only ever
+draw through the active backend, so none of them depend on a particular API.
+
+The engine ships an OpenGL backend (see renderBackendGL.h), a software backend that draws into memory
+(see renderBackendSoftware.h) and a null backend that draws nothing and only records what it was asked
+to do (see renderBackendNull.h).
+*/
+typedef struct _renderBackend
+{
+    const char* name;
+
+    /*
+    Compiles and links a program, and fills in its id, isInstanced, isBatched, hasCameraBlock and uniform locations
+
+    Returns false if the program could not be created
+    */
+    bool (*createProgram)(program* p, const char* vertexShader, const char* fragmentShader);
+    void (*deleteProgram)(program* p);
+
+    /*
+    Creates a transparent RGBA texture with levelCount mip levels (see rawTexture.h). Textures with more than
+    one level are sampled with trilinear filtering.
+
+    Returns the id of the new texture, or 0 if it could not be created
+    */
+    uint32_t (*createTexture)(size_t width, size_t height, size_t levelCount);
+    void (*deleteTexture)(uint32_t textureId);
+
+    // Copies a row-major block of RGBA texels into a mip level of a texture. The block is in texels of the level.
+    void (*updateTexture)(uint32_t textureId, size_t level, size_t x, size_t y, size_t width, size_t height, const uint8_t* texels);
+
+    // Clears the screen to a color, at the start of every frame
+    void (*clear)(float r, float g, float b, float a);
+
+    // Sets the view projection matrix every following draw uses, see setViewProjection_render()
+    void (*setViewProjection)(MATRIX_TYPE(3, 3)* viewProjection);
+
+    // Makes a program or texture active. The caller skips these when the program or texture is already active.
+    void (*useProgram)(program* p);
+    void (*bindTexture)(uint32_t textureId);
+
+    // Draws a batch of renders with the active program and texture, which must be the given program
+    void (*draw)(program* p, const renderInstance* instances, size_t count);
+
+    /*
+    Copies the vertices of a static batch into a buffer that lives until the batch is deleted
+
+    Returns the id of the new batch, or 0 if it could not be created
+    */
+    uint32_t (*createBatch)(const batchVertex* vertices, size_t count);
+    void (*deleteBatch)(uint32_t batchId);
+
+    // Draws every vertex of a static batch with the active program and texture in a single call
+    void (*drawBatch)(program* p, uint32_t batchId, size_t vertexCount);
+
+    // Finishes the frame, once everything in it has been drawn
+    void (*present)(void);
+} renderBackend;
+
+/*
+Sets the backend the engine draws with. The backend must be set before any render, texture or program is
+created, since those are owned by the backend that created them. The null backend is active by default.
+
+Arguments
+    const renderBackend* backend: The backend to draw with, or NULL for the null backend
+*/
+void set_renderBackend(const renderBackend* backend);
+
+/*
+Fills in a program for a backend that can't compile shaders. The vertex shader's source is searched for the
+names the OpenGL backend would look up after linking, to find out whether the program is instanced or batched,
+and whether it has a camera block. The program's id is left for the backend to set.
+
+Arguments
+    program* p: The program to fill in
+
+    const char* vertexShader: The file name of the vertex shader
+
+Returns
+    Returns false if the vertex shader could not be read
+*/
+bool describeProgram_renderBackend(program* p, const char* vertexShader);
+
+/*
+Gets the backend the engine draws with
+
+Returns
+    Returns the active backend, which is never NULL
+*/
+const renderBackend* get_renderBackend();
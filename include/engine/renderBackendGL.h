@@ -0,0 +1,12 @@
+#pragma once
+
+#include "engine/renderBackend.h"
+
+/*
+Gets the OpenGL 3.3 core backend. An OpenGL context must be current on the calling thread
+whenever the engine draws, or creates a render, texture or program.
+
+Returns
+    Returns the OpenGL backend
+*/
+const renderBackend* getGL_renderBackend();
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "engine/renderBackend.h"
+
+/*
+Everything the null backend was asked to do since its stats were last reset
+*/
+typedef struct _nullRenderBackendStats
+{
+    size_t programs; // The number of programs alive
+    size_t textures; // The number of textures alive
+    size_t batches; // The number of static batches alive
+    size_t mipUpdates; // The number of updates to a mip level past the first, across every texture
+
+    size_t frames;
+    size_t clears;
+    size_t programSwitches;
+    size_t textureBinds;
+    size_t draws;
+    size_t instances; // The number of renders drawn, across every draw
+    size_t batchDraws;
+} nullRenderBackendStats;
+
+/*
+Gets the null backend. It draws nothing, so the engine can run simulation only or be benchmarked
+without a GPU. It records every call it gets, see getStats_nullRenderBackend().
+
+Programs are never compiled. The null backend only checks that the vertex shader can be read, and finds
+out whether it is instanced or has a camera block by searching its source.
+
+Returns
+    Returns the null backend
+*/
+const renderBackend* getNull_renderBackend();
+
+/*
+Gets what the null backend has recorded since its stats were last reset
+
+Returns
+    Returns the recorded stats
+*/
+nullRenderBackendStats getStats_nullRenderBackend();
+
+/*
+Resets the per frame stats (frames, clears, programSwitches, textureBinds, draws, instances and batchDraws) of the null backend
+*/
+void resetStats_nullRenderBackend();
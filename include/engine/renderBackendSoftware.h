@@ -0,0 +1,71 @@
+#pragma once
+
+#include "engine/renderBackend.h"
+
+/*
+Creates the framebuffer of the software backend, or resizes it if it already exists. Must be called
+before anything is drawn with the software backend.
+
+The software backend draws into memory, so frames can be rendered and captured on machines without a GPU.
+It runs the same quad pipeline as resources/shaders/instanced.vert and triangles.vert for every program:
+each render is transformed by the view projection, model and size, and filled with its color multiplied by
+its texture, which is sampled bilinearly with a transparent border.
+
+NOTE: Like the OpenGL backend, which never enables blending, every render is drawn opaque. Each pixel of a render
+replaces the pixel under it, alpha included, instead of being blended with it.
+
+Draws are recorded during the frame, and rasterized when the frame is presented. The framebuffer is split into
+tiles, and each quad is put into the list of every tile it overlaps, in draw order. The tiles are shared out
+between the presenting thread and a pool of worker threads that lives until free_softwareRenderBackend(), so
+every thread writes to its own pixels and draw order is kept.
+
+Arguments
+    size_t width: The width of the framebuffer in pixels
+
+    size_t height: The height of the framebuffer in pixels
+
+    size_t threadCount: The number of threads that rasterize each frame, including the thread that presents,
+        or 0 for one per online processor
+
+Returns
+    Returns false if either size is 0 or memory allocation failed
+*/
+bool init_softwareRenderBackend(size_t width, size_t height, size_t threadCount);
+
+/*
+Stops the worker threads, and frees the framebuffer, textures and recorded draws of the software backend
+*/
+void free_softwareRenderBackend();
+
+/*
+Gets the software backend. See init_softwareRenderBackend()
+
+Returns
+    Returns the software backend
+*/
+const renderBackend* getSoftware_renderBackend();
+
+/*
+Gets the framebuffer of the software backend, as it was when the last frame was presented
+
+Arguments
+    size_t* outWidth: The width of the framebuffer in pixels
+
+    size_t* outHeight: The height of the framebuffer in pixels
+
+Returns
+    Returns the RGBA texels of the framebuffer, with the bottom row first as in OpenGL, or NULL if
+    init_softwareRenderBackend() has not been called
+*/
+const uint8_t* getFramebuffer_softwareRenderBackend(size_t* outWidth, size_t* outHeight);
+
+/*
+Writes the framebuffer of the software backend to a png
+
+Arguments
+    const char* fileName: The file name of the png
+
+Returns
+    Returns false if fileName is NULL, there is no framebuffer, or the png could not be written
+*/
+bool writeFramebuffer_softwareRenderBackend(const char* fileName);
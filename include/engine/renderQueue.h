@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct _arena arena;
+typedef struct _render render;
+
+/*
+The bits of a render sort key, from most to least significant. Sorting by the key draws layers
+in order, and within a layer keeps renders that share a program and texture next to each other.
+See getSortKey_render()
+*/
+#define SORT_KEY_LAYER_BITS 8
+#define SORT_KEY_PROGRAM_BITS 16
+#define SORT_KEY_TEXTURE_BITS 16
+#define SORT_KEY_DEPTH_BITS 24
+
+#define SORT_KEY_DEPTH_SHIFT 0
+#define SORT_KEY_TEXTURE_SHIFT (SORT_KEY_DEPTH_SHIFT + SORT_KEY_DEPTH_BITS)
+#define SORT_KEY_PROGRAM_SHIFT (SORT_KEY_TEXTURE_SHIFT + SORT_KEY_TEXTURE_BITS)
+#define SORT_KEY_LAYER_SHIFT (SORT_KEY_PROGRAM_SHIFT + SORT_KEY_PROGRAM_BITS)
+
+typedef struct _renderCommand
+{
+    uint64_t key;
+    render* r;
+} renderCommand;
+
+/*
+A list of renders to draw during a single frame, ordered by their sort keys.
+
+All of the memory of a render queue comes from an arena, so a queue is never freed. It becomes
+invalid when the arena is reset.
+*/
+typedef struct _renderQueue
+{
+    renderCommand* commands;
+    size_t count;
+    size_t capacity;
+} renderQueue;
+
+/*
+Creates an empty render queue
+
+Arguments
+    renderQueue* q: The queue to create
+
+    size_t capacity: The most renders the queue can hold
+
+    arena* a: The arena the queue is allocated from
+
+Returns
+    Returns false if any of the arguments are NULL or memory allocation failed
+*/
+bool create_renderQueue(renderQueue* q, size_t capacity, arena* a);
+
+/*
+Adds a render to the end of the queue
+
+Runs in O(1) time.
+
+Arguments
+    renderQueue* q: The queue to add to
+
+    uint64_t key: The sort key of the render
+
+    render* r: The render to add
+
+Returns
+    Returns false if q or r is NULL, or if the queue is full
+*/
+bool push_renderQueue(renderQueue* q, uint64_t key, render* r);
+
+/*
+Sorts the queue by key in ascending order. Renders with equal keys keep the order they were pushed in,
+so the draw order is the same every frame.
+
+The keys are sorted with a least significant digit radix sort, a byte at a time. Bytes that are the
+same for every key are skipped, so it runs in O(n * k) time, where k is the number of bytes that differ.
+
+Arguments
+    renderQueue* q: The queue to sort
+
+    arena* a: The arena temporary memory is allocated from
+
+Returns
+    Returns false if any of the arguments are NULL or memory allocation failed
+*/
+bool sort_renderQueue(renderQueue* q, arena* a);
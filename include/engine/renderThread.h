@@ -0,0 +1,159 @@
+#pragma once
+
+#include "engine/math/matrix.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct _program program;
+typedef struct _render render;
+typedef struct _renderInstance renderInstance;
+typedef struct _renderThread renderThread;
+
+typedef void (*onRenderThreadHandler)(void* userdata);
+
+typedef struct _renderThreadEvents
+{
+    // Called on the render thread before anything is drawn, e.g. to make the OpenGL context current
+    onRenderThreadHandler onStart;
+
+    // Called on the render thread after each frame is presented, e.g. to swap the window's buffers
+    onRenderThreadHandler onPresent;
+
+    // Called on the render thread before it exits, e.g. to release the OpenGL context
+    onRenderThreadHandler onStop;
+} renderThreadEvents;
+
+// A static batch recorded into a frame, see staticBatch.h
+typedef struct _renderBatchCommand
+{
+    program* p;
+    uint32_t textureId;
+    uint32_t batchId;
+    size_t vertexCount;
+
+    size_t commandIndex; // The number of renders recorded before the batch, which are drawn before it. Set by pushBatch_renderFrame()
+} renderBatchCommand;
+
+/*
+The draw commands of a single frame. Each command is a copy of everything needed to draw a render
+(see record_render()), so the frame can be drawn while the renders themselves change or are freed.
+The commands are drawn in order, so they should be recorded from a sorted renderQueue.
+
+The fields are read only, use push_renderFrame() and setViewProjection_renderFrame().
+*/
+typedef struct _renderFrame
+{
+    MATRIX_TYPE(3, 3) viewProjection;
+
+    // Parallel arrays, one entry per command
+    program** programs;
+    uint32_t* textureIds;
+    renderInstance* instances;
+
+    size_t count;
+    size_t capacity;
+
+    // Static batches, which are drawn in between the commands in the order they were recorded
+    renderBatchCommand* batches;
+    size_t batchCount;
+    size_t batchCapacity;
+} renderFrame;
+
+/*
+Starts a thread that draws every frame with the backend that is active when it is created.
+
+From then on the render thread is the only thread that calls into that backend. The active backend is
+replaced with one that forwards every call to the render thread and waits for it to finish, so renders,
+textures and programs can still be created and freed from any thread. Forwarded calls only run once every
+submitted frame has been drawn.
+
+Only one render thread can run at a time.
+
+Arguments
+    renderThreadEvents events: The handlers called on the render thread. Any of them may be NULL
+
+    void* userdata: Passed to every handler
+
+Returns
+    Returns the new render thread or NULL if a render thread is already running, or if memory allocation
+    or thread creation failed
+*/
+renderThread* create_renderThread(renderThreadEvents events, void* userdata);
+
+/*
+Draws every submitted frame, stops the render thread, and makes its backend the active backend again
+
+Arguments
+    renderThread* rt: The render thread to stop and free
+
+Returns
+    Returns false if rt is NULL
+*/
+bool free_renderThread(renderThread* rt);
+
+/*
+Gets the next frame to record into. Frames are double buffered, so the next frame can be recorded while
+the last one is drawn. Waits until the render thread has finished drawing the frame that last used the buffer.
+
+The frame starts out empty.
+
+Arguments
+    renderThread* rt: The render thread
+
+Returns
+    Returns the frame to record into, or NULL if rt is NULL
+*/
+renderFrame* beginFrame_renderThread(renderThread* rt);
+
+/*
+Hands the frame from beginFrame_renderThread() over to the render thread. Frames are drawn in the order
+they are submitted.
+
+Arguments
+    renderThread* rt: The render thread
+
+Returns
+    Returns false if rt is NULL or no frame was begun
+*/
+bool submit_renderThread(renderThread* rt);
+
+/*
+Records a render at the end of a frame
+
+Runs in amortized O(1) time.
+
+Arguments
+    renderFrame* f: The frame to record into
+
+    render* r: The render to record
+
+Returns
+    Returns false if any of the arguments are NULL or memory allocation failed
+*/
+bool push_renderFrame(renderFrame* f, render* r);
+
+/*
+Records a static batch at the end of a frame. The batch must not be deleted until the frame has been drawn, which
+deleting it through the forwarding backend guarantees.
+
+Arguments
+    renderFrame* f: The frame to record into
+
+    renderBatchCommand batch: The batch and the program and texture it is drawn with
+
+Returns
+    Returns false if f is NULL or memory allocation failed
+*/
+bool pushBatch_renderFrame(renderFrame* f, renderBatchCommand batch);
+
+/*
+Sets the view projection matrix a frame is drawn with
+
+Arguments
+    renderFrame* f: The frame
+
+    MATRIX_TYPE(3, 3)* viewProjection: The matrix that takes world space into clip space
+*/
+void setViewProjection_renderFrame(renderFrame* f, MATRIX_TYPE(3, 3)* viewProjection);
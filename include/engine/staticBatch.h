@@ -0,0 +1,161 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct _arena arena;
+typedef struct _render render;
+typedef struct _renderFrame renderFrame;
+typedef struct _staticBatches staticBatches;
+
+// The shaders static renders are created with, so they can be drawn in a batch (see isBatched_render()).
+// The vertices already hold the color and texture coordinates, so the fragment shader is shared with instanced renders
+#define STATIC_VERTEX_SHADER "resources/shaders/static.vert"
+#define STATIC_FRAGMENT_SHADER "resources/shaders/instanced.frag"
+
+/*
+Creates an empty set of static batches.
+
+Renders that never move, like level geometry, are merged into a few prebuilt vertex buffers instead of
+being drawn one at a time every frame. Every render that shares a layer, program and texture with its
+neighbours in sort order ends up in the same batch, and its quad is transformed into world space once,
+when the batch is built. Each batch is drawn with a single call, with the program of its renders.
+
+Only renders whose program reads the world space vertices of a batch can be batched, see isBatched_render().
+Batches keep the layer of their renders, so they can be drawn in layer order along with every other render,
+see renderLayers_staticBatches().
+
+Returns
+    Returns the new set of static batches or NULL if memory allocation failed
+*/
+staticBatches* create_staticBatches();
+
+/*
+Frees a set of static batches, along with the vertex buffers of every batch. The renders are not freed.
+
+Arguments
+    staticBatches* sb: The static batches to free
+
+Returns
+    Returns false if sb is NULL
+*/
+bool free_staticBatches(staticBatches* sb);
+
+/*
+Adds a render to the static batches. The batches are rebuilt by the next build_staticBatches().
+
+NOTE: The render is drawn with the transform, size, color and texture it has when the batches are built.
+Later changes are only picked up if the batches are rebuilt.
+
+Arguments
+    staticBatches* sb: The static batches to add to
+
+    render* r: The render to add
+
+Returns
+    Returns false if any of the arguments are NULL, the render can't be batched (see isBatched_render()) or
+    memory allocation failed
+*/
+bool add_staticBatches(staticBatches* sb, render* r);
+
+/*
+Removes a render from the static batches. The batches are rebuilt by the next build_staticBatches().
+
+Arguments
+    staticBatches* sb: The static batches to remove from
+
+    render* r: The render to remove
+
+Returns
+    Returns false if any of the arguments are NULL or the render was never added
+*/
+bool remove_staticBatches(staticBatches* sb, render* r);
+
+/*
+Rebuilds the vertex buffers of the batches, if a render was added or removed since they were last built.
+Otherwise nothing is done.
+
+Arguments
+    staticBatches* sb: The static batches to build
+
+    arena* a: The arena temporary memory is allocated from
+
+Returns
+    Returns false if any of the arguments are NULL, or if the batches could not be built
+*/
+bool build_staticBatches(staticBatches* sb, arena* a);
+
+/*
+Makes the next build_staticBatches() rebuild the batches even if no render was added or removed, e.g.
+because a requested texture a render uses has been uploaded
+
+Arguments
+    staticBatches* sb: The static batches to rebuild
+*/
+void invalidate_staticBatches(staticBatches* sb);
+
+/*
+Draws every batch with the active backend, with one draw call per batch. The view projection matrix must
+already be set, see setViewProjection_render().
+
+Arguments
+    staticBatches* sb: The static batches to draw
+*/
+void renderAll_staticBatches(staticBatches* sb);
+
+/*
+Draws the batches whose layer is between firstLayer and lastLayer, inclusive, the same as renderAll_staticBatches().
+Drawing the batches of each layer just before the other renders of that layer keeps higher layers on top,
+see setLayer_render().
+
+Arguments
+    staticBatches* sb: The static batches to draw
+
+    uint8_t firstLayer: The lowest layer to draw
+
+    uint8_t lastLayer: The highest layer to draw
+*/
+void renderLayers_staticBatches(staticBatches* sb, uint8_t firstLayer, uint8_t lastLayer);
+
+/*
+Records every batch into a frame for the render thread, see renderThread.h
+
+Arguments
+    staticBatches* sb: The static batches to record
+
+    renderFrame* f: The frame to record into
+
+Returns
+    Returns false if any of the arguments are NULL or memory allocation failed
+*/
+bool record_staticBatches(staticBatches* sb, renderFrame* f);
+
+/*
+Records the batches whose layer is between firstLayer and lastLayer, inclusive, after everything already
+recorded into a frame. See renderLayers_staticBatches()
+
+Arguments
+    staticBatches* sb: The static batches to record
+
+    renderFrame* f: The frame to record into
+
+    uint8_t firstLayer: The lowest layer to record
+
+    uint8_t lastLayer: The highest layer to record
+
+Returns
+    Returns false if any of the arguments are NULL or memory allocation failed
+*/
+bool recordLayers_staticBatches(staticBatches* sb, renderFrame* f, uint8_t firstLayer, uint8_t lastLayer);
+
+/*
+Gets the number of batches that were made by the last build_staticBatches()
+
+Arguments
+    staticBatches* sb: The static batches
+
+Returns
+    Returns the number of batches, or 0 if sb is NULL
+*/
+size_t getCount_staticBatches(staticBatches* sb);
@@ -1,15 +1,161 @@
 #pragma once
 
+#include "engine/asset.h"
+#include "engine/math/vec.h"
+
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 /*
-Gets the OpenGL id associated with a given texture. This function loads the texture from disk
-if was not previously retrieved. File name is relative to the cwd of the executable
+A rectangle of an atlas page. Textures are packed together into a few large OpenGL textures,
+so renders that use different textures can still share a texture and be drawn together.
+*/
+typedef struct _textureRegion
+{
+    uint32_t textureId; // The OpenGL id of the atlas page, or 0 if the texture could not be loaded
+
+    // The texture coordinates of the region's corners on the page
+    vec2f uvMin;
+    vec2f uvMax;
+} textureRegion;
+
+/*
+How much memory textures take up, see getStats_texture()
+*/
+typedef struct _textureStats
+{
+    size_t gpuBytes; // The size of every resident atlas page
+    size_t gpuBudget; // See setBudget_texture()
+    size_t cpuBytes; // The size of every decoded texture that is waiting to be uploaded
+    size_t cpuBudget;
+
+    size_t pages; // The number of resident atlas pages
+    size_t loaded; // The number of textures packed into a resident page
+    size_t evicted; // The number of textures whose page was evicted, and that haven't been reloaded since
+
+    size_t evictions; // The number of pages evicted so far
+    size_t reloads; // The number of evicted textures loaded again so far
+} textureStats;
+
+/*
+Gets the atlas region a given texture is packed into. This function loads the texture from the mounted
+archive (see archive.h) or from disk, and packs it into an atlas page if it was not previously retrieved,
+or if its page has since been evicted. File name is relative to the cwd of the executable
+
+The texels are only kept on the atlas page, they are released from memory as soon as they are uploaded.
+
+If the texture was requested with request_texture() and is still loading, waits for it to be decoded
+and uploads it right away.
+
+Arguments
+    const char* fileName: The file name of the texture
+
+Returns
+    Returns the region of the texture. The region's textureId is 0 if the texture could not be loaded.
+*/
+textureRegion get_texture(const char* fileName);
+
+/*
+Same as get_texture(), for a file name that has already been interned. Callers that get a texture
+repeatedly, e.g. every spawn, intern its file name once and skip hashing it on every call.
+
+Arguments
+    assetHandle asset: The asset handle of the texture's file name, see intern_asset()
+
+Returns
+    Returns the region of the texture. The region's textureId is 0 if the handle is invalid or the texture
+    could not be loaded.
+*/
+textureRegion getByAsset_texture(assetHandle asset);
+
+/*
+Requests a texture without waiting for it to load. The texture is decoded by a pool of worker threads,
+and packed into an atlas page by a later uploadRequested_texture(), since only the thread that owns the
+render backend may upload it. Until then the returned region is a placeholder texture.
+
+The returned region is updated in place once the texture is uploaded, so renders created with it as
+their textureHandle (see renderInfo) pick up the texture without being recreated. If the texture can't
+be loaded, the region keeps the placeholder.
 
 Arguments
     const char* fileName: The file name of the texture
 
 Returns
-    Returns the OpenGL id for the texture;
+    Returns the region of the texture, which lives as long as the program, or NULL if fileName is NULL
+    or memory allocation failed
+*/
+const textureRegion* request_texture(const char* fileName);
+
+/*
+Same as request_texture(), for a file name that has already been interned
+
+Arguments
+    assetHandle asset: The asset handle of the texture's file name, see intern_asset()
+
+Returns
+    Returns the region of the texture, which lives as long as the program, or NULL if the handle is invalid
+    or memory allocation failed
+*/
+const textureRegion* requestByAsset_texture(assetHandle asset);
+
+/*
+Uploads requested textures that have finished decoding. Called by run_gameEnvironment() every step,
+see gameSettings.textureUploadsPerStep
+
+Arguments
+    size_t maxUploads: The most textures to upload, so a burst of decoded textures is spread over several frames
+
+Returns
+    Returns the number of requested textures that were uploaded or failed to load
+*/
+size_t uploadRequested_texture(size_t maxUploads);
+
+/*
+Gets the number of requested textures that have not been uploaded yet, e.g. to show a loading screen
+
+Returns
+    Returns the number of requested textures that are still decoding or waiting to be uploaded
+*/
+size_t getPendingCount_texture();
+
+/*
+Sets how much memory textures may take up. Budgets are soft, they are never exceeded by more than a
+single texture.
+
+When a new atlas page would go over the GPU budget, the least recently used pages are evicted first.
+Only pages that haven't been used for a few frames can be evicted (see use_texture()), so every texture
+that is still drawn stays resident. Evicted textures are loaded again by their next get_texture() or
+request_texture().
+
+When the decoded textures waiting to be uploaded go over the CPU budget, the decode workers wait for
+uploads to catch up.
+
+Arguments
+    size_t gpuBytes: The most memory the atlas pages may take up, or 0 for no limit. There is no limit by default.
+
+    size_t cpuBytes: The most memory decoded textures may take up before they are uploaded, or 0 for no limit
+*/
+void setBudget_texture(size_t gpuBytes, size_t cpuBytes);
+
+/*
+Marks the atlas page of a texture as used during the current frame, so it isn't evicted.
+The gameEnvironment marks the texture of every render it owns each step.
+
+Arguments
+    uint32_t textureId: The texture id of a region, see textureRegion
+*/
+void use_texture(uint32_t textureId);
+
+/*
+Starts the next frame. Pages are evicted by how many frames ago they were last used.
+*/
+void nextFrame_texture();
+
+/*
+Gets how much memory textures take up, and how many have been evicted
+
+Returns
+    Returns the texture stats
 */
-uint32_t get_texture(const char* fileName);
+textureStats getStats_texture();
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(write_archive);
+PROTOTYPE_TEST(mount_archive);
+PROTOTYPE_TEST(readPolygon_archive);
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(intern_asset);
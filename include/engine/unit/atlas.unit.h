@@ -0,0 +1,7 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(create_atlas);
+PROTOTYPE_TEST(pack_atlas);
+PROTOTYPE_TEST(pack_atlas_full);
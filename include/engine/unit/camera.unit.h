@@ -0,0 +1,7 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(getView_camera);
+PROTOTYPE_TEST(getViewProjection_camera);
+PROTOTYPE_TEST(getBounds_camera);
@@ -13,6 +13,8 @@ struct _collider {
     polygon* polygons;
     int polygonCount;
     float radius; // Used for bubble collision detection (cheap and fast to detect)
+
+    pool* pool; // The pool the collider was allocated from, or NULL if it was malloc'd
 };
 
 collision _detectCollision_polygon(polygon* base, polygon* target);
@@ -22,4 +24,5 @@ PROTOTYPE_TEST(_detectCollision_polygon);
 
 // External Unit Tests
 PROTOTYPE_TEST(create_collider_quad);
+PROTOTYPE_TEST(createWithOptions_collider_simplified);
 PROTOTYPE_TEST(detectCollision_collider);
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(push_components);
+PROTOTYPE_TEST(swapRemove_components);
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(decompose_decompositionCache);
+PROTOTYPE_TEST(decomposeWithMode_decompositionCache);
+PROTOTYPE_TEST(load_decompositionCache);
+PROTOTYPE_TEST(setCapacity_decompositionCache);
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(run_gameEnvironment_evictions);
+PROTOTYPE_TEST(setRender_gameObject_static);
+PROTOTYPE_TEST(run_gameEnvironment_staticRenders);
+PROTOTYPE_TEST(run_gameEnvironment_staticLayers);
@@ -33,6 +33,7 @@ referenceVertex* _create_referenceVertices(polygon* poly);
 vertexDiagonal* _init_vertexDiagonal(vertexDiagonal* diagonal, vertexDiagonal* prev, vertexDiagonal* next, int endpoint);
 void _addDiagonal_vertexDiagonal(polygon* poly, vertexDiagonal** currentDiagonal, vertexDiagonal** center, int prevVertex, int nextVertex);
 vertexDiagonal** _triangulate_polygon(polygon* poly, vertexDiagonal** diagonalPool);
+vertexDiagonal** _triangulateMonotone_polygon(polygon* poly, vertexDiagonal** diagonalPool);
 bool _isEssential_vertexDiagonal(polygon* poly, vertexDiagonal* base);
 bool _isInessential_vertexDiagonal(polygon* poly, vertexDiagonal* base);
 void _removeDiagonal_vertexDiagonal(vertexDiagonal** diagonals, vertexDiagonal* base);
@@ -48,6 +49,9 @@ PROTOTYPE_TEST(decompose_polygon_quadReflex);
 PROTOTYPE_TEST(decompose_polygon_complexReflex);
 PROTOTYPE_TEST(decompose_polygon_fewTowers);
 PROTOTYPE_TEST(decompose_polygon_towers);
+PROTOTYPE_TEST(decompose_polygon_star);
+PROTOTYPE_TEST(decomposeMinimum_polygon_towers);
+PROTOTYPE_TEST(simplify_polygon);
 PROTOTYPE_TEST(project_polygon);
 
 // Private API
@@ -58,6 +62,11 @@ PROTOTYPE_TEST(_triangulate_polygon_quad);
 PROTOTYPE_TEST(_triangulate_polygon_quadReflex);
 PROTOTYPE_TEST(_triangulate_polygon_pentagon);
 PROTOTYPE_TEST(_triangulate_polygon_complexReflex);
+PROTOTYPE_TEST(_triangulateMonotone_polygon_quad);
+PROTOTYPE_TEST(_triangulateMonotone_polygon_quadReflex);
+PROTOTYPE_TEST(_triangulateMonotone_polygon_complexReflex);
+PROTOTYPE_TEST(_triangulateMonotone_polygon_fewTowers);
+PROTOTYPE_TEST(_triangulateMonotone_polygon_towers);
 PROTOTYPE_TEST(_isEssential_vertexDiagonal);
 PROTOTYPE_TEST(_isInessential_vertexDiagonal);
 
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(hash_programCache);
+PROTOTYPE_TEST(store_programCache);
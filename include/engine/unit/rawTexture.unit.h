@@ -0,0 +1,6 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(buildMipmaps_rawTexture);
+PROTOTYPE_TEST(read_rawTexture);
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(get_renderBackend);
+PROTOTYPE_TEST(renderAll_render);
+PROTOTYPE_TEST(getFramebuffer_softwareRenderBackend);
+PROTOTYPE_TEST(init_softwareRenderBackend);
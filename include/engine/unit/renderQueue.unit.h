@@ -0,0 +1,6 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(push_renderQueue);
+PROTOTYPE_TEST(sort_renderQueue);
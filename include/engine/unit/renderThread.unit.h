@@ -0,0 +1,7 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(create_renderThread);
+PROTOTYPE_TEST(submit_renderThread);
+PROTOTYPE_TEST(pushBatch_renderFrame);
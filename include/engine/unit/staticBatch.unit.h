@@ -0,0 +1,6 @@
+#pragma once
+
+#include "util/unit.h"
+
+PROTOTYPE_TEST(build_staticBatches);
+PROTOTYPE_TEST(renderAll_staticBatches);
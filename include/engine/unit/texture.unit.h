@@ -0,0 +1,13 @@
+#pragma once
+
+#include "util/unit.h"
+
+#include <stdbool.h>
+
+// Writes a png that is packed into an atlas page of its own, for tests that need to fill the texture budget
+bool _writeWide_textureTest(const char* fileName);
+
+PROTOTYPE_TEST(request_texture);
+PROTOTYPE_TEST(getByAsset_texture);
+PROTOTYPE_TEST(uploadRequested_texture);
+PROTOTYPE_TEST(setBudget_texture);
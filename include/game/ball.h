@@ -1,9 +1,10 @@
 #pragma once
 
+typedef struct _gameEnvironment gameEnvironment;
 typedef struct _gameObject gameObject;
 typedef struct _collision collision;
 
-gameObject* create_ball();
+gameObject* create_ball(gameEnvironment* env);
 
 void update_ball(gameObject* ball);
 void onCollision_ball(gameObject* ball, gameObject* g, collision* c);
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "engine/math/vec.h"
 
+typedef struct _gameEnvironment gameEnvironment;
 typedef struct _gameObject gameObject;
 
 typedef struct
@@ -9,5 +10,5 @@ typedef struct
 	gameObject *left, *right, *top;
 } border;
 
-border create_border();
+border create_border(gameEnvironment* env);
 vec2f getSize_border(gameObject* border);
\ No newline at end of file
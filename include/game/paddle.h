@@ -1,9 +1,10 @@
 #pragma once
 
+typedef struct _gameEnvironment gameEnvironment;
 typedef struct _gameObject gameObject;
 typedef struct _collision collision;
 
-gameObject* create_paddle();
+gameObject* create_paddle(gameEnvironment* env);
 
 void update_paddle(gameObject* paddle);
 void onCollision_paddle(gameObject* paddle, gameObject* g2, collision* c);
\ No newline at end of file
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <stddef.h>
+
+// Reads a whole file into a null terminated buffer that must be freed. outSize, if not NULL, gets the size
+// without the terminator. Returns NULL if the file could not be read.
+char* read_file(const char* fileName, size_t* outSize);
@@ -15,6 +15,11 @@
 //  LoadShaders() returns the shader program value (as returned by
 //    glCreateProgram()) on success, or zero on failure.
 //
+//  When the program cache is enabled (see engine/programCache.h), the
+//    linked binary is cached, and later calls with the same sources on
+//    the same driver load it instead of compiling. The shaders are not
+//    created in that case, so every ShaderInfo's shader is left 0.
+//
 
 typedef struct
 {
@@ -0,0 +1,12 @@
+#version 330 core
+in vec2 imageCoordinate;
+in vec3 color;
+
+uniform sampler2D image;
+
+out vec4 outColor;
+
+void main()
+{
+    outColor = vec4(color, 1.0) * texture(image, imageCoordinate);
+}
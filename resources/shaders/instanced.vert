@@ -0,0 +1,24 @@
+#version 330 core
+layout(location = 0) in vec4 vertex;
+
+// Per instance attributes, see renderAll_render()
+layout(location = 1) in mat3 instanceModel;
+layout(location = 4) in vec2 instanceSize;
+layout(location = 5) in vec3 instanceColor;
+layout(location = 6) in vec4 instanceUvRect; // The min (xy) and max (zw) texture coordinates of the atlas region
+
+layout(std140) uniform Camera
+{
+    mat3 viewProjection;
+};
+
+out vec2 imageCoordinate;
+out vec3 color;
+
+void main()
+{
+    gl_Position = vec4(viewProjection * instanceModel * vec3(vertex.xy * instanceSize, 1.0), 1.0);
+
+    imageCoordinate = mix(instanceUvRect.xy, instanceUvRect.zw, vertex.zw);
+    color = instanceColor;
+}
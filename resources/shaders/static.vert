@@ -0,0 +1,20 @@
+#version 330 core
+layout(location = 0) in vec4 vertex; // The world space position (xy) and texture coordinate (zw), see batchVertex
+layout(location = 1) in vec3 vertexColor;
+
+layout(std140) uniform Camera
+{
+    mat3 viewProjection;
+};
+
+out vec2 imageCoordinate;
+out vec3 color;
+
+void main()
+{
+    // Static batches are already in world space, so only the camera is applied
+    gl_Position = vec4(viewProjection * vec3(vertex.xy, 1.0), 1.0);
+
+    imageCoordinate = vertex.zw;
+    color = vertexColor;
+}
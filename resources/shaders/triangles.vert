@@ -1,14 +1,20 @@
 #version 150 core
 in vec4 vertex;
 
-uniform mat3 mvp;
+layout(std140) uniform Camera
+{
+    mat3 viewProjection;
+};
+
+uniform mat3 model;
 uniform mat3 size;
+uniform vec4 uvRect; // The min (xy) and max (zw) texture coordinates of the atlas region
 
 out vec2 imageCoordinate;
 
 void main()
 {
-    gl_Position = vec4(mvp * size * vec3(vertex.xy, 1.0), 1.0);
+    gl_Position = vec4(viewProjection * model * size * vec3(vertex.xy, 1.0), 1.0);
 
-    imageCoordinate = vertex.zw;
+    imageCoordinate = mix(uvRect.xy, uvRect.zw, vertex.zw);
 }
@@ -0,0 +1,200 @@
+#include "datastructures/arena.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef struct _arenaBlock
+{
+    struct _arenaBlock* next;
+    size_t capacity;
+    size_t used;
+    _Alignas(max_align_t) uint8_t data[];
+} arenaBlock;
+
+struct _arena
+{
+    arenaBlock* block; // The main block
+    arenaBlock* overflow; // Blocks allocated once the main block is full, newest first
+
+    size_t used; // Total bytes used across all blocks
+};
+
+/*
+Allocates a new arena block
+
+Arguments
+    size_t capacity: The capacity in bytes of the block
+
+Returns
+    Returns the new block or NULL if memory allocation failed
+*/
+arenaBlock* _create_arenaBlock(size_t capacity)
+{
+    arenaBlock* block = malloc(sizeof(arenaBlock) + capacity);
+    if (!block)
+    {
+        return NULL;
+    }
+
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+
+    return block;
+}
+
+/*
+Bumps the pointer of a block
+
+Arguments
+    arenaBlock* block: The block to allocate from
+
+    size_t size: The aligned number of bytes to allocate
+
+Returns
+    Returns the allocated memory or NULL if the block does not have enough room
+*/
+void* _alloc_arenaBlock(arenaBlock* block, size_t size)
+{
+    if (!block || block->capacity - block->used < size)
+    {
+        return NULL;
+    }
+
+    void* memory = &block->data[block->used];
+    block->used += size;
+
+    return memory;
+}
+
+arena* create_arena(size_t capacity)
+{
+    if (capacity == 0)
+    {
+        return NULL;
+    }
+
+    arena* a = malloc(sizeof(arena));
+    if (!a)
+    {
+        return NULL;
+    }
+
+    a->block = _create_arenaBlock(capacity);
+    if (!a->block)
+    {
+        free(a);
+        return NULL;
+    }
+
+    a->overflow = NULL;
+    a->used = 0;
+
+    return a;
+}
+
+/*
+Frees every overflow block of an arena
+
+Arguments
+    arena* a: The arena to free the overflow blocks of
+*/
+void _freeOverflow_arena(arena* a)
+{
+    arenaBlock* it = a->overflow;
+    arenaBlock* next;
+    while (it)
+    {
+        next = it->next;
+        free(it);
+        it = next;
+    }
+
+    a->overflow = NULL;
+}
+
+bool free_arena(arena* a)
+{
+    if (!a)
+    {
+        return false;
+    }
+
+    _freeOverflow_arena(a);
+    free(a->block);
+    free(a);
+
+    return true;
+}
+
+void* alloc_arena(arena* a, size_t size)
+{
+    if (!a || size == 0)
+    {
+        return NULL;
+    }
+
+    // Keep every allocation aligned for any type
+    const size_t alignment = _Alignof(max_align_t);
+    size = (size + alignment - 1) / alignment * alignment;
+
+    void* memory = _alloc_arenaBlock(a->block, size);
+    if (!memory)
+    {
+        memory = _alloc_arenaBlock(a->overflow, size);
+    }
+
+    if (!memory)
+    {
+        // The main block is full, so overflow into a new block at least as large as the main block
+        size_t capacity = a->block->capacity > size ? a->block->capacity : size;
+        arenaBlock* block = _create_arenaBlock(capacity);
+        if (!block)
+        {
+            return NULL;
+        }
+
+        block->next = a->overflow;
+        a->overflow = block;
+
+        memory = _alloc_arenaBlock(block, size);
+    }
+
+    a->used += size;
+
+    return memory;
+}
+
+void reset_arena(arena* a)
+{
+    if (!a)
+    {
+        return;
+    }
+
+    // If we overflowed, grow the main block so the same amount of memory fits in one block next time
+    if (a->overflow)
+    {
+        _freeOverflow_arena(a);
+
+        arenaBlock* block = _create_arenaBlock(a->used);
+        if (block)
+        {
+            free(a->block);
+            a->block = block;
+        }
+    }
+
+    a->block->used = 0;
+    a->used = 0;
+}
+
+size_t getUsed_arena(arena* a)
+{
+    if (!a)
+    {
+        return 0;
+    }
+
+    return a->used;
+}
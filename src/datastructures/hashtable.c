@@ -280,17 +280,29 @@ void** getAll_hashtable(hashtable* table)
         return NULL;
     }
 
+    copyAll_hashtable(table, allData);
+
+    return allData;
+}
+
+size_t copyAll_hashtable(hashtable* table, void** out)
+{
+    if (!table || !out)
+    {
+        return 0;
+    }
+
     size_t allDataIndex = 0;
 
     for (size_t i = 0; i < table->capacity; i++)
     {
         for (bucketNode* it = table->buckets[i].head; it; it = it->next)
         {
-            allData[allDataIndex++] = it->value;
+            out[allDataIndex++] = it->value;
         }
     }
 
-    return allData;
+    return allDataIndex;
 }
 
 size_t getCount_hashtable(hashtable* table)
@@ -0,0 +1,198 @@
+#include "datastructures/pool.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef struct _slab
+{
+    struct _slab* next;
+    _Alignas(max_align_t) uint8_t elements[];
+} slab;
+
+typedef struct _freeElement
+{
+    struct _freeElement* next;
+} freeElement;
+
+struct _pool
+{
+    size_t elementSize;
+    size_t slabCapacity;
+
+    slab* slabs; // Slabs are kept in the order they were allocated
+    slab* lastSlab;
+
+    slab* currentSlab; // The slab new elements are taken from once the free list is empty
+    size_t currentSlabUsed;
+
+    freeElement* freeList;
+
+    size_t count;
+};
+
+pool* create_pool(size_t elementSize, size_t slabCapacity)
+{
+    if (elementSize == 0 || slabCapacity == 0)
+    {
+        return NULL;
+    }
+
+    pool* p = malloc(sizeof(pool));
+    if (!p)
+    {
+        return NULL;
+    }
+
+    // Every element must be able to hold a free list node, and must keep the next element aligned
+    const size_t alignment = _Alignof(max_align_t);
+    if (elementSize < sizeof(freeElement))
+    {
+        elementSize = sizeof(freeElement);
+    }
+    p->elementSize = (elementSize + alignment - 1) / alignment * alignment;
+    p->slabCapacity = slabCapacity;
+
+    p->slabs = NULL;
+    p->lastSlab = NULL;
+    p->currentSlab = NULL;
+    p->currentSlabUsed = 0;
+    p->freeList = NULL;
+    p->count = 0;
+
+    return p;
+}
+
+bool free_pool(pool* p)
+{
+    if (!p)
+    {
+        return false;
+    }
+
+    slab* it = p->slabs;
+    slab* next;
+    while (it)
+    {
+        next = it->next;
+        free(it);
+        it = next;
+    }
+
+    free(p);
+
+    return true;
+}
+
+/*
+Moves the pool to the next slab with free space, allocating a new slab if every slab is full
+
+Arguments
+    pool* p: The pool whose current slab is full
+
+Returns
+    Returns false if memory allocation failed
+*/
+bool _nextSlab_pool(pool* p)
+{
+    // Slabs left over from clear_pool() are refilled before new ones are allocated
+    if (p->currentSlab && p->currentSlab->next)
+    {
+        p->currentSlab = p->currentSlab->next;
+        p->currentSlabUsed = 0;
+
+        return true;
+    }
+
+    slab* s = malloc(sizeof(slab) + p->elementSize * p->slabCapacity);
+    if (!s)
+    {
+        return false;
+    }
+
+    s->next = NULL;
+    if (p->lastSlab)
+    {
+        p->lastSlab->next = s;
+    }
+    else
+    {
+        p->slabs = s;
+    }
+    p->lastSlab = s;
+
+    p->currentSlab = s;
+    p->currentSlabUsed = 0;
+
+    return true;
+}
+
+void* alloc_pool(pool* p)
+{
+    if (!p)
+    {
+        return NULL;
+    }
+
+    // Reuse released elements first
+    if (p->freeList)
+    {
+        void* element = p->freeList;
+        p->freeList = p->freeList->next;
+        p->count++;
+
+        return element;
+    }
+
+    if (!p->currentSlab || p->currentSlabUsed == p->slabCapacity)
+    {
+        if (!_nextSlab_pool(p))
+        {
+            return NULL;
+        }
+    }
+
+    void* element = &p->currentSlab->elements[p->currentSlabUsed * p->elementSize];
+    p->currentSlabUsed++;
+    p->count++;
+
+    return element;
+}
+
+bool release_pool(pool* p, void* element)
+{
+    if (!p || !element)
+    {
+        return false;
+    }
+
+    freeElement* e = element;
+    e->next = p->freeList;
+    p->freeList = e;
+    p->count--;
+
+    return true;
+}
+
+void clear_pool(pool* p)
+{
+    if (!p)
+    {
+        return;
+    }
+
+    // Rewind to the first slab, every slab is refilled in order by alloc_pool()
+    p->currentSlab = p->slabs;
+    p->currentSlabUsed = 0;
+    p->freeList = NULL;
+    p->count = 0;
+}
+
+size_t getCount_pool(pool* p)
+{
+    if (!p)
+    {
+        return 0;
+    }
+
+    return p->count;
+}
@@ -0,0 +1,286 @@
+#include "datastructures/slotmap.h"
+
+#include <stdlib.h>
+
+#define HANDLE_INDEX_MASK ((1u << HANDLE_INDEX_BITS) - 1)
+#define HANDLE_GENERATION_MASK ((1u << HANDLE_GENERATION_BITS) - 1)
+#define NO_FREE_SLOT UINT32_MAX
+
+typedef struct _slot
+{
+    uint32_t index; // The index of the value if the slot is in use, otherwise the next free slot
+    uint32_t generation;
+} slot;
+
+struct _slotmap
+{
+    void** values;
+    uint32_t* valueSlots; // The slot of each value, parallel to values
+
+    slot* slots;
+    uint32_t freeSlot; // The head of the free slot list
+
+    size_t count;
+    size_t slotCount;
+    size_t capacity;
+};
+
+/*
+Builds a handle from a slot index and generation
+*/
+handle _create_handle(uint32_t index, uint32_t generation)
+{
+    return (generation << HANDLE_INDEX_BITS) | index;
+}
+
+slotmap* create_slotmap(size_t capacity)
+{
+    if (capacity == 0)
+    {
+        return NULL;
+    }
+
+    slotmap* sm = malloc(sizeof(slotmap));
+    if (!sm)
+    {
+        return NULL;
+    }
+
+    sm->values = malloc(sizeof(void*) * capacity);
+    sm->valueSlots = malloc(sizeof(uint32_t) * capacity);
+    sm->slots = malloc(sizeof(slot) * capacity);
+    if (!sm->values || !sm->valueSlots || !sm->slots)
+    {
+        free(sm->values);
+        free(sm->valueSlots);
+        free(sm->slots);
+        free(sm);
+
+        return NULL;
+    }
+
+    sm->freeSlot = NO_FREE_SLOT;
+    sm->count = 0;
+    sm->slotCount = 0;
+    sm->capacity = capacity;
+
+    return sm;
+}
+
+bool free_slotmap(slotmap* sm)
+{
+    if (!sm)
+    {
+        return false;
+    }
+
+    free(sm->values);
+    free(sm->valueSlots);
+    free(sm->slots);
+    free(sm);
+
+    return true;
+}
+
+/*
+Doubles the capacity of a slotmap
+
+Arguments
+    slotmap* sm: The slotmap to grow
+
+Returns
+    Returns false if memory allocation failed
+*/
+bool _grow_slotmap(slotmap* sm)
+{
+    size_t capacity = sm->capacity * 2;
+
+    void** values = realloc(sm->values, sizeof(void*) * capacity);
+    if (!values)
+    {
+        return false;
+    }
+    sm->values = values;
+
+    uint32_t* valueSlots = realloc(sm->valueSlots, sizeof(uint32_t) * capacity);
+    if (!valueSlots)
+    {
+        return false;
+    }
+    sm->valueSlots = valueSlots;
+
+    slot* slots = realloc(sm->slots, sizeof(slot) * capacity);
+    if (!slots)
+    {
+        return false;
+    }
+    sm->slots = slots;
+
+    sm->capacity = capacity;
+
+    return true;
+}
+
+handle insert_slotmap(slotmap* sm, void* value)
+{
+    if (!sm || !value)
+    {
+        return INVALID_HANDLE;
+    }
+
+    // Reuse a free slot, otherwise take a brand new one
+    uint32_t slotIndex;
+    if (sm->freeSlot != NO_FREE_SLOT)
+    {
+        slotIndex = sm->freeSlot;
+        sm->freeSlot = sm->slots[slotIndex].index;
+    }
+    else
+    {
+        if (sm->slotCount > HANDLE_INDEX_MASK)
+        {
+            return INVALID_HANDLE;
+        }
+
+        if (sm->slotCount == sm->capacity && !_grow_slotmap(sm))
+        {
+            return INVALID_HANDLE;
+        }
+
+        slotIndex = sm->slotCount++;
+
+        // Generation 0 is never used, so a zeroed handle is always invalid
+        sm->slots[slotIndex].generation = 1;
+    }
+
+    // Every value owns a slot, so there is always room for the value once there is room for its slot
+    sm->slots[slotIndex].index = sm->count;
+    sm->values[sm->count] = value;
+    sm->valueSlots[sm->count] = slotIndex;
+    sm->count++;
+
+    return _create_handle(slotIndex, sm->slots[slotIndex].generation);
+}
+
+bool getIndex_slotmap(slotmap* sm, handle h, size_t* outIndex)
+{
+    if (!sm || !outIndex)
+    {
+        return false;
+    }
+
+    uint32_t slotIndex = h & HANDLE_INDEX_MASK;
+    uint32_t generation = h >> HANDLE_INDEX_BITS;
+    if (slotIndex >= sm->slotCount || sm->slots[slotIndex].generation != generation)
+    {
+        return false;
+    }
+
+    // Free slots point to other free slots rather than values
+    uint32_t index = sm->slots[slotIndex].index;
+    if (index >= sm->count || sm->valueSlots[index] != slotIndex)
+    {
+        return false;
+    }
+
+    *outIndex = index;
+
+    return true;
+}
+
+void* get_slotmap(slotmap* sm, handle h)
+{
+    size_t index;
+    if (!getIndex_slotmap(sm, h, &index))
+    {
+        return NULL;
+    }
+
+    return sm->values[index];
+}
+
+handle getHandle_slotmap(slotmap* sm, size_t index)
+{
+    if (!sm || index >= sm->count)
+    {
+        return INVALID_HANDLE;
+    }
+
+    uint32_t slotIndex = sm->valueSlots[index];
+
+    return _create_handle(slotIndex, sm->slots[slotIndex].generation);
+}
+
+void* remove_slotmap(slotmap* sm, handle h, size_t* outIndex)
+{
+    size_t index;
+    if (!getIndex_slotmap(sm, h, &index))
+    {
+        return NULL;
+    }
+
+    void* value = sm->values[index];
+    uint32_t slotIndex = sm->valueSlots[index];
+
+    // Move the last value into the hole so the values stay densely packed
+    size_t lastIndex = sm->count - 1;
+    sm->values[index] = sm->values[lastIndex];
+    sm->valueSlots[index] = sm->valueSlots[lastIndex];
+    sm->slots[sm->valueSlots[index]].index = index;
+    sm->count--;
+
+    // Invalidate every outstanding handle to the slot, skipping generation 0
+    uint32_t generation = (sm->slots[slotIndex].generation + 1) & HANDLE_GENERATION_MASK;
+    sm->slots[slotIndex].generation = generation == 0 ? 1 : generation;
+
+    sm->slots[slotIndex].index = sm->freeSlot;
+    sm->freeSlot = slotIndex;
+
+    if (outIndex)
+    {
+        *outIndex = index;
+    }
+
+    return value;
+}
+
+bool swap_slotmap(slotmap* sm, size_t i, size_t j)
+{
+    if (!sm || i >= sm->count || j >= sm->count)
+    {
+        return false;
+    }
+
+    void* value = sm->values[i];
+    sm->values[i] = sm->values[j];
+    sm->values[j] = value;
+
+    uint32_t valueSlot = sm->valueSlots[i];
+    sm->valueSlots[i] = sm->valueSlots[j];
+    sm->valueSlots[j] = valueSlot;
+
+    sm->slots[sm->valueSlots[i]].index = i;
+    sm->slots[sm->valueSlots[j]].index = j;
+
+    return true;
+}
+
+void** getValues_slotmap(slotmap* sm)
+{
+    if (!sm)
+    {
+        return NULL;
+    }
+
+    return sm->values;
+}
+
+size_t getCount_slotmap(slotmap* sm)
+{
+    if (!sm)
+    {
+        return 0;
+    }
+
+    return sm->count;
+}
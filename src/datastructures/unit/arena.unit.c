@@ -0,0 +1,118 @@
+#include "datastructures/unit/arena.unit.h"
+
+#include "datastructures/arena.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// arena* create_arena(size_t capacity)
+IMPLEMENT_TEST(create_arena)
+{
+    arena* a = create_arena(0);
+    if (a)
+    {
+        free_arena(a);
+        FAIL_TEST("Created an arena with a capacity of 0");
+    }
+
+    a = create_arena(64);
+    if (!a)
+    {
+        FAIL_TEST("Could not create an arena with the required arguments");
+    }
+
+    free_arena(a);
+
+    PASS_TEST();
+}
+
+// void* alloc_arena(arena* a, size_t size)
+IMPLEMENT_TEST(alloc_arena)
+{
+    arena* a = create_arena(64);
+    if (!a)
+    {
+        FAIL_TEST("Could not create an arena with the required arguments");
+    }
+
+    if (alloc_arena(a, 0))
+    {
+        free_arena(a);
+        FAIL_TEST("Allocated 0 bytes from an arena");
+    }
+
+    uint8_t* first = alloc_arena(a, 1);
+    uint64_t* second = alloc_arena(a, sizeof(uint64_t));
+    if (!first || !second)
+    {
+        free_arena(a);
+        FAIL_TEST("Could not allocate from an arena with enough capacity");
+    }
+
+    if ((uintptr_t) second % _Alignof(max_align_t) != 0)
+    {
+        free_arena(a);
+        FAIL_TEST("Arena allocations are not aligned");
+    }
+
+    if ((uint8_t*) second <= first)
+    {
+        free_arena(a);
+        FAIL_TEST("Arena allocations did not bump forward");
+    }
+
+    // Allocating more than the capacity should overflow instead of failing
+    uint8_t* large = alloc_arena(a, 256);
+    if (!large)
+    {
+        free_arena(a);
+        FAIL_TEST("Could not allocate more than the arena's capacity");
+    }
+    large[255] = 1;
+
+    free_arena(a);
+
+    PASS_TEST();
+}
+
+// void reset_arena(arena* a)
+IMPLEMENT_TEST(reset_arena)
+{
+    arena* a = create_arena(64);
+    if (!a)
+    {
+        FAIL_TEST("Could not create an arena with the required arguments");
+    }
+
+    void* first = alloc_arena(a, 16);
+    reset_arena(a);
+
+    if (getUsed_arena(a) != 0)
+    {
+        free_arena(a);
+        FAIL_TEST("Resetting an arena did not release its memory");
+    }
+
+    if (alloc_arena(a, 16) != first)
+    {
+        free_arena(a);
+        FAIL_TEST("Resetting an arena did not rewind it");
+    }
+
+    // After overflowing, a reset should grow the arena so the same usage fits in a single block
+    alloc_arena(a, 256);
+    size_t used = getUsed_arena(a);
+    reset_arena(a);
+
+    uint8_t* start = alloc_arena(a, 16);
+    uint8_t* end = alloc_arena(a, used - 16);
+    if (!start || !end || end != start + 16)
+    {
+        free_arena(a);
+        FAIL_TEST("Resetting an overflowed arena did not grow it");
+    }
+
+    free_arena(a);
+
+    PASS_TEST();
+}
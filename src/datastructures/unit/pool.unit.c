@@ -0,0 +1,132 @@
+#include "datastructures/unit/pool.unit.h"
+
+#include "datastructures/pool.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// pool* create_pool(size_t elementSize, size_t slabCapacity)
+IMPLEMENT_TEST(create_pool)
+{
+    pool* p = create_pool(0, 4);
+    if (p)
+    {
+        free_pool(p);
+        FAIL_TEST("Created a pool with an element size of 0");
+    }
+
+    p = create_pool(sizeof(uint64_t), 0);
+    if (p)
+    {
+        free_pool(p);
+        FAIL_TEST("Created a pool with a slab capacity of 0");
+    }
+
+    p = create_pool(sizeof(uint64_t), 4);
+    if (!p)
+    {
+        FAIL_TEST("Could not create a pool with the required arguments");
+    }
+
+    free_pool(p);
+
+    PASS_TEST();
+}
+
+// void* alloc_pool(pool* p)
+// bool release_pool(pool* p, void* element)
+IMPLEMENT_TEST(allocRelease_pool)
+{
+    pool* p = create_pool(sizeof(uint64_t), 4);
+    if (!p)
+    {
+        FAIL_TEST("Could not create a pool with the required arguments");
+    }
+
+    // Elements allocated together should sit next to each other
+    uint64_t* elements[6];
+    for (int i = 0; i < 6; i++)
+    {
+        elements[i] = alloc_pool(p);
+        if (!elements[i])
+        {
+            free_pool(p);
+            FAIL_TEST("Could not allocate an element from the pool");
+        }
+
+        *elements[i] = i;
+    }
+
+    if ((uint8_t*) elements[1] - (uint8_t*) elements[0] != (uint8_t*) elements[2] - (uint8_t*) elements[1] ||
+        elements[1] <= elements[0])
+    {
+        free_pool(p);
+        FAIL_TEST("Elements allocated together are not contiguous");
+    }
+
+    for (int i = 0; i < 6; i++)
+    {
+        if (*elements[i] != i)
+        {
+            free_pool(p);
+            FAIL_TEST("Elements overlap each other");
+        }
+    }
+
+    if (getCount_pool(p) != 6)
+    {
+        free_pool(p);
+        FAIL_TEST("Pool count does not match the number of allocated elements");
+    }
+
+    // Released elements should be reused before anything else
+    release_pool(p, elements[2]);
+    if (alloc_pool(p) != elements[2])
+    {
+        free_pool(p);
+        FAIL_TEST("A released element was not reused");
+    }
+
+    free_pool(p);
+
+    PASS_TEST();
+}
+
+// void clear_pool(pool* p)
+IMPLEMENT_TEST(clear_pool)
+{
+    pool* p = create_pool(sizeof(uint64_t), 2);
+    if (!p)
+    {
+        FAIL_TEST("Could not create a pool with the required arguments");
+    }
+
+    void* first = alloc_pool(p);
+    alloc_pool(p);
+    void* third = alloc_pool(p);
+
+    clear_pool(p);
+    if (getCount_pool(p) != 0)
+    {
+        free_pool(p);
+        FAIL_TEST("Clearing a pool did not reset its count");
+    }
+
+    // The existing slabs are refilled in order
+    if (alloc_pool(p) != first)
+    {
+        free_pool(p);
+        FAIL_TEST("Clearing a pool did not rewind to the first slab");
+    }
+
+    alloc_pool(p);
+    if (alloc_pool(p) != third)
+    {
+        free_pool(p);
+        FAIL_TEST("Clearing a pool did not reuse the second slab");
+    }
+
+    free_pool(p);
+
+    PASS_TEST();
+}
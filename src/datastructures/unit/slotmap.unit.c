@@ -0,0 +1,162 @@
+#include "datastructures/unit/slotmap.unit.h"
+
+#include "datastructures/slotmap.h"
+
+#include <stdlib.h>
+
+// slotmap* create_slotmap(size_t capacity)
+IMPLEMENT_TEST(create_slotmap)
+{
+    slotmap* sm = create_slotmap(0);
+    if (sm)
+    {
+        free_slotmap(sm);
+        FAIL_TEST("Created a slotmap with a capacity of 0");
+    }
+
+    sm = create_slotmap(4);
+    if (!sm)
+    {
+        FAIL_TEST("Could not create a slotmap with the required arguments");
+    }
+
+    free_slotmap(sm);
+
+    PASS_TEST();
+}
+
+// handle insert_slotmap(slotmap* sm, void* value)
+// void* get_slotmap(slotmap* sm, handle h)
+IMPLEMENT_TEST(insertGet_slotmap)
+{
+    // Start small so the slotmap has to grow
+    slotmap* sm = create_slotmap(1);
+    if (!sm)
+    {
+        FAIL_TEST("Could not create a slotmap with the required arguments");
+    }
+
+    char values[3] = { 'a', 'b', 'c' };
+    handle handles[3];
+    for (int i = 0; i < 3; i++)
+    {
+        handles[i] = insert_slotmap(sm, &values[i]);
+        if (handles[i] == INVALID_HANDLE)
+        {
+            free_slotmap(sm);
+            FAIL_TEST("Could not insert a value into the slotmap");
+        }
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (get_slotmap(sm, handles[i]) != &values[i])
+        {
+            free_slotmap(sm);
+            FAIL_TEST("A handle did not resolve to its value");
+        }
+    }
+
+    if (get_slotmap(sm, INVALID_HANDLE))
+    {
+        free_slotmap(sm);
+        FAIL_TEST("The invalid handle resolved to a value");
+    }
+
+    if (getCount_slotmap(sm) != 3 || getValues_slotmap(sm)[2] != &values[2])
+    {
+        free_slotmap(sm);
+        FAIL_TEST("The values are not densely packed in insertion order");
+    }
+
+    free_slotmap(sm);
+
+    PASS_TEST();
+}
+
+// void* remove_slotmap(slotmap* sm, handle h, size_t* outIndex)
+IMPLEMENT_TEST(remove_slotmap)
+{
+    slotmap* sm = create_slotmap(4);
+    if (!sm)
+    {
+        FAIL_TEST("Could not create a slotmap with the required arguments");
+    }
+
+    char values[3] = { 'a', 'b', 'c' };
+    handle a = insert_slotmap(sm, &values[0]);
+    insert_slotmap(sm, &values[1]);
+    handle c = insert_slotmap(sm, &values[2]);
+
+    size_t removedIndex;
+    if (remove_slotmap(sm, a, &removedIndex) != &values[0] || removedIndex != 0)
+    {
+        free_slotmap(sm);
+        FAIL_TEST("Could not remove a value from the slotmap");
+    }
+
+    // The last value fills the hole
+    size_t index;
+    if (getCount_slotmap(sm) != 2 || !getIndex_slotmap(sm, c, &index) || index != 0 || getHandle_slotmap(sm, 0) != c)
+    {
+        free_slotmap(sm);
+        FAIL_TEST("The last value did not move into the removed value's index");
+    }
+
+    if (get_slotmap(sm, a) || remove_slotmap(sm, a, NULL))
+    {
+        free_slotmap(sm);
+        FAIL_TEST("A stale handle resolved after its value was removed");
+    }
+
+    // Reusing the slot must not revive the stale handle
+    handle d = insert_slotmap(sm, &values[0]);
+    if (d == a || get_slotmap(sm, a) || get_slotmap(sm, d) != &values[0])
+    {
+        free_slotmap(sm);
+        FAIL_TEST("A reused slot did not change generation");
+    }
+
+    free_slotmap(sm);
+
+    PASS_TEST();
+}
+
+// bool swap_slotmap(slotmap* sm, size_t i, size_t j)
+IMPLEMENT_TEST(swap_slotmap)
+{
+    slotmap* sm = create_slotmap(4);
+    if (!sm)
+    {
+        FAIL_TEST("Could not create a slotmap with the required arguments");
+    }
+
+    char values[2] = { 'a', 'b' };
+    handle a = insert_slotmap(sm, &values[0]);
+    handle b = insert_slotmap(sm, &values[1]);
+
+    if (swap_slotmap(sm, 0, 2))
+    {
+        free_slotmap(sm);
+        FAIL_TEST("Swapped an index that is out of bounds");
+    }
+
+    if (!swap_slotmap(sm, 0, 1) || getValues_slotmap(sm)[0] != &values[1] || getValues_slotmap(sm)[1] != &values[0])
+    {
+        free_slotmap(sm);
+        FAIL_TEST("The values were not swapped");
+    }
+
+    // Handles follow their values
+    size_t index;
+    if (get_slotmap(sm, a) != &values[0] || get_slotmap(sm, b) != &values[1] ||
+        !getIndex_slotmap(sm, a, &index) || index != 1 || getHandle_slotmap(sm, 0) != b)
+    {
+        free_slotmap(sm);
+        FAIL_TEST("A handle did not follow its value after a swap");
+    }
+
+    free_slotmap(sm);
+
+    PASS_TEST();
+}
@@ -0,0 +1,400 @@
+#include "engine/archive.h"
+
+#include "engine/rawTexture.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char ARCHIVE_MAGIC[4] = { 'G', 'E', 'A', 'R' };
+static const uint32_t ARCHIVE_VERSION = 2;
+static const size_t ARCHIVE_ALIGNMENT = 16;
+
+struct _archive
+{
+    const uint8_t* data; // The whole mapped file
+    size_t size;
+
+    const archiveEntry* entries; // Sorted by name
+    size_t entryCount;
+};
+
+static archive* mountedArchive = NULL;
+
+archive* open_archive(const char* fileName)
+{
+    if (!fileName)
+    {
+        return NULL;
+    }
+
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(archiveHeader))
+    {
+        printf("open_archive(): %s is too small to be an archive\n", fileName);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = info.st_size;
+    void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping keeps the file open
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        printf("open_archive(): could not map %s\n", fileName);
+        return NULL;
+    }
+
+    const archiveHeader* header = data;
+    if (memcmp(header->magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0 || header->version != ARCHIVE_VERSION ||
+        header->entryCount > (size - sizeof(archiveHeader)) / sizeof(archiveEntry))
+    {
+        printf("open_archive(): %s is not a valid archive\n", fileName);
+        munmap(data, size);
+        return NULL;
+    }
+
+    const archiveEntry* entries = (const archiveEntry*) &header[1];
+    for (size_t i = 0; i < header->entryCount; i++)
+    {
+        if (entries[i].offset > size || entries[i].size > size - entries[i].offset ||
+            entries[i].name[ARCHIVE_NAME_SIZE - 1] != '\0')
+        {
+            printf("open_archive(): %s has a corrupt entry\n", fileName);
+            munmap(data, size);
+            return NULL;
+        }
+    }
+
+    archive* a = malloc(sizeof(archive));
+    if (!a)
+    {
+        munmap(data, size);
+        return NULL;
+    }
+
+    *a = (archive) { data, size, entries, header->entryCount };
+
+    return a;
+}
+
+bool close_archive(archive* a)
+{
+    if (!a)
+    {
+        return false;
+    }
+
+    if (mountedArchive == a)
+    {
+        mountedArchive = NULL;
+    }
+
+    munmap((void*) a->data, a->size);
+    free(a);
+
+    return true;
+}
+
+const archiveEntry* find_archive(archive* a, const char* name)
+{
+    if (!a || !name)
+    {
+        return NULL;
+    }
+
+    size_t low = 0;
+    size_t high = a->entryCount;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        int order = strcmp(name, a->entries[middle].name);
+        if (order == 0)
+        {
+            return &a->entries[middle];
+        }
+
+        if (order < 0)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+
+    return NULL;
+}
+
+const void* getData_archive(archive* a, const archiveEntry* e)
+{
+    if (!a || !e)
+    {
+        return NULL;
+    }
+
+    return &a->data[e->offset];
+}
+
+void mount_archive(archive* a)
+{
+    mountedArchive = a;
+}
+
+archive* getMounted_archive()
+{
+    return mountedArchive;
+}
+
+/*
+Finds an entry of a given type in the mounted archive
+
+Arguments
+    const char* fileName: The name of the entry
+
+    archiveEntryType type: The type the entry must have
+
+Returns
+    Returns the entry, or NULL if no archive is mounted or it has no such entry
+*/
+const archiveEntry* _findMounted_archive(const char* fileName, archiveEntryType type)
+{
+    const archiveEntry* e = find_archive(mountedArchive, fileName);
+    if (!e || e->type != type)
+    {
+        return NULL;
+    }
+
+    return e;
+}
+
+const char* getShader_archive(const char* fileName)
+{
+    const archiveEntry* e = _findMounted_archive(fileName, ARCHIVE_SHADER);
+    if (!e)
+    {
+        return NULL;
+    }
+
+    return getData_archive(mountedArchive, e);
+}
+
+const uint8_t* getTexture_archive(const char* fileName, size_t* outWidth, size_t* outHeight, size_t* outLevelCount)
+{
+    const archiveEntry* e = _findMounted_archive(fileName, ARCHIVE_TEXTURE);
+    if (!e || !outWidth || !outHeight || !outLevelCount)
+    {
+        return NULL;
+    }
+
+    if (e->levelCount == 0 || e->size < getSize_rawTexture(e->width, e->height, e->levelCount))
+    {
+        printf("getTexture_archive(): %s is smaller than its mip chain\n", fileName);
+        return NULL;
+    }
+
+    *outWidth = e->width;
+    *outHeight = e->height;
+    *outLevelCount = e->levelCount;
+
+    return getData_archive(mountedArchive, e);
+}
+
+bool getPolygon_archive(const char* fileName, polygon* outPoly)
+{
+    const archiveEntry* e = _findMounted_archive(fileName, ARCHIVE_POLYGON);
+    if (!e || !outPoly)
+    {
+        return false;
+    }
+
+    outPoly->vertices = (vec2f*) getData_archive(mountedArchive, e);
+    outPoly->vertexCount = e->width;
+
+    return true;
+}
+
+bool readPolygon_archive(const char* fileName, polygon* outPoly)
+{
+    if (!fileName || !outPoly)
+    {
+        return false;
+    }
+
+    FILE* file = fopen(fileName, "r");
+    if (!file)
+    {
+        return false;
+    }
+
+    vec2f* vertices = NULL;
+    int count = 0;
+    int capacity = 0;
+
+    float x, y;
+    while (fscanf(file, "%f %f", &x, &y) == 2)
+    {
+        if (count == capacity)
+        {
+            capacity = capacity ? capacity * 2 : 8;
+            vec2f* resized = realloc(vertices, sizeof(vec2f) * capacity);
+            if (!resized)
+            {
+                free(vertices);
+                fclose(file);
+                return false;
+            }
+
+            vertices = resized;
+        }
+
+        vertices[count++] = to_vec2f(x, y);
+    }
+
+    fclose(file);
+
+    if (count < 3)
+    {
+        free(vertices);
+        return false;
+    }
+
+    outPoly->vertices = vertices;
+    outPoly->vertexCount = count;
+
+    return true;
+}
+
+/*
+Orders sources by name, for qsort()
+*/
+int _compareSources_archive(const void* a, const void* b)
+{
+    return strcmp((*(const archiveSource**) a)->name, (*(const archiveSource**) b)->name);
+}
+
+/*
+Pads a file with zeros up to the next multiple of ARCHIVE_ALIGNMENT
+
+Arguments
+    FILE* file: The file to pad
+
+    size_t* offset: The current size of the file, which is updated
+
+Returns
+    Returns false if the padding could not be written
+*/
+bool _align_archive(FILE* file, size_t* offset)
+{
+    static const uint8_t zeros[16] = { 0 };
+
+    size_t padding = (ARCHIVE_ALIGNMENT - *offset % ARCHIVE_ALIGNMENT) % ARCHIVE_ALIGNMENT;
+    if (fwrite(zeros, 1, padding, file) != padding)
+    {
+        return false;
+    }
+
+    *offset += padding;
+
+    return true;
+}
+
+bool write_archive(const char* fileName, const archiveSource* sources, size_t count)
+{
+    if (!fileName || (!sources && count > 0))
+    {
+        return false;
+    }
+
+    // The index is searched with a binary search, so it is written in name order
+    const archiveSource** sorted = malloc(sizeof(archiveSource*) * (count ? count : 1));
+    archiveEntry* entries = calloc(count ? count : 1, sizeof(archiveEntry));
+    if (!sorted || !entries)
+    {
+        free(sorted);
+        free(entries);
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        sorted[i] = &sources[i];
+    }
+    qsort(sorted, count, sizeof(archiveSource*), _compareSources_archive);
+
+    size_t offset = sizeof(archiveHeader) + sizeof(archiveEntry) * count;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (strlen(sorted[i]->name) >= ARCHIVE_NAME_SIZE)
+        {
+            printf("write_archive(): %s is too long to be an entry name\n", sorted[i]->name);
+            free(sorted);
+            free(entries);
+            return false;
+        }
+
+        offset += (ARCHIVE_ALIGNMENT - offset % ARCHIVE_ALIGNMENT) % ARCHIVE_ALIGNMENT;
+
+        archiveEntry* e = &entries[i];
+        strcpy(e->name, sorted[i]->name);
+        e->type = sorted[i]->type;
+        e->width = sorted[i]->width;
+        e->height = sorted[i]->height;
+        e->levelCount = sorted[i]->levelCount;
+        e->offset = offset;
+        e->size = sorted[i]->size;
+
+        offset += sorted[i]->size;
+    }
+
+    FILE* file = fopen(fileName, "wb");
+    if (!file)
+    {
+        printf("write_archive(): could not open %s\n", fileName);
+        free(sorted);
+        free(entries);
+        return false;
+    }
+
+    archiveHeader header;
+    memcpy(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    header.version = ARCHIVE_VERSION;
+    header.entryCount = count;
+
+    bool isWritten = fwrite(&header, sizeof(header), 1, file) == 1 &&
+        (count == 0 || fwrite(entries, sizeof(archiveEntry), count, file) == count);
+
+    offset = sizeof(archiveHeader) + sizeof(archiveEntry) * count;
+    for (size_t i = 0; isWritten && i < count; i++)
+    {
+        isWritten = _align_archive(file, &offset) &&
+            (sorted[i]->size == 0 || fwrite(sorted[i]->data, sorted[i]->size, 1, file) == 1);
+        offset += sorted[i]->size;
+    }
+
+    isWritten = fclose(file) == 0 && isWritten;
+    if (!isWritten)
+    {
+        printf("write_archive(): could not write %s\n", fileName);
+    }
+
+    free(sorted);
+    free(entries);
+
+    return isWritten;
+}
@@ -0,0 +1,90 @@
+#include "engine/asset.h"
+
+#include "datastructures/hashtable.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static hashtable* assetTable = NULL; // The handle of every interned file name, by file name
+
+// The file name of every handle, indexed by handle. Index 0 is INVALID_ASSET, which is never handed out.
+static char** fileNames = NULL;
+static size_t fileNamesCount = 1;
+static size_t fileNamesCapacity = 0;
+
+assetHandle intern_asset(const char* fileName)
+{
+    if (!fileName)
+    {
+        return INVALID_ASSET;
+    }
+
+    if (!assetTable)
+    {
+        assetTable = create_hashtable(64, hasher_string, comparator_string);
+        if (!assetTable)
+        {
+            return INVALID_ASSET;
+        }
+    }
+
+    // The handle is stored as the value itself, it is never 0 so it can't be confused for a missing key
+    assetHandle asset = (assetHandle) (uintptr_t) get_hashtable(assetTable, (void*) fileName);
+    if (asset != INVALID_ASSET)
+    {
+        return asset;
+    }
+
+    if (fileNamesCount == UINT32_MAX)
+    {
+        return INVALID_ASSET;
+    }
+
+    if (fileNamesCount >= fileNamesCapacity)
+    {
+        size_t capacity = fileNamesCapacity ? fileNamesCapacity * 2 : 64;
+        char** resized = realloc(fileNames, sizeof(char*) * capacity);
+        if (!resized)
+        {
+            return INVALID_ASSET;
+        }
+
+        fileNames = resized;
+        fileNames[INVALID_ASSET] = NULL;
+        fileNamesCapacity = capacity;
+    }
+
+    // The copy is the table's key, so the caller's file name doesn't have to outlive the call
+    char* ownedFileName = malloc(strlen(fileName) + 1);
+    if (!ownedFileName)
+    {
+        return INVALID_ASSET;
+    }
+    strcpy(ownedFileName, fileName);
+
+    asset = (assetHandle) fileNamesCount;
+    if (!set_hashtable(assetTable, ownedFileName, (void*) (uintptr_t) asset))
+    {
+        free(ownedFileName);
+        return INVALID_ASSET;
+    }
+
+    fileNames[fileNamesCount++] = ownedFileName;
+
+    return asset;
+}
+
+const char* getFileName_asset(assetHandle asset)
+{
+    if (asset == INVALID_ASSET || asset >= fileNamesCount)
+    {
+        return NULL;
+    }
+
+    return fileNames[asset];
+}
+
+size_t getCount_asset()
+{
+    return fileNamesCount - 1;
+}
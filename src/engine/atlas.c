@@ -0,0 +1,232 @@
+#include "engine/atlas.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// A horizontal segment of the skyline. The segments are sorted by x and cover the whole page width
+typedef struct _skylineNode
+{
+    size_t x;
+    size_t y;
+    size_t width;
+} skylineNode;
+
+struct _atlas
+{
+    size_t width;
+    size_t height;
+
+    skylineNode* nodes;
+    size_t nodeCount;
+    size_t nodeCapacity;
+};
+
+atlas* create_atlas(size_t width, size_t height)
+{
+    if (width == 0 || height == 0)
+    {
+        return NULL;
+    }
+
+    atlas* a = malloc(sizeof(atlas));
+    if (!a)
+    {
+        return NULL;
+    }
+
+    a->nodeCapacity = 16;
+    a->nodes = malloc(sizeof(skylineNode) * a->nodeCapacity);
+    if (!a->nodes)
+    {
+        free(a);
+        return NULL;
+    }
+
+    a->width = width;
+    a->height = height;
+
+    // The page starts out empty, so the skyline is a single segment along the bottom
+    a->nodes[0] = (skylineNode) { 0, 0, width };
+    a->nodeCount = 1;
+
+    return a;
+}
+
+bool free_atlas(atlas* a)
+{
+    if (!a)
+    {
+        return false;
+    }
+
+    free(a->nodes);
+    free(a);
+
+    return true;
+}
+
+/*
+Finds the height a rectangle would rest at if its left edge was placed at a skyline segment
+
+Arguments
+    atlas* a: The packer
+
+    size_t index: The index of the segment the left edge is placed at
+
+    size_t width: The width of the rectangle
+
+    size_t height: The height of the rectangle
+
+    size_t* outY: The bottom edge of the rectangle
+
+Returns
+    Returns false if the rectangle would stick out of the page
+*/
+bool _fit_atlas(atlas* a, size_t index, size_t width, size_t height, size_t* outY)
+{
+    if (a->nodes[index].x + width > a->width)
+    {
+        return false;
+    }
+
+    // The rectangle rests on the highest segment underneath it
+    size_t y = 0;
+    size_t remaining = width;
+    for (size_t i = index; remaining > 0; i++)
+    {
+        if (a->nodes[i].y > y)
+        {
+            y = a->nodes[i].y;
+        }
+
+        remaining = a->nodes[i].width >= remaining ? 0 : remaining - a->nodes[i].width;
+    }
+
+    if (y + height > a->height)
+    {
+        return false;
+    }
+
+    *outY = y;
+
+    return true;
+}
+
+/*
+Raises the skyline over a newly packed rectangle
+
+Arguments
+    atlas* a: The packer
+
+    size_t index: The index of the segment the rectangle's left edge was placed at
+
+    size_t width: The width of the rectangle
+
+    size_t top: The top edge of the rectangle
+
+Returns
+    Returns false if memory allocation failed
+*/
+bool _raise_atlas(atlas* a, size_t index, size_t width, size_t top)
+{
+    if (a->nodeCount == a->nodeCapacity)
+    {
+        skylineNode* nodes = realloc(a->nodes, sizeof(skylineNode) * a->nodeCapacity * 2);
+        if (!nodes)
+        {
+            return false;
+        }
+
+        a->nodes = nodes;
+        a->nodeCapacity *= 2;
+    }
+
+    // Insert the rectangle's top edge before the segment it was placed at
+    size_t x = a->nodes[index].x;
+    memmove(&a->nodes[index + 1], &a->nodes[index], sizeof(skylineNode) * (a->nodeCount - index));
+    a->nodes[index] = (skylineNode) { x, top, width };
+    a->nodeCount++;
+
+    // Cut away the segments the rectangle now covers
+    size_t end = x + width;
+    size_t i = index + 1;
+    while (i < a->nodeCount && a->nodes[i].x < end)
+    {
+        size_t nodeEnd = a->nodes[i].x + a->nodes[i].width;
+        if (nodeEnd > end)
+        {
+            a->nodes[i].width = nodeEnd - end;
+            a->nodes[i].x = end;
+            break;
+        }
+
+        memmove(&a->nodes[i], &a->nodes[i + 1], sizeof(skylineNode) * (a->nodeCount - i - 1));
+        a->nodeCount--;
+    }
+
+    // Merge neighbouring segments at the same height, so the skyline stays as short as possible
+    i = 0;
+    while (i + 1 < a->nodeCount)
+    {
+        if (a->nodes[i].y == a->nodes[i + 1].y)
+        {
+            a->nodes[i].width += a->nodes[i + 1].width;
+            memmove(&a->nodes[i + 1], &a->nodes[i + 2], sizeof(skylineNode) * (a->nodeCount - i - 2));
+            a->nodeCount--;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return true;
+}
+
+bool pack_atlas(atlas* a, size_t width, size_t height, size_t* outX, size_t* outY)
+{
+    if (!a || !outX || !outY || width == 0 || height == 0)
+    {
+        return false;
+    }
+
+    // Pick the placement with the lowest top edge, breaking ties with the narrowest segment
+    size_t bestIndex = SIZE_MAX;
+    size_t bestTop = SIZE_MAX;
+    size_t bestWidth = SIZE_MAX;
+    size_t bestY = 0;
+    for (size_t i = 0; i < a->nodeCount; i++)
+    {
+        size_t y;
+        if (!_fit_atlas(a, i, width, height, &y))
+        {
+            continue;
+        }
+
+        size_t top = y + height;
+        if (top < bestTop || (top == bestTop && a->nodes[i].width < bestWidth))
+        {
+            bestIndex = i;
+            bestTop = top;
+            bestWidth = a->nodes[i].width;
+            bestY = y;
+        }
+    }
+
+    if (bestIndex == SIZE_MAX)
+    {
+        return false;
+    }
+
+    size_t x = a->nodes[bestIndex].x;
+    if (!_raise_atlas(a, bestIndex, width, bestTop))
+    {
+        return false;
+    }
+
+    *outX = x;
+    *outY = bestY;
+
+    return true;
+}
@@ -0,0 +1,65 @@
+#include "engine/camera.h"
+
+#include "engine/math/transform.h"
+
+#include <math.h>
+
+camera create_camera()
+{
+    return (camera) {
+        to_vec2f(0.0f, 0.0f), // position
+        0.0f, // rotation
+        1.0f, // zoom
+    };
+}
+
+MATRIX_TYPE(3, 3) getView_camera(camera* c)
+{
+    // The inverse of the camera's transform: undo the translation, then the rotation, then zoom
+    MATRIX_TYPE(3, 3) transMatrix = {{
+        {1, 0, -GET_X(c->position)},
+        {0, 1, -GET_Y(c->position)},
+        {0, 0, 1},
+    }};
+
+    double sinAngle = sin(c->rotation);
+    double cosAngle = cos(c->rotation);
+    MATRIX_TYPE(3, 3) rotMatrix = {{
+        {cosAngle, -sinAngle, 0},
+        {sinAngle, cosAngle,  0},
+        {0,        0,         1}
+    }};
+
+    MATRIX_TYPE(3, 3) zoomMatrix = {{
+        {c->zoom, 0,       0},
+        {0,       c->zoom, 0},
+        {0,       0,       1},
+    }};
+
+    MATRIX_TYPE(3, 3) rotTransMatrix = MULTIPLY_MATRIX_FN(3, 3, 3)(&rotMatrix, &transMatrix);
+
+    return MULTIPLY_MATRIX_FN(3, 3, 3)(&zoomMatrix, &rotTransMatrix);
+}
+
+MATRIX_TYPE(3, 3) getViewProjection_camera(camera* c, float aspect)
+{
+    MATRIX_TYPE(3, 3) viewMat = getView_camera(c);
+
+    MATRIX_TYPE(3, 3) projectionMat = {{
+        {aspect, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+    }};
+
+    return MULTIPLY_MATRIX_FN(3, 3, 3)(&projectionMat, &viewMat);
+}
+
+void getBounds_camera(camera* c, float aspect, vec2f* outMin, vec2f* outMax)
+{
+    // Clip space spans from -1 to 1 on both axes, so undo the projection and zoom to get the
+    // size of the screen in the world
+    vec2f screenSize = to_vec2f(2.0f / (aspect * c->zoom), 2.0f / c->zoom);
+
+    transform t = { c->position, c->rotation, to_vec2f(1.0f, 1.0f) };
+    getBounds_transform(&t, screenSize, outMin, outMax);
+}
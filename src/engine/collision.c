@@ -1,5 +1,8 @@
 #include "engine/collision.h"
 
+#include "datastructures/arena.h"
+#include "datastructures/pool.h"
+#include "engine/decompositionCache.h"
 #include "engine/util.h"
 #include "engine/math/float.h"
 #include "engine/math/polygon.h"
@@ -17,12 +20,75 @@ struct _collider {
     polygon* polygons;
     int polygonCount;
     float radius; // Used for bubble collision detection (cheap and fast to detect)
+
+    pool* pool; // The pool the collider was allocated from, or NULL if it was malloc'd
 };
 #else
 #include "engine/unit/collision.unit.h"
 #endif
 
+const colliderOptions DEFAULT_COLLIDER_OPTIONS = { DECOMPOSITION_FAST, 0.0f };
+
+/*
+Initializes a collider that has already been allocated
+
+Arguments
+    collider* c: The collider to initialize
+
+    pool* p: The pool c was allocated from, or NULL if c was malloc'd
+
+    transform* transform: See create_collider()
+
+    polygon* poly: See create_collider()
+
+    const colliderOptions* options: See createWithOptions_collider(), which must not be NULL
+
+Returns
+    Returns false if the polygon could not be decomposed
+*/
+bool _init_collider(collider* c, pool* p, transform* transform, polygon* poly, const colliderOptions* options)
+{
+    c->transform = transform;
+    c->radius = 0.0f;
+    c->pool = p;
+
+    polygon simplified = {NULL, 0};
+    if (options->simplifyTolerance > 0.0f)
+    {
+        if (!simplify_polygon(poly, &simplified, options->simplifyTolerance))
+        {
+            return false;
+        }
+
+        poly = &simplified;
+    }
+
+    // Shapes that were decomposed before, by another collider or ahead of time, are copied from the cache
+    bool isDecomposed = decomposeWithMode_decompositionCache(poly, options->decomposition, &c->polygons, &c->polygonCount);
+    free_polygon(&simplified);
+
+    if (!isDecomposed)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < c->polygonCount; i++)
+    {
+        for (int j = 0; j < c->polygons[i].vertexCount; j++)
+        {
+            c->radius = fmax(c->radius, radius_vec2f(c->polygons[i].vertices[j]));
+        }
+    }
+
+    return true;
+}
+
 collider* create_collider(transform* transform, polygon* polygon)
+{
+    return createWithOptions_collider(transform, polygon, NULL);
+}
+
+collider* createWithOptions_collider(transform* transform, polygon* polygon, const colliderOptions* options)
 {
     if (!transform || !polygon)
     {
@@ -35,21 +101,42 @@ collider* create_collider(transform* transform, polygon* polygon)
         return NULL;
     }
 
-    c->transform = transform;
-    c->radius = 0.0f;
-
-    if (!decompose_polygon(polygon, &c->polygons, &c->polygonCount))
+    if (!_init_collider(c, NULL, transform, polygon, options ? options : &DEFAULT_COLLIDER_OPTIONS))
     {
         free(c);
         return NULL;
     }
 
-    for (int i = 0; i < c->polygonCount; i++)
+    return c;
+}
+
+pool* createPool_collider(size_t slabCapacity)
+{
+    return create_pool(sizeof(collider), slabCapacity);
+}
+
+collider* createFromPool_collider(pool* p, transform* transform, polygon* polygon)
+{
+    return createFromPoolWithOptions_collider(p, transform, polygon, NULL);
+}
+
+collider* createFromPoolWithOptions_collider(pool* p, transform* transform, polygon* polygon, const colliderOptions* options)
+{
+    if (!p || !transform || !polygon)
     {
-        for (int j = 0; j < c->polygons[i].vertexCount; j++)
-        {
-            c->radius = fmax(c->radius, radius_vec2f(c->polygons[i].vertices[j]));
-        }
+        return NULL;
+    }
+
+    collider* c = alloc_pool(p);
+    if (!c)
+    {
+        return NULL;
+    }
+
+    if (!_init_collider(c, p, transform, polygon, options ? options : &DEFAULT_COLLIDER_OPTIONS))
+    {
+        release_pool(p, c);
+        return NULL;
     }
 
     return c;
@@ -66,12 +153,30 @@ bool free_collider(collider* c)
     {
         free_polygon(&c->polygons[i]);
     }
+    free(c->polygons);
 
-    free(c);
+    if (c->pool)
+    {
+        release_pool(c->pool, c);
+    }
+    else
+    {
+        free(c);
+    }
 
     return true;
 }
 
+float getRadius_collider(collider* c)
+{
+    if (!c)
+    {
+        return 0.0f;
+    }
+
+    return c->radius;
+}
+
 collision create_collision(bool isColliding, vec2f overlap)
 {
     return (collision) { isColliding, overlap };
@@ -175,47 +280,90 @@ collision _detectCollision_polygon(polygon* base, polygon* target)
     return create_collision(true, overlap);
 }
 
+/*
+Transforms every convex polygon of a collider into world space
+
+Arguments
+    collider* c: The collider to transform
+
+    arena* a: The arena to allocate the transformed polygons from, or NULL to use malloc
+
+Returns
+    Returns an array of c->polygonCount transformed polygons, or NULL if memory allocation failed.
+    If a is NULL, the result must be freed with free()
+*/
+polygon* _transformPolygons_collider(collider* c, arena* a)
+{
+    int vertexCount = 0;
+    for (int i = 0; i < c->polygonCount; i++)
+    {
+        vertexCount += c->polygons[i].vertexCount;
+    }
+
+    // The polygons and all of their vertices share a single allocation
+    size_t size = sizeof(polygon) * c->polygonCount + sizeof(vec2f) * vertexCount;
+    polygon* polygons = a ? alloc_arena(a, size) : malloc(size);
+    if (!polygons)
+    {
+        return NULL;
+    }
+
+    // Only calculate the transform matrix once for all polygons
+    MATRIX_TYPE(3, 3) transformMatrix = getMatrix_transform(c->transform);
+
+    vec2f* vertices = (vec2f*) &polygons[c->polygonCount];
+    for (int i = 0; i < c->polygonCount; i++)
+    {
+        polygons[i].vertices = vertices;
+        applyMatrix_polygon(&c->polygons[i], &transformMatrix, &polygons[i]);
+
+        vertices += c->polygons[i].vertexCount;
+    }
+
+    return polygons;
+}
+
 collision detectCollision_collider(collider* c1, collider* c2)
+{
+    return detectCollisionInArena_collider(c1, c2, NULL);
+}
+
+collision detectCollisionInArena_collider(collider* c1, collider* c2, arena* a)
 {
     if (!c1 || !c2)
     {
-        return create_collision(false, to_vec2f(0, 0));;
+        return create_collision(false, to_vec2f(0, 0));
     }
 
     // Perfom a bubble collision detection
     if (distance_vec2f(c1->transform->position, c2->transform->position) > c1->radius + c2->radius)
     {
-        return create_collision(false, to_vec2f(0, 0));;
+        return create_collision(false, to_vec2f(0, 0));
     }
 
-    // If the bubbles are colliding, then do polygonal collision checking
-    collision c = create_collision(false, to_vec2f(0, 0));;
-    for (int c1Index = 0; c1Index < c1->polygonCount && !c.isColliding; c1Index++)
-    {
-        polygon c1Poly;
-        if (!applyTransform_polygon(&c1->polygons[c1Index], c1->transform, &c1Poly))
-        {
-            // Some memory error happened
-            break;
-        }
+    // If the bubbles are colliding, then do polygonal collision checking.
+    // Each polygon is transformed exactly once, rather than once per polygon pair
+    polygon* c1Polygons = _transformPolygons_collider(c1, a);
+    polygon* c2Polygons = _transformPolygons_collider(c2, a);
 
-        for (int c2Index = 0; c2Index < c2->polygonCount && !c.isColliding; c2Index++)
+    collision c = create_collision(false, to_vec2f(0, 0));
+    if (c1Polygons && c2Polygons) // Otherwise some memory error happened
+    {
+        for (int c1Index = 0; c1Index < c1->polygonCount && !c.isColliding; c1Index++)
         {
-            polygon c2Poly;
-            if (!applyTransform_polygon(&c2->polygons[c2Index], c2->transform, &c2Poly))
+            for (int c2Index = 0; c2Index < c2->polygonCount && !c.isColliding; c2Index++)
             {
-                // Some memory error happened
-                break;
+                c = _detectCollision_polygon(&c1Polygons[c1Index], &c2Polygons[c2Index]);
             }
-
-            c = _detectCollision_polygon(&c1Poly, &c2Poly);
-
-            free_polygon(&c2Poly);
         }
-
-        free_polygon(&c1Poly);
     }
 
+    // Arena memory is released all at once by the arena's owner
+    if (!a)
+    {
+        free(c1Polygons);
+        free(c2Polygons);
+    }
 
     return c;
 }
@@ -0,0 +1,224 @@
+#include "engine/components.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "engine/collision.h"
+#include "engine/gameObject.h"
+#include "engine/util.h"
+
+/*
+Reallocates a single array of a components storage
+
+Arguments
+    void** array: The array to reallocate. It is only changed if reallocation succeeds.
+
+    size_t elementSize: The size of a single element of the array
+
+    size_t capacity: The new number of elements the array can hold
+
+Returns
+    Returns false if memory allocation failed
+*/
+bool _resize_components(void** array, size_t elementSize, size_t capacity)
+{
+    void* resized = realloc(*array, elementSize * capacity);
+    if (!resized)
+    {
+        return false;
+    }
+
+    *array = resized;
+
+    return true;
+}
+
+/*
+Resizes every array of a components storage
+
+Arguments
+    components* c: The storage to resize
+
+    size_t capacity: The new number of gameObjects the storage can hold
+
+Returns
+    Returns false if memory allocation failed
+*/
+bool _reserve_components(components* c, size_t capacity)
+{
+    if (!_resize_components((void**) &c->positions, sizeof(vec2f), capacity) ||
+        !_resize_components((void**) &c->rotations, sizeof(float), capacity) ||
+        !_resize_components((void**) &c->scales, sizeof(vec2f), capacity) ||
+        !_resize_components((void**) &c->radii, sizeof(float), capacity) ||
+        !_resize_components((void**) &c->types, sizeof(uint16_t), capacity) ||
+        !_resize_components((void**) &c->colliders, sizeof(collider*), capacity) ||
+        !_resize_components((void**) &c->renders, sizeof(render*), capacity))
+    {
+        return false;
+    }
+
+    c->capacity = capacity;
+
+    return true;
+}
+
+bool create_components(components* c, size_t capacity)
+{
+    if (!c || capacity == 0)
+    {
+        return false;
+    }
+
+    c->positions = NULL;
+    c->rotations = NULL;
+    c->scales = NULL;
+    c->radii = NULL;
+    c->types = NULL;
+    c->colliders = NULL;
+    c->renders = NULL;
+    c->count = 0;
+    c->capacity = 0;
+
+    if (!_reserve_components(c, capacity))
+    {
+        free_components(c);
+        return false;
+    }
+
+    return true;
+}
+
+bool free_components(components* c)
+{
+    if (!c)
+    {
+        return false;
+    }
+
+    free(c->positions);
+    free(c->rotations);
+    free(c->scales);
+    free(c->radii);
+    free(c->types);
+    free(c->colliders);
+    free(c->renders);
+
+    c->positions = NULL;
+    c->rotations = NULL;
+    c->scales = NULL;
+    c->radii = NULL;
+    c->types = NULL;
+    c->colliders = NULL;
+    c->renders = NULL;
+    c->count = 0;
+    c->capacity = 0;
+
+    return true;
+}
+
+bool push_components(components* c, gameObject* g)
+{
+    if (!c || !g)
+    {
+        return false;
+    }
+
+    if (c->count == c->capacity && !_reserve_components(c, c->capacity * 2))
+    {
+        return false;
+    }
+
+    size_t index = c->count++;
+
+    transform t = getTransform_gameObject(g);
+    c->positions[index] = t.position;
+    c->rotations[index] = t.rotation;
+    c->scales[index] = t.scale;
+    c->types[index] = getType_gameObject(g);
+    setGameObject_components(c, index, g);
+    setComponents_gameObject(g, c, index);
+
+    return true;
+}
+
+bool swapRemove_components(components* c, size_t index)
+{
+    if (!c || index >= c->count)
+    {
+        return false;
+    }
+
+    size_t last = --c->count;
+    if (index != last)
+    {
+        c->positions[index] = c->positions[last];
+        c->rotations[index] = c->rotations[last];
+        c->scales[index] = c->scales[last];
+        c->radii[index] = c->radii[last];
+        c->types[index] = c->types[last];
+        c->colliders[index] = c->colliders[last];
+        c->renders[index] = c->renders[last];
+    }
+
+    return true;
+}
+
+bool swap_components(components* c, size_t i, size_t j)
+{
+    if (!c || i >= c->count || j >= c->count)
+    {
+        return false;
+    }
+
+    SWAP(c->positions[i], c->positions[j]);
+    SWAP(c->rotations[i], c->rotations[j]);
+    SWAP(c->scales[i], c->scales[j]);
+    SWAP(c->radii[i], c->radii[j]);
+    SWAP(c->types[i], c->types[j]);
+    SWAP(c->colliders[i], c->colliders[j]);
+    SWAP(c->renders[i], c->renders[j]);
+
+    return true;
+}
+
+/*
+Recalculates the world space bounding radius at an index from its collider and scale
+
+Arguments
+    components* c: The storage to update
+
+    size_t index: The index to update
+*/
+void _updateRadius_components(components* c, size_t index)
+{
+    if (!c->colliders[index])
+    {
+        c->radii[index] = 0.0f;
+        return;
+    }
+
+    // Rotation doesn't change the bounding circle, only the largest scale axis does
+    float scale = fmaxf(fabsf(GET_X(c->scales[index])), fabsf(GET_Y(c->scales[index])));
+    c->radii[index] = getRadius_collider(c->colliders[index]) * scale;
+}
+
+void setTransform_components(components* c, size_t index, transform t)
+{
+    c->positions[index] = t.position;
+    c->rotations[index] = t.rotation;
+    c->scales[index] = t.scale;
+
+    _updateRadius_components(c, index);
+}
+
+void setGameObject_components(components* c, size_t index, gameObject* g)
+{
+    c->colliders[index] = getCollider_gameObject(g);
+
+    // Static renders are drawn from their batch, so they are left out of the per frame renders. Static renders
+    // whose program can't draw a batch are drawn every frame like any other render
+    render* r = getRender_gameObject(g);
+    c->renders[index] = isStatic_gameObject(g) && isBatched_render(r) ? NULL : r;
+
+    _updateRadius_components(c, index);
+}
@@ -0,0 +1,559 @@
+#include "engine/decompositionCache.h"
+
+#include "datastructures/hashtable.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char DECOMPOSITION_CACHE_MAGIC[4] = { 'G', 'E', 'D', 'C' };
+static const uint32_t DECOMPOSITION_CACHE_VERSION = 2;
+
+// Each vertex is stored as its x and y coordinates, whatever the layout of vec2f
+static const uint32_t STORED_VERTEX_SIZE = sizeof(float) * 2;
+
+// 64 bit FNV-1a
+static const uint64_t HASH_OFFSET = 14695981039346656037ULL;
+static const uint64_t HASH_PRIME = 1099511628211ULL;
+
+/*
+A cache file starts with a decompositionCacheHeader, followed by every decomposition. A decomposition is a
+decompositionRecord, followed by the vertex count of each piece as a uint32_t, followed by the x and y
+coordinates of every vertex of every piece as floats.
+*/
+typedef struct _decompositionCacheHeader
+{
+    char magic[4]; // "GEDC"
+    uint32_t version;
+
+    // The sizes the file was written with, so a file from a build with another layout is rejected instead of misread
+    uint32_t recordSize; // sizeof(decompositionRecord)
+    uint32_t vertexSize; // STORED_VERTEX_SIZE
+
+    uint64_t entryCount;
+} decompositionCacheHeader;
+
+typedef struct _decompositionRecord
+{
+    uint64_t key;
+    uint32_t vertexCount; // Of the decomposed polygon, which guards against a hash collision
+    uint32_t pieceCount;
+} decompositionRecord;
+
+// A cached decomposition
+typedef struct _decompositionEntry
+{
+    decompositionRecord record; // record.key is also the entry's key in the cache table
+    polygon* pieces;
+} decompositionEntry;
+
+static hashtable* cacheTable = NULL; // Every cached decomposition, by key
+static size_t capacity = DEFAULT_DECOMPOSITION_CACHE_CAPACITY; // The most decompositions that are cached as they are made
+static size_t hits = 0;
+static size_t misses = 0;
+
+uint64_t hash_decompositionCache(polygon* poly)
+{
+    uint64_t hash = HASH_OFFSET;
+    if (!poly || !poly->vertices)
+    {
+        return hash;
+    }
+
+    // Only the coordinates are hashed, so the key doesn't depend on how vec2f is laid out
+    for (int i = 0; i < poly->vertexCount; i++)
+    {
+        float coordinates[2] = { GET_X(poly->vertices[i]), GET_Y(poly->vertices[i]) };
+        const uint8_t* bytes = (const uint8_t*) coordinates;
+        for (size_t j = 0; j < sizeof(coordinates); j++)
+        {
+            hash ^= bytes[j];
+            hash *= HASH_PRIME;
+        }
+    }
+
+    return hash;
+}
+
+/*
+Frees a cached decomposition
+
+Arguments
+    decompositionEntry* entry: The entry to free, which has been removed from the cache table
+*/
+void _freeEntry_decompositionCache(decompositionEntry* entry)
+{
+    if (!entry)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; entry->pieces && i < entry->record.pieceCount; i++)
+    {
+        free_polygon(&entry->pieces[i]);
+    }
+
+    free(entry->pieces);
+    free(entry);
+}
+
+/*
+Adds a decomposition to the cache, replacing any cached under the same key
+
+Arguments
+    decompositionEntry* entry: The decomposition, which is owned by the cache afterwards
+
+Returns
+    Returns false if memory allocation failed, in which case the entry is freed
+*/
+bool _add_decompositionCache(decompositionEntry* entry)
+{
+    if (!cacheTable)
+    {
+        cacheTable = create_hashtable(64, hasher_uint64_t, comparator_uint64_t);
+        if (!cacheTable)
+        {
+            _freeEntry_decompositionCache(entry);
+            return false;
+        }
+    }
+
+    _freeEntry_decompositionCache(remove_hashtable(cacheTable, &entry->record.key));
+
+    if (!set_hashtable(cacheTable, &entry->record.key, entry))
+    {
+        _freeEntry_decompositionCache(entry);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+Copies the pieces of a decomposition
+
+Arguments
+    polygon* pieces: The pieces to copy
+
+    int count: The number of pieces
+
+Returns
+    Returns the copied pieces, or NULL if memory allocation failed
+*/
+polygon* _copyPieces_decompositionCache(polygon* pieces, int count)
+{
+    polygon* copies = calloc(count, sizeof(polygon));
+    if (!copies)
+    {
+        return NULL;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (!create_polygon(&copies[i], pieces[i].vertexCount))
+        {
+            for (int j = 0; j < i; j++)
+            {
+                free_polygon(&copies[j]);
+            }
+            free(copies);
+            return NULL;
+        }
+
+        memcpy(copies[i].vertices, pieces[i].vertices, sizeof(vec2f) * pieces[i].vertexCount);
+    }
+
+    return copies;
+}
+
+/*
+Gets the key a decomposition is cached under
+
+Arguments
+    polygon* poly: The decomposed polygon
+
+    decompositionMode mode: How it was decomposed
+
+Returns
+    Returns the key, which is hash_decompositionCache() for DECOMPOSITION_FAST
+*/
+uint64_t _getKey_decompositionCache(polygon* poly, decompositionMode mode)
+{
+    uint64_t hash = hash_decompositionCache(poly);
+    if (mode == DECOMPOSITION_FAST)
+    {
+        return hash;
+    }
+
+    hash ^= (uint8_t) mode;
+    hash *= HASH_PRIME;
+
+    return hash;
+}
+
+bool decompose_decompositionCache(polygon* in, polygon** out, int* outCount)
+{
+    return decomposeWithMode_decompositionCache(in, DECOMPOSITION_FAST, out, outCount);
+}
+
+bool decomposeWithMode_decompositionCache(polygon* in, decompositionMode mode, polygon** out, int* outCount)
+{
+    if (!in || !in->vertices || !out || !outCount)
+    {
+        return false;
+    }
+
+    uint64_t key = _getKey_decompositionCache(in, mode);
+    decompositionEntry* entry = cacheTable ? get_hashtable(cacheTable, &key) : NULL;
+    if (entry && entry->record.vertexCount == (uint32_t) in->vertexCount)
+    {
+        *out = _copyPieces_decompositionCache(entry->pieces, entry->record.pieceCount);
+        if (!*out)
+        {
+            return false;
+        }
+
+        *outCount = entry->record.pieceCount;
+        hits++;
+
+        return true;
+    }
+
+    misses++;
+    bool isDecomposed = mode == DECOMPOSITION_MINIMUM ?
+        decomposeMinimum_polygon(in, out, outCount) :
+        decompose_polygon(in, out, outCount);
+    if (!isDecomposed)
+    {
+        return false;
+    }
+
+    // Once the cache is full, new shapes are decomposed every time instead of growing it without bound
+    if (!*out || getStats_decompositionCache().entries >= capacity)
+    {
+        return true;
+    }
+
+    // The caller owns the pieces, so the cache keeps a copy of its own
+    entry = malloc(sizeof(decompositionEntry));
+    polygon* pieces = entry ? _copyPieces_decompositionCache(*out, *outCount) : NULL;
+    if (!pieces)
+    {
+        // The decomposition is still good, it just isn't cached
+        free(entry);
+        return true;
+    }
+
+    entry->record = (decompositionRecord) { key, in->vertexCount, *outCount };
+    entry->pieces = pieces;
+    _add_decompositionCache(entry);
+
+    return true;
+}
+
+/*
+Writes the vertices of a piece to a cache file, as the x and y coordinates of each vertex
+
+Arguments
+    FILE* file: The file to write to
+
+    polygon* piece: The piece to write
+
+Returns
+    Returns false if the vertices could not be written or memory allocation failed
+*/
+bool _writeVertices_decompositionCache(FILE* file, polygon* piece)
+{
+    size_t coordinateCount = (size_t) piece->vertexCount * 2;
+    float* coordinates = malloc(sizeof(float) * coordinateCount);
+    if (!coordinates)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < piece->vertexCount; i++)
+    {
+        coordinates[i * 2] = GET_X(piece->vertices[i]);
+        coordinates[i * 2 + 1] = GET_Y(piece->vertices[i]);
+    }
+
+    bool isWritten = fwrite(coordinates, sizeof(float), coordinateCount, file) == coordinateCount;
+    free(coordinates);
+
+    return isWritten;
+}
+
+/*
+Reads the vertices of a piece from a cache file, see _writeVertices_decompositionCache()
+
+Arguments
+    FILE* file: The file to read from
+
+    polygon* piece: The piece to read into, which already has room for its vertices
+
+Returns
+    Returns false if the vertices could not be read or memory allocation failed
+*/
+bool _readVertices_decompositionCache(FILE* file, polygon* piece)
+{
+    size_t coordinateCount = (size_t) piece->vertexCount * 2;
+    float* coordinates = malloc(sizeof(float) * coordinateCount);
+    if (!coordinates)
+    {
+        return false;
+    }
+
+    bool isRead = fread(coordinates, sizeof(float), coordinateCount, file) == coordinateCount;
+    for (int i = 0; isRead && i < piece->vertexCount; i++)
+    {
+        piece->vertices[i] = to_vec2f(coordinates[i * 2], coordinates[i * 2 + 1]);
+    }
+
+    free(coordinates);
+
+    return isRead;
+}
+
+/*
+Reads a decomposition from a cache file
+
+Arguments
+    FILE* file: The file, positioned at the start of a decompositionRecord
+
+    uint64_t fileSize: The size of the file in bytes
+
+Returns
+    Returns the decomposition, or NULL if it could not be read or memory allocation failed
+*/
+decompositionEntry* _read_decompositionCache(FILE* file, uint64_t fileSize)
+{
+    decompositionRecord record;
+    long position = ftell(file);
+    if (position < 0 || fread(&record, sizeof(decompositionRecord), 1, file) != 1)
+    {
+        return NULL;
+    }
+
+    /*
+    The counts are checked against the bytes left in the file before anything is allocated from them, so a
+    corrupt count fails instead of allocating whatever it says. A piece never has more vertices than the
+    polygon, every piece has at least 3 and the polygon's count has to fit in a polygon.
+    */
+    uint64_t end = (uint64_t) position + sizeof(decompositionRecord);
+    uint64_t remaining = fileSize > end ? fileSize - end : 0;
+    if (record.vertexCount < 3 || record.vertexCount > INT_MAX || record.pieceCount == 0 ||
+        record.pieceCount > record.vertexCount ||
+        (uint64_t) record.pieceCount * (sizeof(uint32_t) + 3 * STORED_VERTEX_SIZE) > remaining)
+    {
+        return NULL;
+    }
+
+    uint32_t* vertexCounts = malloc(sizeof(uint32_t) * record.pieceCount);
+    if (!vertexCounts)
+    {
+        return NULL;
+    }
+
+    bool isRead = fread(vertexCounts, sizeof(uint32_t), record.pieceCount, file) == record.pieceCount;
+    remaining -= (uint64_t) record.pieceCount * sizeof(uint32_t);
+
+    uint64_t vertexBytes = 0;
+    for (uint32_t i = 0; isRead && i < record.pieceCount; i++)
+    {
+        vertexBytes += (uint64_t) vertexCounts[i] * STORED_VERTEX_SIZE;
+        isRead = vertexCounts[i] >= 3 && vertexCounts[i] <= record.vertexCount && vertexBytes <= remaining;
+    }
+
+    decompositionEntry* entry = isRead ? calloc(1, sizeof(decompositionEntry)) : NULL;
+    polygon* pieces = entry ? calloc(record.pieceCount, sizeof(polygon)) : NULL;
+    if (!pieces)
+    {
+        free(vertexCounts);
+        free(entry);
+        return NULL;
+    }
+
+    entry->record = record;
+    entry->pieces = pieces;
+    for (uint32_t i = 0; isRead && i < record.pieceCount; i++)
+    {
+        isRead = create_polygon(&entry->pieces[i], vertexCounts[i]) &&
+            _readVertices_decompositionCache(file, &entry->pieces[i]);
+    }
+
+    free(vertexCounts);
+
+    if (!isRead)
+    {
+        _freeEntry_decompositionCache(entry);
+        return NULL;
+    }
+
+    return entry;
+}
+
+bool load_decompositionCache(const char* fileName)
+{
+    if (!fileName)
+    {
+        return false;
+    }
+
+    FILE* file = fopen(fileName, "rb");
+    if (!file)
+    {
+        return false;
+    }
+
+    decompositionCacheHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, DECOMPOSITION_CACHE_MAGIC, sizeof(DECOMPOSITION_CACHE_MAGIC)) != 0 ||
+        header.version != DECOMPOSITION_CACHE_VERSION || header.recordSize != sizeof(decompositionRecord) ||
+        header.vertexSize != STORED_VERTEX_SIZE)
+    {
+        printf("load_decompositionCache(): %s is not a decomposition cache of this version\n", fileName);
+        fclose(file);
+        return false;
+    }
+
+    // Entries are checked against the size of the file as they are read
+    long position = ftell(file);
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, position, SEEK_SET);
+
+    // Every entry takes at least a record and a triangle, which bounds a corrupt entry count
+    uint64_t minimumEntrySize = sizeof(decompositionRecord) + sizeof(uint32_t) + 3 * STORED_VERTEX_SIZE;
+    if (fileSize < 0 || header.entryCount > (uint64_t) fileSize / minimumEntrySize)
+    {
+        printf("load_decompositionCache(): could not read %s\n", fileName);
+        fclose(file);
+        return false;
+    }
+
+    // Every entry is read before any is added, so a truncated file adds nothing
+    decompositionEntry** entries = header.entryCount ? calloc(header.entryCount, sizeof(decompositionEntry*)) : NULL;
+    bool isRead = header.entryCount == 0 || entries;
+    for (uint64_t i = 0; isRead && i < header.entryCount; i++)
+    {
+        entries[i] = _read_decompositionCache(file, fileSize);
+        isRead = entries[i] != NULL;
+    }
+
+    fclose(file);
+
+    bool isLoaded = isRead;
+    for (uint64_t i = 0; entries && i < header.entryCount; i++)
+    {
+        if (isRead)
+        {
+            isLoaded = _add_decompositionCache(entries[i]) && isLoaded;
+        }
+        else
+        {
+            _freeEntry_decompositionCache(entries[i]);
+        }
+    }
+    free(entries);
+
+    if (!isRead)
+    {
+        printf("load_decompositionCache(): could not read %s\n", fileName);
+    }
+
+    return isLoaded;
+}
+
+bool save_decompositionCache(const char* fileName)
+{
+    if (!fileName)
+    {
+        return false;
+    }
+
+    size_t entryCount = cacheTable ? getCount_hashtable(cacheTable) : 0;
+    decompositionEntry** entries = entryCount ? (decompositionEntry**) getAll_hashtable(cacheTable) : NULL;
+    if (entryCount && !entries)
+    {
+        return false;
+    }
+
+    FILE* file = fopen(fileName, "wb");
+    if (!file)
+    {
+        printf("save_decompositionCache(): could not open %s\n", fileName);
+        free(entries);
+        return false;
+    }
+
+    decompositionCacheHeader header;
+    memcpy(header.magic, DECOMPOSITION_CACHE_MAGIC, sizeof(DECOMPOSITION_CACHE_MAGIC));
+    header.version = DECOMPOSITION_CACHE_VERSION;
+    header.recordSize = sizeof(decompositionRecord);
+    header.vertexSize = STORED_VERTEX_SIZE;
+    header.entryCount = entryCount;
+
+    bool isWritten = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (size_t i = 0; isWritten && i < entryCount; i++)
+    {
+        decompositionEntry* entry = entries[i];
+        isWritten = fwrite(&entry->record, sizeof(decompositionRecord), 1, file) == 1;
+
+        for (uint32_t j = 0; isWritten && j < entry->record.pieceCount; j++)
+        {
+            uint32_t vertexCount = entry->pieces[j].vertexCount;
+            isWritten = fwrite(&vertexCount, sizeof(uint32_t), 1, file) == 1;
+        }
+
+        for (uint32_t j = 0; isWritten && j < entry->record.pieceCount; j++)
+        {
+            isWritten = _writeVertices_decompositionCache(file, &entry->pieces[j]);
+        }
+    }
+
+    free(entries);
+    isWritten = fclose(file) == 0 && isWritten;
+
+    if (!isWritten)
+    {
+        printf("save_decompositionCache(): could not write %s\n", fileName);
+        remove(fileName);
+    }
+
+    return isWritten;
+}
+
+void clear_decompositionCache()
+{
+    size_t entryCount = cacheTable ? getCount_hashtable(cacheTable) : 0;
+    decompositionEntry** entries = entryCount ? (decompositionEntry**) getAll_hashtable(cacheTable) : NULL;
+    for (size_t i = 0; entries && i < entryCount; i++)
+    {
+        _freeEntry_decompositionCache(entries[i]);
+    }
+    free(entries);
+
+    if (cacheTable)
+    {
+        clear_hashtable(cacheTable);
+    }
+
+    hits = 0;
+    misses = 0;
+}
+
+void setCapacity_decompositionCache(size_t maxEntries)
+{
+    capacity = maxEntries;
+}
+
+decompositionCacheStats getStats_decompositionCache()
+{
+    decompositionCacheStats stats;
+    stats.entries = cacheTable ? getCount_hashtable(cacheTable) : 0;
+    stats.hits = hits;
+    stats.misses = misses;
+
+    return stats;
+}
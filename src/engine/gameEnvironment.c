@@ -1,47 +1,78 @@
 #include "engine/gameEnvironment.h"
 
-#include <OpenGL/gl3.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "datastructures/arena.h"
 #include "datastructures/hashtable.h"
+#include "datastructures/slotmap.h"
+#include "engine/camera.h"
 #include "engine/collision.h"
+#include "engine/components.h"
 #include "engine/gameObject.h"
 #include "engine/render.h"
+#include "engine/renderBackend.h"
+#include "engine/renderQueue.h"
+#include "engine/renderThread.h"
+#include "engine/staticBatch.h"
+#include "engine/texture.h"
 #include "engine/util.h"
 
 #include "util/msTimer.h"
 
 const size_t DEFAULT_GAME_OBJECTS_CAPACITY = 1024;
+const size_t DEFAULT_FRAME_ARENA_CAPACITY = 64 * 1024;
+const size_t DEFAULT_TEXTURE_UPLOADS_PER_STEP = 4;
+
+typedef struct _typeUpdateHandler
+{
+    uint16_t type;
+    onUpdateTypeHandler handler;
+} typeUpdateHandler;
 
 struct _gameEnvironment
 {
     gameEvents events;
+    typeUpdateHandler* updateHandlers; // Sorted by type
+    size_t updateHandlerCount;
+
     gameSettings settings;
 
-    hashtable* gameObjects;
+    slotmap* gameObjects; // Densely packed, grouped by type, and indexed by gameObject handles
+    components components; // Parallel to the gameObjects slotmap values
     hashtable* gameObjectQueue; // The queue holds all new gameObjects until run_gameEnvironment() is called
     hashtable* gameObjectsToRemove;
 
+    camera camera;
+
+    staticBatches* staticBatches; // The renders of every static gameObject, drawn before every other render
+
+    gameObjectPools pools; // Every gameObject created by createGameObject_gameEnvironment() is allocated from here
+
+    arena* frameArena; // Scratch memory that is reset at the start of every run_gameEnvironment()
+
+    renderThread* renderThread; // If set, frames are recorded and handed to the render thread instead of drawn
+
     void* userdata;
 };
 
 gameEnvironment* create_gameEnvironment(gameEvents ge, gameSettings gs)
 {
-    // All event handlers are required
-    if (!ge.onUpdate || !ge.onCollision || !ge.onRenderStart || !ge.onRenderEnd || !ge.onRemoveGameObject)
+    // All event handlers except onUpdate are required
+    if (!ge.onCollision || !ge.onRenderStart || !ge.onRenderEnd || !ge.onRemoveGameObject)
     {
         return NULL;
     }
 
-    gameEnvironment* env = malloc(sizeof(gameEnvironment));
+    gameEnvironment* env = calloc(1, sizeof(gameEnvironment));
     if (!env)
     {
         return NULL;
     }
 
-    env->gameObjects = create_hashtable(DEFAULT_GAME_OBJECTS_CAPACITY, hasher_ptr, comparator_ptr);
+    env->gameObjects = create_slotmap(DEFAULT_GAME_OBJECTS_CAPACITY);
     if (!env->gameObjects)
     {
         free_gameEnvironment(env);
@@ -62,12 +93,94 @@ gameEnvironment* create_gameEnvironment(gameEvents ge, gameSettings gs)
         return NULL;
     }
 
+    if (!create_components(&env->components, DEFAULT_GAME_OBJECTS_CAPACITY))
+    {
+        free_gameEnvironment(env);
+        return NULL;
+    }
+
+    if (!create_gameObjectPools(&env->pools, DEFAULT_GAME_OBJECTS_CAPACITY))
+    {
+        free_gameEnvironment(env);
+        return NULL;
+    }
+
+    env->frameArena = create_arena(DEFAULT_FRAME_ARENA_CAPACITY);
+    if (!env->frameArena)
+    {
+        free_gameEnvironment(env);
+        return NULL;
+    }
+
+    env->staticBatches = create_staticBatches();
+    if (!env->staticBatches)
+    {
+        free_gameEnvironment(env);
+        return NULL;
+    }
+
     env->events = ge;
     env->settings = gs;
+    env->camera = create_camera();
 
     return env;
 }
 
+/*
+Copies every gameObject in a table into the frame arena
+
+Arguments
+    gameEnvironment* env: The gameEnvironment that owns the frame arena
+
+    hashtable* table: The table of gameObjects to copy
+
+    size_t* outCount: The number of gameObjects copied
+
+Returns
+    Returns the copied gameObjects. The memory is released when the frame arena is reset.
+*/
+gameObject** _getAll_gameEnvironment(gameEnvironment* env, hashtable* table, size_t* outCount)
+{
+    *outCount = getCount_hashtable(table);
+
+    gameObject** allGameObjects = alloc_arena(env->frameArena, sizeof(gameObject*) * *outCount);
+    if (!allGameObjects)
+    {
+        *outCount = 0;
+        return NULL;
+    }
+
+    copyAll_hashtable(table, (void**) allGameObjects);
+
+    return allGameObjects;
+}
+
+/*
+Frees every gameObject in an array that was allocated from the gameEnvironment's pools
+
+Arguments
+    gameEnvironment* env: The gameEnvironment that owns the pools
+
+    gameObject** gameObjects: The gameObjects to free
+
+    size_t gameObjectsCount: The size of gameObjects
+*/
+void _freePooledGameObjects_gameEnvironment(gameEnvironment* env, gameObject** gameObjects, size_t gameObjectsCount)
+{
+    if (!gameObjects)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < gameObjectsCount; i++)
+    {
+        if (isFromPools_gameObject(gameObjects[i], &env->pools))
+        {
+            free_gameObject(gameObjects[i]);
+        }
+    }
+}
+
 bool free_gameEnvironment(gameEnvironment* env)
 {
     if (!env)
@@ -75,14 +188,51 @@ bool free_gameEnvironment(gameEnvironment* env)
         return false;
     }
 
-    free_hashtable(env->gameObjects);
+    // Pooled gameObjects own collider polygons outside of the pools, so they are freed individually
+    if (env->pools.gameObjects && env->frameArena)
+    {
+        reset_arena(env->frameArena);
+
+        size_t gameObjectQueueCount;
+        gameObject** gameObjectQueue = _getAll_gameEnvironment(env, env->gameObjectQueue, &gameObjectQueueCount);
+
+        // Queued gameObjects that were already added are freed with the rest of the added gameObjects
+        size_t queuedOnlyCount = 0;
+        for (size_t i = 0; i < gameObjectQueueCount; i++)
+        {
+            if (!getGameObject_gameEnvironment(env, getHandle_gameObject(gameObjectQueue[i])))
+            {
+                gameObjectQueue[queuedOnlyCount++] = gameObjectQueue[i];
+            }
+        }
+
+        _freePooledGameObjects_gameEnvironment(env, gameObjectQueue, queuedOnlyCount);
+        _freePooledGameObjects_gameEnvironment(env, (gameObject**) getValues_slotmap(env->gameObjects), getCount_slotmap(env->gameObjects));
+    }
+
+    free_staticBatches(env->staticBatches);
+    free_slotmap(env->gameObjects);
+    free_components(&env->components);
     free_hashtable(env->gameObjectQueue);
     free_hashtable(env->gameObjectsToRemove);
+    free_gameObjectPools(&env->pools);
+    free_arena(env->frameArena);
+    free(env->updateHandlers);
     free(env);
 
     return true;
 }
 
+gameObject* createGameObject_gameEnvironment(gameEnvironment* env, uint16_t type)
+{
+    if (!env)
+    {
+        return NULL;
+    }
+
+    return createFromPools_gameObject(&env->pools, type);
+}
+
 bool addGameObject_gameEnvironment(gameEnvironment* env, gameObject* g)
 {
     if (!env || !g)
@@ -93,6 +243,101 @@ bool addGameObject_gameEnvironment(gameEnvironment* env, gameObject* g)
     return set_hashtable(env->gameObjectQueue, g, g);
 }
 
+/*
+Swaps two added gameObjects, keeping the slotmap, the components and the gameObjects in sync
+
+Arguments
+    gameEnvironment* env: The gameEnvironment to reorder
+
+    size_t i: The dense index of the first gameObject
+
+    size_t j: The dense index of the second gameObject
+*/
+void _swap_gameEnvironment(gameEnvironment* env, size_t i, size_t j)
+{
+    if (i == j)
+    {
+        return;
+    }
+
+    swap_slotmap(env->gameObjects, i, j);
+    swap_components(&env->components, i, j);
+
+    gameObject** allGameObjects = (gameObject**) getValues_slotmap(env->gameObjects);
+    setComponents_gameObject(allGameObjects[i], &env->components, i);
+    setComponents_gameObject(allGameObjects[j], &env->components, j);
+}
+
+/*
+Finds the first index of a type's group. Runs in O(log n) time.
+
+Arguments
+    gameEnvironment* env: The gameEnvironment to search
+
+    size_t end: Only indices before end are searched. They must be grouped by type in ascending order.
+
+    uint16_t type: The type of the group
+
+Returns
+    Returns the first index before end whose type is not less than type, or end if there is none
+*/
+size_t _groupStart_gameEnvironment(gameEnvironment* env, size_t end, uint16_t type)
+{
+    const uint16_t* types = env->components.types;
+
+    size_t low = 0;
+    size_t high = end;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (types[middle] < type)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/*
+Finds the index just past a type's group. Runs in O(log n) time.
+
+Arguments
+    gameEnvironment* env: The gameEnvironment to search
+
+    size_t start: Only indices from start on are searched. They must be grouped by type in ascending order.
+
+    uint16_t type: The type of the group
+
+Returns
+    Returns the first index from start on whose type is greater than type, or the gameObject count if there is none
+*/
+size_t _groupEnd_gameEnvironment(gameEnvironment* env, size_t start, uint16_t type)
+{
+    const uint16_t* types = env->components.types;
+
+    size_t low = start;
+    size_t high = env->components.count;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (types[middle] <= type)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
 /*
 Adds all queued gameObjects to the main game object table.
 
@@ -102,16 +347,52 @@ Arguments
 void _addGameObjects_gameEnvironment(gameEnvironment* env)
 {
     // Get all queued gameObjects
-    size_t gameObjectQueueCount = getCount_hashtable(env->gameObjectQueue);
-    gameObject** gameObjectQueue = (gameObject**) getAll_hashtable(env->gameObjectQueue);
+    size_t gameObjectQueueCount;
+    gameObject** gameObjectQueue = _getAll_gameEnvironment(env, env->gameObjectQueue, &gameObjectQueueCount);
 
-    // Add the queued gameObjects to the main gameObject hashtable
+    // Add the queued gameObjects to the main gameObject slotmap
     for (size_t i = 0; i < gameObjectQueueCount; i++)
     {
-        set_hashtable(env->gameObjects, gameObjectQueue[i], gameObjectQueue[i]);
-    }
+        gameObject* g = gameObjectQueue[i];
+
+        // Skip gameObjects that were already added
+        if (get_slotmap(env->gameObjects, getHandle_gameObject(g)) == g)
+        {
+            continue;
+        }
 
-    free(gameObjectQueue);
+        handle h = insert_slotmap(env->gameObjects, g);
+        if (h == INVALID_HANDLE)
+        {
+            continue;
+        }
+
+        // The components are pushed in the same order, so they share the slotmap's dense index
+        if (!push_components(&env->components, g))
+        {
+            remove_slotmap(env->gameObjects, h, NULL);
+            continue;
+        }
+
+        setHandle_gameObject(g, h);
+
+        // Static renders that can't be batched are drawn every frame instead, see setGameObject_components()
+        if (isStatic_gameObject(g) && isBatched_render(getRender_gameObject(g)))
+        {
+            add_staticBatches(env->staticBatches, getRender_gameObject(g));
+        }
+
+        // Move the new gameObject into its type's group by swapping it with the first
+        // gameObject of every group with a greater type
+        const uint16_t* types = env->components.types;
+        size_t index = env->components.count - 1;
+        while (index > 0 && types[index - 1] > types[index])
+        {
+            size_t start = _groupStart_gameEnvironment(env, index, types[index - 1]);
+            _swap_gameEnvironment(env, start, index);
+            index = start;
+        }
+    }
 
     // Clear the gameObject queue
     clear_hashtable(env->gameObjectQueue);
@@ -126,17 +407,46 @@ Arguments
 void _removeGameObjects_gameEnvironment(gameEnvironment* env)
 {
     // Get all queued gameObjects
-    size_t gameObjectToRemoveCount = getCount_hashtable(env->gameObjectsToRemove);
-    gameObject** gameObjectToRemove = (gameObject**) getAll_hashtable(env->gameObjectsToRemove);
+    size_t gameObjectToRemoveCount;
+    gameObject** gameObjectToRemove = _getAll_gameEnvironment(env, env->gameObjectsToRemove, &gameObjectToRemoveCount);
 
-    // Add the queued gameObjects to the main gameObject hashtable
+    // Remove the queued gameObjects from the main gameObject slotmap
     for (size_t i = 0; i < gameObjectToRemoveCount; i++)
     {
-        remove_hashtable(env->gameObjects, gameObjectToRemove[i]);
-        env->events.onRemoveGameObject(env, gameObjectToRemove[i]);
-    }
+        gameObject* g = gameObjectToRemove[i];
+
+        handle h = getHandle_gameObject(g);
+
+        size_t index;
+        if (!getIndex_slotmap(env->gameObjects, h, &index))
+        {
+            continue;
+        }
+
+        // Move the gameObject to the end without breaking up the type groups, by swapping it
+        // with the last gameObject of every group after it. Removing the last gameObject moves nothing.
+        const uint16_t* types = env->components.types;
+        size_t last = env->components.count - 1;
+        while (index < last)
+        {
+            size_t end = _groupEnd_gameEnvironment(env, index + 1, types[index + 1]) - 1;
+            _swap_gameEnvironment(env, index, end);
+            index = end;
+        }
 
-    free(gameObjectToRemove);
+        if (isStatic_gameObject(g) && getRender_gameObject(g))
+        {
+            remove_staticBatches(env->staticBatches, getRender_gameObject(g));
+        }
+
+        remove_slotmap(env->gameObjects, h, NULL);
+        swapRemove_components(&env->components, index);
+        setComponents_gameObject(g, NULL, 0);
+
+        // The handle is now stale, so make sure it's never used again
+        setHandle_gameObject(g, INVALID_HANDLE);
+        env->events.onRemoveGameObject(env, g);
+    }
 
     clear_hashtable(env->gameObjectsToRemove);
 }
@@ -154,12 +464,92 @@ gameObject* removeGameObject_gameEnvironment(gameEnvironment* env, gameObject* g
 }
 
 /*
-Calls onUpdate for each gameObject
+Finds the update handler set for a type
+
+Arguments
+    gameEnvironment* env: The gameEnvironment to search
+
+    uint16_t type: The type to find the update handler of
+
+    size_t* outIndex: The index of the handler in env->updateHandlers, or the index the handler
+        would be inserted at if it is not set
+
+Returns
+    Returns true if an update handler is set for the type
+*/
+bool _findUpdateHandler_gameEnvironment(gameEnvironment* env, uint16_t type, size_t* outIndex)
+{
+    size_t low = 0;
+    size_t high = env->updateHandlerCount;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (env->updateHandlers[middle].type < type)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    *outIndex = low;
+
+    return low < env->updateHandlerCount && env->updateHandlers[low].type == type;
+}
+
+bool setUpdateHandler_gameEnvironment(gameEnvironment* env, uint16_t type, onUpdateTypeHandler handler)
+{
+    if (!env)
+    {
+        return false;
+    }
+
+    size_t index;
+    if (_findUpdateHandler_gameEnvironment(env, type, &index))
+    {
+        if (handler)
+        {
+            env->updateHandlers[index].handler = handler;
+            return true;
+        }
+
+        // Unset the handler
+        env->updateHandlerCount--;
+        memmove(&env->updateHandlers[index], &env->updateHandlers[index + 1], sizeof(typeUpdateHandler) * (env->updateHandlerCount - index));
+
+        return true;
+    }
+
+    if (!handler)
+    {
+        return true;
+    }
+
+    typeUpdateHandler* updateHandlers = realloc(env->updateHandlers, sizeof(typeUpdateHandler) * (env->updateHandlerCount + 1));
+    if (!updateHandlers)
+    {
+        return false;
+    }
+    env->updateHandlers = updateHandlers;
+
+    memmove(&env->updateHandlers[index + 1], &env->updateHandlers[index], sizeof(typeUpdateHandler) * (env->updateHandlerCount - index));
+    env->updateHandlers[index].type = type;
+    env->updateHandlers[index].handler = handler;
+    env->updateHandlerCount++;
+
+    return true;
+}
+
+/*
+Updates each group of gameObjects with the same type. Groups with an update handler are passed to
+the handler all at once, every other gameObject is passed to onUpdate one at a time.
 
 Arguments
     gameEnvironment* env: TODO
 
-    gameObject** allGameObjects: The game objects to update
+    gameObject** allGameObjects: The game objects to update, grouped by type
 
     size_t gameObjectsCount: The size of allGameObjects
 */
@@ -168,10 +558,28 @@ void _updateGameObjects_env(gameEnvironment* env, gameObject** allGameObjects, s
     // printf("_updateGameObjects_env()\n");
 
     onUpdateHandler onUpdate = env->events.onUpdate;
+    const uint16_t* types = env->components.types;
 
-    for (size_t i = 0; i < gameObjectsCount; i++)
+    size_t first = 0;
+    while (first < gameObjectsCount)
     {
-        onUpdate(env, allGameObjects[i]);
+        uint16_t type = types[first];
+        size_t end = _groupEnd_gameEnvironment(env, first, type);
+
+        size_t index;
+        if (_findUpdateHandler_gameEnvironment(env, type, &index))
+        {
+            env->updateHandlers[index].handler(env, &allGameObjects[first], first, end - first);
+        }
+        else if (onUpdate)
+        {
+            for (size_t i = first; i < end; i++)
+            {
+                onUpdate(env, allGameObjects[i]);
+            }
+        }
+
+        first = end;
     }
 }
 
@@ -196,12 +604,18 @@ void _detectCollisions_env(gameEnvironment* env, gameObject** allGameObjects, si
         return;
     }
 
+    // The broadphase only streams through positions and radii, gameObjects and colliders
+    // are only visited for pairs whose bounding circles overlap
+    const vec2f* positions = env->components.positions;
+    const float* radii = env->components.radii;
+    const uint16_t* types = env->components.types;
+    collider* const* colliders = env->components.colliders;
+
     // Detect collision between each gameobject exactly once
     for (size_t i = 0; i < gameObjectsCount - 1; i++)
     {
-        gameObject* g1 = allGameObjects[i];
-        collider* c1 = getCollider_gameObject(g1);
-        if (!c1)
+        // gameObjects without a collider have a radius of 0
+        if (radii[i] <= 0.0f)
         {
             continue;
         }
@@ -209,29 +623,92 @@ void _detectCollisions_env(gameEnvironment* env, gameObject** allGameObjects, si
         // Start at the next index so that we don't check any gameObjects for collisons twice
         for (size_t j = i + 1; j < gameObjectsCount; j++)
         {
-            gameObject* g2 = allGameObjects[j];
-            collider* c2 = getCollider_gameObject(g2);
-            if (!c2)
+            if (radii[j] <= 0.0f)
+            {
+                continue;
+            }
+
+            float reach = radii[i] + radii[j];
+            if (distanceSqrd_vec2f(positions[i], positions[j]) > reach * reach)
             {
                 continue;
             }
 
             // We want to order the collision by type, so the callback arguments are consistent between different runs
-            if (getType_gameObject(g1) > getType_gameObject(g2))
+            size_t first = i;
+            size_t second = j;
+            if (types[first] > types[second])
             {
-                SWAP(g1, g2);
-                SWAP(c1, c2);
+                SWAP(first, second);
             }
 
-            collision c = detectCollision_collider(c1, c2);
+            collision c = detectCollisionInArena_collider(colliders[first], colliders[second], env->frameArena);
             if (c.isColliding)
             {
-                onCollision(env, g1, g2, &c);
+                onCollision(env, allGameObjects[first], allGameObjects[second], &c);
             }
         }
     }
 }
 
+/*
+Draws or records a sorted queue of renders along with the static batches, one layer at a time. The static
+batches of each layer are drawn just before the other renders of that layer, so higher layers are always on top.
+
+Arguments
+    gameEnvironment* env: The gameEnvironment whose static batches are drawn
+
+    const renderQueue* queue: The sorted renders
+
+    renderFrame* frame: The frame to record into, or NULL to draw with the active backend
+*/
+void _renderLayers_env(gameEnvironment* env, const renderQueue* queue, renderFrame* frame)
+{
+    // The first layer whose static batches haven't been drawn yet. Wider than a layer, so it can step past the last one
+    unsigned int nextLayer = 0;
+
+    size_t first = 0;
+    while (first < queue->count)
+    {
+        uint8_t layer = (uint8_t) (queue->commands[first].key >> SORT_KEY_LAYER_SHIFT);
+        size_t end = first + 1;
+        while (end < queue->count && (uint8_t) (queue->commands[end].key >> SORT_KEY_LAYER_SHIFT) == layer)
+        {
+            end++;
+        }
+
+        if (frame)
+        {
+            recordLayers_staticBatches(env->staticBatches, frame, nextLayer, layer);
+            for (size_t i = first; i < end; i++)
+            {
+                push_renderFrame(frame, queue->commands[i].r);
+            }
+        }
+        else
+        {
+            renderLayers_staticBatches(env->staticBatches, nextLayer, layer);
+            renderQueue layerQueue = { &queue->commands[first], end - first, end - first };
+            renderAll_render(&layerQueue, env->frameArena);
+        }
+
+        nextLayer = layer + 1u;
+        first = end;
+    }
+
+    if (nextLayer <= UINT8_MAX)
+    {
+        if (frame)
+        {
+            recordLayers_staticBatches(env->staticBatches, frame, nextLayer, UINT8_MAX);
+        }
+        else
+        {
+            renderLayers_staticBatches(env->staticBatches, nextLayer, UINT8_MAX);
+        }
+    }
+}
+
 /*
 Renders all gameObjects
 
@@ -253,16 +730,72 @@ void _render_env(gameEnvironment* env, gameObject** allGameObjects, size_t gameO
     onRenderStart(env);
     // printf("[TIMER]: render onRenderStart: %llu ms\n", diff_msTimer(&startTime));
 
-    startTime = start_msTimer();
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClearDepthf(1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    // printf("[TIMER]: render clear: %llu ms\n", diff_msTimer(&startTime));
+    // The render thread clears and presents its own frames
+    if (!env->renderThread)
+    {
+        startTime = start_msTimer();
+        get_renderBackend()->clear(0.0f, 0.0f, 0.0f, 1.0f);
+        // printf("[TIMER]: render clear: %llu ms\n", diff_msTimer(&startTime));
+    }
 
     startTime = start_msTimer();
-    for (size_t i = 0; i < gameObjectsCount; i++)
+    // Only renders that overlap the camera's view are drawn
+    vec2f cameraMin;
+    vec2f cameraMax;
+    getBounds_camera(&env->camera, aspect, &cameraMin, &cameraMax);
+
+    // Queue every visible render, then sort the queue so renders that share GL state are drawn together
+    render* const* renders = env->components.renders;
+    renderQueue queue;
+    if (create_renderQueue(&queue, gameObjectsCount, env->frameArena))
+    {
+        for (size_t i = 0; i < gameObjectsCount; i++)
+        {
+            if (!renders[i])
+            {
+                continue;
+            }
+
+            // Textures are kept resident as long as a render uses them, even while it is off screen
+            use_texture(getTextureId_render(renders[i]));
+
+            vec2f renderMin;
+            vec2f renderMax;
+            getBounds_render(renders[i], &renderMin, &renderMax);
+            if (GET_X(renderMax) < GET_X(cameraMin) || GET_X(renderMin) > GET_X(cameraMax) ||
+                GET_Y(renderMax) < GET_Y(cameraMin) || GET_Y(renderMin) > GET_Y(cameraMax))
+            {
+                continue;
+            }
+
+            push_renderQueue(&queue, getSortKey_render(renders[i]), renders[i]);
+        }
+
+        // The camera only moves between frames, so every render shares one view projection matrix
+        MATRIX_TYPE(3, 3) viewProjection = getViewProjection_camera(&env->camera, aspect);
+        sort_renderQueue(&queue, env->frameArena);
+
+        // Static batches are only rebuilt after a static gameObject was added or removed
+        build_staticBatches(env->staticBatches, env->frameArena);
+
+        if (env->renderThread)
+        {
+            // Waits until the frame before last has been drawn
+            renderFrame* frame = beginFrame_renderThread(env->renderThread);
+            setViewProjection_renderFrame(frame, &viewProjection);
+            _renderLayers_env(env, &queue, frame);
+            submit_renderThread(env->renderThread);
+        }
+        else
+        {
+            setViewProjection_render(&viewProjection);
+            _renderLayers_env(env, &queue, NULL);
+        }
+    }
+
+    if (!env->renderThread)
     {
-        render_render(getRender_gameObject(allGameObjects[i]), aspect);
+        get_renderBackend()->present();
     }
     // printf("[TIMER]: render allGameObjects: %llu ms\n", diff_msTimer(&startTime));
 
@@ -280,13 +813,21 @@ void run_gameEnvironment(gameEnvironment* env)
 
     struct timespec startTime = start_msTimer();
 
+    // Everything allocated from the frame arena during the last tick is released here
+    reset_arena(env->frameArena);
+
+    // Atlas pages are evicted by how many steps ago they were last used
+    nextFrame_texture();
+
     // Add then remove gameObjects, so if a gameObject was added and removed in the 
     // same tick, never process it
     _addGameObjects_gameEnvironment(env);
     _removeGameObjects_gameEnvironment(env);
 
-    size_t gameObjectsCount = getCount_hashtable(env->gameObjects);
-    gameObject** allGameObjects = (gameObject**) getAll_hashtable(env->gameObjects);
+    // gameObjects are only added and removed at the start of a step, so the densely packed
+    // slotmap values can be used directly
+    size_t gameObjectsCount = getCount_slotmap(env->gameObjects);
+    gameObject** allGameObjects = (gameObject**) getValues_slotmap(env->gameObjects);
     // printf("[TIMER]: allGameObjects: %llu ms\n", diff_msTimer(&startTime));
 
     startTime = start_msTimer();
@@ -297,11 +838,37 @@ void run_gameEnvironment(gameEnvironment* env)
     _detectCollisions_env(env, allGameObjects, gameObjectsCount);
     // printf("[TIMER]: allGameObjects detect collisions: %llu ms\n", diff_msTimer(&startTime));
 
+    // Requested textures are uploaded a few at a time, so a burst of them doesn't stall a single frame
+    size_t uploadsPerStep = env->settings.textureUploadsPerStep ? env->settings.textureUploadsPerStep : DEFAULT_TEXTURE_UPLOADS_PER_STEP;
+    if (uploadRequested_texture(uploadsPerStep) > 0)
+    {
+        // The static batches hold copies of the texture coordinates, which may have left the placeholder
+        invalidate_staticBatches(env->staticBatches);
+    }
+
     startTime = start_msTimer();
     _render_env(env, allGameObjects, gameObjectsCount, env->settings.aspect);
     // printf("[TIMER]: allGameObjects render: %llu ms\n", diff_msTimer(&startTime));
+}
+
+gameObject* getGameObject_gameEnvironment(gameEnvironment* env, handle h)
+{
+    if (!env)
+    {
+        return NULL;
+    }
+
+    return get_slotmap(env->gameObjects, h);
+}
+
+const components* getComponents_gameEnvironment(gameEnvironment* env)
+{
+    if (!env)
+    {
+        return NULL;
+    }
 
-    free(allGameObjects);
+    return &env->components;
 }
 
 void setUserdata_gameEnvironment(gameEnvironment* env, void* userdata)
@@ -323,3 +890,33 @@ void* getUserdata_gameEnvironment(gameEnvironment* env)
 
     return env->userdata;
 }
+
+camera* getCamera_gameEnvironment(gameEnvironment* env)
+{
+    if (!env)
+    {
+        return NULL;
+    }
+
+    return &env->camera;
+}
+
+void setRenderThread_gameEnvironment(gameEnvironment* env, renderThread* rt)
+{
+    if (!env)
+    {
+        return;
+    }
+
+    env->renderThread = rt;
+}
+
+arena* getFrameArena_gameEnvironment(gameEnvironment* env)
+{
+    if (!env)
+    {
+        return NULL;
+    }
+
+    return env->frameArena;
+}
@@ -2,35 +2,138 @@
 
 #include <stdlib.h>
 
+#include "datastructures/pool.h"
 #include "engine/collision.h"
+#include "engine/components.h"
 #include "engine/math/polygon.h"
 #include "engine/math/vec.h"
 #include "engine/render.h"
 
 struct _gameObject {
     uint16_t type;
+    handle h; // The handle of the gameObject in its gameEnvironment
     void* userdata;
     transform t;
     collider* c;
     render* r;
+    bool isStatic; // The gameObject never moves, so its render is drawn in a static batch
+
+    gameObjectPools* pools; // The pools the gameObject was allocated from, or NULL if it was malloc'd
+
+    components* store; // The gameEnvironment storage that mirrors this gameObject, or NULL if it isn't added
+    size_t index; // The index of the gameObject in store
 };
 
-gameObject* create_gameObject(uint16_t type)
+/*
+Initializes a gameObject that has already been allocated
+
+Arguments
+    gameObject* g: The gameObject to initialize
+
+    gameObjectPools* pools: The pools g was allocated from, or NULL if g was malloc'd
+
+    uint16_t type: See create_gameObject()
+
+Returns
+    Returns g
+*/
+gameObject* _init_gameObject(gameObject* g, gameObjectPools* pools, uint16_t type)
 {
-    gameObject* g = malloc(sizeof(gameObject));
     g->t.position = to_vec2f(0.0f, 0.0f);
     g->t.scale = to_vec2f(1.0f, 1.0f);
     g->t.rotation = 0.0f;
 
     g->c = NULL;
     g->r = NULL;
+    g->isStatic = false;
 
     g->type = type;
+    g->h = INVALID_HANDLE;
     g->userdata = NULL;
 
+    g->pools = pools;
+
+    g->store = NULL;
+    g->index = 0;
+
     return g;
 }
 
+gameObject* create_gameObject(uint16_t type)
+{
+    gameObject* g = malloc(sizeof(gameObject));
+    if (!g)
+    {
+        return NULL;
+    }
+
+    return _init_gameObject(g, NULL, type);
+}
+
+gameObject* createFromPools_gameObject(gameObjectPools* pools, uint16_t type)
+{
+    if (!pools)
+    {
+        return NULL;
+    }
+
+    gameObject* g = alloc_pool(pools->gameObjects);
+    if (!g)
+    {
+        return NULL;
+    }
+
+    return _init_gameObject(g, pools, type);
+}
+
+bool create_gameObjectPools(gameObjectPools* pools, size_t slabCapacity)
+{
+    if (!pools)
+    {
+        return false;
+    }
+
+    pools->gameObjects = create_pool(sizeof(gameObject), slabCapacity);
+    pools->colliders = createPool_collider(slabCapacity);
+    pools->renders = createPool_render(slabCapacity);
+
+    if (!pools->gameObjects || !pools->colliders || !pools->renders)
+    {
+        free_gameObjectPools(pools);
+        return false;
+    }
+
+    return true;
+}
+
+bool isFromPools_gameObject(gameObject* g, gameObjectPools* pools)
+{
+    if (!g || !pools)
+    {
+        return false;
+    }
+
+    return g->pools == pools;
+}
+
+bool free_gameObjectPools(gameObjectPools* pools)
+{
+    if (!pools)
+    {
+        return false;
+    }
+
+    free_pool(pools->gameObjects);
+    free_pool(pools->colliders);
+    free_pool(pools->renders);
+
+    pools->gameObjects = NULL;
+    pools->colliders = NULL;
+    pools->renders = NULL;
+
+    return true;
+}
+
 bool free_gameObject(gameObject* g)
 {
     if (!g)
@@ -39,8 +142,16 @@ bool free_gameObject(gameObject* g)
     }
 
     free_collider(g->c);
+    free_render(g->r);
 
-    free(g);
+    if (g->pools)
+    {
+        release_pool(g->pools->gameObjects, g);
+    }
+    else
+    {
+        free(g);
+    }
 
     return true;
 }
@@ -50,6 +161,41 @@ uint16_t getType_gameObject(gameObject* g)
     return g->type;
 }
 
+handle getHandle_gameObject(gameObject* g)
+{
+    if (!g)
+    {
+        return INVALID_HANDLE;
+    }
+
+    return g->h;
+}
+
+bool setHandle_gameObject(gameObject* g, handle h)
+{
+    if (!g)
+    {
+        return false;
+    }
+
+    g->h = h;
+
+    return true;
+}
+
+bool setComponents_gameObject(gameObject* g, components* store, size_t index)
+{
+    if (!g)
+    {
+        return false;
+    }
+
+    g->store = store;
+    g->index = index;
+
+    return true;
+}
+
 void* getUserdata_gameObject(gameObject* g)
 {
     if (!g)
@@ -86,17 +232,34 @@ bool setTransform_gameObject(gameObject* g, transform t)
 
     g->t = t;
 
+    if (g->store)
+    {
+        setTransform_components(g->store, g->index, t);
+    }
+
     return true;
 }
 
 bool setCollider_gameObject(gameObject* g, polygon* p)
+{
+    return setColliderWithOptions_gameObject(g, p, NULL);
+}
+
+bool setColliderWithOptions_gameObject(gameObject* g, polygon* p, const colliderOptions* options)
 {
     if (!g || !p || g->c)
     {
         return false;
     }
 
-    g->c = create_collider(&g->t, p);
+    g->c = g->pools ?
+        createFromPoolWithOptions_collider(g->pools->colliders, &g->t, p, options) :
+        createWithOptions_collider(&g->t, p, options);
+
+    if (g->store)
+    {
+        setGameObject_components(g->store, g->index, g);
+    }
 
     return g->c != NULL;
 }
@@ -123,12 +286,41 @@ render* getRender_gameObject(gameObject* g)
 
 bool setRender_gameObject(gameObject* g, renderInfo rI)
 {
-    if (!g || g->r)
+    // Static renders only reach the batches as their gameObject is added, see setStatic_gameObject()
+    if (!g || g->r || (g->isStatic && g->store))
     {
         return false;
     }
 
-    g->r = create_render(&g->t, rI);
+    g->r = g->pools ? createFromPool_render(g->pools->renders, &g->t, rI) : create_render(&g->t, rI);
+
+    if (g->store)
+    {
+        setGameObject_components(g->store, g->index, g);
+    }
 
     return g->r != NULL;
 }
+
+bool setStatic_gameObject(gameObject* g, bool isStatic)
+{
+    // The gameEnvironment only sorts gameObjects into static batches as they are added
+    if (!g || g->store)
+    {
+        return false;
+    }
+
+    g->isStatic = isStatic;
+
+    return true;
+}
+
+bool isStatic_gameObject(gameObject* g)
+{
+    if (!g)
+    {
+        return false;
+    }
+
+    return g->isStatic;
+}
@@ -4,6 +4,8 @@
 #include "engine/unit/math/polygon.unit.h"
 #endif
 
+#include <float.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #include "engine/util.h"
@@ -30,6 +32,49 @@ struct _vertexDiagonal
 };
 #endif
 
+// Polygons with at least this many vertices are triangulated by _triangulateMonotone_polygon() instead of ear clipping
+static const int MONOTONE_TRIANGULATION_VERTEX_COUNT = 32;
+
+// Pieces are split at most this many times by _decomposeBayazit_polygon(), after which they are decomposed by
+// decompose_polygon() instead. It keeps the recursion bounded for polygons that float error won't let converge.
+static const int BAYAZIT_MAX_DEPTH = 256;
+
+// The convex pieces found by decomposeMinimum_polygon(), which grows as pieces are found
+typedef struct _pieceList
+{
+    polygon* pieces;
+    int count;
+    int capacity;
+} pieceList;
+
+// A vertex in the order the sweep line of _partitionMonotone_polygon() reaches it
+typedef struct _sweepVertex
+{
+    vec2f vertex;
+    int index;
+} sweepVertex;
+
+// The polygon edges crossing the sweep line of _partitionMonotone_polygon(), as a treap. Every array is
+// indexed by edge, where edge i goes from vertex i to vertex i + 1, and -1 means no edge.
+typedef struct _sweepStatus
+{
+    int* left;
+    int* right;
+    int* parent;
+    int* priority;
+    int* helper; // The lowest vertex above the sweep line that can see the edge to its left
+    int root;
+} sweepStatus;
+
+// One direction of a polygon side or diagonal, see _createHalfEdges_polygon()
+typedef struct _halfEdge
+{
+    int id;
+    int from;
+    int to;
+    vec2f direction;
+} halfEdge;
+
 // see header for documentation
 bool create_polygon(polygon* poly, int vertexCount)
 {
@@ -459,491 +504,1976 @@ vertexDiagonal** _triangulate_polygon(polygon* poly, vertexDiagonal** diagonalPo
 }
 
 /*
-Determines if a given diagonal is essential to decomposing `poly` into convex polygons.
-A diagonal is essential if removed, it would create a reflex vertex.
+Determines whether a vertex is above another for the sweep line of _triangulateMonotone_polygon(). Vertices
+at the same height are ordered left to right, as if the plane were rotated slightly clockwise, so no two
+vertices are ever at the same height.
 
 Runs in O(1) time.
 
 Arguments
-    polygon* poly: The polygon being processed
+    vec2f v1: The vertex to test
 
-    vertexDiagonal* base: The diagonal being tested
+    vec2f v2: The vertex to test against
 
-Preconditions
-    `base` and `base->opposite` are not NULL
+Returns
+    Returns true if v1 is above v2
+*/
+bool _isAbove_polygon(vec2f v1, vec2f v2)
+{
+    return GET_Y(v1) > GET_Y(v2) || (GET_Y(v1) == GET_Y(v2) && GET_X(v1) < GET_X(v2));
+}
+
+/*
+Computes the cross product of (v2 - v1) and (v3 - v1). Unlike linearity_vec2f() there is no tolerance, so the
+sweep line always agrees with itself about which side of an edge a vertex is on.
+
+Runs in O(1) time.
 
 Returns
-    Returns true if the previous, base, and next vertices have appear in clockwise order
+    Returns a positive number if v1, v2 and v3 are in counter clockwise order, a negative number if they are
+    in clockwise order and 0 if they are collinear
 */
-bool _isEssential_vertexDiagonal(polygon* poly, vertexDiagonal* base)
+float _cross_polygon(vec2f v1, vec2f v2, vec2f v3)
 {
-    // Get either the prev's vertexDiagonal endpoint or the prev polygon vertex
-    vec2f prevVertex;
-    if (base->prev)
+    return (GET_X(v2) - GET_X(v1)) * (GET_Y(v3) - GET_Y(v1)) - (GET_X(v3) - GET_X(v1)) * (GET_Y(v2) - GET_Y(v1));
+}
+
+/*
+Orders vertex indices from the top of the polygon down, for qsort()
+*/
+int _compare_sweepVertex(const void* p1, const void* p2)
+{
+    const sweepVertex* v1 = p1;
+    const sweepVertex* v2 = p2;
+
+    if (_isAbove_polygon(v1->vertex, v2->vertex))
     {
-        prevVertex = poly->vertices[base->prev->opposite->index];
+        return -1;
     }
-    else
+    else if (_isAbove_polygon(v2->vertex, v1->vertex))
     {
-        if (base->index == 0)
-        {
-            prevVertex = poly->vertices[poly->vertexCount - 1];
-        }
-        else
-        {
-            prevVertex = poly->vertices[base->index - 1];
-        }
+        return 1;
     }
 
-    // Get either the next's vertexDiagonal endpoint or the next polygon vertex
-    vec2f nextVertex;
-    if (base->next)
+    // Only duplicate vertices get here, keep the order stable
+    return v1->index - v2->index;
+}
+
+/*
+Rotates an edge of the sweep status above its parent, keeping the edges in order
+
+Runs in O(1) time.
+
+Arguments
+    sweepStatus* status: The sweep status
+
+    int edge: The edge to rotate, which is not the root
+*/
+void _rotate_sweepStatus(sweepStatus* status, int edge)
+{
+    int parent = status->parent[edge];
+    int grandparent = status->parent[parent];
+
+    if (status->left[parent] == edge)
     {
-        nextVertex = poly->vertices[base->next->opposite->index];
+        status->left[parent] = status->right[edge];
+        if (status->right[edge] >= 0)
+        {
+            status->parent[status->right[edge]] = parent;
+        }
+        status->right[edge] = parent;
     }
     else
     {
-        if (base->index == poly->vertexCount - 1)
-        {
-            nextVertex = poly->vertices[0];
-        }
-        else
+        status->right[parent] = status->left[edge];
+        if (status->left[edge] >= 0)
         {
-            nextVertex = poly->vertices[base->index + 1];
+            status->parent[status->left[edge]] = parent;
         }
+        status->left[edge] = parent;
     }
 
-    vec2f baseVertex = poly->vertices[base->index];
+    status->parent[parent] = edge;
+    status->parent[edge] = grandparent;
 
-    // Would removing this diagonal create a reflex vertex?
-    if (linearity_vec2f(prevVertex, baseVertex, nextVertex) == LINEARITY_CLOCKWISE)
+    if (grandparent < 0)
     {
-        return true;
+        status->root = edge;
+    }
+    else if (status->left[grandparent] == parent)
+    {
+        status->left[grandparent] = edge;
     }
     else
     {
-        return false;
+        status->right[grandparent] = edge;
     }
 }
 
 /*
-Determines if both sides of a diagonal are inessential and can be removed without
-affecting the decomposition of a polygon into convex polygon(s)
+Determines whether a vertex is to the right of an edge in the sweep status
 
 Runs in O(1) time.
 
 Arguments
-    polygon* poly: The polygon being processed
+    polygon* poly: The polygon being swept
 
-    vertexDiagonal* base: The diagonal being tested
+    int edge: The edge from poly->vertices[edge] down to the next vertex
 
-Preconditions
-    `base` is not NULL
+    vec2f vertex: The vertex to test
 
 Returns
-    Returns true both sides of the diagonal are inessential and removing them
-    would not create a reflex vertex
+    Returns true if the vertex is to the right of the edge
 */
-bool _isInessential_vertexDiagonal(polygon* poly, vertexDiagonal* base)
+bool _isRightOf_sweepStatus(polygon* poly, int edge, vec2f vertex)
 {
-    // If removal of the diagonal would make either side a reflex vertex, then it is essential
-    if (_isEssential_vertexDiagonal(poly, base) ||
-        _isEssential_vertexDiagonal(poly, base->opposite))
+    vec2f upper = poly->vertices[edge];
+    vec2f lower = poly->vertices[(edge + 1) % poly->vertexCount];
+
+    // The edge points down, so its right side is clockwise from it
+    return _cross_polygon(upper, lower, vertex) > 0.0f;
+}
+
+/*
+Inserts an edge into the sweep status. The sweep status only holds edges with the polygon's interior to their
+right, ordered left to right where they cross the sweep line. It is a treap, so every operation is O(log n)
+on average.
+
+Arguments
+    sweepStatus* status: The sweep status
+
+    polygon* poly: The polygon being swept
+
+    int edge: The edge from poly->vertices[edge] down to the next vertex
+*/
+void _insert_sweepStatus(sweepStatus* status, polygon* poly, int edge)
+{
+    status->left[edge] = -1;
+    status->right[edge] = -1;
+    status->parent[edge] = -1;
+
+    // Edges in the sweep status never cross, so the new edge is ordered by its upper vertex
+    vec2f vertex = poly->vertices[edge];
+    int parent = -1;
+    for (int it = status->root; it >= 0; it = _isRightOf_sweepStatus(poly, it, vertex) ? status->right[it] : status->left[it])
     {
-        return false;
+        parent = it;
+    }
+
+    status->parent[edge] = parent;
+    if (parent < 0)
+    {
+        status->root = edge;
+    }
+    else if (_isRightOf_sweepStatus(poly, parent, vertex))
+    {
+        status->right[parent] = edge;
     }
     else
     {
-        return true;
+        status->left[parent] = edge;
+    }
+
+    while (status->parent[edge] >= 0 && status->priority[edge] > status->priority[status->parent[edge]])
+    {
+        _rotate_sweepStatus(status, edge);
     }
 }
 
 /*
-Removes a diagonal by unlinking it from surrounding diagonals.
-
-Runs in O(1) time.
+Removes an edge from the sweep status
 
 Arguments
-    vertexDiagonal** diagonals: An array of vertexDiagonal*'s where diagonal at the given
-        index is the "center"
+    sweepStatus* status: The sweep status
 
-    vertexDiagonal* toRemove: The vertexDiagonal* to remove
+    int edge: An edge in the sweep status
 */
-void _removeDiagonal_vertexDiagonal(vertexDiagonal** diagonals, vertexDiagonal* toRemove)
+void _remove_sweepStatus(sweepStatus* status, int edge)
 {
-    // Unlink toRemove from the prev and next vertexDiagonal's
-    if (toRemove->prev)
+    // Rotate the edge down until it is a leaf
+    while (status->left[edge] >= 0 || status->right[edge] >= 0)
     {
-        toRemove->prev->next = toRemove->next;
+        int left = status->left[edge];
+        int right = status->right[edge];
+        int child = right < 0 || (left >= 0 && status->priority[left] > status->priority[right]) ? left : right;
+
+        _rotate_sweepStatus(status, child);
     }
 
-    if (toRemove->next)
+    int parent = status->parent[edge];
+    if (parent < 0)
     {
-        toRemove->next->prev = toRemove->prev;
+        status->root = -1;
     }
+    else if (status->left[parent] == edge)
+    {
+        status->left[parent] = -1;
+    }
+    else
+    {
+        status->right[parent] = -1;
+    }
+}
 
-    if (toRemove == diagonals[toRemove->index])
+/*
+Finds the edge of the sweep status that is directly left of a vertex
+
+Arguments
+    sweepStatus* status: The sweep status
+
+    polygon* poly: The polygon being swept
+
+    vec2f vertex: The vertex on the sweep line
+
+Returns
+    Returns the edge, or -1 if there is no edge left of the vertex
+*/
+int _findLeft_sweepStatus(sweepStatus* status, polygon* poly, vec2f vertex)
+{
+    int found = -1;
+    int it = status->root;
+    while (it >= 0)
     {
-        if (toRemove->prev)
-        {
-            diagonals[toRemove->index] = toRemove->prev;
-        }
-        else if (toRemove->next)
+        if (_isRightOf_sweepStatus(poly, it, vertex))
         {
-            diagonals[toRemove->index] = toRemove->next;
+            found = it;
+            it = status->right[it];
         }
         else
         {
-            diagonals[toRemove->index] = NULL;
+            it = status->left[it];
         }
     }
+
+    return found;
 }
 
 /*
-Removes all inessential diagonals from the `diagonals` array. An diagonal is removed
-if and only if removing it would not create a reflex vertex.
+Adds a diagonal to a list of diagonals
 
-This function implements the Herman-Mehlhorn algorithm
+Runs in O(1) time.
 
-Runs in O(n) time.
+Arguments
+    int* diagonals: The endpoints of every diagonal, two per diagonal
+
+    int* diagonalCount: The number of diagonals in the list, which is incremented
+
+    int maxDiagonalCount: The capacity of the list
+
+    int v1: One endpoint of the diagonal
+
+    int v2: The other endpoint of the diagonal
+
+Returns
+    Returns false if the list is full, which only happens for a polygon that crosses through itself
+*/
+bool _pushDiagonal_polygon(int* diagonals, int* diagonalCount, int maxDiagonalCount, int v1, int v2)
+{
+    if (*diagonalCount >= maxDiagonalCount)
+    {
+        return false;
+    }
+
+    diagonals[*diagonalCount * 2] = v1;
+    diagonals[*diagonalCount * 2 + 1] = v2;
+    (*diagonalCount)++;
+
+    return true;
+}
+
+/*
+Partitions a counter clockwise polygon into y-monotone pieces with a sweep line from top to bottom. Every
+split and merge vertex, where the polygon stops being monotone, is connected to a vertex above or below it.
+
+Runs in O(n log n) time.
 
 Arguments
-    polygon* poly: The polygon being decomposed into convex polygons
+    polygon* poly: The polygon to partition
 
-    vertexDiagonal** diagonals: An array of vertexDiagonal*'s where diagonal at the given
-        index is the "center"
+    int* diagonals: The endpoints of every diagonal, two per diagonal
+
+    int* diagonalCount: The number of diagonals in the list, which is incremented for every diagonal added
+
+    int maxDiagonalCount: The capacity of the list
 
 Returns
-    Returns the number of essential diagonals left after processing
+    Returns false if memory allocation failed or the diagonals did not fit in the list
 */
-int _removeInessentialDiagonals_vertexDiagonals(polygon* poly, vertexDiagonal** diagonals)
+bool _partitionMonotone_polygon(polygon* poly, int* diagonals, int* diagonalCount, int maxDiagonalCount)
 {
-    int essentialDiagonalCount = 0;
+    int vertexCount = poly->vertexCount;
 
-    // Even though there are 2 loops, this is still O(n) since there are O(n) diagonals
-    for (int baseIndex = 0; baseIndex < poly->vertexCount; baseIndex++)
+    sweepVertex* order = malloc(sizeof(sweepVertex) * vertexCount);
+    int* statusMemory = malloc(sizeof(int) * vertexCount * 5);
+    bool* isMerge = calloc(vertexCount, sizeof(bool));
+    if (!order || !statusMemory || !isMerge)
     {
-        if (!diagonals[baseIndex])
-        {
-            continue;
-        }
+        free(order);
+        free(statusMemory);
+        free(isMerge);
+        return false;
+    }
 
-        // Remove prev inessential diagonals
-        vertexDiagonal* it = diagonals[baseIndex]->prev;
-        vertexDiagonal* toRemove;
-        while (it)
-        {
-            toRemove = it;
-            it = it->prev;
+    sweepStatus status = {
+        &statusMemory[0], // left
+        &statusMemory[vertexCount], // right
+        &statusMemory[vertexCount * 2], // parent
+        &statusMemory[vertexCount * 3], // priority
+        &statusMemory[vertexCount * 4], // helper
+        -1 // root
+    };
+
+    // The treap priorities only need to look random, and seeding them the same way keeps decompositions deterministic
+    uint32_t seed = 2463534242u;
+    for (int i = 0; i < vertexCount; i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        status.priority[i] = (int) (seed >> 1);
 
-            if (_isInessential_vertexDiagonal(poly, toRemove))
-            {
+        order[i].vertex = poly->vertices[i];
+        order[i].index = i;
+    }
 
-                // Remove both sides of the diagonal
-                _removeDiagonal_vertexDiagonal(diagonals, toRemove);
-                _removeDiagonal_vertexDiagonal(diagonals, toRemove->opposite);
-            }
-            else
+    qsort(order, vertexCount, sizeof(sweepVertex), _compare_sweepVertex);
+
+    bool isPartitioned = true;
+    for (int i = 0; isPartitioned && i < vertexCount; i++)
+    {
+        int current = order[i].index;
+        int prev = current == 0 ? vertexCount - 1 : current - 1;
+        int next = (current + 1) % vertexCount;
+
+        vec2f vertex = poly->vertices[current];
+        bool isPrevBelow = _isAbove_polygon(vertex, poly->vertices[prev]);
+        bool isNextBelow = _isAbove_polygon(vertex, poly->vertices[next]);
+        bool isConvex = _cross_polygon(poly->vertices[prev], vertex, poly->vertices[next]) > 0.0f;
+
+        // The edge before the vertex is prev, the edge after it is current. See _isRightOf_sweepStatus()
+        if (isPrevBelow && isNextBelow)
+        {
+            if (!isConvex)
             {
-                essentialDiagonalCount++;
+                // Split vertex, connect it to the lowest vertex above it between the edges around it
+                int left = _findLeft_sweepStatus(&status, poly, vertex);
+                if (left >= 0)
+                {
+                    isPartitioned = _pushDiagonal_polygon(diagonals, diagonalCount, maxDiagonalCount, current, status.helper[left]);
+                    status.helper[left] = current;
+                }
             }
-        }
 
-        // Remove next inessential diagonals
-        it = diagonals[baseIndex]->next;
-        while (it)
+            // Start vertex or split vertex
+            status.helper[current] = current;
+            _insert_sweepStatus(&status, poly, current);
+        }
+        else if (!isPrevBelow && !isNextBelow)
         {
-            toRemove = it;
-            it = it->next;
-
-            if (_isInessential_vertexDiagonal(poly, toRemove))
+            // End vertex or merge vertex
+            if (isMerge[status.helper[prev]])
             {
-
-                // Remove both sides of the diagonal
-                _removeDiagonal_vertexDiagonal(diagonals, toRemove);
-                _removeDiagonal_vertexDiagonal(diagonals, toRemove->opposite);
+                isPartitioned = _pushDiagonal_polygon(diagonals, diagonalCount, maxDiagonalCount, current, status.helper[prev]);
             }
-            else
+            _remove_sweepStatus(&status, prev);
+
+            if (!isConvex)
             {
-                essentialDiagonalCount++;
+                // Merge vertex, it is connected to the highest vertex below it later on
+                isMerge[current] = true;
+
+                int left = _findLeft_sweepStatus(&status, poly, vertex);
+                if (left >= 0)
+                {
+                    if (isMerge[status.helper[left]])
+                    {
+                        isPartitioned = isPartitioned &&
+                            _pushDiagonal_polygon(diagonals, diagonalCount, maxDiagonalCount, current, status.helper[left]);
+                    }
+                    status.helper[left] = current;
+                }
             }
         }
-
-        // Remove and reassign the center;
-        toRemove = diagonals[baseIndex];
-        if (_isInessential_vertexDiagonal(poly, toRemove))
+        else if (isNextBelow)
         {
+            // Regular vertex on the left side, with the interior to its right
+            if (isMerge[status.helper[prev]])
+            {
+                isPartitioned = _pushDiagonal_polygon(diagonals, diagonalCount, maxDiagonalCount, current, status.helper[prev]);
+            }
+            _remove_sweepStatus(&status, prev);
 
-            // Remove both sides of the diagonal
-            _removeDiagonal_vertexDiagonal(diagonals, toRemove);
-            _removeDiagonal_vertexDiagonal(diagonals, toRemove->opposite);
+            status.helper[current] = current;
+            _insert_sweepStatus(&status, poly, current);
         }
         else
         {
-            essentialDiagonalCount++;
+            // Regular vertex on the right side
+            int left = _findLeft_sweepStatus(&status, poly, vertex);
+            if (left >= 0)
+            {
+                if (isMerge[status.helper[left]])
+                {
+                    isPartitioned = _pushDiagonal_polygon(diagonals, diagonalCount, maxDiagonalCount, current, status.helper[left]);
+                }
+                status.helper[left] = current;
+            }
         }
     }
 
-    return essentialDiagonalCount / 2; // We count each end of the diagonal once, so half to return the total number of essential diagonals
+    free(order);
+    free(statusMemory);
+    free(isMerge);
+
+    return isPartitioned;
 }
 
 /*
-Generates a polygon for a given starting diagonal and stores in in polyPool.
-
-Any additional diagonals encountered while processing will kickoff new polygon generation
+Orders half edges by the vertex they leave, then counter clockwise by their direction starting from +x, for qsort()
+*/
+int _compare_halfEdge(const void* p1, const void* p2)
+{
+    const halfEdge* e1 = p1;
+    const halfEdge* e2 = p2;
 
-Arguments
-    polygon* inPoly: The polygon to generate a convex polygon from
+    if (e1->from != e2->from)
+    {
+        return e1->from - e2->from;
+    }
 
-    vertexDiagonals** diagonals: An array of essential diagonals that are used
-        to generate the convex polygons
+    // Directions in [0, pi) come before directions in [pi, 2pi)
+    vec2f d1 = e1->direction;
+    vec2f d2 = e2->direction;
+    bool isLower1 = GET_Y(d1) < 0.0f || (GET_Y(d1) == 0.0f && GET_X(d1) < 0.0f);
+    bool isLower2 = GET_Y(d2) < 0.0f || (GET_Y(d2) == 0.0f && GET_X(d2) < 0.0f);
+    if (isLower1 != isLower2)
+    {
+        return isLower1 ? 1 : -1;
+    }
 
-    vertexDiagonal* start: The diagonal to start from when generating a new convex polygon.
-        Passing NULL here will start at index 0, which may or may not have a starting diagonal.
+    float cross = GET_X(d1) * GET_Y(d2) - GET_Y(d1) * GET_X(d2);
+    if (cross > 0.0f)
+    {
+        return -1;
+    }
+    else if (cross < 0.0f)
+    {
+        return 1;
+    }
 
-    int* vertexAccumulator: Memory given to this function to temporarily store vertex indices.
-        This total length of this memory should equal the number of polygon vertices + the number of essential diagonals * 2
+    return e1->id - e2->id;
+}
 
-    polygon*** currentPoly: A pointer to a pool of polygon pointers
+/*
+Builds the planar graph of a polygon's sides and diagonals as half edges. Half edge 2i leaves vertex i for
+vertex i + 1 along the polygon, and 2i + 1 is its twin. Half edges 2n + 2j and 2n + 2j + 1 are the two
+directions of diagonal j.
 
-Preconditions
-    When calling this function with `start` == NULL, currentPoly should be a reference to allocated memory with size of
-    `essentialDiagonalCount + 1`
+Runs in O(n log n) time.
+
+Arguments
+    polygon* poly: The polygon
+
+    int* diagonals: The endpoints of every diagonal, two per diagonal
+
+    int diagonalCount: The number of diagonals
+
+    int** outPositions: The index in the returned array of every half edge, by id. Must be freed.
+
+    int** outFirst: The index in the returned array of the first half edge leaving every vertex. Has a length
+        of poly->vertexCount + 1, so the half edges leaving vertex v are outFirst[v] up to outFirst[v + 1].
+        Must be freed.
 
 Returns
-    Returns false only if memory allocation fails
+    Returns the half edges leaving every vertex, ordered counter clockwise around it, or NULL if memory
+    allocation failed. Must be freed.
 */
-bool _generateConvexPolygon_vertexDiagonals(polygon* inPoly, vertexDiagonal** diagonals, vertexDiagonal* start, int endIndex, int* vertexAccumulator, polygon** currentPoly)
+halfEdge* _createHalfEdges_polygon(polygon* poly, int* diagonals, int diagonalCount, int** outPositions, int** outFirst)
 {
-    // printf("\n    _generateConvexPolygon_vertexDiagonals(), endIndex: %d\n", endIndex);
+    int vertexCount = poly->vertexCount;
+    int edgeCount = (vertexCount + diagonalCount) * 2;
 
-    // This will contain the newly created convex polygon for this initial diagonal
-    polygon* outPoly = *currentPoly;
-    (*currentPoly)++;
+    halfEdge* edges = malloc(sizeof(halfEdge) * edgeCount);
+    *outPositions = malloc(sizeof(int) * edgeCount);
+    *outFirst = calloc(vertexCount + 1, sizeof(int));
+    if (!edges || !*outPositions || !*outFirst)
+    {
+        free(edges);
+        free(*outPositions);
+        free(*outFirst);
+        return NULL;
+    }
 
-    int accumulatorIndex = 0;
+    for (int i = 0; i < vertexCount + diagonalCount; i++)
+    {
+        int v1 = i < vertexCount ? i : diagonals[(i - vertexCount) * 2];
+        int v2 = i < vertexCount ? (i + 1) % vertexCount : diagonals[(i - vertexCount) * 2 + 1];
 
-    // We need both the currentIndex and currentDiagonal because not every vertex has a diagonal
-    int currentIndex = start->index;
-    vertexDiagonal* currentDiagonal = NULL;
+        edges[i * 2] = (halfEdge) { i * 2, v1, v2, sub_vec2f(poly->vertices[v2], poly->vertices[v1]) };
+        edges[i * 2 + 1] = (halfEdge) { i * 2 + 1, v2, v1, sub_vec2f(poly->vertices[v1], poly->vertices[v2]) };
+    }
 
-    if (start->opposite) // Is this a real vertexDiagonal?
+    qsort(edges, edgeCount, sizeof(halfEdge), _compare_halfEdge);
+
+    for (int i = 0; i < edgeCount; i++)
     {
-        currentDiagonal = start;
+        (*outPositions)[edges[i].id] = i;
+        (*outFirst)[edges[i].from + 1]++;
+    }
+
+    for (int i = 0; i < vertexCount; i++)
+    {
+        (*outFirst)[i + 1] += (*outFirst)[i];
+    }
+
+    return edges;
+}
+
+/*
+Triangulates a y-monotone piece of a polygon by sweeping it from top to bottom and connecting every vertex to
+the vertices above it that it can see.
+
+Runs in O(k) time, where k is the number of vertices of the piece.
+
+Arguments
+    polygon* poly: The polygon the piece is part of
+
+    int* piece: The indices of the piece's vertices, in counter clockwise order
+
+    int pieceCount: The number of vertices of the piece
+
+    int* sorted: Memory for the piece's vertices in sweep order, with room for pieceCount indices
+
+    bool* isLeft: Memory for which side of the piece each vertex is on, with room for pieceCount values
+
+    int* stack: Memory for the sweep, with room for pieceCount indices
+
+    int* diagonals: The endpoints of every diagonal, two per diagonal
+
+    int* diagonalCount: The number of diagonals in the list, which is incremented for every diagonal added
+
+    int maxDiagonalCount: The capacity of the list
+
+Returns
+    Returns false if the diagonals did not fit in the list
+*/
+bool _triangulateMonotonePiece_polygon(polygon* poly, int* piece, int pieceCount, int* sorted, bool* isLeft, int* stack, int* diagonals, int* diagonalCount, int maxDiagonalCount)
+{
+    if (pieceCount <= 3)
+    {
+        return true;
     }
-    else if (currentIndex == 0)
+
+    int top = 0;
+    int bottom = 0;
+    for (int i = 1; i < pieceCount; i++)
     {
-        currentDiagonal = diagonals[currentIndex];
-        while (currentDiagonal && currentDiagonal->prev)
+        if (_isAbove_polygon(poly->vertices[piece[i]], poly->vertices[piece[top]]))
+        {
+            top = i;
+        }
+
+        if (_isAbove_polygon(poly->vertices[piece[bottom]], poly->vertices[piece[i]]))
         {
-            currentDiagonal = currentDiagonal->prev;
+            bottom = i;
         }
-        endIndex = inPoly->vertexCount - 1;
     }
 
-    // Follow the polygon vertices and diagonals counter clockwise
-    while (currentIndex != endIndex)
+    // Counter clockwise from the top is down the left side, clockwise is down the right side. Merge them.
+    int left = (top + 1) % pieceCount;
+    int right = (top + pieceCount - 1) % pieceCount;
+    sorted[0] = piece[top];
+    isLeft[0] = true;
+    for (int i = 1; i < pieceCount - 1; i++)
     {
-        // printf("        (%p) currentIndex: %d\n", outPoly, currentIndex);
-        // if (currentDiagonal)
-        // {
-        //     printf("        (%p) currentDiagonal: opposite: %d\n", outPoly, currentDiagonal->opposite->index);
-        // }
-        // else
-        // {
-        //     printf("        (%p) currentDiagonal: NULL\n", outPoly);
-        // }
-        // printf("        (%p) accumulatorIndex: %d\n\n", outPoly, accumulatorIndex);
+        if (right == bottom || (left != bottom && _isAbove_polygon(poly->vertices[piece[left]], poly->vertices[piece[right]])))
+        {
+            sorted[i] = piece[left];
+            isLeft[i] = true;
+            left = (left + 1) % pieceCount;
+        }
+        else
+        {
+            sorted[i] = piece[right];
+            isLeft[i] = false;
+            right = (right + pieceCount - 1) % pieceCount;
+        }
+    }
+    sorted[pieceCount - 1] = piece[bottom];
 
-        // Save the index of our vertice we want to assign to the generated polygon later
-        vertexAccumulator[accumulatorIndex++] = currentIndex;
+    // The stack holds positions in sorted, so the side of each vertex is known
+    int stackCount = 0;
+    stack[stackCount++] = 0;
+    stack[stackCount++] = 1;
 
-        // Are we tranversing a diagonal?
-        if (currentDiagonal)
+    for (int i = 2; i < pieceCount - 1; i++)
+    {
+        int vertex = sorted[i];
+        if (isLeft[i] != isLeft[stack[stackCount - 1]])
         {
-            // Do we generate a new polygon following the next vertexDiagonal?
-            if (currentDiagonal->next)
-            {
-                vertexDiagonal* start = currentDiagonal->next;
-                int endIndex = currentDiagonal->opposite->index;
-                if (!_generateConvexPolygon_vertexDiagonals(inPoly, diagonals, start, endIndex, &vertexAccumulator[accumulatorIndex + 1], currentPoly))
-                {
-                    return false;
-                }
-            }
-            // Or do we generate a new polygon following the polygon vertices?
-            else
+            // On the other side from the stack, so it can see every vertex on it
+            int last = stack[stackCount - 1];
+            while (stackCount > 0)
             {
-                vertexDiagonal start = {currentDiagonal->index, NULL, NULL, NULL};
-                int endIndex = currentDiagonal->opposite->index;
-                if (!_generateConvexPolygon_vertexDiagonals(inPoly, diagonals, &start, endIndex, &vertexAccumulator[accumulatorIndex + 1], currentPoly))
+                int popped = stack[--stackCount];
+                if (stackCount > 0 && !_pushDiagonal_polygon(diagonals, diagonalCount, maxDiagonalCount, vertex, sorted[popped]))
                 {
                     return false;
                 }
             }
 
-            // Follow the diagonal and save the opposite index here, otherwise we will jump back and forth
-            currentDiagonal = currentDiagonal->opposite;
-
-            // Follow the polygon path counter clockwise
-            currentIndex = currentDiagonal->index;
-            currentDiagonal = currentDiagonal->next;
+            stack[stackCount++] = last;
+            stack[stackCount++] = i;
         }
-        // Nope, we are rotating ccw through the polygon vertices
         else
         {
-            currentIndex = (currentIndex + 1) % inPoly->vertexCount;
-
-            // If there are diagonals at the current index, find the left most one
-            currentDiagonal = diagonals[currentIndex];
-            while (currentDiagonal && currentDiagonal->prev)
+            // On the same side, so it can only see the vertices above it until the side turns away from it
+            int last = stack[--stackCount];
+            while (stackCount > 0)
             {
-                currentDiagonal = currentDiagonal->prev;
-            }
-        }
-    }
+                float cross = _cross_polygon(poly->vertices[vertex], poly->vertices[sorted[last]], poly->vertices[sorted[stack[stackCount - 1]]]);
+                if (isLeft[i] ? cross >= 0.0f : cross <= 0.0f)
+                {
+                    break;
+                }
 
-    // Save the last vertex to complete the polygon
-    vertexAccumulator[accumulatorIndex++] = endIndex;
+                last = stack[--stackCount];
+                if (!_pushDiagonal_polygon(diagonals, diagonalCount, maxDiagonalCount, vertex, sorted[last]))
+                {
+                    return false;
+                }
+            }
 
-    // Allocate the newly created convex polygon
-    if (!create_polygon(outPoly, accumulatorIndex))
-    {
-        return false;
+            stack[stackCount++] = last;
+            stack[stackCount++] = i;
+        }
     }
 
-    // Assign the vertices
-    for (int i = 0; i < accumulatorIndex; i++)
+    // The bottom can see every vertex left on the stack, apart from the ones it shares a side with
+    for (int i = 1; i < stackCount - 1; i++)
     {
-        outPoly->vertices[i] = inPoly->vertices[vertexAccumulator[i]];
+        if (!_pushDiagonal_polygon(diagonals, diagonalCount, maxDiagonalCount, sorted[pieceCount - 1], sorted[stack[i]]))
+        {
+            return false;
+        }
     }
 
-    // printf("\n    (%p) done\n", outPoly);
-
     return true;
 }
 
 /*
-Generates convex polygons from a source polygon and eseential diagonals.
+Links the diagonals of a triangulation into vertexDiagonals. The diagonals around each vertex are ordered from
+the previous polygon vertex's side to the next polygon vertex's side, like the ones _triangulate_polygon() adds.
+
+Runs in O(n log n) time.
 
 Arguments
-    polygon* poly: The source polygon to generate convex polygon's from
+    polygon* poly: The triangulated polygon
 
-    vertexDiagonal** diagonals: An array of diagonals essential creating convex polygons
+    int* diagonals: The endpoints of every diagonal, two per diagonal
 
-    int essentialDiagonalCount: A number >= 0 that represents the number of essential diagonals
-        in `diagonals`. This value is used only to optimize the amount of memory allocated.
+    int diagonalCount: The number of diagonals
+
+    vertexDiagonal** diagonalPool: See _triangulate_polygon()
 
 Returns
-    An array of convex polygons with length of essentialDiagonal + 1. The array returned
-    is dynamically allocated memory and must be freed.
+    See _triangulate_polygon()
 */
-polygon* _generateConvexPolygons_vertexDiagonals(polygon* poly, vertexDiagonal** diagonals, int essentialDiagonalCount)
+vertexDiagonal** _link_vertexDiagonals(polygon* poly, int* diagonals, int diagonalCount, vertexDiagonal** diagonalPool)
 {
-    int* vertexAccumulator = calloc(poly->vertexCount + essentialDiagonalCount * 2, sizeof(int));
-    if (!vertexAccumulator)
+    int vertexCount = poly->vertexCount;
+
+    int* positions;
+    int* first;
+    halfEdge* edges = _createHalfEdges_polygon(poly, diagonals, diagonalCount, &positions, &first);
+    if (!edges)
     {
         return NULL;
     }
 
-    int convexPolygonCount = essentialDiagonalCount + 1;
-    polygon* convexPolygons = calloc(convexPolygonCount, sizeof(polygon));
-    if (!convexPolygons)
+    vertexDiagonal** centers = calloc(sizeof(vertexDiagonal*), vertexCount);
+    *diagonalPool = calloc(sizeof(vertexDiagonal), diagonalCount * 2 + 1);
+    if (!centers || !*diagonalPool)
     {
-        free(vertexAccumulator);
+        free(edges);
+        free(positions);
+        free(first);
+        free(centers);
+        free(*diagonalPool);
         return NULL;
     }
 
-    polygon* currentDiagonal = convexPolygons;
-    vertexDiagonal start = {0, NULL, NULL, NULL};
-    if (!_generateConvexPolygon_vertexDiagonals(poly, diagonals, &start, poly->vertexCount - 1, vertexAccumulator, &currentDiagonal))
+    for (int i = 0; i < diagonalCount * 2; i++)
     {
-        for (int i = 0; i < convexPolygonCount; i++)
+        (*diagonalPool)[i].index = diagonals[i];
+        (*diagonalPool)[i].opposite = &(*diagonalPool)[i ^ 1];
+    }
+
+    for (int v = 0; v < vertexCount; v++)
+    {
+        int degree = first[v + 1] - first[v];
+
+        // The interior is counter clockwise from the side to the next vertex, up to the side to the previous vertex
+        int position = positions[v * 2] - first[v];
+        vertexDiagonal* nextSide = NULL;
+        for (int i = 1; i < degree; i++)
         {
-            free_polygon(&convexPolygons[i]);
+            int id = edges[first[v] + (position + i) % degree].id;
+            if (id < vertexCount * 2)
+            {
+                break;
+            }
+
+            vertexDiagonal* diagonal = &(*diagonalPool)[id - vertexCount * 2];
+            _init_vertexDiagonal(diagonal, NULL, nextSide, v);
+            nextSide = diagonal;
         }
 
-        free(convexPolygons);
-        convexPolygons = NULL;
+        centers[v] = nextSide;
     }
 
-    free(vertexAccumulator);
+    free(edges);
+    free(positions);
+    free(first);
 
-    return convexPolygons;
+    return centers;
 }
 
-void print_vertexDiagonals(vertexDiagonal* v)
+/*
+Triagulates a polygon by partitioning it into y-monotone pieces and triangulating each piece. Produces
+the same output as _triangulate_polygon(), though not necessarily the same triangles.
+
+Runs in O(n log n) time.
+
+Arguments
+    polygon* poly: The counter clockwise polygon to triagulate
+
+    vertexDiagonal** diagonalPool: See _triangulate_polygon()
+
+Returns
+    See _triangulate_polygon(). Also returns NULL if the polygon crosses through itself.
+*/
+vertexDiagonal** _triangulateMonotone_polygon(polygon* poly, vertexDiagonal** diagonalPool)
 {
-    if (!v)
-    {
-        return;
-    }
-    printf("vertexDiagonal[%d]: ", v->index);
+    int vertexCount = poly->vertexCount;
+    int maxDiagonalCount = vertexCount - 3;
 
-    while (v->prev)
+    int* diagonals = malloc(sizeof(int) * (maxDiagonalCount * 2 + 1));
+    if (!diagonals)
     {
-        v = v->prev;
+        return NULL;
     }
 
-    while (v)
+    int monotoneDiagonalCount = 0;
+    if (!_partitionMonotone_polygon(poly, diagonals, &monotoneDiagonalCount, maxDiagonalCount))
     {
-        printf(" %d,", v->opposite->index);
-        v = v->next;
+        free(diagonals);
+        return NULL;
     }
 
-    printf("\n");
-}
-
-// see header for documentation
-bool decompose_polygon(polygon* in, polygon** out, int* outCount)
-{
-    if (!in || !in->vertices || !out || !outCount)
+    int* positions;
+    int* first;
+    halfEdge* edges = _createHalfEdges_polygon(poly, diagonals, monotoneDiagonalCount, &positions, &first);
+    if (!edges)
     {
-        return false;
+        free(diagonals);
+        return NULL;
     }
 
-    *out = NULL;
+    // Memory for walking and triangulating the pieces, no piece has more vertices than there are half edges
+    int edgeCount = (vertexCount + monotoneDiagonalCount) * 2;
+    bool* isVisited = calloc(edgeCount, sizeof(bool));
+    int* piece = malloc(sizeof(int) * edgeCount * 3);
+    bool* isLeft = malloc(sizeof(bool) * edgeCount);
 
-    int vertexCount = in->vertexCount;
-    polygon counterClockWisePoly;
-    create_polygon(&counterClockWisePoly, vertexCount);
+    bool isTriangulated = isVisited && piece && isLeft;
 
-    // All of the decomposition functions assume a ccw polygon, so reverse the order of points as necessary
-    if (isClockwise_polygon(in))
+    // The twins of the polygon's sides bound the outside of the polygon
+    for (int i = 0; isTriangulated && i < vertexCount; i++)
     {
-        for (int i = 0; i < vertexCount; i++)
-        {
-            counterClockWisePoly.vertices[i] = in->vertices[vertexCount - 1 - i];
-        }
+        isVisited[positions[i * 2 + 1]] = true;
     }
-    else
+
+    int diagonalCount = monotoneDiagonalCount;
+    for (int start = 0; isTriangulated && start < edgeCount; start++)
     {
-        for (int i = 0; i < vertexCount; i++)
+        if (isVisited[start])
         {
-            counterClockWisePoly.vertices[i] = in->vertices[i];
+            continue;
         }
+
+        // Walk the piece to the left of the half edge, turning as far left as possible at every vertex
+        int pieceCount = 0;
+        int it = start;
+        do
+        {
+            isVisited[it] = true;
+            piece[pieceCount++] = edges[it].from;
+
+            int to = edges[it].to;
+            int degree = first[to + 1] - first[to];
+            int twin = positions[edges[it].id ^ 1] - first[to];
+            it = first[to] + (twin + degree - 1) % degree;
+        } while (it != start && pieceCount < edgeCount);
+
+        isTriangulated = it == start && _triangulateMonotonePiece_polygon(
+            poly, piece, pieceCount, &piece[edgeCount], isLeft, &piece[edgeCount * 2],
+            diagonals, &diagonalCount, maxDiagonalCount);
     }
 
-    vertexDiagonal* diagonalPool;
-    vertexDiagonal** diagonals = _triangulate_polygon(&counterClockWisePoly, &diagonalPool);
-    if (!diagonals)
+    free(edges);
+    free(positions);
+    free(first);
+    free(isVisited);
+    free(piece);
+    free(isLeft);
+
+    vertexDiagonal** centers = NULL;
+    if (isTriangulated && diagonalCount == maxDiagonalCount)
     {
-        return false;
+        centers = _link_vertexDiagonals(poly, diagonals, diagonalCount, diagonalPool);
     }
 
-    int essentialDiagonalCount = _removeInessentialDiagonals_vertexDiagonals(&counterClockWisePoly, diagonals);
-    *outCount = essentialDiagonalCount + 1;
+    free(diagonals);
 
-    // for (int i = 0; i < in->vertexCount; i++)
-    // {
-    //     print_vertexDiagonals(diagonals[i]);
-    // }
+    return centers;
+}
 
-    *out = _generateConvexPolygons_vertexDiagonals(&counterClockWisePoly, diagonals, essentialDiagonalCount);
+/*
+Determines if a given diagonal is essential to decomposing `poly` into convex polygons.
+A diagonal is essential if removed, it would create a reflex vertex.
 
-    free_polygon(&counterClockWisePoly);
-    free(diagonalPool);
-    free(diagonals);
+Runs in O(1) time.
+
+Arguments
+    polygon* poly: The polygon being processed
+
+    vertexDiagonal* base: The diagonal being tested
+
+Preconditions
+    `base` and `base->opposite` are not NULL
+
+Returns
+    Returns true if the previous, base, and next vertices have appear in clockwise order
+*/
+bool _isEssential_vertexDiagonal(polygon* poly, vertexDiagonal* base)
+{
+    // Get either the prev's vertexDiagonal endpoint or the prev polygon vertex
+    vec2f prevVertex;
+    if (base->prev)
+    {
+        prevVertex = poly->vertices[base->prev->opposite->index];
+    }
+    else
+    {
+        if (base->index == 0)
+        {
+            prevVertex = poly->vertices[poly->vertexCount - 1];
+        }
+        else
+        {
+            prevVertex = poly->vertices[base->index - 1];
+        }
+    }
+
+    // Get either the next's vertexDiagonal endpoint or the next polygon vertex
+    vec2f nextVertex;
+    if (base->next)
+    {
+        nextVertex = poly->vertices[base->next->opposite->index];
+    }
+    else
+    {
+        if (base->index == poly->vertexCount - 1)
+        {
+            nextVertex = poly->vertices[0];
+        }
+        else
+        {
+            nextVertex = poly->vertices[base->index + 1];
+        }
+    }
+
+    vec2f baseVertex = poly->vertices[base->index];
+
+    // Would removing this diagonal create a reflex vertex?
+    if (linearity_vec2f(prevVertex, baseVertex, nextVertex) == LINEARITY_CLOCKWISE)
+    {
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/*
+Determines if both sides of a diagonal are inessential and can be removed without
+affecting the decomposition of a polygon into convex polygon(s)
+
+Runs in O(1) time.
+
+Arguments
+    polygon* poly: The polygon being processed
+
+    vertexDiagonal* base: The diagonal being tested
+
+Preconditions
+    `base` is not NULL
+
+Returns
+    Returns true both sides of the diagonal are inessential and removing them
+    would not create a reflex vertex
+*/
+bool _isInessential_vertexDiagonal(polygon* poly, vertexDiagonal* base)
+{
+    // If removal of the diagonal would make either side a reflex vertex, then it is essential
+    if (_isEssential_vertexDiagonal(poly, base) ||
+        _isEssential_vertexDiagonal(poly, base->opposite))
+    {
+        return false;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+/*
+Removes a diagonal by unlinking it from surrounding diagonals.
+
+Runs in O(1) time.
+
+Arguments
+    vertexDiagonal** diagonals: An array of vertexDiagonal*'s where diagonal at the given
+        index is the "center"
+
+    vertexDiagonal* toRemove: The vertexDiagonal* to remove
+*/
+void _removeDiagonal_vertexDiagonal(vertexDiagonal** diagonals, vertexDiagonal* toRemove)
+{
+    // Unlink toRemove from the prev and next vertexDiagonal's
+    if (toRemove->prev)
+    {
+        toRemove->prev->next = toRemove->next;
+    }
+
+    if (toRemove->next)
+    {
+        toRemove->next->prev = toRemove->prev;
+    }
+
+    if (toRemove == diagonals[toRemove->index])
+    {
+        if (toRemove->prev)
+        {
+            diagonals[toRemove->index] = toRemove->prev;
+        }
+        else if (toRemove->next)
+        {
+            diagonals[toRemove->index] = toRemove->next;
+        }
+        else
+        {
+            diagonals[toRemove->index] = NULL;
+        }
+    }
+}
+
+/*
+Removes all inessential diagonals from the `diagonals` array. An diagonal is removed
+if and only if removing it would not create a reflex vertex.
+
+This function implements the Herman-Mehlhorn algorithm
+
+Runs in O(n) time.
+
+Arguments
+    polygon* poly: The polygon being decomposed into convex polygons
+
+    vertexDiagonal** diagonals: An array of vertexDiagonal*'s where diagonal at the given
+        index is the "center"
+
+Returns
+    Returns the number of essential diagonals left after processing
+*/
+int _removeInessentialDiagonals_vertexDiagonals(polygon* poly, vertexDiagonal** diagonals)
+{
+    int essentialDiagonalCount = 0;
+
+    // Even though there are 2 loops, this is still O(n) since there are O(n) diagonals
+    for (int baseIndex = 0; baseIndex < poly->vertexCount; baseIndex++)
+    {
+        if (!diagonals[baseIndex])
+        {
+            continue;
+        }
+
+        // Remove prev inessential diagonals
+        vertexDiagonal* it = diagonals[baseIndex]->prev;
+        vertexDiagonal* toRemove;
+        while (it)
+        {
+            toRemove = it;
+            it = it->prev;
+
+            if (_isInessential_vertexDiagonal(poly, toRemove))
+            {
+
+                // Remove both sides of the diagonal
+                _removeDiagonal_vertexDiagonal(diagonals, toRemove);
+                _removeDiagonal_vertexDiagonal(diagonals, toRemove->opposite);
+            }
+            else
+            {
+                essentialDiagonalCount++;
+            }
+        }
+
+        // Remove next inessential diagonals
+        it = diagonals[baseIndex]->next;
+        while (it)
+        {
+            toRemove = it;
+            it = it->next;
+
+            if (_isInessential_vertexDiagonal(poly, toRemove))
+            {
+
+                // Remove both sides of the diagonal
+                _removeDiagonal_vertexDiagonal(diagonals, toRemove);
+                _removeDiagonal_vertexDiagonal(diagonals, toRemove->opposite);
+            }
+            else
+            {
+                essentialDiagonalCount++;
+            }
+        }
+
+        // Remove and reassign the center;
+        toRemove = diagonals[baseIndex];
+        if (_isInessential_vertexDiagonal(poly, toRemove))
+        {
+
+            // Remove both sides of the diagonal
+            _removeDiagonal_vertexDiagonal(diagonals, toRemove);
+            _removeDiagonal_vertexDiagonal(diagonals, toRemove->opposite);
+        }
+        else
+        {
+            essentialDiagonalCount++;
+        }
+    }
+
+    return essentialDiagonalCount / 2; // We count each end of the diagonal once, so half to return the total number of essential diagonals
+}
+
+/*
+Generates a polygon for a given starting diagonal and stores in in polyPool.
+
+Any additional diagonals encountered while processing will kickoff new polygon generation
+
+Arguments
+    polygon* inPoly: The polygon to generate a convex polygon from
+
+    vertexDiagonals** diagonals: An array of essential diagonals that are used
+        to generate the convex polygons
+
+    vertexDiagonal* start: The diagonal to start from when generating a new convex polygon.
+        A vertexDiagonal without an opposite starts at its index and follows the polygon side from there.
+
+    int* vertexAccumulator: Memory given to this function to temporarily store vertex indices.
+        This total length of this memory should equal the number of polygon vertices + the number of essential diagonals * 3 + 1
+
+    polygon*** currentPoly: A pointer to a pool of polygon pointers
+
+Preconditions
+    When generating the first polygon, currentPoly should be a reference to allocated memory with size of
+    `essentialDiagonalCount + 1`
+
+Returns
+    Returns false only if memory allocation fails
+*/
+bool _generateConvexPolygon_vertexDiagonals(polygon* inPoly, vertexDiagonal** diagonals, vertexDiagonal* start, int endIndex, int* vertexAccumulator, polygon** currentPoly)
+{
+    // printf("\n    _generateConvexPolygon_vertexDiagonals(), endIndex: %d\n", endIndex);
+
+    // This will contain the newly created convex polygon for this initial diagonal
+    polygon* outPoly = *currentPoly;
+    (*currentPoly)++;
+
+    int accumulatorIndex = 0;
+
+    // We need both the currentIndex and currentDiagonal because not every vertex has a diagonal
+    int currentIndex = start->index;
+    vertexDiagonal* currentDiagonal = NULL;
+
+    if (start->opposite) // Is this a real vertexDiagonal?
+    {
+        currentDiagonal = start;
+    }
+
+    // Follow the polygon vertices and diagonals counter clockwise
+    while (currentIndex != endIndex)
+    {
+        // printf("        (%p) currentIndex: %d\n", outPoly, currentIndex);
+        // if (currentDiagonal)
+        // {
+        //     printf("        (%p) currentDiagonal: opposite: %d\n", outPoly, currentDiagonal->opposite->index);
+        // }
+        // else
+        // {
+        //     printf("        (%p) currentDiagonal: NULL\n", outPoly);
+        // }
+        // printf("        (%p) accumulatorIndex: %d\n\n", outPoly, accumulatorIndex);
+
+        // Save the index of our vertice we want to assign to the generated polygon later
+        vertexAccumulator[accumulatorIndex++] = currentIndex;
+
+        // Are we tranversing a diagonal?
+        if (currentDiagonal)
+        {
+            // Do we generate a new polygon following the next vertexDiagonal?
+            if (currentDiagonal->next)
+            {
+                vertexDiagonal* start = currentDiagonal->next;
+                int endIndex = currentDiagonal->opposite->index;
+                if (!_generateConvexPolygon_vertexDiagonals(inPoly, diagonals, start, endIndex, &vertexAccumulator[accumulatorIndex + 1], currentPoly))
+                {
+                    return false;
+                }
+            }
+            // Or do we generate a new polygon following the polygon vertices?
+            else
+            {
+                vertexDiagonal start = {currentDiagonal->index, NULL, NULL, NULL};
+                int endIndex = currentDiagonal->opposite->index;
+                if (!_generateConvexPolygon_vertexDiagonals(inPoly, diagonals, &start, endIndex, &vertexAccumulator[accumulatorIndex + 1], currentPoly))
+                {
+                    return false;
+                }
+            }
+
+            // Follow the diagonal and save the opposite index here, otherwise we will jump back and forth
+            currentDiagonal = currentDiagonal->opposite;
+
+            // Follow the polygon path counter clockwise
+            currentIndex = currentDiagonal->index;
+            currentDiagonal = currentDiagonal->next;
+        }
+        // Nope, we are rotating ccw through the polygon vertices
+        else
+        {
+            currentIndex = (currentIndex + 1) % inPoly->vertexCount;
+
+            // If there are diagonals at the current index, find the left most one
+            currentDiagonal = diagonals[currentIndex];
+            while (currentDiagonal && currentDiagonal->prev)
+            {
+                currentDiagonal = currentDiagonal->prev;
+            }
+        }
+    }
+
+    // Save the last vertex to complete the polygon
+    vertexAccumulator[accumulatorIndex++] = endIndex;
+
+    // Allocate the newly created convex polygon
+    if (!create_polygon(outPoly, accumulatorIndex))
+    {
+        return false;
+    }
+
+    // Assign the vertices
+    for (int i = 0; i < accumulatorIndex; i++)
+    {
+        outPoly->vertices[i] = inPoly->vertices[vertexAccumulator[i]];
+    }
+
+    // printf("\n    (%p) done\n", outPoly);
+
+    return true;
+}
+
+/*
+Generates convex polygons from a source polygon and eseential diagonals.
+
+Arguments
+    polygon* poly: The source polygon to generate convex polygon's from
+
+    vertexDiagonal** diagonals: An array of diagonals essential creating convex polygons
+
+    int essentialDiagonalCount: A number >= 0 that represents the number of essential diagonals
+        in `diagonals`. This value is used only to optimize the amount of memory allocated.
+
+Returns
+    An array of convex polygons with length of essentialDiagonal + 1. The array returned
+    is dynamically allocated memory and must be freed.
+*/
+polygon* _generateConvexPolygons_vertexDiagonals(polygon* poly, vertexDiagonal** diagonals, int essentialDiagonalCount)
+{
+    // Every polygon takes its vertices, and skips one more, past the end of the polygon that started it. Together
+    // the polygons have every vertex plus both ends of every diagonal, and there is one polygon per diagonal plus one.
+    int* vertexAccumulator = calloc(poly->vertexCount + essentialDiagonalCount * 3 + 1, sizeof(int));
+    if (!vertexAccumulator)
+    {
+        return NULL;
+    }
+
+    int convexPolygonCount = essentialDiagonalCount + 1;
+    polygon* convexPolygons = calloc(convexPolygonCount, sizeof(polygon));
+    if (!convexPolygons)
+    {
+        free(vertexAccumulator);
+        return NULL;
+    }
+
+    // The first polygon has the side from the last vertex to vertex 0, so it leaves vertex 0 along the left most
+    // diagonal, if there is one. Any other polygon that starts at vertex 0 is after a diagonal, so it can't be the first.
+    vertexDiagonal* firstDiagonal = diagonals[0];
+    while (firstDiagonal && firstDiagonal->prev)
+    {
+        firstDiagonal = firstDiagonal->prev;
+    }
+
+    polygon* currentDiagonal = convexPolygons;
+    vertexDiagonal start = {0, NULL, NULL, NULL};
+    if (!_generateConvexPolygon_vertexDiagonals(poly, diagonals, firstDiagonal ? firstDiagonal : &start, poly->vertexCount - 1, vertexAccumulator, &currentDiagonal))
+    {
+        for (int i = 0; i < convexPolygonCount; i++)
+        {
+            free_polygon(&convexPolygons[i]);
+        }
+
+        free(convexPolygons);
+        convexPolygons = NULL;
+    }
+
+    free(vertexAccumulator);
+
+    return convexPolygons;
+}
+
+void print_vertexDiagonals(vertexDiagonal* v)
+{
+    if (!v)
+    {
+        return;
+    }
+    printf("vertexDiagonal[%d]: ", v->index);
+
+    while (v->prev)
+    {
+        v = v->prev;
+    }
+
+    while (v)
+    {
+        printf(" %d,", v->opposite->index);
+        v = v->next;
+    }
+
+    printf("\n");
+}
+
+// see header for documentation
+bool decompose_polygon(polygon* in, polygon** out, int* outCount)
+{
+    if (!in || !in->vertices || !out || !outCount)
+    {
+        return false;
+    }
+
+    *out = NULL;
+
+    int vertexCount = in->vertexCount;
+    polygon counterClockWisePoly;
+    create_polygon(&counterClockWisePoly, vertexCount);
+
+    // All of the decomposition functions assume a ccw polygon, so reverse the order of points as necessary
+    if (isClockwise_polygon(in))
+    {
+        for (int i = 0; i < vertexCount; i++)
+        {
+            counterClockWisePoly.vertices[i] = in->vertices[vertexCount - 1 - i];
+        }
+    }
+    else
+    {
+        for (int i = 0; i < vertexCount; i++)
+        {
+            counterClockWisePoly.vertices[i] = in->vertices[i];
+        }
+    }
+
+    // Ear clipping is O(n^2), but it tends to leave fewer essential diagonals, so it is kept for small polygons
+    vertexDiagonal* diagonalPool;
+    vertexDiagonal** diagonals = vertexCount < MONOTONE_TRIANGULATION_VERTEX_COUNT ?
+        _triangulate_polygon(&counterClockWisePoly, &diagonalPool) :
+        _triangulateMonotone_polygon(&counterClockWisePoly, &diagonalPool);
+    if (!diagonals)
+    {
+        return false;
+    }
+
+    int essentialDiagonalCount = _removeInessentialDiagonals_vertexDiagonals(&counterClockWisePoly, diagonals);
+    *outCount = essentialDiagonalCount + 1;
+
+    // for (int i = 0; i < in->vertexCount; i++)
+    // {
+    //     print_vertexDiagonals(diagonals[i]);
+    // }
+
+    *out = _generateConvexPolygons_vertexDiagonals(&counterClockWisePoly, diagonals, essentialDiagonalCount);
+
+    free_polygon(&counterClockWisePoly);
+    free(diagonalPool);
+    free(diagonals);
+
+    return true;
+}
+
+/*
+Gets a vertex of a polygon, where the index wraps around both ends of the polygon
+
+Runs in O(1) time.
+*/
+vec2f _at_polygon(polygon* poly, int index)
+{
+    return poly->vertices[((index % poly->vertexCount) + poly->vertexCount) % poly->vertexCount];
+}
+
+/*
+Adds a convex piece to a list of pieces. Repeated and collinear vertices are dropped from the piece, since
+each one would only add another projection to the separating axis test, and a piece left with no area is
+not added at all.
+
+Runs in O(n) time.
+
+Arguments
+    pieceList* list: The list of pieces
+
+    polygon* piece: The convex piece, which is copied
+
+Returns
+    Returns false if memory allocation failed
+*/
+bool _push_pieceList(pieceList* list, polygon* piece)
+{
+    polygon copy;
+    if (!create_polygon(&copy, piece->vertexCount))
+    {
+        return false;
+    }
+
+    int count = 0;
+    for (int i = 0; i < piece->vertexCount; i++)
+    {
+        vec2f prev = count > 0 ? copy.vertices[count - 1] : _at_polygon(piece, i - 1);
+        vec2f current = piece->vertices[i];
+        vec2f next = _at_polygon(piece, i + 1);
+
+        if (_cross_polygon(prev, current, next) != 0.0f)
+        {
+            copy.vertices[count++] = current;
+        }
+    }
+    copy.vertexCount = count;
+
+    if (count < 3)
+    {
+        free_polygon(&copy);
+        return true;
+    }
+
+    if (list->count == list->capacity)
+    {
+        int capacity = list->capacity ? list->capacity * 2 : 8;
+        polygon* pieces = realloc(list->pieces, sizeof(polygon) * capacity);
+        if (!pieces)
+        {
+            free_polygon(&copy);
+            return false;
+        }
+
+        list->pieces = pieces;
+        list->capacity = capacity;
+    }
+
+    list->pieces[list->count++] = copy;
+
+    return true;
+}
+
+/*
+Frees every piece of a list of pieces, and the list itself
+*/
+void _free_pieceList(pieceList* list)
+{
+    for (int i = 0; i < list->count; i++)
+    {
+        free_polygon(&list->pieces[i]);
+    }
+    free(list->pieces);
+
+    list->pieces = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+/*
+Finds where two lines cross
+
+Runs in O(1) time.
+
+Arguments
+    vec2f p1, p2: Two points on the first line
+
+    vec2f q1, q2: Two points on the second line
+
+    vec2f* intersection: The point where the lines cross
+
+Returns
+    Returns false if the lines are parallel
+*/
+bool _intersectLines_polygon(vec2f p1, vec2f p2, vec2f q1, vec2f q2, vec2f* intersection)
+{
+    vec2f pDirection = sub_vec2f(p2, p1);
+    vec2f qDirection = sub_vec2f(q2, q1);
+
+    float denominator = GET_X(pDirection) * GET_Y(qDirection) - GET_Y(pDirection) * GET_X(qDirection);
+    if (denominator == 0.0f)
+    {
+        return false;
+    }
+
+    vec2f offset = sub_vec2f(q1, p1);
+    float t = (GET_X(offset) * GET_Y(qDirection) - GET_Y(offset) * GET_X(qDirection)) / denominator;
+    *intersection = add_vec2f(p1, mul_vec2f(pDirection, t));
+
+    return true;
+}
+
+/*
+Determines whether a segment between two vertices of a polygon crosses any of its sides
+
+Runs in O(n) time.
+
+Arguments
+    polygon* poly: The polygon
+
+    int v1: The first vertex
+
+    int v2: The second vertex
+
+Returns
+    Returns true if no side, other than the sides at v1 and v2, touches the segment
+*/
+bool _canSee_polygon(polygon* poly, int v1, int v2)
+{
+    int vertexCount = poly->vertexCount;
+    for (int i = 0; i < vertexCount; i++)
+    {
+        int next = (i + 1) % vertexCount;
+        if (i == v1 || i == v2 || next == v1 || next == v2)
+        {
+            continue;
+        }
+
+        if (areSegmentsIntersecting_vec2f(poly->vertices[v1], poly->vertices[v2], poly->vertices[i], poly->vertices[next]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+Copies a run of vertices of a polygon into a new polygon
+
+Runs in O(n) time.
+
+Arguments
+    polygon* poly: The polygon to copy from
+
+    int from: The first vertex of the run
+
+    int to: The last vertex of the run, which can be before `from` to wrap around the end of the polygon
+
+    vec2f* last: A vertex to add after the run, or NULL
+
+    polygon* out: The new polygon
+
+Returns
+    Returns false if the new polygon has fewer than 3 vertices or memory allocation failed
+*/
+bool _copyRun_polygon(polygon* poly, int from, int to, vec2f* last, polygon* out)
+{
+    int runCount = (to - from + poly->vertexCount) % poly->vertexCount + 1;
+    if (!create_polygon(out, runCount + (last ? 1 : 0)))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < runCount; i++)
+    {
+        out->vertices[i] = _at_polygon(poly, from + i);
+    }
+
+    if (last)
+    {
+        out->vertices[runCount] = *last;
+    }
+
+    return true;
+}
+
+/*
+Adds the decomposition of decompose_polygon() to a list of pieces, for the pieces Bayazit's algorithm can't split
+
+Returns
+    Returns false if memory allocation failed
+*/
+bool _decomposeFallback_polygon(polygon* poly, pieceList* pieces)
+{
+    polygon* fallbackPieces;
+    int fallbackCount;
+    if (!decompose_polygon(poly, &fallbackPieces, &fallbackCount) || !fallbackPieces)
+    {
+        return false;
+    }
+
+    bool isAdded = true;
+    for (int i = 0; i < fallbackCount; i++)
+    {
+        isAdded = isAdded && _push_pieceList(pieces, &fallbackPieces[i]);
+        free_polygon(&fallbackPieces[i]);
+    }
+    free(fallbackPieces);
+
+    return isAdded;
+}
+
+/*
+Decomposes a counter clockwise polygon into convex pieces with Bayazit's algorithm. The polygon is split at
+its first reflex vertex, toward the closest vertex it can see between the extensions of its two sides, and
+both halves are decomposed the same way. If no vertex can be seen there, the split goes to a new point
+between where the extensions hit the polygon. Every split removes at least one reflex vertex, which tends
+to leave far fewer pieces than triangulating first.
+
+Runs in O(n^3) time in the worst case, from testing the visibility of O(n) vertices per reflex vertex.
+
+Arguments
+    polygon* poly: The polygon, which must be counter clockwise
+
+    pieceList* pieces: The list the convex pieces are added to
+
+    int depth: How many times the polygon has been split
+
+Returns
+    Returns false if memory allocation failed
+*/
+bool _decomposeBayazit_polygon(polygon* poly, pieceList* pieces, int depth)
+{
+    int vertexCount = poly->vertexCount;
+
+    int reflexIndex = 0;
+    while (reflexIndex < vertexCount &&
+        _cross_polygon(_at_polygon(poly, reflexIndex - 1), poly->vertices[reflexIndex], _at_polygon(poly, reflexIndex + 1)) >= 0.0f)
+    {
+        reflexIndex++;
+    }
+
+    // Without any reflex vertices the polygon is already convex
+    if (reflexIndex == vertexCount)
+    {
+        return _push_pieceList(pieces, poly);
+    }
+
+    if (depth >= BAYAZIT_MAX_DEPTH)
+    {
+        return _decomposeFallback_polygon(poly, pieces);
+    }
+
+    vec2f prev = _at_polygon(poly, reflexIndex - 1);
+    vec2f reflex = poly->vertices[reflexIndex];
+    vec2f next = _at_polygon(poly, reflexIndex + 1);
+
+    // Extend both sides at the reflex vertex into the polygon, and find the closest side each one hits.
+    // The lower side is the one hit by extending the side from prev, the upper side is hit extending next.
+    float lowerDistance = FLT_MAX;
+    float upperDistance = FLT_MAX;
+    vec2f lowerIntersection = reflex;
+    vec2f upperIntersection = reflex;
+    int lowerIndex = -1;
+    int upperIndex = -1;
+
+    for (int i = 0; i < vertexCount; i++)
+    {
+        vec2f vertex = poly->vertices[i];
+        vec2f intersection;
+
+        // The side from i - 1 to i crosses the extension of prev -> reflex
+        if (_cross_polygon(prev, reflex, vertex) > 0.0f && _cross_polygon(prev, reflex, _at_polygon(poly, i - 1)) <= 0.0f &&
+            _intersectLines_polygon(prev, reflex, vertex, _at_polygon(poly, i - 1), &intersection) &&
+            _cross_polygon(next, reflex, intersection) < 0.0f)
+        {
+            float distance = distanceSqrd_vec2f(reflex, intersection);
+            if (distance < lowerDistance)
+            {
+                lowerDistance = distance;
+                lowerIntersection = intersection;
+                lowerIndex = i;
+            }
+        }
+
+        // The side from i to i + 1 crosses the extension of next -> reflex
+        if (_cross_polygon(next, reflex, _at_polygon(poly, i + 1)) > 0.0f && _cross_polygon(next, reflex, vertex) <= 0.0f &&
+            _intersectLines_polygon(next, reflex, vertex, _at_polygon(poly, i + 1), &intersection) &&
+            _cross_polygon(prev, reflex, intersection) > 0.0f)
+        {
+            float distance = distanceSqrd_vec2f(reflex, intersection);
+            if (distance < upperDistance)
+            {
+                upperDistance = distance;
+                upperIntersection = intersection;
+                upperIndex = i;
+            }
+        }
+    }
+
+    if (lowerIndex < 0 || upperIndex < 0)
+    {
+        return _decomposeFallback_polygon(poly, pieces);
+    }
+
+    polygon lowerPoly = {NULL, 0};
+    polygon upperPoly = {NULL, 0};
+    bool isSplit;
+
+    if (lowerIndex == (upperIndex + 1) % vertexCount)
+    {
+        // Both extensions hit the same side, so there is no vertex to split toward
+        vec2f steinerPoint = div_vec2f(add_vec2f(lowerIntersection, upperIntersection), 2.0f);
+
+        isSplit = _copyRun_polygon(poly, reflexIndex, upperIndex, &steinerPoint, &lowerPoly) &&
+            _copyRun_polygon(poly, lowerIndex, reflexIndex, &steinerPoint, &upperPoly);
+    }
+    else
+    {
+        if (lowerIndex > upperIndex)
+        {
+            upperIndex += vertexCount;
+        }
+
+        // Split toward the closest vertex between the two extensions
+        float closestDistance = FLT_MAX;
+        int closestIndex = -1;
+        for (int i = lowerIndex; i <= upperIndex; i++)
+        {
+            int index = i % vertexCount;
+            int offset = (index - reflexIndex + vertexCount) % vertexCount;
+            if (offset <= 1 || offset == vertexCount - 1)
+            {
+                continue;
+            }
+
+            vec2f vertex = poly->vertices[index];
+            float distance = distanceSqrd_vec2f(reflex, vertex);
+            if (_cross_polygon(prev, reflex, vertex) >= 0.0f && _cross_polygon(next, reflex, vertex) <= 0.0f &&
+                distance < closestDistance && _canSee_polygon(poly, reflexIndex, index))
+            {
+                closestDistance = distance;
+                closestIndex = index;
+            }
+        }
+
+        if (closestIndex < 0)
+        {
+            return _decomposeFallback_polygon(poly, pieces);
+        }
+
+        isSplit = _copyRun_polygon(poly, reflexIndex, closestIndex, NULL, &lowerPoly) &&
+            _copyRun_polygon(poly, closestIndex, reflexIndex, NULL, &upperPoly);
+    }
+
+    bool isDecomposed = isSplit &&
+        _decomposeBayazit_polygon(&lowerPoly, pieces, depth + 1) &&
+        _decomposeBayazit_polygon(&upperPoly, pieces, depth + 1);
+
+    free_polygon(&lowerPoly);
+    free_polygon(&upperPoly);
+
+    return isDecomposed;
+}
+
+// see header for documentation
+bool decomposeMinimum_polygon(polygon* in, polygon** out, int* outCount)
+{
+    if (!in || !in->vertices || !out || !outCount || in->vertexCount < 3)
+    {
+        return false;
+    }
+
+    *out = NULL;
+
+    polygon counterClockWisePoly;
+    if (!create_polygon(&counterClockWisePoly, in->vertexCount))
+    {
+        return false;
+    }
+
+    bool isClockwise = isClockwise_polygon(in);
+    for (int i = 0; i < in->vertexCount; i++)
+    {
+        counterClockWisePoly.vertices[i] = in->vertices[isClockwise ? in->vertexCount - 1 - i : i];
+    }
+
+    pieceList pieces = {NULL, 0, 0};
+    bool isDecomposed = _decomposeBayazit_polygon(&counterClockWisePoly, &pieces, 0);
+    free_polygon(&counterClockWisePoly);
+
+    polygon* fastPieces;
+    int fastCount;
+    if (!isDecomposed || !decompose_polygon(in, &fastPieces, &fastCount) || !fastPieces)
+    {
+        _free_pieceList(&pieces);
+        return false;
+    }
+
+    // Bayazit's algorithm is a heuristic, so keep whichever decomposition has fewer pieces
+    if (fastCount <= pieces.count)
+    {
+        _free_pieceList(&pieces);
+
+        *out = fastPieces;
+        *outCount = fastCount;
+
+        return true;
+    }
+
+    for (int i = 0; i < fastCount; i++)
+    {
+        free_polygon(&fastPieces[i]);
+    }
+    free(fastPieces);
+
+    *out = pieces.pieces;
+    *outCount = pieces.count;
+
+    return true;
+}
+
+/*
+Finds the squared distance from a point to a line segment
+
+Runs in O(1) time.
+
+Arguments
+    vec2f point: The point
+
+    vec2f endpoint1: The first end of the segment
+
+    vec2f endpoint2: The second end of the segment
+
+Returns
+    Returns the squared distance to the closest point of the segment
+*/
+float _distanceToSegmentSqrd_polygon(vec2f point, vec2f endpoint1, vec2f endpoint2)
+{
+    vec2f segment = sub_vec2f(endpoint2, endpoint1);
+    float lengthSqrd = dot_vec2f(segment, segment);
+    if (lengthSqrd == 0.0f)
+    {
+        return distanceSqrd_vec2f(point, endpoint1);
+    }
+
+    float t = dot_vec2f(sub_vec2f(point, endpoint1), segment) / lengthSqrd;
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+
+    return distanceSqrd_vec2f(point, add_vec2f(endpoint1, mul_vec2f(segment, t)));
+}
+
+/*
+Marks the vertices between two kept vertices that Ramer-Douglas-Peucker keeps. The vertex furthest from the
+segment between the two is kept if it is further than the tolerance, and both halves are simplified the same way.
+
+Runs in O(n log n) time on average, and O(n^2) in the worst case.
+
+Arguments
+    polygon* poly: The polygon being simplified
+
+    int first: A kept vertex
+
+    int last: A later kept vertex, which can be past the end of the polygon to wrap around it
+
+    float toleranceSqrd: The squared distance a vertex must be from the segment to be kept
+
+    bool* isKept: Whether each vertex is kept
+*/
+void _simplifyRun_polygon(polygon* poly, int first, int last, float toleranceSqrd, bool* isKept)
+{
+    vec2f firstVertex = _at_polygon(poly, first);
+    vec2f lastVertex = _at_polygon(poly, last);
+
+    float furthestDistance = toleranceSqrd;
+    int furthest = -1;
+    for (int i = first + 1; i < last; i++)
+    {
+        float distance = _distanceToSegmentSqrd_polygon(_at_polygon(poly, i), firstVertex, lastVertex);
+        if (distance > furthestDistance)
+        {
+            furthestDistance = distance;
+            furthest = i;
+        }
+    }
+
+    if (furthest < 0)
+    {
+        return;
+    }
+
+    isKept[furthest % poly->vertexCount] = true;
+    _simplifyRun_polygon(poly, first, furthest, toleranceSqrd, isKept);
+    _simplifyRun_polygon(poly, furthest, last, toleranceSqrd, isKept);
+}
+
+/*
+Determines whether any two sides of a polygon cross
+
+Runs in O(n^2) time.
+
+Returns
+    Returns true if no two sides, other than neighbouring sides, touch
+*/
+bool _isSimple_polygon(polygon* poly)
+{
+    int vertexCount = poly->vertexCount;
+    for (int i = 0; i < vertexCount; i++)
+    {
+        for (int j = i + 2; j < vertexCount; j++)
+        {
+            if (i == 0 && j == vertexCount - 1)
+            {
+                continue;
+            }
+
+            if (areSegmentsIntersecting_vec2f(poly->vertices[i], poly->vertices[i + 1], poly->vertices[j], _at_polygon(poly, j + 1)))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// see header for documentation
+bool simplify_polygon(polygon* in, polygon* out, float tolerance)
+{
+    if (!in || !in->vertices || !out || in->vertexCount < 3 || tolerance < 0.0f)
+    {
+        return false;
+    }
+
+    int vertexCount = in->vertexCount;
+    bool* isKept = calloc(vertexCount, sizeof(bool));
+    if (!isKept)
+    {
+        return false;
+    }
+
+    // A closed polygon has no ends to start from, so start from vertex 0 and the vertex furthest from it
+    int furthest = 0;
+    for (int i = 1; i < vertexCount; i++)
+    {
+        if (distanceSqrd_vec2f(in->vertices[0], in->vertices[i]) > distanceSqrd_vec2f(in->vertices[0], in->vertices[furthest]))
+        {
+            furthest = i;
+        }
+    }
+
+    float toleranceSqrd = tolerance * tolerance;
+    isKept[0] = true;
+    isKept[furthest] = true;
+    _simplifyRun_polygon(in, 0, furthest, toleranceSqrd, isKept);
+    _simplifyRun_polygon(in, furthest, vertexCount, toleranceSqrd, isKept);
+
+    int keptCount = 0;
+    for (int i = 0; i < vertexCount; i++)
+    {
+        keptCount += isKept[i] ? 1 : 0;
+    }
+
+    // Ramer-Douglas-Peucker never drops the two starting vertices, so drop them too if they are within the
+    // tolerance of the line through their kept neighbours. Vertex 0 is checked again after its neighbour.
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int i = 0; keptCount > 3 && i < vertexCount; i++)
+        {
+            if (!isKept[i] || (i != 0 && i != furthest))
+            {
+                continue;
+            }
+
+            int prev = (i + vertexCount - 1) % vertexCount;
+            while (!isKept[prev])
+            {
+                prev = (prev + vertexCount - 1) % vertexCount;
+            }
+
+            int next = (i + 1) % vertexCount;
+            while (!isKept[next])
+            {
+                next = (next + 1) % vertexCount;
+            }
+
+            if (_distanceToSegmentSqrd_polygon(in->vertices[i], in->vertices[prev], in->vertices[next]) <= toleranceSqrd)
+            {
+                isKept[i] = false;
+                keptCount--;
+            }
+        }
+    }
+
+    bool isSimplified = keptCount >= 3 && create_polygon(out, keptCount);
+    if (isSimplified)
+    {
+        int outIndex = 0;
+        for (int i = 0; i < vertexCount; i++)
+        {
+            if (isKept[i])
+            {
+                out->vertices[outIndex++] = in->vertices[i];
+            }
+        }
+
+        // Dropping vertices can pull a side across another, which decomposition can't handle, so keep the
+        // polygon as it was instead
+        if (!_isSimple_polygon(out))
+        {
+            free_polygon(out);
+            isSimplified = false;
+        }
+    }
+
+    free(isKept);
+
+    if (isSimplified)
+    {
+        return true;
+    }
+
+    if (!create_polygon(out, vertexCount))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < vertexCount; i++)
+    {
+        out->vertices[i] = in->vertices[i];
+    }
 
     return true;
 }
@@ -41,6 +41,21 @@ MATRIX_TYPE(3, 3) getMatrix_transform(transform* t)
     );
 }
 
+void getBounds_transform(transform* t, vec2f size, vec2f* outMin, vec2f* outMax)
+{
+    float halfWidth = fabsf(GET_X(t->scale) * GET_X(size)) / 2.0f;
+    float halfHeight = fabsf(GET_Y(t->scale) * GET_Y(size)) / 2.0f;
+
+    // The extents of a rotated rectangle along each axis
+    float sinAngle = fabsf(sinf(t->rotation));
+    float cosAngle = fabsf(cosf(t->rotation));
+    float extentX = cosAngle * halfWidth + sinAngle * halfHeight;
+    float extentY = sinAngle * halfWidth + cosAngle * halfHeight;
+
+    *outMin = to_vec2f(GET_X(t->position) - extentX, GET_Y(t->position) - extentY);
+    *outMax = to_vec2f(GET_X(t->position) + extentX, GET_Y(t->position) + extentY);
+}
+
 /*
 Applies a 3x3 matrix to a 2d point. A 3x3 matrix is used so that translations can
 be encoded in matrix form
@@ -76,9 +91,21 @@ bool applyTransform_polygon(polygon* in, transform* t, polygon* out)
 
     // Transform the polygon
     MATRIX_TYPE(3, 3) transformMatrix = getMatrix_transform(t);
+
+    return applyMatrix_polygon(in, &transformMatrix, out);
+}
+
+bool applyMatrix_polygon(polygon* in, MATRIX_TYPE(3, 3)* matrix, polygon* out)
+{
+    if (!in || !matrix || !out || !out->vertices)
+    {
+        return false;
+    }
+
+    out->vertexCount = in->vertexCount;
     for (size_t i = 0; i < out->vertexCount; i++)
     {
-        out->vertices[i] = _applymMatrix_vec2f(in->vertices[i], &transformMatrix);
+        out->vertices[i] = _applymMatrix_vec2f(in->vertices[i], matrix);
     }
 
     return true;
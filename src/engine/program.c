@@ -0,0 +1,204 @@
+#include "engine/program.h"
+
+#include "datastructures/hashtable.h"
+#include "engine/asset.h"
+#include "engine/renderBackend.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static hashtable* programTable = NULL; // Every live program, by the key of its pair of shaders
+
+// Indices of released programs, reused before new indices are handed out
+static uint16_t* freeIndices = NULL;
+static size_t freeIndicesCount = 0;
+static size_t freeIndicesCapacity = 0;
+static uint16_t nextIndex = 0;
+
+/*
+Builds the key a pair of shaders is cached under
+
+Arguments
+    assetHandle vertexShader: See getByAssets_program()
+
+    assetHandle fragmentShader: See getByAssets_program()
+
+Returns
+    Returns the key
+*/
+uint64_t _getKey_program(assetHandle vertexShader, assetHandle fragmentShader)
+{
+    return ((uint64_t) vertexShader << 32) | fragmentShader;
+}
+
+/*
+Takes an unused program index
+
+Arguments
+    uint16_t* outIndex: The index
+
+Returns
+    Returns false if every index is in use
+*/
+bool _takeIndex_program(uint16_t* outIndex)
+{
+    if (freeIndicesCount > 0)
+    {
+        *outIndex = freeIndices[--freeIndicesCount];
+        return true;
+    }
+
+    if (nextIndex == UINT16_MAX)
+    {
+        return false;
+    }
+
+    *outIndex = nextIndex++;
+
+    return true;
+}
+
+/*
+Returns a program index so it can be reused
+
+Arguments
+    uint16_t index: The index to return
+
+Returns
+    Returns false if memory allocation failed, in which case the index is never reused
+*/
+bool _returnIndex_program(uint16_t index)
+{
+    if (freeIndicesCount == freeIndicesCapacity)
+    {
+        size_t capacity = freeIndicesCapacity ? freeIndicesCapacity * 2 : 16;
+        uint16_t* indices = realloc(freeIndices, sizeof(uint16_t) * capacity);
+        if (!indices)
+        {
+            return false;
+        }
+
+        freeIndices = indices;
+        freeIndicesCapacity = capacity;
+    }
+
+    freeIndices[freeIndicesCount++] = index;
+
+    return true;
+}
+
+/*
+Compiles and links a new program, and looks up its uniforms
+
+Arguments
+    assetHandle vertexShader: See getByAssets_program()
+
+    assetHandle fragmentShader: See getByAssets_program()
+
+Returns
+    Returns the new program, with a reference count of 0, or NULL if it could not be created
+*/
+program* _create_program(assetHandle vertexShader, assetHandle fragmentShader)
+{
+    program* p = malloc(sizeof(program));
+    if (!p)
+    {
+        return NULL;
+    }
+
+    p->key = _getKey_program(vertexShader, fragmentShader);
+
+    if (!_takeIndex_program(&p->index))
+    {
+        printf("get_program(): too many programs\n");
+        free(p);
+        return NULL;
+    }
+
+    if (!get_renderBackend()->createProgram(p, getFileName_asset(vertexShader), getFileName_asset(fragmentShader)))
+    {
+        _returnIndex_program(p->index);
+        free(p);
+        return NULL;
+    }
+
+    p->refCount = 0;
+
+    return p;
+}
+
+program* get_program(const char* vertexShader, const char* fragmentShader)
+{
+    if (!vertexShader || !fragmentShader)
+    {
+        return NULL;
+    }
+
+    return getByAssets_program(intern_asset(vertexShader), intern_asset(fragmentShader));
+}
+
+program* getByAssets_program(assetHandle vertexShader, assetHandle fragmentShader)
+{
+    if (!getFileName_asset(vertexShader) || !getFileName_asset(fragmentShader))
+    {
+        return NULL;
+    }
+
+    if (!programTable)
+    {
+        programTable = create_hashtable(32, hasher_uint64_t, comparator_uint64_t);
+        if (!programTable)
+        {
+            return NULL;
+        }
+    }
+
+    // See if the program has already been linked
+    uint64_t key = _getKey_program(vertexShader, fragmentShader);
+    program* p = get_hashtable(programTable, &key);
+
+    if (!p)
+    {
+        p = _create_program(vertexShader, fragmentShader);
+        if (!p)
+        {
+            printf("get_program(): could not create program %s, %s\n", getFileName_asset(vertexShader), getFileName_asset(fragmentShader));
+            return NULL;
+        }
+
+        // The key is owned by the program, so it lives as long as the table entry
+        if (!set_hashtable(programTable, &p->key, p))
+        {
+            get_renderBackend()->deleteProgram(p);
+            _returnIndex_program(p->index);
+            free(p);
+            return NULL;
+        }
+    }
+
+    p->refCount++;
+
+    return p;
+}
+
+bool release_program(program* p)
+{
+    if (!p)
+    {
+        return false;
+    }
+
+    p->refCount--;
+    if (p->refCount > 0)
+    {
+        return true;
+    }
+
+    remove_hashtable(programTable, &p->key);
+    get_renderBackend()->deleteProgram(p);
+    _returnIndex_program(p->index);
+
+    free(p);
+
+    return true;
+}
@@ -0,0 +1,216 @@
+#include "engine/programCache.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static const char PROGRAM_CACHE_MAGIC[4] = { 'G', 'E', 'P', 'B' };
+
+// 64 bit FNV-1a
+static const uint64_t HASH_OFFSET = 14695981039346656037ULL;
+static const uint64_t HASH_PRIME = 1099511628211ULL;
+
+// The header of every cached binary
+typedef struct _programCacheHeader
+{
+    char magic[4];
+    uint32_t format;
+    uint64_t key; // Guards against a file being renamed or a hash collision between file names
+    uint64_t size;
+} programCacheHeader;
+
+static char* cacheDirectory = NULL;
+
+bool setDirectory_programCache(const char* directory)
+{
+    free(cacheDirectory);
+    cacheDirectory = NULL;
+
+    if (!directory)
+    {
+        return true;
+    }
+
+    cacheDirectory = malloc(strlen(directory) + 1);
+    if (!cacheDirectory)
+    {
+        return false;
+    }
+    strcpy(cacheDirectory, directory);
+
+    return true;
+}
+
+bool isEnabled_programCache()
+{
+    return cacheDirectory != NULL;
+}
+
+/*
+Adds bytes to a running hash
+
+Arguments
+    uint64_t hash: The hash so far
+
+    const char* bytes: The bytes to add
+
+    size_t size: The number of bytes
+
+Returns
+    Returns the new hash
+*/
+uint64_t _hash_programCache(uint64_t hash, const char* bytes, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= (uint8_t) bytes[i];
+        hash *= HASH_PRIME;
+    }
+
+    return hash;
+}
+
+uint64_t hash_programCache(const char** sources, size_t count, const char* driver)
+{
+    uint64_t hash = HASH_OFFSET;
+
+    // The terminators are hashed too, so moving text from one source into the next changes the key
+    for (size_t i = 0; sources && i < count; i++)
+    {
+        const char* source = sources[i] ? sources[i] : "";
+        hash = _hash_programCache(hash, source, strlen(source) + 1);
+    }
+
+    const char* driverName = driver ? driver : "";
+    hash = _hash_programCache(hash, driverName, strlen(driverName) + 1);
+
+    return hash;
+}
+
+/*
+Gets the file a binary is cached in
+
+Arguments
+    uint64_t key: The key of the binary
+
+    char* outPath: The file name
+
+    size_t pathSize: The size of outPath
+
+Returns
+    Returns false if the cache is disabled or the file name doesn't fit in outPath
+*/
+bool _getPath_programCache(uint64_t key, char* outPath, size_t pathSize)
+{
+    if (!cacheDirectory)
+    {
+        return false;
+    }
+
+    int length = snprintf(outPath, pathSize, "%s/%016" PRIx64 ".bin", cacheDirectory, key);
+
+    return length > 0 && (size_t) length < pathSize;
+}
+
+void* load_programCache(uint64_t key, uint32_t* outFormat, size_t* outSize)
+{
+    char path[1024];
+    if (!outFormat || !outSize || !_getPath_programCache(key, path, sizeof(path)))
+    {
+        return NULL;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file)
+    {
+        return NULL;
+    }
+
+    programCacheHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, PROGRAM_CACHE_MAGIC, sizeof(PROGRAM_CACHE_MAGIC)) != 0 ||
+        header.key != key || header.size == 0)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    void* binary = malloc(header.size);
+    if (!binary)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    if (fread(binary, header.size, 1, file) != 1)
+    {
+        free(binary);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+
+    *outFormat = header.format;
+    *outSize = header.size;
+
+    return binary;
+}
+
+bool store_programCache(uint64_t key, uint32_t format, const void* binary, size_t size)
+{
+    char path[1024];
+    if (!binary || size == 0 || !_getPath_programCache(key, path, sizeof(path)))
+    {
+        return false;
+    }
+
+    if (mkdir(cacheDirectory, 0755) != 0 && errno != EEXIST)
+    {
+        printf("store_programCache(): could not create %s\n", cacheDirectory);
+        return false;
+    }
+
+    // Written under a temporary name first, so another process never loads half a binary
+    char temporaryPath[1040];
+    snprintf(temporaryPath, sizeof(temporaryPath), "%s.tmp", path);
+
+    FILE* file = fopen(temporaryPath, "wb");
+    if (!file)
+    {
+        printf("store_programCache(): could not open %s\n", temporaryPath);
+        return false;
+    }
+
+    programCacheHeader header;
+    memcpy(header.magic, PROGRAM_CACHE_MAGIC, sizeof(PROGRAM_CACHE_MAGIC));
+    header.format = format;
+    header.key = key;
+    header.size = size;
+
+    bool isWritten = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(binary, size, 1, file) == 1;
+    isWritten = fclose(file) == 0 && isWritten;
+
+    if (!isWritten || rename(temporaryPath, path) != 0)
+    {
+        printf("store_programCache(): could not write %s\n", path);
+        remove(temporaryPath);
+        return false;
+    }
+
+    return true;
+}
+
+bool remove_programCache(uint64_t key)
+{
+    char path[1024];
+    if (!_getPath_programCache(key, path, sizeof(path)))
+    {
+        return false;
+    }
+
+    return remove(path) == 0;
+}
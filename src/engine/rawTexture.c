@@ -0,0 +1,185 @@
+#include "engine/rawTexture.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char RAW_TEXTURE_MAGIC[4] = { 'R', 'T', 'E', 'X' };
+static const uint32_t RAW_TEXTURE_VERSION = 1;
+static const size_t TEXEL_SIZE = 4; // RGBA
+
+size_t getLevelCount_rawTexture(size_t width, size_t height)
+{
+    size_t levelCount = 1;
+    while (width > 1 || height > 1)
+    {
+        width /= 2;
+        height /= 2;
+        levelCount++;
+    }
+
+    return levelCount;
+}
+
+void getLevelSize_rawTexture(size_t width, size_t height, size_t level, size_t* outWidth, size_t* outHeight)
+{
+    // Shifting by the word size or more is undefined
+    size_t shift = level < sizeof(size_t) * 8 ? level : sizeof(size_t) * 8 - 1;
+
+    size_t levelWidth = width >> shift;
+    size_t levelHeight = height >> shift;
+    *outWidth = levelWidth ? levelWidth : 1;
+    *outHeight = levelHeight ? levelHeight : 1;
+}
+
+size_t getSize_rawTexture(size_t width, size_t height, size_t levelCount)
+{
+    size_t size = 0;
+    for (size_t level = 0; level < levelCount; level++)
+    {
+        size_t levelWidth, levelHeight;
+        getLevelSize_rawTexture(width, height, level, &levelWidth, &levelHeight);
+        size += levelWidth * levelHeight * TEXEL_SIZE;
+    }
+
+    return size;
+}
+
+bool buildMipmaps_rawTexture(uint8_t* chain, size_t width, size_t height, size_t firstMissing, size_t levelCount)
+{
+    if (!chain || firstMissing == 0)
+    {
+        return false;
+    }
+
+    size_t previousWidth, previousHeight;
+    getLevelSize_rawTexture(width, height, firstMissing - 1, &previousWidth, &previousHeight);
+
+    const uint8_t* previous = chain + getSize_rawTexture(width, height, firstMissing - 1);
+    for (size_t level = firstMissing; level < levelCount; level++)
+    {
+        size_t levelWidth, levelHeight;
+        getLevelSize_rawTexture(width, height, level, &levelWidth, &levelHeight);
+
+        uint8_t* current = (uint8_t*) previous + previousWidth * previousHeight * TEXEL_SIZE;
+        for (size_t y = 0; y < levelHeight; y++)
+        {
+            // A level that is already 1 texel tall or wide only halves along the other axis
+            size_t y0 = previousHeight > 1 ? y * 2 : y;
+            size_t y1 = previousHeight > 1 ? y0 + 1 : y0;
+
+            for (size_t x = 0; x < levelWidth; x++)
+            {
+                size_t x0 = previousWidth > 1 ? x * 2 : x;
+                size_t x1 = previousWidth > 1 ? x0 + 1 : x0;
+
+                for (size_t channel = 0; channel < TEXEL_SIZE; channel++)
+                {
+                    unsigned sum = previous[(y0 * previousWidth + x0) * TEXEL_SIZE + channel] +
+                        previous[(y0 * previousWidth + x1) * TEXEL_SIZE + channel] +
+                        previous[(y1 * previousWidth + x0) * TEXEL_SIZE + channel] +
+                        previous[(y1 * previousWidth + x1) * TEXEL_SIZE + channel];
+
+                    current[(y * levelWidth + x) * TEXEL_SIZE + channel] = (sum + 2) / 4;
+                }
+            }
+        }
+
+        previous = current;
+        previousWidth = levelWidth;
+        previousHeight = levelHeight;
+    }
+
+    return true;
+}
+
+bool write_rawTexture(const char* fileName, const uint8_t* texels, size_t width, size_t height)
+{
+    if (!fileName || !texels || width == 0 || height == 0)
+    {
+        return false;
+    }
+
+    size_t levelCount = getLevelCount_rawTexture(width, height);
+    size_t size = getSize_rawTexture(width, height, levelCount);
+    uint8_t* chain = malloc(size);
+    if (!chain)
+    {
+        return false;
+    }
+
+    memcpy(chain, texels, width * height * TEXEL_SIZE);
+    buildMipmaps_rawTexture(chain, width, height, 1, levelCount);
+
+    FILE* file = fopen(fileName, "wb");
+    if (!file)
+    {
+        printf("write_rawTexture(): could not open %s\n", fileName);
+        free(chain);
+        return false;
+    }
+
+    rawTextureHeader header;
+    memcpy(header.magic, RAW_TEXTURE_MAGIC, sizeof(RAW_TEXTURE_MAGIC));
+    header.version = RAW_TEXTURE_VERSION;
+    header.width = width;
+    header.height = height;
+    header.levelCount = levelCount;
+    header.unused = 0;
+
+    bool isWritten = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(chain, size, 1, file) == 1;
+    isWritten = fclose(file) == 0 && isWritten;
+
+    free(chain);
+
+    return isWritten;
+}
+
+uint8_t* read_rawTexture(const char* fileName, size_t* outWidth, size_t* outHeight, size_t* outLevelCount)
+{
+    if (!fileName || !outWidth || !outHeight || !outLevelCount)
+    {
+        return NULL;
+    }
+
+    FILE* file = fopen(fileName, "rb");
+    if (!file)
+    {
+        return NULL;
+    }
+
+    rawTextureHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, RAW_TEXTURE_MAGIC, sizeof(RAW_TEXTURE_MAGIC)) != 0 || header.version != RAW_TEXTURE_VERSION ||
+        header.width == 0 || header.height == 0 || header.levelCount == 0 ||
+        header.levelCount > getLevelCount_rawTexture(header.width, header.height))
+    {
+        printf("read_rawTexture(): %s is not a raw texture\n", fileName);
+        fclose(file);
+        return NULL;
+    }
+
+    size_t size = getSize_rawTexture(header.width, header.height, header.levelCount);
+    uint8_t* chain = malloc(size);
+    if (!chain)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    if (fread(chain, size, 1, file) != 1)
+    {
+        printf("read_rawTexture(): %s is truncated\n", fileName);
+        free(chain);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+
+    *outWidth = header.width;
+    *outHeight = header.height;
+    *outLevelCount = header.levelCount;
+
+    return chain;
+}
@@ -1,87 +1,66 @@
 #include "engine/render.h"
 
+#include "datastructures/arena.h"
+#include "datastructures/pool.h"
 #include "engine/math/transform.h"
 #include "engine/math/vec.h"
+#include "engine/program.h"
+#include "engine/renderBackend.h"
+#include "engine/renderQueue.h"
 #include "engine/texture.h"
-#include "util/loadShaders.h"
 
-#include <OpenGL/gl3.h>
+#include <math.h>
+#include <stddef.h>
 #include <stdio.h>
 
-static const int INITIAL_INDEX = 0;
-static const int VERTEX_SIZE = 4;
-static const int VERTEX_COUNT = 6;
-static const int TIGHTLY_PACKED_ARRAY = 0;
-static const void* NO_INITIAL_OFFSET = NULL;
-static const int RESET = 0;
-static const int INVALID_UNIFORM = -1;
-
-static float quadVertices[VERTEX_COUNT][VERTEX_SIZE] = {
-    // Pos              // Tex
-    { -0.5f, -0.5f,     0.0f, 0.0f },
-    {  0.5f, -0.5f,     1.0f, 0.0f },
-    {  0.5f,  0.5f,     1.0f,  1.0f },
-
-    { -0.5f, -0.5f,     0.0f, 0.0f },
-    {  0.5f,  0.5f,     1.0f, 1.0f },
-    { -0.5f,  0.5f,     0.0f, 1.0f },
-};
-
-static uint32_t quadVertexArray = 0;
-static uint32_t quadVertexBuffer = 0;
-
 typedef struct _render
 {
     transform* t;
 
-    uint32_t shaderId;
-    int32_t mvpUniform;
-    int32_t sizeUniform;
-    int32_t imageUniform;
-    int32_t colorUniform;
+    program* program; // Shared with every other render that uses the same shaders
 
-    uint32_t textureId;
+    textureRegion texture; // The atlas page and region the render's texture is packed into
+    const textureRegion* region; // Either texture, or the requested texture the render follows
 
     MATRIX_TYPE(3, 3) size; // size.rows[0].x/size.rows[1].y are the x and y components of the render size
-} render;
+    vec3f color;
 
-render* create_render(transform* t, renderInfo rI)
-{
-    if (!t || GET_X(rI.size) <= 0.0f || GET_Y(rI.size) <= 0.0f || !rI.vertexShader || !rI.fragmentShader || rI.textureId == 0)
-    {
-        printf("create_render(): could not create render\n");
-        return NULL;
-    }
+    uint8_t layer;
+    float depth;
 
-    // Every render will use the same vao/vbo, but use a different model and texture
-    // to display them individually
-    if (quadVertexArray == 0)
-    {
-        // Create the OpenGL vao/vbos
-        glGenVertexArrays(1, &quadVertexArray);
-        glGenBuffers(1, &quadVertexBuffer);
+    pool* pool; // The pool the render was allocated from, or NULL if it was malloc'd
+} render;
 
-        // Link quadVertices to quadVertexBuffer
-        glBindBuffer(GL_ARRAY_BUFFER, quadVertexBuffer);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+/*
+Allocates and initializes a render
 
-        // Link quadVertexArray with quadVertexBuffer
-        glBindVertexArray(quadVertexArray);
+Arguments
+    pool* p: The pool to allocate the render from, or NULL to malloc it
 
-        // Define how the vertex data is stored
-        glEnableVertexAttribArray(INITIAL_INDEX);
-        glVertexAttribPointer(INITIAL_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, TIGHTLY_PACKED_ARRAY, NO_INITIAL_OFFSET);
+    transform* t: See create_render()
 
-        // Reset the buffer and vertex arrays inside OpenGL (does not delete the objects)
-        glBindBuffer(GL_ARRAY_BUFFER, RESET);
-        glBindVertexArray(RESET);
+    renderInfo rI: See create_render()
+
+Returns
+    Returns the new render or NULL if the render could not be created
+*/
+render* _create_render(pool* p, transform* t, renderInfo rI)
+{
+    const textureRegion* region = rI.textureHandle ? rI.textureHandle : &rI.texture;
+    bool hasShaderAssets = rI.vertexShaderAsset != INVALID_ASSET && rI.fragmentShaderAsset != INVALID_ASSET;
+    bool hasShaders = hasShaderAssets || (rI.vertexShader && rI.fragmentShader);
+    if (!t || GET_X(rI.size) <= 0.0f || GET_Y(rI.size) <= 0.0f || !hasShaders || region->textureId == 0)
+    {
+        printf("create_render(): could not create render\n");
+        return NULL;
     }
 
-    render* r = malloc(sizeof(render));
+    render* r = p ? alloc_pool(p) : malloc(sizeof(render));
     if (!r)
     {
         return NULL;
     }
+    r->pool = p;
 
     r->size = (MATRIX_TYPE(3, 3)) {{
         {GET_X(rI.size), 0, 0},
@@ -89,84 +68,304 @@ render* create_render(transform* t, renderInfo rI)
         {0, 0, 1},
     }};
 
+    r->color = to_vec3f(1.0f, 1.0f, 1.0f);
+    r->layer = 0;
+    r->depth = 0.0f;
+
     r->t = t;
 
-    // Load the actual shaders
-    ShaderInfo shaders[] = {
-        { GL_VERTEX_SHADER, rI.vertexShader },
-        { GL_FRAGMENT_SHADER, rI.fragmentShader },
-        { GL_NONE, NULL },
-    };
-    r->shaderId = loadShaders(shaders);
-    if (r->shaderId == 0)
+    // Compiling and linking only happens for the first render that uses these shaders
+    r->program = hasShaderAssets ?
+        getByAssets_program(rI.vertexShaderAsset, rI.fragmentShaderAsset) :
+        get_program(rI.vertexShader, rI.fragmentShader);
+    if (!r->program)
+    {
+        free_render(r);
+        return NULL;
+    }
+
+    r->texture = rI.texture;
+    r->region = rI.textureHandle ? rI.textureHandle : &r->texture;
+
+    return r;
+}
+
+render* create_render(transform* t, renderInfo rI)
+{
+    return _create_render(NULL, t, rI);
+}
+
+pool* createPool_render(size_t slabCapacity)
+{
+    return create_pool(sizeof(render), slabCapacity);
+}
+
+render* createFromPool_render(pool* p, transform* t, renderInfo rI)
+{
+    if (!p)
+    {
+        return NULL;
+    }
+
+    return _create_render(p, t, rI);
+}
+
+/*
+Fills in the per instance data of a render
+
+Arguments
+    renderInstance* instance: The instance data to fill in
+
+    render* r: The render to read the size, color and texture coordinates from
+
+    MATRIX_TYPE(3, 3)* model: The model matrix of the render
+*/
+void _setInstance_render(renderInstance* instance, render* r, MATRIX_TYPE(3, 3)* model)
+{
+    for (int column = 0; column < 3; column++)
+    {
+        for (int row = 0; row < 3; row++)
+        {
+            instance->model[column][row] = model->data[row][column];
+        }
+    }
+
+    instance->size[0] = r->size.data[0][0];
+    instance->size[1] = r->size.data[1][1];
+
+    instance->color[0] = GET_X(r->color);
+    instance->color[1] = GET_Y(r->color);
+    instance->color[2] = GET_Z(r->color);
+
+    instance->uvRect[0] = GET_X(r->region->uvMin);
+    instance->uvRect[1] = GET_Y(r->region->uvMin);
+    instance->uvRect[2] = GET_X(r->region->uvMax);
+    instance->uvRect[3] = GET_Y(r->region->uvMax);
+}
+
+bool free_render(render* r)
+{
+    if (!r)
     {
         return false;
     }
 
-    // Get the shader variable locations
-    r->mvpUniform   = glGetUniformLocation(r->shaderId, "mvp");
-    r->sizeUniform  = glGetUniformLocation(r->shaderId, "size");
-    r->imageUniform = glGetUniformLocation(r->shaderId, "image");
-    r->colorUniform = glGetUniformLocation(r->shaderId, "color");
+    release_program(r->program);
 
-    // Make sure all of the uniforms actually exist
-    if (r->mvpUniform   == INVALID_UNIFORM ||
-        r->sizeUniform  == INVALID_UNIFORM ||
-        r->imageUniform == INVALID_UNIFORM ||
-        r->colorUniform == INVALID_UNIFORM)
+    if (r->pool)
+    {
+        release_pool(r->pool, r);
+    }
+    else
     {
-        // TODO: free shaders, do some error handling
+        free(r);
     }
 
-    r->textureId = rI.textureId;
+    return true;
+}
 
-    return r;
+void setViewProjection_render(MATRIX_TYPE(3, 3)* viewProjection)
+{
+    if (!viewProjection)
+    {
+        return;
+    }
+
+    get_renderBackend()->setViewProjection(viewProjection);
+}
+
+bool setColor_render(render* r, vec3f color)
+{
+    if (!r)
+    {
+        return false;
+    }
+
+    r->color = color;
+
+    return true;
+}
+
+bool setLayer_render(render* r, uint8_t layer)
+{
+    if (!r)
+    {
+        return false;
+    }
+
+    r->layer = layer;
+
+    return true;
+}
+
+bool setDepth_render(render* r, float depth)
+{
+    if (!r)
+    {
+        return false;
+    }
+
+    r->depth = fminf(fmaxf(depth, 0.0f), 1.0f);
+
+    return true;
+}
+
+bool getBounds_render(render* r, vec2f* outMin, vec2f* outMax)
+{
+    if (!r || !outMin || !outMax)
+    {
+        return false;
+    }
+
+    getBounds_transform(r->t, to_vec2f(r->size.data[0][0], r->size.data[1][1]), outMin, outMax);
+
+    return true;
+}
+
+uint32_t getTextureId_render(render* r)
+{
+    if (!r)
+    {
+        return 0;
+    }
+
+    return r->region->textureId;
+}
+
+bool isBatched_render(render* r)
+{
+    if (!r || !r->program)
+    {
+        return false;
+    }
+
+    return r->program->isBatched;
 }
 
-void render_render(render* r, float aspect)
+uint64_t getSortKey_render(render* r)
 {
-    if (!r || r->shaderId == 0)
+    if (!r || !r->program)
+    {
+        return 0;
+    }
+
+    const uint64_t textureMask = (1ull << SORT_KEY_TEXTURE_BITS) - 1;
+    const uint64_t depthMask = (1ull << SORT_KEY_DEPTH_BITS) - 1;
+
+    // Texture ids that collide in the key only cost an extra bind, the texture itself is compared when drawing
+    return ((uint64_t) r->layer << SORT_KEY_LAYER_SHIFT) |
+        ((uint64_t) r->program->index << SORT_KEY_PROGRAM_SHIFT) |
+        (((uint64_t) r->region->textureId & textureMask) << SORT_KEY_TEXTURE_SHIFT) |
+        (((uint64_t) (r->depth * depthMask)) << SORT_KEY_DEPTH_SHIFT);
+}
+
+/*
+Makes a render's program and texture active, skipping whichever one is already active
+
+Arguments
+    const renderBackend* backend: The backend to draw with
+
+    render* r: The render whose program and texture should be active
+
+    program** boundProgram: The active program, which is updated
+
+    uint32_t* boundTexture: The id of the bound texture, which is updated
+*/
+void _bind_render(const renderBackend* backend, render* r, program** boundProgram, uint32_t* boundTexture)
+{
+    if (*boundProgram != r->program)
+    {
+        backend->useProgram(r->program);
+        *boundProgram = r->program;
+    }
+
+    if (*boundTexture != r->region->textureId)
+    {
+        backend->bindTexture(r->region->textureId);
+        *boundTexture = r->region->textureId;
+    }
+}
+
+bool record_render(render* r, program** outProgram, uint32_t* outTextureId, renderInstance* outInstance)
+{
+    if (!r || !outProgram || !outTextureId || !outInstance)
+    {
+        return false;
+    }
+
+    MATRIX_TYPE(3, 3) modelMat = getMatrix_transform(r->t);
+    _setInstance_render(outInstance, r, &modelMat);
+
+    *outProgram = r->program;
+    *outTextureId = r->region->textureId;
+
+    return true;
+}
+
+void render_render(render* r)
+{
+    if (!r || !r->program)
     {
         return;
     }
 
-    // Make this render's shader active
-    glUseProgram(r->shaderId);
+    const renderBackend* backend = get_renderBackend();
+
+    // Nothing is known to be bound, so the program and texture are always made active
+    program* boundProgram = NULL;
+    uint32_t boundTexture = 0;
+    _bind_render(backend, r, &boundProgram, &boundTexture);
 
+    renderInstance instance;
     MATRIX_TYPE(3, 3) modelMat = getMatrix_transform(r->t);
+    _setInstance_render(&instance, r, &modelMat);
 
-    // View TODO: replace with movable camera matrix
-    MATRIX_TYPE(3, 3) viewMat = {{
-        {1.0f, 0.0f, 0.0f},
-        {0.0f, 1.0f, 0.0f},
-        {0.0f, 0.0f, 1.0f},
-    }};
+    backend->draw(r->program, &instance, 1);
+}
 
-    MATRIX_TYPE(3, 3) projectionMat = {{
-        {aspect, 0.0f, 0.0f},
-        {0.0f, 1.0f, 0.0f},
-        {0.0f, 0.0f, 1.0f},
-    }};
+void renderAll_render(const renderQueue* q, arena* a)
+{
+    if (!q || q->count == 0 || !a)
+    {
+        return;
+    }
 
-    MATRIX_TYPE(3, 3) modelViewMat = MULTIPLY_MATRIX_FN(3, 3, 3)(&viewMat, &modelMat);
+    const renderCommand* commands = q->commands;
+    size_t count = q->count;
 
-    MATRIX_TYPE(3, 3) mvp = MULTIPLY_MATRIX_FN(3, 3, 3)(&projectionMat, &modelViewMat);
+    renderInstance* instances = alloc_arena(a, sizeof(renderInstance) * count);
+    if (!instances)
+    {
+        return;
+    }
 
-    // TODO: replace with user set color
-    vec3f color = to_vec3f(1.0f, 1.0f, 1.0f);
+    const renderBackend* backend = get_renderBackend();
 
-    // Set the uniform variables in the shader
-    glUniformMatrix3fv(r->mvpUniform,   1, GL_TRUE, (const GLfloat*) mvp.data);
-    glUniformMatrix3fv(r->sizeUniform,  1, GL_TRUE, (const GLfloat*) r->size.data);
-    glUniform3f(r->colorUniform, GET_X(color), GET_Y(color), GET_Z(color));
+    program* boundProgram = NULL;
+    uint32_t boundTexture = 0;
+
+    size_t first = 0;
+    while (first < count)
+    {
+        render* r = commands[first].r;
 
-    // Set the texture we want in the shader
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, r->textureId);
-    glUniform1i(r->imageUniform, 0);
+        // Find every following render that shares this render's program and texture
+        size_t end = first + 1;
+        while (end < count && commands[end].r->program == r->program && commands[end].r->region->textureId == r->region->textureId)
+        {
+            end++;
+        }
 
-    // Draw the quad
-    glBindVertexArray(quadVertexArray);
-    glDrawArrays(GL_TRIANGLES, INITIAL_INDEX, VERTEX_COUNT);
-    glBindVertexArray(RESET);
+        _bind_render(backend, r, &boundProgram, &boundTexture);
+
+        for (size_t i = first; i < end; i++)
+        {
+            MATRIX_TYPE(3, 3) modelMat = getMatrix_transform(commands[i].r->t);
+            _setInstance_render(&instances[i - first], commands[i].r, &modelMat);
+        }
+
+        backend->draw(r->program, instances, end - first);
+
+        first = end;
+    }
 }
@@ -0,0 +1,66 @@
+#include "engine/renderBackend.h"
+
+#include "engine/archive.h"
+#include "engine/program.h"
+#include "engine/renderBackendNull.h"
+#include "util/file.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const renderBackend* activeBackend = NULL;
+
+void set_renderBackend(const renderBackend* backend)
+{
+    activeBackend = backend;
+}
+
+bool describeProgram_renderBackend(program* p, const char* vertexShader)
+{
+    if (!p || !vertexShader)
+    {
+        return false;
+    }
+
+    // Shaders in the mounted archive are read in place
+    const char* source = getShader_archive(vertexShader);
+    char* fileSource = NULL;
+    if (!source)
+    {
+        source = fileSource = read_file(vertexShader, NULL);
+    }
+
+    if (!source)
+    {
+        printf("describeProgram_renderBackend(): could not read %s\n", vertexShader);
+        return false;
+    }
+
+    p->isInstanced = strstr(source, "instanceModel") != NULL;
+    p->isBatched = strstr(source, "vertexColor") != NULL;
+    p->hasCameraBlock = strstr(source, "uniform Camera") != NULL;
+
+    // Every uniform is set directly by the backend, so any location will do
+    p->modelUniform = 0;
+    p->mvpUniform = 0;
+    p->sizeUniform = 0;
+    p->imageUniform = 0;
+    p->colorUniform = 0;
+    p->uvRectUniform = 0;
+
+    free(fileSource);
+
+    return true;
+}
+
+const renderBackend* get_renderBackend()
+{
+    if (!activeBackend)
+    {
+        activeBackend = getNull_renderBackend();
+    }
+
+    return activeBackend;
+}
@@ -0,0 +1,437 @@
+#include "engine/renderBackendGL.h"
+
+#include "engine/program.h"
+#include "engine/rawTexture.h"
+#include "util/loadShaders.h"
+
+#include <OpenGL/gl3.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static const int INITIAL_INDEX = 0;
+static const int VERTEX_SIZE = 4;
+static const int VERTEX_COUNT = 6;
+static const int TIGHTLY_PACKED_ARRAY = 0;
+static const void* NO_INITIAL_OFFSET = NULL;
+static const int RESET = 0;
+static const int INVALID_UNIFORM = -1;
+static const size_t TEXEL_SIZE = 4; // RGBA
+
+// The attribute locations of the per instance data in instanced shaders, see resources/shaders/instanced.vert
+static const int INSTANCE_MODEL_ATTRIBUTE = 1; // A mat3 takes up 3 locations, one per column
+static const int INSTANCE_SIZE_ATTRIBUTE = 4;
+static const int INSTANCE_COLOR_ATTRIBUTE = 5;
+static const int INSTANCE_UV_RECT_ATTRIBUTE = 6;
+static const int PER_INSTANCE = 1;
+
+// The attribute locations of static batch vertices, see resources/shaders/static.vert
+static const int BATCH_COLOR_ATTRIBUTE = 1;
+
+static float quadVertices[VERTEX_COUNT][VERTEX_SIZE] = {
+    // Pos              // Tex
+    { -0.5f, -0.5f,     0.0f, 0.0f },
+    {  0.5f, -0.5f,     1.0f, 0.0f },
+    {  0.5f,  0.5f,     1.0f,  1.0f },
+
+    { -0.5f, -0.5f,     0.0f, 0.0f },
+    {  0.5f,  0.5f,     1.0f, 1.0f },
+    { -0.5f,  0.5f,     0.0f, 1.0f },
+};
+
+static uint32_t quadVertexArray = 0;
+static uint32_t quadVertexBuffer = 0;
+
+static uint32_t instanceVertexArray = 0;
+static uint32_t instanceBuffer = 0;
+
+// The uniform buffer backing the camera block of every program, see setViewProjection_render()
+static uint32_t cameraBuffer = 0;
+
+// A copy of the view projection matrix, for programs that take the whole mvp matrix instead of the camera block
+static MATRIX_TYPE(3, 3) viewProjectionMat = {{
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, 1.0f},
+}};
+
+/*
+Creates the vertex arrays every render is drawn with, the first time it is called
+*/
+void _createVertexArrays_glRenderBackend()
+{
+    // Every render will use the same vao/vbo, but use a different model and texture
+    // to display them individually
+    if (quadVertexArray == 0)
+    {
+        // Create the OpenGL vao/vbos
+        glGenVertexArrays(1, &quadVertexArray);
+        glGenBuffers(1, &quadVertexBuffer);
+
+        // Link quadVertices to quadVertexBuffer
+        glBindBuffer(GL_ARRAY_BUFFER, quadVertexBuffer);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+
+        // Link quadVertexArray with quadVertexBuffer
+        glBindVertexArray(quadVertexArray);
+
+        // Define how the vertex data is stored
+        glEnableVertexAttribArray(INITIAL_INDEX);
+        glVertexAttribPointer(INITIAL_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, TIGHTLY_PACKED_ARRAY, NO_INITIAL_OFFSET);
+
+        // Reset the buffer and vertex arrays inside OpenGL (does not delete the objects)
+        glBindBuffer(GL_ARRAY_BUFFER, RESET);
+        glBindVertexArray(RESET);
+    }
+
+    // Instanced renders share a second vao, which reads the same quad along with the per instance data
+    if (instanceVertexArray == 0)
+    {
+        glGenVertexArrays(1, &instanceVertexArray);
+        glGenBuffers(1, &instanceBuffer);
+
+        glBindVertexArray(instanceVertexArray);
+
+        glBindBuffer(GL_ARRAY_BUFFER, quadVertexBuffer);
+        glEnableVertexAttribArray(INITIAL_INDEX);
+        glVertexAttribPointer(INITIAL_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, TIGHTLY_PACKED_ARRAY, NO_INITIAL_OFFSET);
+
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        for (int column = 0; column < 3; column++)
+        {
+            glEnableVertexAttribArray(INSTANCE_MODEL_ATTRIBUTE + column);
+            glVertexAttribPointer(INSTANCE_MODEL_ATTRIBUTE + column, 3, GL_FLOAT, GL_FALSE, sizeof(renderInstance),
+                (const void*) (offsetof(renderInstance, model) + sizeof(GLfloat) * 3 * column));
+            glVertexAttribDivisor(INSTANCE_MODEL_ATTRIBUTE + column, PER_INSTANCE);
+        }
+
+        glEnableVertexAttribArray(INSTANCE_SIZE_ATTRIBUTE);
+        glVertexAttribPointer(INSTANCE_SIZE_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, sizeof(renderInstance), (const void*) offsetof(renderInstance, size));
+        glVertexAttribDivisor(INSTANCE_SIZE_ATTRIBUTE, PER_INSTANCE);
+
+        glEnableVertexAttribArray(INSTANCE_COLOR_ATTRIBUTE);
+        glVertexAttribPointer(INSTANCE_COLOR_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, sizeof(renderInstance), (const void*) offsetof(renderInstance, color));
+        glVertexAttribDivisor(INSTANCE_COLOR_ATTRIBUTE, PER_INSTANCE);
+
+        glEnableVertexAttribArray(INSTANCE_UV_RECT_ATTRIBUTE);
+        glVertexAttribPointer(INSTANCE_UV_RECT_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, sizeof(renderInstance), (const void*) offsetof(renderInstance, uvRect));
+        glVertexAttribDivisor(INSTANCE_UV_RECT_ATTRIBUTE, PER_INSTANCE);
+
+        glBindBuffer(GL_ARRAY_BUFFER, RESET);
+        glBindVertexArray(RESET);
+    }
+}
+
+bool _createProgram_glRenderBackend(program* p, const char* vertexShader, const char* fragmentShader)
+{
+    ShaderInfo shaders[] = {
+        { GL_VERTEX_SHADER, vertexShader },
+        { GL_FRAGMENT_SHADER, fragmentShader },
+        { GL_NONE, NULL },
+    };
+    p->id = loadShaders(shaders);
+    if (p->id == 0)
+    {
+        return false;
+    }
+
+    // The linked program keeps the compiled code, so the shaders are no longer needed
+    deleteShaders(shaders);
+
+    // Shaders that take the model, size, color and texture coordinates per instance are drawn in batches by renderAll_render()
+    p->isInstanced = glGetAttribLocation(p->id, "instanceModel") == INSTANCE_MODEL_ATTRIBUTE;
+
+    // Shaders that take world space vertices can draw static batches, see staticBatch.h
+    p->isBatched = glGetAttribLocation(p->id, "vertexColor") == BATCH_COLOR_ATTRIBUTE;
+
+    // Every program shares the same camera uniform buffer, so the view projection is uploaded once per frame
+    GLuint cameraBlock = glGetUniformBlockIndex(p->id, "Camera");
+    p->hasCameraBlock = cameraBlock != GL_INVALID_INDEX;
+    if (p->hasCameraBlock)
+    {
+        glUniformBlockBinding(p->id, cameraBlock, CAMERA_BLOCK_BINDING);
+    }
+
+    // Get the shader variable locations
+    p->modelUniform = glGetUniformLocation(p->id, "model");
+    p->mvpUniform   = glGetUniformLocation(p->id, "mvp");
+    p->sizeUniform  = glGetUniformLocation(p->id, "size");
+    p->imageUniform = glGetUniformLocation(p->id, "image");
+    p->colorUniform = glGetUniformLocation(p->id, "color");
+    p->uvRectUniform = glGetUniformLocation(p->id, "uvRect");
+
+    // Make sure all of the uniforms actually exist. Non instanced programs either take the model along
+    // with the camera block, or the whole mvp matrix
+    bool hasTransform = p->isInstanced || p->isBatched ?
+        p->hasCameraBlock :
+        (p->hasCameraBlock && p->modelUniform != INVALID_UNIFORM) || p->mvpUniform != INVALID_UNIFORM;
+
+    if ((p->isInstanced || p->isBatched) && (!hasTransform || p->imageUniform == INVALID_UNIFORM))
+    {
+        printf("get_program(): %s is missing the Camera block or image uniform\n", vertexShader);
+    }
+    else if (!p->isInstanced && !p->isBatched && (!hasTransform ||
+        p->sizeUniform  == INVALID_UNIFORM ||
+        p->imageUniform == INVALID_UNIFORM ||
+        p->colorUniform == INVALID_UNIFORM ||
+        p->uvRectUniform == INVALID_UNIFORM))
+    {
+        printf("get_program(): %s is missing the model, mvp, size, image, color or uvRect uniform\n", vertexShader);
+    }
+
+    return true;
+}
+
+void _deleteProgram_glRenderBackend(program* p)
+{
+    glDeleteProgram(p->id);
+}
+
+uint32_t _createTexture_glRenderBackend(size_t width, size_t height, size_t levelCount)
+{
+    levelCount = levelCount ? levelCount : 1;
+
+    // Clear the texture so any texels that are never updated are transparent
+    uint8_t* clear = calloc(width * height, TEXEL_SIZE);
+    if (!clear)
+    {
+        return 0;
+    }
+
+    // Create the OpenGL texture
+    uint32_t textureId;
+    glGenTextures(1, &textureId);
+
+    glBindTexture(GL_TEXTURE_2D, textureId);
+
+    // Linear interpolation, also between mip levels when minified
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+
+    // Don't tile the texture
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+
+    // Every level is smaller than the first, so they can all be cleared from the same texels
+    for (size_t level = 0; level < levelCount; level++)
+    {
+        size_t levelWidth, levelHeight;
+        getLevelSize_rawTexture(width, height, level, &levelWidth, &levelHeight);
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, levelWidth, levelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, clear);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    free(clear);
+
+    return textureId;
+}
+
+void _deleteTexture_glRenderBackend(uint32_t textureId)
+{
+    glDeleteTextures(1, &textureId);
+}
+
+void _updateTexture_glRenderBackend(uint32_t textureId, size_t level, size_t x, size_t y, size_t width, size_t height, const uint8_t* texels)
+{
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, texels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void _clear_glRenderBackend(float r, float g, float b, float a)
+{
+    glClearColor(r, g, b, a);
+    glClearDepthf(1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void _setViewProjection_glRenderBackend(MATRIX_TYPE(3, 3)* viewProjection)
+{
+    viewProjectionMat = *viewProjection;
+
+    if (cameraBuffer == 0)
+    {
+        glGenBuffers(1, &cameraBuffer);
+    }
+
+    // std140 stores each column of a mat3 as a vec4
+    GLfloat block[3][4] = {{ 0 }};
+    for (int column = 0; column < 3; column++)
+    {
+        for (int row = 0; row < 3; row++)
+        {
+            block[column][row] = viewProjection->data[row][column];
+        }
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(block), block, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, RESET);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BLOCK_BINDING, cameraBuffer);
+}
+
+void _useProgram_glRenderBackend(program* p)
+{
+    glUseProgram(p->id);
+
+    // Uniforms are kept by the program, so they only need to be set as it becomes active
+    glUniform1i(p->imageUniform, 0);
+}
+
+void _bindTexture_glRenderBackend(uint32_t textureId)
+{
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, textureId);
+}
+
+/*
+Draws a single render with a program that reads the model (or mvp), size, color and uvRect uniforms
+
+Arguments
+    program* p: The active program
+
+    const renderInstance* instance: The render to draw
+*/
+void _drawSingle_glRenderBackend(program* p, const renderInstance* instance)
+{
+    // Set the uniform variables in the shader. The camera block already holds the view projection,
+    // so only programs without it need the full mvp
+    if (p->hasCameraBlock && p->modelUniform != INVALID_UNIFORM)
+    {
+        glUniformMatrix3fv(p->modelUniform, 1, GL_FALSE, (const GLfloat*) instance->model);
+    }
+    else
+    {
+        MATRIX_TYPE(3, 3) modelMat;
+        for (int column = 0; column < 3; column++)
+        {
+            for (int row = 0; row < 3; row++)
+            {
+                modelMat.data[row][column] = instance->model[column][row];
+            }
+        }
+
+        MATRIX_TYPE(3, 3) mvp = MULTIPLY_MATRIX_FN(3, 3, 3)(&viewProjectionMat, &modelMat);
+        glUniformMatrix3fv(p->mvpUniform, 1, GL_TRUE, (const GLfloat*) mvp.data);
+    }
+
+    GLfloat size[3][3] = {
+        { instance->size[0], 0.0f, 0.0f },
+        { 0.0f, instance->size[1], 0.0f },
+        { 0.0f, 0.0f, 1.0f },
+    };
+    glUniformMatrix3fv(p->sizeUniform, 1, GL_FALSE, (const GLfloat*) size);
+    glUniform3fv(p->colorUniform, 1, instance->color);
+    glUniform4fv(p->uvRectUniform, 1, instance->uvRect);
+
+    // Draw the quad
+    glBindVertexArray(quadVertexArray);
+    glDrawArrays(GL_TRIANGLES, INITIAL_INDEX, VERTEX_COUNT);
+    glBindVertexArray(RESET);
+}
+
+void _draw_glRenderBackend(program* p, const renderInstance* instances, size_t count)
+{
+    _createVertexArrays_glRenderBackend();
+
+    // Programs that don't read per instance data are drawn one render at a time
+    if (!p->isInstanced)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            _drawSingle_glRenderBackend(p, &instances[i]);
+        }
+
+        return;
+    }
+
+    // Orphan the previous batch's data so the driver doesn't have to wait for the last draw
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(renderInstance) * count, instances, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, RESET);
+
+    glBindVertexArray(instanceVertexArray);
+    glDrawArraysInstanced(GL_TRIANGLES, INITIAL_INDEX, VERTEX_COUNT, count);
+    glBindVertexArray(RESET);
+}
+
+uint32_t _createBatch_glRenderBackend(const batchVertex* vertices, size_t count)
+{
+    GLuint vertexArray;
+    GLuint vertexBuffer;
+    glGenVertexArrays(1, &vertexArray);
+    glGenBuffers(1, &vertexBuffer);
+
+    // Static batches are uploaded once and drawn every frame until they are rebuilt
+    glBindVertexArray(vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(batchVertex) * count, vertices, GL_STATIC_DRAW);
+
+    // The position and texture coordinate are read together, like the unit quad's vertices
+    glEnableVertexAttribArray(INITIAL_INDEX);
+    glVertexAttribPointer(INITIAL_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, sizeof(batchVertex), (const void*) offsetof(batchVertex, position));
+
+    glEnableVertexAttribArray(BATCH_COLOR_ATTRIBUTE);
+    glVertexAttribPointer(BATCH_COLOR_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, sizeof(batchVertex), (const void*) offsetof(batchVertex, color));
+
+    glBindBuffer(GL_ARRAY_BUFFER, RESET);
+    glBindVertexArray(RESET);
+
+    return vertexArray;
+}
+
+void _deleteBatch_glRenderBackend(uint32_t batchId)
+{
+    // The vao remembers its buffer, so the buffer id doesn't need to be kept separately
+    GLint vertexBuffer = 0;
+    glBindVertexArray(batchId);
+    glGetVertexAttribiv(INITIAL_INDEX, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &vertexBuffer);
+    glBindVertexArray(RESET);
+
+    GLuint buffer = vertexBuffer;
+    glDeleteBuffers(1, &buffer);
+    glDeleteVertexArrays(1, &batchId);
+}
+
+void _drawBatch_glRenderBackend(program* p, uint32_t batchId, size_t vertexCount)
+{
+    glBindVertexArray(batchId);
+    glDrawArrays(GL_TRIANGLES, INITIAL_INDEX, vertexCount);
+    glBindVertexArray(RESET);
+}
+
+void _present_glRenderBackend()
+{
+    // The window's owner swaps the buffers, see gameEvents.onRenderEnd
+}
+
+static const renderBackend glBackend = {
+    "OpenGL",
+
+    _createProgram_glRenderBackend,
+    _deleteProgram_glRenderBackend,
+
+    _createTexture_glRenderBackend,
+    _deleteTexture_glRenderBackend,
+    _updateTexture_glRenderBackend,
+
+    _clear_glRenderBackend,
+    _setViewProjection_glRenderBackend,
+    _useProgram_glRenderBackend,
+    _bindTexture_glRenderBackend,
+    _draw_glRenderBackend,
+
+    _createBatch_glRenderBackend,
+    _deleteBatch_glRenderBackend,
+    _drawBatch_glRenderBackend,
+
+    _present_glRenderBackend,
+};
+
+const renderBackend* getGL_renderBackend()
+{
+    return &glBackend;
+}
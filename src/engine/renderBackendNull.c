@@ -0,0 +1,140 @@
+#include "engine/renderBackendNull.h"
+
+#include "engine/program.h"
+
+#include <stddef.h>
+
+static nullRenderBackendStats stats = { 0 };
+
+static uint32_t nextProgramId = 1;
+static uint32_t nextTextureId = 1;
+static uint32_t nextBatchId = 1;
+
+bool _createProgram_nullRenderBackend(program* p, const char* vertexShader, const char* fragmentShader)
+{
+    if (!describeProgram_renderBackend(p, vertexShader))
+    {
+        return false;
+    }
+
+    p->id = nextProgramId++;
+
+    stats.programs++;
+
+    return true;
+}
+
+void _deleteProgram_nullRenderBackend(program* p)
+{
+    stats.programs--;
+}
+
+uint32_t _createTexture_nullRenderBackend(size_t width, size_t height, size_t levelCount)
+{
+    stats.textures++;
+
+    return nextTextureId++;
+}
+
+void _deleteTexture_nullRenderBackend(uint32_t textureId)
+{
+    stats.textures--;
+}
+
+void _updateTexture_nullRenderBackend(uint32_t textureId, size_t level, size_t x, size_t y, size_t width, size_t height, const uint8_t* texels)
+{
+    if (level > 0)
+    {
+        stats.mipUpdates++;
+    }
+}
+
+void _clear_nullRenderBackend(float r, float g, float b, float a)
+{
+    stats.clears++;
+}
+
+void _setViewProjection_nullRenderBackend(MATRIX_TYPE(3, 3)* viewProjection) {}
+
+void _useProgram_nullRenderBackend(program* p)
+{
+    stats.programSwitches++;
+}
+
+void _bindTexture_nullRenderBackend(uint32_t textureId)
+{
+    stats.textureBinds++;
+}
+
+void _draw_nullRenderBackend(program* p, const renderInstance* instances, size_t count)
+{
+    // Programs that aren't instanced take one draw per render
+    stats.draws += p->isInstanced ? 1 : count;
+    stats.instances += count;
+}
+
+uint32_t _createBatch_nullRenderBackend(const batchVertex* vertices, size_t count)
+{
+    stats.batches++;
+
+    return nextBatchId++;
+}
+
+void _deleteBatch_nullRenderBackend(uint32_t batchId)
+{
+    stats.batches--;
+}
+
+void _drawBatch_nullRenderBackend(program* p, uint32_t batchId, size_t vertexCount)
+{
+    stats.batchDraws++;
+}
+
+void _present_nullRenderBackend()
+{
+    stats.frames++;
+}
+
+static const renderBackend nullBackend = {
+    "null",
+
+    _createProgram_nullRenderBackend,
+    _deleteProgram_nullRenderBackend,
+
+    _createTexture_nullRenderBackend,
+    _deleteTexture_nullRenderBackend,
+    _updateTexture_nullRenderBackend,
+
+    _clear_nullRenderBackend,
+    _setViewProjection_nullRenderBackend,
+    _useProgram_nullRenderBackend,
+    _bindTexture_nullRenderBackend,
+    _draw_nullRenderBackend,
+
+    _createBatch_nullRenderBackend,
+    _deleteBatch_nullRenderBackend,
+    _drawBatch_nullRenderBackend,
+
+    _present_nullRenderBackend,
+};
+
+const renderBackend* getNull_renderBackend()
+{
+    return &nullBackend;
+}
+
+nullRenderBackendStats getStats_nullRenderBackend()
+{
+    return stats;
+}
+
+void resetStats_nullRenderBackend()
+{
+    stats.frames = 0;
+    stats.clears = 0;
+    stats.programSwitches = 0;
+    stats.textureBinds = 0;
+    stats.draws = 0;
+    stats.instances = 0;
+    stats.batchDraws = 0;
+}
@@ -0,0 +1,1116 @@
+#include "engine/renderBackendSoftware.h"
+
+#include "engine/program.h"
+
+#include <math.h>
+#include <png.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static const size_t TILE_SIZE = 64;
+static const size_t TEXEL_SIZE = 4; // RGBA
+
+typedef struct _softwareTexture
+{
+    size_t width;
+    size_t height;
+
+    uint8_t* texels; // Row-major, the first row is at texture coordinate 0
+} softwareTexture;
+
+// A static batch, kept as the renders its quads were built from
+typedef struct _softwareBatch
+{
+    renderInstance* instances; // NULL once the batch has been deleted
+    size_t count;
+} softwareBatch;
+
+// A render that has been drawn this frame, ready to be rasterized
+typedef struct _softwareQuad
+{
+    // Takes a pixel into quad space, where the quad covers (0, 0) to (1, 1). Row-major 2x3 affine matrix
+    float toQuad[2][3];
+
+    // The pixels the quad may cover, clamped to the framebuffer. The max is exclusive.
+    size_t minX;
+    size_t minY;
+    size_t maxX;
+    size_t maxY;
+
+    float uvMin[2];
+    float uvMax[2];
+    float color[4];
+
+    uint32_t textureId;
+} softwareQuad;
+
+static uint8_t* framebuffer = NULL;
+static size_t framebufferWidth = 0;
+static size_t framebufferHeight = 0;
+
+static softwareTexture* textures = NULL; // Texture ids are an index into textures plus one
+static size_t texturesCount = 0;
+static size_t texturesCapacity = 0;
+
+static softwareBatch* batches = NULL; // Batch ids are an index into batches plus one
+static size_t batchesCount = 0;
+static size_t batchesCapacity = 0;
+
+static softwareQuad* quads = NULL;
+static size_t quadsCount = 0;
+static size_t quadsCapacity = 0;
+
+static bool hasClear = false;
+static uint8_t clearColor[4];
+
+static MATRIX_TYPE(3, 3) viewProjectionMat = {{
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, 1.0f},
+}};
+static uint32_t boundTexture = 0;
+
+// The quads that overlap each tile, in the order they were drawn. The quads of tile i are the indices
+// tileQuads[tileStarts[i]] up to tileQuads[tileStarts[i + 1]]. Rebuilt by every present
+static size_t* tileStarts = NULL;
+static size_t tileStartsCapacity = 0;
+static size_t* tileQuads = NULL;
+static size_t tileQuadsCapacity = 0;
+
+static atomic_size_t nextTile;
+
+// The threads that rasterize tiles along with the thread that presents. They live from init_softwareRenderBackend()
+// to free_softwareRenderBackend(), and are woken up once per present
+static pthread_t* workers = NULL;
+static size_t workerCount = 0;
+static pthread_mutex_t workerMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t frameStarted = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t frameFinished = PTHREAD_COND_INITIALIZER;
+static uint64_t frameIndex = 0; // Bumped by every present, so workers know there is a new frame to rasterize
+static size_t busyWorkers = 0; // The workers that haven't finished rasterizing the current frame
+static bool isStopping = false;
+
+/*
+Converts a color channel between 0 and 1 to a byte
+*/
+uint8_t _toByte_softwareRenderBackend(float channel)
+{
+    return (uint8_t) (fminf(fmaxf(channel, 0.0f), 1.0f) * 255.0f + 0.5f);
+}
+
+bool _createProgram_softwareRenderBackend(program* p, const char* vertexShader, const char* fragmentShader)
+{
+    if (!describeProgram_renderBackend(p, vertexShader))
+    {
+        return false;
+    }
+
+    // Every program runs the same fixed pipeline, so the id only has to be non zero
+    p->id = 1;
+
+    return true;
+}
+
+void _deleteProgram_softwareRenderBackend(program* p) {}
+
+uint32_t _createTexture_softwareRenderBackend(size_t width, size_t height, size_t levelCount)
+{
+    if (texturesCount == texturesCapacity)
+    {
+        size_t capacity = texturesCapacity ? texturesCapacity * 2 : 4;
+        softwareTexture* resized = realloc(textures, sizeof(softwareTexture) * capacity);
+        if (!resized)
+        {
+            return 0;
+        }
+
+        textures = resized;
+        texturesCapacity = capacity;
+    }
+
+    // New textures are transparent
+    uint8_t* texels = calloc(width * height, TEXEL_SIZE);
+    if (!texels)
+    {
+        return 0;
+    }
+
+    textures[texturesCount] = (softwareTexture) { width, height, texels };
+    texturesCount++;
+
+    return texturesCount;
+}
+
+void _deleteTexture_softwareRenderBackend(uint32_t textureId)
+{
+    if (textureId == 0 || textureId > texturesCount)
+    {
+        return;
+    }
+
+    // Ids are never reused, so the slot is only emptied
+    free(textures[textureId - 1].texels);
+    textures[textureId - 1] = (softwareTexture) { 0, 0, NULL };
+}
+
+void _updateTexture_softwareRenderBackend(uint32_t textureId, size_t level, size_t x, size_t y, size_t width, size_t height, const uint8_t* texels)
+{
+    // Only the first level is kept, since quads are always sampled from it
+    if (textureId == 0 || textureId > texturesCount || level > 0)
+    {
+        return;
+    }
+
+    softwareTexture* t = &textures[textureId - 1];
+    if (x + width > t->width || y + height > t->height)
+    {
+        return;
+    }
+
+    for (size_t row = 0; row < height; row++)
+    {
+        memcpy(&t->texels[((y + row) * t->width + x) * TEXEL_SIZE], &texels[row * width * TEXEL_SIZE], width * TEXEL_SIZE);
+    }
+}
+
+void _clear_softwareRenderBackend(float r, float g, float b, float a)
+{
+    // Everything drawn before the clear would be covered by it
+    quadsCount = 0;
+
+    hasClear = true;
+    clearColor[0] = _toByte_softwareRenderBackend(r);
+    clearColor[1] = _toByte_softwareRenderBackend(g);
+    clearColor[2] = _toByte_softwareRenderBackend(b);
+    clearColor[3] = _toByte_softwareRenderBackend(a);
+}
+
+void _setViewProjection_softwareRenderBackend(MATRIX_TYPE(3, 3)* viewProjection)
+{
+    viewProjectionMat = *viewProjection;
+}
+
+void _useProgram_softwareRenderBackend(program* p) {}
+
+void _bindTexture_softwareRenderBackend(uint32_t textureId)
+{
+    boundTexture = textureId;
+}
+
+/*
+Builds the quad a render is rasterized as
+
+Arguments
+    const renderInstance* instance: The render
+
+    softwareQuad* outQuad: The quad
+
+Returns
+    Returns false if the render doesn't cover any pixels
+*/
+bool _createQuad_softwareRenderBackend(const renderInstance* instance, softwareQuad* outQuad)
+{
+    // Quad space is offset by half so the quad is centered on the model's origin, like resources/shaders/instanced.vert
+    MATRIX_TYPE(3, 3) size = {{
+        {instance->size[0], 0.0f, -0.5f * instance->size[0]},
+        {0.0f, instance->size[1], -0.5f * instance->size[1]},
+        {0.0f, 0.0f, 1.0f},
+    }};
+
+    MATRIX_TYPE(3, 3) model;
+    for (int column = 0; column < 3; column++)
+    {
+        for (int row = 0; row < 3; row++)
+        {
+            model.data[row][column] = instance->model[column][row];
+        }
+    }
+
+    // Clip space to pixels, with the bottom row of the framebuffer at -1
+    MATRIX_TYPE(3, 3) viewport = {{
+        {0.5f * framebufferWidth, 0.0f, 0.5f * framebufferWidth},
+        {0.0f, 0.5f * framebufferHeight, 0.5f * framebufferHeight},
+        {0.0f, 0.0f, 1.0f},
+    }};
+
+    MATRIX_TYPE(3, 3) modelSize = MULTIPLY_MATRIX_FN(3, 3, 3)(&model, &size);
+    MATRIX_TYPE(3, 3) mvp = MULTIPLY_MATRIX_FN(3, 3, 3)(&viewProjectionMat, &modelSize);
+    MATRIX_TYPE(3, 3) toPixels = MULTIPLY_MATRIX_FN(3, 3, 3)(&viewport, &mvp);
+
+    float a = toPixels.data[0][0], b = toPixels.data[0][1], tx = toPixels.data[0][2];
+    float c = toPixels.data[1][0], d = toPixels.data[1][1], ty = toPixels.data[1][2];
+
+    float det = a * d - b * c;
+    if (fabsf(det) < 1e-12f)
+    {
+        return false;
+    }
+
+    // Invert the affine matrix so pixels can be mapped back into quad space
+    float invDet = 1.0f / det;
+    outQuad->toQuad[0][0] = d * invDet;
+    outQuad->toQuad[0][1] = -b * invDet;
+    outQuad->toQuad[1][0] = -c * invDet;
+    outQuad->toQuad[1][1] = a * invDet;
+    outQuad->toQuad[0][2] = -(outQuad->toQuad[0][0] * tx + outQuad->toQuad[0][1] * ty);
+    outQuad->toQuad[1][2] = -(outQuad->toQuad[1][0] * tx + outQuad->toQuad[1][1] * ty);
+
+    // The bounds of the quad's corners
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (int corner = 0; corner < 4; corner++)
+    {
+        float s = corner & 1;
+        float t = corner >> 1;
+        float x = a * s + b * t + tx;
+        float y = c * s + d * t + ty;
+
+        minX = fminf(minX, x);
+        minY = fminf(minY, y);
+        maxX = fmaxf(maxX, x);
+        maxY = fmaxf(maxY, y);
+    }
+
+    if (maxX <= 0.0f || maxY <= 0.0f || minX >= framebufferWidth || minY >= framebufferHeight)
+    {
+        return false;
+    }
+
+    outQuad->minX = minX > 0.0f ? (size_t) minX : 0;
+    outQuad->minY = minY > 0.0f ? (size_t) minY : 0;
+    outQuad->maxX = maxX < framebufferWidth ? (size_t) ceilf(maxX) : framebufferWidth;
+    outQuad->maxY = maxY < framebufferHeight ? (size_t) ceilf(maxY) : framebufferHeight;
+
+    outQuad->uvMin[0] = instance->uvRect[0];
+    outQuad->uvMin[1] = instance->uvRect[1];
+    outQuad->uvMax[0] = instance->uvRect[2];
+    outQuad->uvMax[1] = instance->uvRect[3];
+
+    outQuad->color[0] = instance->color[0];
+    outQuad->color[1] = instance->color[1];
+    outQuad->color[2] = instance->color[2];
+    outQuad->color[3] = 1.0f;
+
+    return true;
+}
+
+void _draw_softwareRenderBackend(program* p, const renderInstance* instances, size_t count)
+{
+    if (!framebuffer)
+    {
+        return;
+    }
+
+    if (quadsCount + count > quadsCapacity)
+    {
+        size_t capacity = quadsCapacity ? quadsCapacity : 64;
+        while (capacity < quadsCount + count)
+        {
+            capacity *= 2;
+        }
+
+        softwareQuad* resized = realloc(quads, sizeof(softwareQuad) * capacity);
+        if (!resized)
+        {
+            return;
+        }
+
+        quads = resized;
+        quadsCapacity = capacity;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (_createQuad_softwareRenderBackend(&instances[i], &quads[quadsCount]))
+        {
+            quads[quadsCount].textureId = boundTexture;
+            quadsCount++;
+        }
+    }
+}
+
+uint32_t _createBatch_softwareRenderBackend(const batchVertex* vertices, size_t count)
+{
+    // Reuse the slot of a deleted batch if there is one
+    size_t index = 0;
+    while (index < batchesCount && batches[index].instances)
+    {
+        index++;
+    }
+
+    if (index == batchesCapacity)
+    {
+        size_t capacity = batchesCapacity ? batchesCapacity * 2 : 4;
+        softwareBatch* resized = realloc(batches, sizeof(softwareBatch) * capacity);
+        if (!resized)
+        {
+            return 0;
+        }
+
+        batches = resized;
+        batchesCapacity = capacity;
+    }
+
+    size_t quadCount = count / 6;
+    renderInstance* instances = malloc(sizeof(renderInstance) * (quadCount ? quadCount : 1));
+    if (!instances)
+    {
+        return 0;
+    }
+
+    // Each quad is rebuilt as a unit sized render whose model matrix maps the unit quad onto its corners,
+    // so batches are rasterized exactly like every other render
+    for (size_t i = 0; i < quadCount; i++)
+    {
+        const batchVertex* lowerLeft = &vertices[i * 6];
+        const batchVertex* lowerRight = &vertices[i * 6 + 1];
+        const batchVertex* upperRight = &vertices[i * 6 + 2];
+        const batchVertex* upperLeft = &vertices[i * 6 + 5];
+
+        renderInstance* instance = &instances[i];
+        for (int axis = 0; axis < 2; axis++)
+        {
+            instance->model[0][axis] = lowerRight->position[axis] - lowerLeft->position[axis];
+            instance->model[1][axis] = upperLeft->position[axis] - lowerLeft->position[axis];
+            instance->model[2][axis] = 0.5f * (lowerLeft->position[axis] + upperRight->position[axis]);
+        }
+        instance->model[0][2] = 0.0f;
+        instance->model[1][2] = 0.0f;
+        instance->model[2][2] = 1.0f;
+
+        instance->size[0] = 1.0f;
+        instance->size[1] = 1.0f;
+
+        memcpy(instance->color, lowerLeft->color, sizeof(instance->color));
+
+        instance->uvRect[0] = lowerLeft->uv[0];
+        instance->uvRect[1] = lowerLeft->uv[1];
+        instance->uvRect[2] = upperRight->uv[0];
+        instance->uvRect[3] = upperRight->uv[1];
+    }
+
+    batches[index] = (softwareBatch) { instances, quadCount };
+    if (index == batchesCount)
+    {
+        batchesCount++;
+    }
+
+    return index + 1;
+}
+
+void _deleteBatch_softwareRenderBackend(uint32_t batchId)
+{
+    if (batchId == 0 || batchId > batchesCount)
+    {
+        return;
+    }
+
+    free(batches[batchId - 1].instances);
+    batches[batchId - 1] = (softwareBatch) { NULL, 0 };
+}
+
+void _drawBatch_softwareRenderBackend(program* p, uint32_t batchId, size_t vertexCount)
+{
+    if (batchId == 0 || batchId > batchesCount || !batches[batchId - 1].instances)
+    {
+        return;
+    }
+
+    _draw_softwareRenderBackend(p, batches[batchId - 1].instances, batches[batchId - 1].count);
+}
+
+/*
+Narrows a span of pixels to the pixels where a linear function of x stays within [0, 1]
+
+Arguments
+    float value: The value of the function at pixel 0
+
+    float step: The change in the function from one pixel to the next
+
+    float* start: The first pixel of the span, which is updated
+
+    float* end: One past the last pixel of the span, which is updated
+*/
+void _clipSpan_softwareRenderBackend(float value, float step, float* start, float* end)
+{
+    if (step == 0.0f)
+    {
+        if (value < 0.0f || value > 1.0f)
+        {
+            *end = *start;
+        }
+
+        return;
+    }
+
+    float first = (0.0f - value) / step;
+    float last = (1.0f - value) / step;
+    if (step < 0.0f)
+    {
+        float swap = first;
+        first = last;
+        last = swap;
+    }
+
+    *start = fmaxf(*start, ceilf(first));
+    *end = fminf(*end, floorf(last) + 1.0f);
+}
+
+#if defined(__SSE2__)
+// The number of pixels filled together, one per SSE lane
+#define SPAN_LANES 4
+
+/*
+Loads the texels of 4 pixels into the lanes of a register, with transparent black for texels outside of the texture
+*/
+static inline __m128i _loadTexels_softwareRenderBackend(const softwareTexture* t, const int32_t* xs, const int32_t* ys)
+{
+    uint32_t texels[SPAN_LANES];
+    for (int i = 0; i < SPAN_LANES; i++)
+    {
+        if (xs[i] < 0 || ys[i] < 0 || xs[i] >= (long) t->width || ys[i] >= (long) t->height)
+        {
+            texels[i] = 0;
+        }
+        else
+        {
+            memcpy(&texels[i], &t->texels[((size_t) ys[i] * t->width + xs[i]) * TEXEL_SIZE], sizeof(uint32_t));
+        }
+    }
+
+    return _mm_loadu_si128((const __m128i*) texels);
+}
+
+/*
+Gets one channel of 4 texels as floats
+*/
+static inline __m128 _channel_softwareRenderBackend(__m128i texels, int channel)
+{
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+
+    return _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(texels, channel * 8), byteMask));
+}
+
+/*
+Rounds 4 floats down to whole numbers. SSE2 only truncates towards zero, which rounds negative numbers up.
+*/
+static inline __m128 _floor_softwareRenderBackend(__m128 values)
+{
+    __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(values));
+
+    return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, values), _mm_set1_ps(1.0f)));
+}
+
+/*
+Fills a span of pixels with a quad, sampling its texture bilinearly. 4 pixels are filtered and shaded at a
+time, with one pixel in each SSE lane and each channel in its own register. The last pixels of a span that
+don't fill every lane are shaded the same way and copied out on their own.
+
+Arguments
+    const softwareQuad* q: The quad
+
+    const softwareTexture* t: The quad's texture
+
+    uint8_t* out: The first pixel of the span
+
+    size_t count: The number of pixels in the span
+
+    float s: The quad space s coordinate of the first pixel's center
+
+    float tCoord: The quad space t coordinate of the first pixel's center
+
+    float ds: The change in s from one pixel to the next
+
+    float dt: The change in t from one pixel to the next
+*/
+void _fillSpan_softwareRenderBackend(const softwareQuad* q, const softwareTexture* t, uint8_t* out, size_t count,
+    float s, float tCoord, float ds, float dt)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 maxChannel = _mm_set1_ps(255.0f);
+
+    // Texel space, offset by half a texel so texel centers land on whole numbers. u only depends on s,
+    // and v only on t, so both step linearly along the span
+    float u = (q->uvMin[0] + (q->uvMax[0] - q->uvMin[0]) * s) * t->width - 0.5f;
+    float v = (q->uvMin[1] + (q->uvMax[1] - q->uvMin[1]) * tCoord) * t->height - 0.5f;
+    float du = (q->uvMax[0] - q->uvMin[0]) * ds * t->width;
+    float dv = (q->uvMax[1] - q->uvMin[1]) * dt * t->height;
+
+    __m128 us = _mm_add_ps(_mm_set1_ps(u), _mm_mul_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps(du)));
+    __m128 vs = _mm_add_ps(_mm_set1_ps(v), _mm_mul_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps(dv)));
+    const __m128 stepU = _mm_set1_ps(du * SPAN_LANES);
+    const __m128 stepV = _mm_set1_ps(dv * SPAN_LANES);
+
+    for (size_t i = 0; i < count; i += SPAN_LANES)
+    {
+        __m128 fx = _floor_softwareRenderBackend(us);
+        __m128 fy = _floor_softwareRenderBackend(vs);
+        __m128 wx = _mm_sub_ps(us, fx);
+        __m128 wy = _mm_sub_ps(vs, fy);
+
+        int32_t xs[SPAN_LANES];
+        int32_t ys[SPAN_LANES];
+        int32_t nextXs[SPAN_LANES];
+        int32_t nextYs[SPAN_LANES];
+        _mm_storeu_si128((__m128i*) xs, _mm_cvttps_epi32(fx));
+        _mm_storeu_si128((__m128i*) ys, _mm_cvttps_epi32(fy));
+        for (int lane = 0; lane < SPAN_LANES; lane++)
+        {
+            nextXs[lane] = xs[lane] + 1;
+            nextYs[lane] = ys[lane] + 1;
+        }
+
+        __m128i bottomLeft = _loadTexels_softwareRenderBackend(t, xs, ys);
+        __m128i bottomRight = _loadTexels_softwareRenderBackend(t, nextXs, ys);
+        __m128i topLeft = _loadTexels_softwareRenderBackend(t, xs, nextYs);
+        __m128i topRight = _loadTexels_softwareRenderBackend(t, nextXs, nextYs);
+
+        // Filter and shade each channel of all 4 pixels, then pack it into its byte of the pixels
+        __m128i pixels = _mm_setzero_si128();
+        for (int channel = 0; channel < 4; channel++)
+        {
+            __m128 bottom = _mm_add_ps(
+                _mm_mul_ps(_channel_softwareRenderBackend(bottomLeft, channel), _mm_sub_ps(one, wx)),
+                _mm_mul_ps(_channel_softwareRenderBackend(bottomRight, channel), wx));
+            __m128 top = _mm_add_ps(
+                _mm_mul_ps(_channel_softwareRenderBackend(topLeft, channel), _mm_sub_ps(one, wx)),
+                _mm_mul_ps(_channel_softwareRenderBackend(topRight, channel), wx));
+            __m128 texel = _mm_add_ps(_mm_mul_ps(bottom, _mm_sub_ps(one, wy)), _mm_mul_ps(top, wy));
+
+            // Texels are loaded between 0 and 255, so shading by the color keeps them in byte range
+            __m128 shaded = _mm_min_ps(_mm_max_ps(_mm_mul_ps(texel, _mm_set1_ps(q->color[channel])), zero), maxChannel);
+            pixels = _mm_or_si128(pixels, _mm_slli_epi32(_mm_cvtps_epi32(shaded), channel * 8));
+        }
+
+        if (count - i >= SPAN_LANES)
+        {
+            _mm_storeu_si128((__m128i*) &out[i * TEXEL_SIZE], pixels);
+        }
+        else
+        {
+            uint8_t last[SPAN_LANES * TEXEL_SIZE];
+            _mm_storeu_si128((__m128i*) last, pixels);
+            memcpy(&out[i * TEXEL_SIZE], last, (count - i) * TEXEL_SIZE);
+        }
+
+        us = _mm_add_ps(us, stepU);
+        vs = _mm_add_ps(vs, stepV);
+    }
+}
+#else
+/*
+Gets a channel of a texel, or 0 if it is outside of the texture
+*/
+static inline float _texel_softwareRenderBackend(const softwareTexture* t, long x, long y, int channel)
+{
+    if (x < 0 || y < 0 || x >= (long) t->width || y >= (long) t->height)
+    {
+        return 0.0f;
+    }
+
+    return t->texels[(y * t->width + x) * TEXEL_SIZE + channel];
+}
+
+/*
+Fills a span of pixels with a quad, sampling its texture bilinearly
+
+Arguments
+    See the SSE version above
+*/
+void _fillSpan_softwareRenderBackend(const softwareQuad* q, const softwareTexture* t, uint8_t* out, size_t count,
+    float s, float tCoord, float ds, float dt)
+{
+    float u = (q->uvMin[0] + (q->uvMax[0] - q->uvMin[0]) * s) * t->width - 0.5f;
+    float v = (q->uvMin[1] + (q->uvMax[1] - q->uvMin[1]) * tCoord) * t->height - 0.5f;
+    float du = (q->uvMax[0] - q->uvMin[0]) * ds * t->width;
+    float dv = (q->uvMax[1] - q->uvMin[1]) * dt * t->height;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        float fx = floorf(u);
+        float fy = floorf(v);
+        long x = (long) fx;
+        long y = (long) fy;
+        float wx = u - fx;
+        float wy = v - fy;
+
+        for (int channel = 0; channel < 4; channel++)
+        {
+            float bottom = _texel_softwareRenderBackend(t, x, y, channel) * (1.0f - wx) + _texel_softwareRenderBackend(t, x + 1, y, channel) * wx;
+            float top = _texel_softwareRenderBackend(t, x, y + 1, channel) * (1.0f - wx) + _texel_softwareRenderBackend(t, x + 1, y + 1, channel) * wx;
+            float texel = bottom * (1.0f - wy) + top * wy;
+
+            out[i * TEXEL_SIZE + channel] = _toByte_softwareRenderBackend(texel / 255.0f * q->color[channel]);
+        }
+
+        u += du;
+        v += dv;
+    }
+}
+#endif
+
+/*
+Rasterizes the part of a quad that lies in a tile
+
+Arguments
+    const softwareQuad* q: The quad
+
+    size_t tileX: The left edge of the tile
+
+    size_t tileY: The bottom edge of the tile
+
+    size_t tileMaxX: The right edge of the tile, exclusive
+
+    size_t tileMaxY: The top edge of the tile, exclusive
+*/
+void _rasterizeQuad_softwareRenderBackend(const softwareQuad* q, size_t tileX, size_t tileY, size_t tileMaxX, size_t tileMaxY)
+{
+    if (q->textureId == 0 || q->textureId > texturesCount || !textures[q->textureId - 1].texels)
+    {
+        return;
+    }
+    const softwareTexture* t = &textures[q->textureId - 1];
+
+    size_t minY = q->minY > tileY ? q->minY : tileY;
+    size_t maxY = q->maxY < tileMaxY ? q->maxY : tileMaxY;
+    size_t minX = q->minX > tileX ? q->minX : tileX;
+    size_t maxX = q->maxX < tileMaxX ? q->maxX : tileMaxX;
+
+    float ds = q->toQuad[0][0];
+    float dt = q->toQuad[1][0];
+
+    for (size_t y = minY; y < maxY; y++)
+    {
+        // Quad space at the center of this row's first pixel
+        float centerY = y + 0.5f;
+        float s0 = q->toQuad[0][0] * 0.5f + q->toQuad[0][1] * centerY + q->toQuad[0][2];
+        float t0 = q->toQuad[1][0] * 0.5f + q->toQuad[1][1] * centerY + q->toQuad[1][2];
+
+        // The quad covers the pixels where both s and t are between 0 and 1
+        float start = minX;
+        float end = maxX;
+        _clipSpan_softwareRenderBackend(s0, ds, &start, &end);
+        _clipSpan_softwareRenderBackend(t0, dt, &start, &end);
+        if (end <= start)
+        {
+            continue;
+        }
+
+        size_t first = (size_t) start;
+        size_t count = (size_t) end - first;
+        uint8_t* out = &framebuffer[(y * framebufferWidth + first) * TEXEL_SIZE];
+
+        _fillSpan_softwareRenderBackend(q, t, out, count, s0 + ds * first, t0 + dt * first, ds, dt);
+    }
+}
+
+/*
+Puts every quad into the list of each tile it overlaps, see tileQuads. Quads are added in the order they were
+drawn, so every list keeps that order.
+
+Arguments
+    size_t tilesX: The number of tiles in a row
+
+    size_t tileCount: The number of tiles
+
+Returns
+    Returns false if memory allocation failed
+*/
+bool _binQuads_softwareRenderBackend(size_t tilesX, size_t tileCount)
+{
+    if (tileCount + 1 > tileStartsCapacity)
+    {
+        size_t* resized = realloc(tileStarts, sizeof(size_t) * (tileCount + 1));
+        if (!resized)
+        {
+            return false;
+        }
+
+        tileStarts = resized;
+        tileStartsCapacity = tileCount + 1;
+    }
+
+    // Count the quads of each tile, then turn the counts into where each tile's list starts
+    memset(tileStarts, 0, sizeof(size_t) * (tileCount + 1));
+    for (size_t i = 0; i < quadsCount; i++)
+    {
+        const softwareQuad* q = &quads[i];
+        if (q->maxX <= q->minX || q->maxY <= q->minY)
+        {
+            continue;
+        }
+
+        for (size_t ty = q->minY / TILE_SIZE; ty <= (q->maxY - 1) / TILE_SIZE; ty++)
+        {
+            for (size_t tx = q->minX / TILE_SIZE; tx <= (q->maxX - 1) / TILE_SIZE; tx++)
+            {
+                tileStarts[ty * tilesX + tx + 1]++;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < tileCount; i++)
+    {
+        tileStarts[i + 1] += tileStarts[i];
+    }
+
+    size_t binnedCount = tileStarts[tileCount];
+    if (binnedCount > tileQuadsCapacity)
+    {
+        size_t* resized = realloc(tileQuads, sizeof(size_t) * binnedCount);
+        if (!resized)
+        {
+            return false;
+        }
+
+        tileQuads = resized;
+        tileQuadsCapacity = binnedCount;
+    }
+
+    // Fill each list, stepping the start of every tile forward as it is filled, then step the starts back
+    for (size_t i = 0; i < quadsCount; i++)
+    {
+        const softwareQuad* q = &quads[i];
+        if (q->maxX <= q->minX || q->maxY <= q->minY)
+        {
+            continue;
+        }
+
+        for (size_t ty = q->minY / TILE_SIZE; ty <= (q->maxY - 1) / TILE_SIZE; ty++)
+        {
+            for (size_t tx = q->minX / TILE_SIZE; tx <= (q->maxX - 1) / TILE_SIZE; tx++)
+            {
+                tileQuads[tileStarts[ty * tilesX + tx]++] = i;
+            }
+        }
+    }
+
+    for (size_t i = tileCount; i > 0; i--)
+    {
+        tileStarts[i] = tileStarts[i - 1];
+    }
+    tileStarts[0] = 0;
+
+    return true;
+}
+
+/*
+Rasterizes tiles until every tile of the frame has been taken. The quads must have been binned into their
+tiles by _binQuads_softwareRenderBackend()
+*/
+void _rasterizeTiles_softwareRenderBackend()
+{
+    size_t tilesX = (framebufferWidth + TILE_SIZE - 1) / TILE_SIZE;
+    size_t tilesY = (framebufferHeight + TILE_SIZE - 1) / TILE_SIZE;
+    size_t tileCount = tilesX * tilesY;
+
+    for (size_t tile = atomic_fetch_add(&nextTile, 1); tile < tileCount; tile = atomic_fetch_add(&nextTile, 1))
+    {
+        size_t tileX = (tile % tilesX) * TILE_SIZE;
+        size_t tileY = (tile / tilesX) * TILE_SIZE;
+        size_t tileMaxX = tileX + TILE_SIZE < framebufferWidth ? tileX + TILE_SIZE : framebufferWidth;
+        size_t tileMaxY = tileY + TILE_SIZE < framebufferHeight ? tileY + TILE_SIZE : framebufferHeight;
+
+        if (hasClear)
+        {
+            for (size_t y = tileY; y < tileMaxY; y++)
+            {
+                for (size_t x = tileX; x < tileMaxX; x++)
+                {
+                    memcpy(&framebuffer[(y * framebufferWidth + x) * TEXEL_SIZE], clearColor, TEXEL_SIZE);
+                }
+            }
+        }
+
+        // Quads are rasterized in the order they were drawn, so later draws cover earlier ones
+        for (size_t i = tileStarts[tile]; i < tileStarts[tile + 1]; i++)
+        {
+            _rasterizeQuad_softwareRenderBackend(&quads[tileQuads[i]], tileX, tileY, tileMaxX, tileMaxY);
+        }
+    }
+}
+
+/*
+A worker's main loop. Rasterizes tiles each time a frame is presented, until the workers are stopped
+
+Arguments
+    void* startFrame: The frameIndex when the worker was started, as a uintptr_t. The worker may only get to
+        run after the next present has begun, which it must not miss
+
+Returns
+    Returns NULL
+*/
+void* _runWorker_softwareRenderBackend(void* startFrame)
+{
+    uint64_t lastFrame = (uintptr_t) startFrame;
+    pthread_mutex_lock(&workerMutex);
+    while (true)
+    {
+        while (!isStopping && frameIndex == lastFrame)
+        {
+            pthread_cond_wait(&frameStarted, &workerMutex);
+        }
+
+        if (isStopping)
+        {
+            break;
+        }
+        lastFrame = frameIndex;
+
+        pthread_mutex_unlock(&workerMutex);
+        _rasterizeTiles_softwareRenderBackend();
+        pthread_mutex_lock(&workerMutex);
+
+        busyWorkers--;
+        if (busyWorkers == 0)
+        {
+            pthread_cond_signal(&frameFinished);
+        }
+    }
+    pthread_mutex_unlock(&workerMutex);
+
+    return NULL;
+}
+
+/*
+Stops and joins every worker
+*/
+void _stopWorkers_softwareRenderBackend()
+{
+    pthread_mutex_lock(&workerMutex);
+    isStopping = true;
+    pthread_cond_broadcast(&frameStarted);
+    pthread_mutex_unlock(&workerMutex);
+
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+
+    free(workers);
+    workers = NULL;
+    workerCount = 0;
+    isStopping = false;
+}
+
+/*
+Starts the workers that rasterize along with the presenting thread, replacing any that are running
+
+Arguments
+    size_t threadCount: The number of threads that rasterize each frame, including the presenting thread
+
+Returns
+    Returns false if memory allocation failed. Workers that could not be created are left out, since the
+    presenting thread rasterizes every tile that no worker takes
+*/
+bool _startWorkers_softwareRenderBackend(size_t threadCount)
+{
+    _stopWorkers_softwareRenderBackend();
+
+    if (threadCount <= 1)
+    {
+        return true;
+    }
+
+    workers = malloc(sizeof(pthread_t) * (threadCount - 1));
+    if (!workers)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i + 1 < threadCount; i++)
+    {
+        if (pthread_create(&workers[workerCount], NULL, _runWorker_softwareRenderBackend, (void*) (uintptr_t) frameIndex) == 0)
+        {
+            workerCount++;
+        }
+    }
+
+    return true;
+}
+
+void _present_softwareRenderBackend()
+{
+    if (!framebuffer)
+    {
+        return;
+    }
+
+    size_t tilesX = (framebufferWidth + TILE_SIZE - 1) / TILE_SIZE;
+    size_t tilesY = (framebufferHeight + TILE_SIZE - 1) / TILE_SIZE;
+    if (!_binQuads_softwareRenderBackend(tilesX, tilesX * tilesY))
+    {
+        printf("_present_softwareRenderBackend(): could not bin the quads into tiles\n");
+        quadsCount = 0;
+        hasClear = false;
+        return;
+    }
+
+    atomic_store(&nextTile, 0);
+
+    // Wake the workers, then rasterize on this thread too until every tile has been taken
+    pthread_mutex_lock(&workerMutex);
+    busyWorkers = workerCount;
+    frameIndex++;
+    pthread_cond_broadcast(&frameStarted);
+    pthread_mutex_unlock(&workerMutex);
+
+    _rasterizeTiles_softwareRenderBackend();
+
+    pthread_mutex_lock(&workerMutex);
+    while (busyWorkers > 0)
+    {
+        pthread_cond_wait(&frameFinished, &workerMutex);
+    }
+    pthread_mutex_unlock(&workerMutex);
+
+    quadsCount = 0;
+    hasClear = false;
+}
+
+static const renderBackend softwareBackend = {
+    "software",
+
+    _createProgram_softwareRenderBackend,
+    _deleteProgram_softwareRenderBackend,
+
+    _createTexture_softwareRenderBackend,
+    _deleteTexture_softwareRenderBackend,
+    _updateTexture_softwareRenderBackend,
+
+    _clear_softwareRenderBackend,
+    _setViewProjection_softwareRenderBackend,
+    _useProgram_softwareRenderBackend,
+    _bindTexture_softwareRenderBackend,
+    _draw_softwareRenderBackend,
+
+    _createBatch_softwareRenderBackend,
+    _deleteBatch_softwareRenderBackend,
+    _drawBatch_softwareRenderBackend,
+
+    _present_softwareRenderBackend,
+};
+
+bool init_softwareRenderBackend(size_t width, size_t height, size_t threadCount)
+{
+    if (width == 0 || height == 0)
+    {
+        return false;
+    }
+
+    uint8_t* resized = realloc(framebuffer, width * height * TEXEL_SIZE);
+    if (!resized)
+    {
+        return false;
+    }
+
+    framebuffer = resized;
+    framebufferWidth = width;
+    framebufferHeight = height;
+    memset(framebuffer, 0, width * height * TEXEL_SIZE);
+
+    if (threadCount == 0)
+    {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        threadCount = processors > 0 ? processors : 1;
+    }
+
+    return _startWorkers_softwareRenderBackend(threadCount);
+}
+
+void free_softwareRenderBackend()
+{
+    _stopWorkers_softwareRenderBackend();
+
+    for (size_t i = 0; i < texturesCount; i++)
+    {
+        free(textures[i].texels);
+    }
+    free(textures);
+    textures = NULL;
+    texturesCount = 0;
+    texturesCapacity = 0;
+
+    for (size_t i = 0; i < batchesCount; i++)
+    {
+        free(batches[i].instances);
+    }
+    free(batches);
+    batches = NULL;
+    batchesCount = 0;
+    batchesCapacity = 0;
+
+    free(quads);
+    quads = NULL;
+    quadsCount = 0;
+    quadsCapacity = 0;
+
+    free(tileStarts);
+    tileStarts = NULL;
+    tileStartsCapacity = 0;
+    free(tileQuads);
+    tileQuads = NULL;
+    tileQuadsCapacity = 0;
+
+    free(framebuffer);
+    framebuffer = NULL;
+    framebufferWidth = 0;
+    framebufferHeight = 0;
+
+    hasClear = false;
+    boundTexture = 0;
+}
+
+const renderBackend* getSoftware_renderBackend()
+{
+    return &softwareBackend;
+}
+
+const uint8_t* getFramebuffer_softwareRenderBackend(size_t* outWidth, size_t* outHeight)
+{
+    if (outWidth)
+    {
+        *outWidth = framebufferWidth;
+    }
+
+    if (outHeight)
+    {
+        *outHeight = framebufferHeight;
+    }
+
+    return framebuffer;
+}
+
+bool writeFramebuffer_softwareRenderBackend(const char* fileName)
+{
+    if (!fileName || !framebuffer)
+    {
+        return false;
+    }
+
+    png_image image;
+    memset(&image, 0, (sizeof image));
+
+    image.version = PNG_IMAGE_VERSION;
+    image.width = framebufferWidth;
+    image.height = framebufferHeight;
+    image.format = PNG_FORMAT_RGBA;
+
+    // A negative row stride tells libpng the bottom row comes first
+    png_int_32 rowStride = -(png_int_32) (framebufferWidth * TEXEL_SIZE);
+    if (png_image_write_to_file(&image, fileName, 0, framebuffer, rowStride, NULL) == 0)
+    {
+        printf("writeFramebuffer_softwareRenderBackend(): could not write %s\n", fileName);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,112 @@
+#include "engine/renderQueue.h"
+
+#include "datastructures/arena.h"
+#include "engine/util.h"
+
+#include <string.h>
+
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+bool create_renderQueue(renderQueue* q, size_t capacity, arena* a)
+{
+    if (!q || !a)
+    {
+        return false;
+    }
+
+    q->count = 0;
+    q->capacity = capacity;
+    q->commands = NULL;
+
+    if (capacity == 0)
+    {
+        return true;
+    }
+
+    q->commands = alloc_arena(a, sizeof(renderCommand) * capacity);
+
+    return q->commands != NULL;
+}
+
+bool push_renderQueue(renderQueue* q, uint64_t key, render* r)
+{
+    if (!q || !r || q->count == q->capacity)
+    {
+        return false;
+    }
+
+    q->commands[q->count++] = (renderCommand) { key, r };
+
+    return true;
+}
+
+bool sort_renderQueue(renderQueue* q, arena* a)
+{
+    if (!q || !a)
+    {
+        return false;
+    }
+
+    if (q->count <= 1)
+    {
+        return true;
+    }
+
+    renderCommand* scratch = alloc_arena(a, sizeof(renderCommand) * q->count);
+    size_t (*histograms)[RADIX_SIZE] = alloc_arena(a, sizeof(size_t) * RADIX_SIZE * RADIX_PASSES);
+    if (!scratch || !histograms)
+    {
+        return false;
+    }
+
+    // Count every byte of every key in a single pass
+    memset(histograms, 0, sizeof(size_t) * RADIX_SIZE * RADIX_PASSES);
+    for (size_t i = 0; i < q->count; i++)
+    {
+        uint64_t key = q->commands[i].key;
+        for (int pass = 0; pass < RADIX_PASSES; pass++)
+        {
+            histograms[pass][(key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)]++;
+        }
+    }
+
+    renderCommand* in = q->commands;
+    renderCommand* out = scratch;
+    for (int pass = 0; pass < RADIX_PASSES; pass++)
+    {
+        size_t* histogram = histograms[pass];
+
+        // When every key has the same byte the pass wouldn't move anything
+        uint64_t firstByte = (in[0].key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1);
+        if (histogram[firstByte] == q->count)
+        {
+            continue;
+        }
+
+        // Turn the counts into the index each byte value starts at
+        size_t offset = 0;
+        for (int i = 0; i < RADIX_SIZE; i++)
+        {
+            size_t count = histogram[i];
+            histogram[i] = offset;
+            offset += count;
+        }
+
+        for (size_t i = 0; i < q->count; i++)
+        {
+            out[histogram[(in[i].key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)]++] = in[i];
+        }
+
+        SWAP(in, out);
+    }
+
+    // An odd number of passes leaves the sorted commands in the scratch memory
+    if (in != q->commands)
+    {
+        memcpy(q->commands, in, sizeof(renderCommand) * q->count);
+    }
+
+    return true;
+}
@@ -0,0 +1,685 @@
+#include "engine/renderThread.h"
+
+#include "engine/render.h"
+#include "engine/renderBackend.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+typedef enum _frameState
+{
+    FRAME_FREE,
+    FRAME_RECORDING,
+    FRAME_PENDING,
+    FRAME_DRAWING,
+} frameState;
+
+typedef void (*renderThreadJob)(void* args);
+
+struct _renderThread
+{
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t changed; // Broadcast whenever a frame changes state, a job is posted or finished, or the thread is stopped
+
+    renderThreadEvents events;
+    void* userdata;
+
+    const renderBackend* backend; // Only ever called on the render thread
+
+    // Frames are recorded and drawn in alternating order
+    renderFrame frames[2];
+    frameState states[2];
+    size_t recordIndex;
+    size_t drawIndex;
+
+    // A backend call forwarded from another thread. Only one call is posted at a time
+    renderThreadJob job;
+    void* jobArgs;
+    uint64_t jobsPosted;
+    uint64_t jobsDone;
+
+    bool stop;
+};
+
+// The render thread the forwarding backend forwards to
+static renderThread* runningThread = NULL;
+
+/*
+Runs a backend call on the render thread, and waits for it to finish. Calls made on the render thread
+itself are run directly.
+
+Arguments
+    renderThreadJob job: The function that makes the backend call
+
+    void* args: The arguments of the call, which job writes its result into
+*/
+void _call_renderThread(renderThreadJob job, void* args)
+{
+    renderThread* rt = runningThread;
+    if (pthread_equal(pthread_self(), rt->thread))
+    {
+        job(args);
+        return;
+    }
+
+    pthread_mutex_lock(&rt->mutex);
+
+    while (rt->job)
+    {
+        pthread_cond_wait(&rt->changed, &rt->mutex);
+    }
+
+    rt->job = job;
+    rt->jobArgs = args;
+    uint64_t ticket = ++rt->jobsPosted;
+    pthread_cond_broadcast(&rt->changed);
+
+    while (rt->jobsDone < ticket)
+    {
+        pthread_cond_wait(&rt->changed, &rt->mutex);
+    }
+
+    pthread_mutex_unlock(&rt->mutex);
+}
+
+// The arguments and results of each forwarded backend call
+
+typedef struct _createProgramCall
+{
+    program* p;
+    const char* vertexShader;
+    const char* fragmentShader;
+    bool result;
+} createProgramCall;
+
+typedef struct _createTextureCall
+{
+    size_t width;
+    size_t height;
+    size_t levelCount;
+    uint32_t result;
+} createTextureCall;
+
+typedef struct _updateTextureCall
+{
+    uint32_t textureId;
+    size_t level;
+    size_t x;
+    size_t y;
+    size_t width;
+    size_t height;
+    const uint8_t* texels;
+} updateTextureCall;
+
+typedef struct _batchCall
+{
+    const batchVertex* vertices;
+    size_t count;
+    uint32_t batchId;
+    program* p;
+} batchCall;
+
+typedef struct _drawCall
+{
+    program* p;
+    uint32_t textureId;
+    const renderInstance* instances;
+    size_t count;
+    float color[4];
+    MATRIX_TYPE(3, 3)* viewProjection;
+} drawCall;
+
+void _runCreateProgram_renderThread(void* args)
+{
+    createProgramCall* c = args;
+    c->result = runningThread->backend->createProgram(c->p, c->vertexShader, c->fragmentShader);
+}
+
+void _runDeleteProgram_renderThread(void* args)
+{
+    runningThread->backend->deleteProgram(args);
+}
+
+void _runCreateTexture_renderThread(void* args)
+{
+    createTextureCall* c = args;
+    c->result = runningThread->backend->createTexture(c->width, c->height, c->levelCount);
+}
+
+void _runDeleteTexture_renderThread(void* args)
+{
+    createTextureCall* c = args;
+    runningThread->backend->deleteTexture(c->result);
+}
+
+void _runUpdateTexture_renderThread(void* args)
+{
+    updateTextureCall* c = args;
+    runningThread->backend->updateTexture(c->textureId, c->level, c->x, c->y, c->width, c->height, c->texels);
+}
+
+void _runClear_renderThread(void* args)
+{
+    drawCall* c = args;
+    runningThread->backend->clear(c->color[0], c->color[1], c->color[2], c->color[3]);
+}
+
+void _runSetViewProjection_renderThread(void* args)
+{
+    drawCall* c = args;
+    runningThread->backend->setViewProjection(c->viewProjection);
+}
+
+void _runUseProgram_renderThread(void* args)
+{
+    runningThread->backend->useProgram(args);
+}
+
+void _runBindTexture_renderThread(void* args)
+{
+    drawCall* c = args;
+    runningThread->backend->bindTexture(c->textureId);
+}
+
+void _runDraw_renderThread(void* args)
+{
+    drawCall* c = args;
+    runningThread->backend->draw(c->p, c->instances, c->count);
+}
+
+void _runCreateBatch_renderThread(void* args)
+{
+    batchCall* c = args;
+    c->batchId = runningThread->backend->createBatch(c->vertices, c->count);
+}
+
+void _runDeleteBatch_renderThread(void* args)
+{
+    batchCall* c = args;
+    runningThread->backend->deleteBatch(c->batchId);
+}
+
+void _runDrawBatch_renderThread(void* args)
+{
+    batchCall* c = args;
+    runningThread->backend->drawBatch(c->p, c->batchId, c->count);
+}
+
+void _runPresent_renderThread(void* args)
+{
+    runningThread->backend->present();
+}
+
+bool _createProgram_renderThread(program* p, const char* vertexShader, const char* fragmentShader)
+{
+    createProgramCall c = { p, vertexShader, fragmentShader, false };
+    _call_renderThread(_runCreateProgram_renderThread, &c);
+
+    return c.result;
+}
+
+void _deleteProgram_renderThread(program* p)
+{
+    _call_renderThread(_runDeleteProgram_renderThread, p);
+}
+
+uint32_t _createTexture_renderThread(size_t width, size_t height, size_t levelCount)
+{
+    createTextureCall c = { width, height, levelCount, 0 };
+    _call_renderThread(_runCreateTexture_renderThread, &c);
+
+    return c.result;
+}
+
+void _deleteTexture_renderThread(uint32_t textureId)
+{
+    createTextureCall c = { 0, 0, 0, textureId };
+    _call_renderThread(_runDeleteTexture_renderThread, &c);
+}
+
+void _updateTexture_renderThread(uint32_t textureId, size_t level, size_t x, size_t y, size_t width, size_t height, const uint8_t* texels)
+{
+    updateTextureCall c = { textureId, level, x, y, width, height, texels };
+    _call_renderThread(_runUpdateTexture_renderThread, &c);
+}
+
+void _clear_renderThread(float r, float g, float b, float a)
+{
+    drawCall c = { .color = { r, g, b, a } };
+    _call_renderThread(_runClear_renderThread, &c);
+}
+
+void _setViewProjection_renderThread(MATRIX_TYPE(3, 3)* viewProjection)
+{
+    drawCall c = { .viewProjection = viewProjection };
+    _call_renderThread(_runSetViewProjection_renderThread, &c);
+}
+
+void _useProgram_renderThread(program* p)
+{
+    _call_renderThread(_runUseProgram_renderThread, p);
+}
+
+void _bindTexture_renderThread(uint32_t textureId)
+{
+    drawCall c = { .textureId = textureId };
+    _call_renderThread(_runBindTexture_renderThread, &c);
+}
+
+void _draw_renderThread(program* p, const renderInstance* instances, size_t count)
+{
+    drawCall c = { .p = p, .instances = instances, .count = count };
+    _call_renderThread(_runDraw_renderThread, &c);
+}
+
+uint32_t _createBatch_renderThread(const batchVertex* vertices, size_t count)
+{
+    batchCall c = { .vertices = vertices, .count = count };
+    _call_renderThread(_runCreateBatch_renderThread, &c);
+
+    return c.batchId;
+}
+
+void _deleteBatch_renderThread(uint32_t batchId)
+{
+    batchCall c = { .batchId = batchId };
+    _call_renderThread(_runDeleteBatch_renderThread, &c);
+}
+
+void _drawBatch_renderThread(program* p, uint32_t batchId, size_t vertexCount)
+{
+    batchCall c = { .p = p, .batchId = batchId, .count = vertexCount };
+    _call_renderThread(_runDrawBatch_renderThread, &c);
+}
+
+void _present_renderThread()
+{
+    _call_renderThread(_runPresent_renderThread, NULL);
+}
+
+// The backend that is active while a render thread runs
+static const renderBackend forwardingBackend = {
+    "render thread",
+
+    _createProgram_renderThread,
+    _deleteProgram_renderThread,
+
+    _createTexture_renderThread,
+    _deleteTexture_renderThread,
+    _updateTexture_renderThread,
+
+    _clear_renderThread,
+    _setViewProjection_renderThread,
+    _useProgram_renderThread,
+    _bindTexture_renderThread,
+    _draw_renderThread,
+
+    _createBatch_renderThread,
+    _deleteBatch_renderThread,
+    _drawBatch_renderThread,
+
+    _present_renderThread,
+};
+
+/*
+Draws a frame with the render thread's backend. Consecutive commands that share a program and texture are
+drawn together, like renderAll_render(), and static batches are drawn in between them where they were recorded
+
+Arguments
+    renderThread* rt: The render thread
+
+    renderFrame* f: The frame to draw
+*/
+void _drawFrame_renderThread(renderThread* rt, renderFrame* f)
+{
+    const renderBackend* backend = rt->backend;
+
+    backend->clear(0.0f, 0.0f, 0.0f, 1.0f);
+    backend->setViewProjection(&f->viewProjection);
+
+    program* boundProgram = NULL;
+    uint32_t boundTexture = 0;
+
+    size_t batch = 0;
+    size_t first = 0;
+    while (first < f->count || batch < f->batchCount)
+    {
+        // Draw the batches that were recorded before the next command
+        for (; batch < f->batchCount && f->batches[batch].commandIndex <= first; batch++)
+        {
+            renderBatchCommand* command = &f->batches[batch];
+
+            if (boundProgram != command->p)
+            {
+                backend->useProgram(command->p);
+                boundProgram = command->p;
+            }
+
+            if (boundTexture != command->textureId)
+            {
+                backend->bindTexture(command->textureId);
+                boundTexture = command->textureId;
+            }
+
+            backend->drawBatch(command->p, command->batchId, command->vertexCount);
+        }
+
+        if (first == f->count)
+        {
+            break;
+        }
+
+        program* p = f->programs[first];
+        uint32_t textureId = f->textureIds[first];
+
+        // Commands are only drawn together up to the next batch
+        size_t last = batch < f->batchCount ? f->batches[batch].commandIndex : f->count;
+        size_t end = first + 1;
+        while (end < last && f->programs[end] == p && f->textureIds[end] == textureId)
+        {
+            end++;
+        }
+
+        if (boundProgram != p)
+        {
+            backend->useProgram(p);
+            boundProgram = p;
+        }
+
+        if (boundTexture != textureId)
+        {
+            backend->bindTexture(textureId);
+            boundTexture = textureId;
+        }
+
+        backend->draw(p, &f->instances[first], end - first);
+
+        first = end;
+    }
+
+    backend->present();
+
+    if (rt->events.onPresent)
+    {
+        rt->events.onPresent(rt->userdata);
+    }
+}
+
+/*
+The render thread's main loop. Draws frames as they are submitted, and runs forwarded backend calls
+once no submitted frame is left to draw
+
+Arguments
+    void* args: The render thread
+
+Returns
+    Returns NULL
+*/
+void* _run_renderThread(void* args)
+{
+    renderThread* rt = args;
+
+    if (rt->events.onStart)
+    {
+        rt->events.onStart(rt->userdata);
+    }
+
+    pthread_mutex_lock(&rt->mutex);
+    while (true)
+    {
+        size_t index = rt->drawIndex;
+
+        if (rt->states[index] == FRAME_PENDING)
+        {
+            rt->states[index] = FRAME_DRAWING;
+            pthread_mutex_unlock(&rt->mutex);
+
+            _drawFrame_renderThread(rt, &rt->frames[index]);
+
+            pthread_mutex_lock(&rt->mutex);
+            rt->states[index] = FRAME_FREE;
+            rt->drawIndex = 1 - index;
+            pthread_cond_broadcast(&rt->changed);
+        }
+        else if (rt->job)
+        {
+            // The caller is blocked until the job is done, so its arguments stay valid
+            renderThreadJob job = rt->job;
+            void* jobArgs = rt->jobArgs;
+            pthread_mutex_unlock(&rt->mutex);
+
+            job(jobArgs);
+
+            pthread_mutex_lock(&rt->mutex);
+            rt->job = NULL;
+            rt->jobsDone++;
+            pthread_cond_broadcast(&rt->changed);
+        }
+        else if (rt->stop)
+        {
+            break;
+        }
+        else
+        {
+            pthread_cond_wait(&rt->changed, &rt->mutex);
+        }
+    }
+    pthread_mutex_unlock(&rt->mutex);
+
+    if (rt->events.onStop)
+    {
+        rt->events.onStop(rt->userdata);
+    }
+
+    return NULL;
+}
+
+renderThread* create_renderThread(renderThreadEvents events, void* userdata)
+{
+    if (runningThread)
+    {
+        return NULL;
+    }
+
+    renderThread* rt = calloc(1, sizeof(renderThread));
+    if (!rt)
+    {
+        return NULL;
+    }
+
+    rt->events = events;
+    rt->userdata = userdata;
+    rt->backend = get_renderBackend();
+
+    if (pthread_mutex_init(&rt->mutex, NULL) != 0)
+    {
+        free(rt);
+        return NULL;
+    }
+
+    if (pthread_cond_init(&rt->changed, NULL) != 0)
+    {
+        pthread_mutex_destroy(&rt->mutex);
+        free(rt);
+        return NULL;
+    }
+
+    runningThread = rt;
+    if (pthread_create(&rt->thread, NULL, _run_renderThread, rt) != 0)
+    {
+        runningThread = NULL;
+        pthread_cond_destroy(&rt->changed);
+        pthread_mutex_destroy(&rt->mutex);
+        free(rt);
+        return NULL;
+    }
+
+    set_renderBackend(&forwardingBackend);
+
+    return rt;
+}
+
+bool free_renderThread(renderThread* rt)
+{
+    if (!rt)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&rt->mutex);
+    rt->stop = true;
+    pthread_cond_broadcast(&rt->changed);
+    pthread_mutex_unlock(&rt->mutex);
+
+    pthread_join(rt->thread, NULL);
+
+    set_renderBackend(rt->backend);
+    runningThread = NULL;
+
+    for (int i = 0; i < 2; i++)
+    {
+        free(rt->frames[i].programs);
+        free(rt->frames[i].textureIds);
+        free(rt->frames[i].instances);
+        free(rt->frames[i].batches);
+    }
+
+    pthread_cond_destroy(&rt->changed);
+    pthread_mutex_destroy(&rt->mutex);
+    free(rt);
+
+    return true;
+}
+
+renderFrame* beginFrame_renderThread(renderThread* rt)
+{
+    if (!rt)
+    {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&rt->mutex);
+
+    size_t index = rt->recordIndex;
+    while (rt->states[index] != FRAME_FREE && rt->states[index] != FRAME_RECORDING)
+    {
+        pthread_cond_wait(&rt->changed, &rt->mutex);
+    }
+
+    if (rt->states[index] == FRAME_FREE)
+    {
+        rt->states[index] = FRAME_RECORDING;
+        rt->frames[index].count = 0;
+        rt->frames[index].batchCount = 0;
+    }
+
+    pthread_mutex_unlock(&rt->mutex);
+
+    return &rt->frames[index];
+}
+
+bool submit_renderThread(renderThread* rt)
+{
+    if (!rt)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&rt->mutex);
+
+    size_t index = rt->recordIndex;
+    bool isRecording = rt->states[index] == FRAME_RECORDING;
+    if (isRecording)
+    {
+        rt->states[index] = FRAME_PENDING;
+        rt->recordIndex = 1 - index;
+        pthread_cond_broadcast(&rt->changed);
+    }
+
+    pthread_mutex_unlock(&rt->mutex);
+
+    return isRecording;
+}
+
+bool push_renderFrame(renderFrame* f, render* r)
+{
+    if (!f || !r)
+    {
+        return false;
+    }
+
+    if (f->count == f->capacity)
+    {
+        size_t capacity = f->capacity ? f->capacity * 2 : 64;
+
+        program** programs = realloc(f->programs, sizeof(program*) * capacity);
+        if (!programs)
+        {
+            return false;
+        }
+        f->programs = programs;
+
+        uint32_t* textureIds = realloc(f->textureIds, sizeof(uint32_t) * capacity);
+        if (!textureIds)
+        {
+            return false;
+        }
+        f->textureIds = textureIds;
+
+        renderInstance* instances = realloc(f->instances, sizeof(renderInstance) * capacity);
+        if (!instances)
+        {
+            return false;
+        }
+        f->instances = instances;
+
+        f->capacity = capacity;
+    }
+
+    if (!record_render(r, &f->programs[f->count], &f->textureIds[f->count], &f->instances[f->count]))
+    {
+        return false;
+    }
+
+    f->count++;
+
+    return true;
+}
+
+bool pushBatch_renderFrame(renderFrame* f, renderBatchCommand batch)
+{
+    if (!f)
+    {
+        return false;
+    }
+
+    if (f->batchCount == f->batchCapacity)
+    {
+        size_t capacity = f->batchCapacity ? f->batchCapacity * 2 : 8;
+
+        renderBatchCommand* batches = realloc(f->batches, sizeof(renderBatchCommand) * capacity);
+        if (!batches)
+        {
+            return false;
+        }
+
+        f->batches = batches;
+        f->batchCapacity = capacity;
+    }
+
+    batch.commandIndex = f->count;
+    f->batches[f->batchCount++] = batch;
+
+    return true;
+}
+
+void setViewProjection_renderFrame(renderFrame* f, MATRIX_TYPE(3, 3)* viewProjection)
+{
+    if (!f || !viewProjection)
+    {
+        return;
+    }
+
+    f->viewProjection = *viewProjection;
+}
@@ -0,0 +1,388 @@
+#include "engine/staticBatch.h"
+
+#include "datastructures/arena.h"
+#include "datastructures/hashtable.h"
+#include "engine/render.h"
+#include "engine/renderBackend.h"
+#include "engine/renderQueue.h"
+#include "engine/renderThread.h"
+#include "engine/texture.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define DEFAULT_STATIC_RENDERS_CAPACITY 64
+
+static const size_t QUAD_VERTEX_COUNT = 6;
+
+// The corners of the unit quad every render is drawn as, in draw order. Matches the quad of the OpenGL backend
+static const float quadCorners[6][2] = {
+    { -0.5f, -0.5f },
+    {  0.5f, -0.5f },
+    {  0.5f,  0.5f },
+
+    { -0.5f, -0.5f },
+    {  0.5f,  0.5f },
+    { -0.5f,  0.5f },
+};
+
+typedef struct _staticBatch
+{
+    uint8_t layer; // The layer of every render in the batch, see setLayer_render()
+    program* program; // The program of every render in the batch
+    uint32_t textureId;
+    uint32_t batchId; // The backend's id of the batch's vertex buffer
+    size_t vertexCount;
+} staticBatch;
+
+struct _staticBatches
+{
+    hashtable* renders; // Every static render, keyed by itself
+
+    staticBatch* batches;
+    size_t count;
+    size_t capacity;
+
+    bool isDirty; // A render was added or removed since the batches were last built
+};
+
+staticBatches* create_staticBatches()
+{
+    staticBatches* sb = calloc(1, sizeof(staticBatches));
+    if (!sb)
+    {
+        return NULL;
+    }
+
+    sb->renders = create_hashtable(DEFAULT_STATIC_RENDERS_CAPACITY, hasher_ptr, comparator_ptr);
+    if (!sb->renders)
+    {
+        free(sb);
+        return NULL;
+    }
+
+    return sb;
+}
+
+/*
+Deletes the vertex buffer of every batch
+
+Arguments
+    staticBatches* sb: The static batches to clear
+*/
+void _clear_staticBatches(staticBatches* sb)
+{
+    const renderBackend* backend = get_renderBackend();
+    for (size_t i = 0; i < sb->count; i++)
+    {
+        backend->deleteBatch(sb->batches[i].batchId);
+    }
+
+    sb->count = 0;
+}
+
+bool free_staticBatches(staticBatches* sb)
+{
+    if (!sb)
+    {
+        return false;
+    }
+
+    _clear_staticBatches(sb);
+
+    free(sb->batches);
+    free_hashtable(sb->renders);
+    free(sb);
+
+    return true;
+}
+
+bool add_staticBatches(staticBatches* sb, render* r)
+{
+    if (!sb || !r || !isBatched_render(r))
+    {
+        return false;
+    }
+
+    // Adding a render twice changes nothing
+    if (get_hashtable(sb->renders, r))
+    {
+        return true;
+    }
+
+    if (!set_hashtable(sb->renders, r, r))
+    {
+        return false;
+    }
+
+    sb->isDirty = true;
+
+    return true;
+}
+
+bool remove_staticBatches(staticBatches* sb, render* r)
+{
+    if (!sb || !r)
+    {
+        return false;
+    }
+
+    if (!remove_hashtable(sb->renders, r))
+    {
+        return false;
+    }
+
+    sb->isDirty = true;
+
+    return true;
+}
+
+void invalidate_staticBatches(staticBatches* sb)
+{
+    if (!sb)
+    {
+        return;
+    }
+
+    sb->isDirty = true;
+}
+
+/*
+Transforms the quad of a render into world space
+
+Arguments
+    const renderInstance* instance: The recorded render, see record_render()
+
+    batchVertex* outVertices: The 6 vertices of the quad
+*/
+void _setVertices_staticBatches(const renderInstance* instance, batchVertex* outVertices)
+{
+    for (size_t i = 0; i < QUAD_VERTEX_COUNT; i++)
+    {
+        float x = quadCorners[i][0] * instance->size[0];
+        float y = quadCorners[i][1] * instance->size[1];
+
+        // The model matrix is column-major
+        batchVertex* v = &outVertices[i];
+        v->position[0] = instance->model[0][0] * x + instance->model[1][0] * y + instance->model[2][0];
+        v->position[1] = instance->model[0][1] * x + instance->model[1][1] * y + instance->model[2][1];
+
+        // The corners are offset by half, so they map onto the texture coordinates after adding it back
+        float s = quadCorners[i][0] + 0.5f;
+        float t = quadCorners[i][1] + 0.5f;
+        v->uv[0] = instance->uvRect[0] + (instance->uvRect[2] - instance->uvRect[0]) * s;
+        v->uv[1] = instance->uvRect[1] + (instance->uvRect[3] - instance->uvRect[1]) * t;
+
+        v->color[0] = instance->color[0];
+        v->color[1] = instance->color[1];
+        v->color[2] = instance->color[2];
+    }
+}
+
+/*
+Creates the vertex buffer of a single batch, and appends it to the batches
+
+Arguments
+    staticBatches* sb: The static batches to append to
+
+    uint8_t layer: The layer the batch is drawn in
+
+    program* p: The program the batch is drawn with
+
+    uint32_t textureId: The texture the batch is drawn with
+
+    const batchVertex* vertices: The vertices of the batch
+
+    size_t vertexCount: The size of vertices
+
+Returns
+    Returns false if memory allocation failed or the backend could not create the batch
+*/
+bool _push_staticBatches(staticBatches* sb, uint8_t layer, program* p, uint32_t textureId, const batchVertex* vertices, size_t vertexCount)
+{
+    if (sb->count == sb->capacity)
+    {
+        size_t capacity = sb->capacity ? sb->capacity * 2 : 4;
+        staticBatch* batches = realloc(sb->batches, sizeof(staticBatch) * capacity);
+        if (!batches)
+        {
+            return false;
+        }
+
+        sb->batches = batches;
+        sb->capacity = capacity;
+    }
+
+    uint32_t batchId = get_renderBackend()->createBatch(vertices, vertexCount);
+    if (batchId == 0)
+    {
+        return false;
+    }
+
+    sb->batches[sb->count++] = (staticBatch) { layer, p, textureId, batchId, vertexCount };
+
+    return true;
+}
+
+bool build_staticBatches(staticBatches* sb, arena* a)
+{
+    if (!sb || !a)
+    {
+        return false;
+    }
+
+    if (!sb->isDirty)
+    {
+        return true;
+    }
+
+    _clear_staticBatches(sb);
+
+    size_t renderCount = getCount_hashtable(sb->renders);
+    if (renderCount == 0)
+    {
+        sb->isDirty = false;
+        return true;
+    }
+
+    render** renders = alloc_arena(a, sizeof(render*) * renderCount);
+    program** programs = alloc_arena(a, sizeof(program*) * renderCount);
+    uint32_t* textureIds = alloc_arena(a, sizeof(uint32_t) * renderCount);
+    batchVertex* vertices = alloc_arena(a, sizeof(batchVertex) * QUAD_VERTEX_COUNT * renderCount);
+    if (!renders || !programs || !textureIds || !vertices)
+    {
+        return false;
+    }
+
+    // Sort the renders the same way as every other render, so batches are split by layer, program and texture
+    renderQueue queue;
+    if (!create_renderQueue(&queue, renderCount, a))
+    {
+        return false;
+    }
+
+    copyAll_hashtable(sb->renders, (void**) renders);
+    for (size_t i = 0; i < renderCount; i++)
+    {
+        push_renderQueue(&queue, getSortKey_render(renders[i]), renders[i]);
+    }
+
+    if (!sort_renderQueue(&queue, a))
+    {
+        return false;
+    }
+
+    // Pre-transform every quad, in sorted order
+    for (size_t i = 0; i < renderCount; i++)
+    {
+        renderInstance instance;
+        record_render(queue.commands[i].r, &programs[i], &textureIds[i], &instance);
+        _setVertices_staticBatches(&instance, &vertices[i * QUAD_VERTEX_COUNT]);
+    }
+
+    size_t first = 0;
+    while (first < renderCount)
+    {
+        size_t end = first + 1;
+        while (end < renderCount && programs[end] == programs[first] && textureIds[end] == textureIds[first])
+        {
+            end++;
+        }
+
+        uint8_t layer = (uint8_t) (queue.commands[first].key >> SORT_KEY_LAYER_SHIFT);
+        if (!_push_staticBatches(sb, layer, programs[first], textureIds[first], &vertices[first * QUAD_VERTEX_COUNT], (end - first) * QUAD_VERTEX_COUNT))
+        {
+            _clear_staticBatches(sb);
+            return false;
+        }
+
+        first = end;
+    }
+
+    sb->isDirty = false;
+
+    return true;
+}
+
+void renderAll_staticBatches(staticBatches* sb)
+{
+    renderLayers_staticBatches(sb, 0, UINT8_MAX);
+}
+
+void renderLayers_staticBatches(staticBatches* sb, uint8_t firstLayer, uint8_t lastLayer)
+{
+    if (!sb || sb->count == 0)
+    {
+        return;
+    }
+
+    const renderBackend* backend = get_renderBackend();
+
+    program* boundProgram = NULL;
+    uint32_t boundTexture = 0;
+    for (size_t i = 0; i < sb->count; i++)
+    {
+        staticBatch* batch = &sb->batches[i];
+        if (batch->layer < firstLayer || batch->layer > lastLayer)
+        {
+            continue;
+        }
+
+        if (boundProgram != batch->program)
+        {
+            backend->useProgram(batch->program);
+            boundProgram = batch->program;
+        }
+
+        use_texture(batch->textureId);
+        if (boundTexture != batch->textureId)
+        {
+            backend->bindTexture(batch->textureId);
+            boundTexture = batch->textureId;
+        }
+
+        backend->drawBatch(batch->program, batch->batchId, batch->vertexCount);
+    }
+}
+
+bool record_staticBatches(staticBatches* sb, renderFrame* f)
+{
+    return recordLayers_staticBatches(sb, f, 0, UINT8_MAX);
+}
+
+bool recordLayers_staticBatches(staticBatches* sb, renderFrame* f, uint8_t firstLayer, uint8_t lastLayer)
+{
+    if (!sb || !f)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < sb->count; i++)
+    {
+        staticBatch* batch = &sb->batches[i];
+        if (batch->layer < firstLayer || batch->layer > lastLayer)
+        {
+            continue;
+        }
+
+        use_texture(batch->textureId);
+
+        renderBatchCommand command = { batch->program, batch->textureId, batch->batchId, batch->vertexCount };
+        if (!pushBatch_renderFrame(f, command))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t getCount_staticBatches(staticBatches* sb)
+{
+    if (!sb)
+    {
+        return 0;
+    }
+
+    return sb->count;
+}
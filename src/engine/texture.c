@@ -1,22 +1,124 @@
 #include "engine/texture.h"
 
-#include "datastructures/hashtable.h"
+#include "engine/archive.h"
+#include "engine/asset.h"
+#include "engine/atlas.h"
+#include "engine/rawTexture.h"
+
+#include "engine/renderBackend.h"
 
 #include <string.h>
-#include <OpenGL/gl3.h>
 #include <png.h>
+#include <pthread.h>
+#include <unistd.h>
+
+static const size_t ATLAS_PAGE_SIZE = 2048;
+
+// Pages have a few mip levels, so minified renders sample a smaller copy of their texture
+static const size_t ATLAS_LEVEL_COUNT = 4;
+
+// Textures are packed on multiples of this, so they start on a whole texel of every level of the page
+static const size_t ATLAS_ALIGNMENT = 8; // 1 << (ATLAS_LEVEL_COUNT - 1)
+
+// Transparent texels around each texture, so filtering doesn't bleed into its neighbours. Still 1 texel on the last level.
+static const size_t ATLAS_PADDING = 8;
+
+static const size_t TEXEL_SIZE = 4; // RGBA
+
+static const size_t MAX_DECODE_THREADS = 4;
+
+// Pages used within this many frames can't be evicted. Frames recorded for the render thread may be
+// drawn a frame or two after they are recorded, see renderThread.h
+static const uint64_t EVICTION_DELAY_FRAMES = 3;
+
+// The texture shown while a requested texture loads
+static const size_t PLACEHOLDER_SIZE = 4;
+static const uint8_t PLACEHOLDER_TEXEL[4] = { 128, 128, 128, 255 };
 
 typedef struct _texture
 {
     size_t width;
     size_t height;
+    size_t levelCount;
 
-    uint8_t* texels; // Row-major
+    uint8_t* texels; // The row-major mip chain, see rawTexture.h
 
-    uint32_t textureId;
+    bool isMapped; // The texels point into the mounted archive, so they are not freed
 } texture;
 
-hashtable* textureTable = NULL;
+// A single OpenGL texture that many textures are packed into
+typedef struct _atlasPage
+{
+    uint32_t textureId;
+
+    size_t width;
+    size_t height;
+
+    atlas* packer;
+
+    uint64_t lastUsedFrame; // See use_texture()
+} atlasPage;
+
+typedef enum _textureState
+{
+    TEXTURE_DECODING, // Waiting for or being decoded by a worker
+    TEXTURE_DECODED, // Waiting to be uploaded, see uploadRequested_texture()
+    TEXTURE_LOADED,
+    TEXTURE_FAILED,
+    TEXTURE_EVICTED, // Its page was evicted, so it is loaded again by the next get_texture() or request_texture()
+} textureState;
+
+// A loaded or requested texture
+typedef struct _textureEntry
+{
+    textureRegion region; // The placeholder's region until the texture is loaded
+    textureState state;
+
+    assetHandle asset;
+    const char* fileName; // The interned file name of the asset, see getFileName_asset()
+
+    texture* decoded; // Set by the worker that decoded the texture, or NULL if it could not be decoded
+
+    bool wasEvicted; // The texture is being loaded again after its page was evicted
+
+    struct _textureEntry* next; // The next entry in the decode or upload queue
+} textureEntry;
+
+// A queue of texture entries, oldest first
+typedef struct _textureQueue
+{
+    textureEntry* head;
+    textureEntry* tail;
+} textureQueue;
+
+// Every texture entry, indexed by its asset handle. Only used by the thread that owns the render backend,
+// so the workers never see the array being resized.
+static textureEntry** textureEntries = NULL;
+static size_t textureEntriesCapacity = 0;
+
+// Guards the queues and the state and decoded texture of requested entries
+static pthread_mutex_t requestMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t decodeRequested = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t decodeFinished = PTHREAD_COND_INITIALIZER;
+
+static textureQueue decodeQueue = { NULL, NULL };
+static textureQueue uploadQueue = { NULL, NULL };
+static size_t pendingCount = 0;
+static bool hasWorkers = false;
+static size_t cpuBytes = 0; // The size of every decoded texture waiting to be uploaded
+static size_t cpuBudget = 0;
+
+// Only used by the thread that owns the render backend
+static size_t gpuBudget = 0;
+static uint64_t currentFrame = 0;
+static size_t evictions = 0;
+static size_t reloads = 0;
+
+static textureRegion placeholderRegion = { 0 };
+
+static atlasPage* atlasPages = NULL;
+static size_t atlasPagesCount = 0;
+static size_t atlasPagesCapacity = 0;
 
 texture* _loadPng_texture(const char* fileName)
 {
@@ -49,72 +151,918 @@ texture* _loadPng_texture(const char* fileName)
     }
 
     texture* t = malloc(sizeof(texture));
-    *t = (texture) { image.width, image.height, buffer };
+    if (!t)
+    {
+        free(buffer);
+        return NULL;
+    }
+    *t = (texture) { image.width, image.height, 1, buffer, false };
 
     return t;
 }
 
-uint32_t get_texture(const char* fileName)
+/*
+Frees a texture loaded by _load_texture()
+
+Arguments
+    texture* t: The texture to free, or NULL
+*/
+void _free_texture(texture* t)
 {
-    if (!fileName)
+    if (!t)
     {
-        return 0;
+        return;
     }
 
-    size_t fileNameLen = strlen(fileName);
-    if (fileNameLen <= 4)
+    if (!t->isMapped)
     {
-        printf("get_texture(): fileName is <= 4 characters %s\n", fileName);
-        return 0;
+        free(t->texels);
     }
 
-    if (!textureTable)
+    free(t);
+}
+
+/*
+Reads a cooked texture with its mip chain, see rawTexture.h
+
+Arguments
+    const char* fileName: The file name of the texture
+
+Returns
+    Returns the texture, or NULL if it could not be read
+*/
+texture* _loadRaw_texture(const char* fileName)
+{
+    size_t width, height, levelCount;
+    uint8_t* chain = read_rawTexture(fileName, &width, &height, &levelCount);
+    if (!chain)
     {
-        textureTable = create_hashtable(32, hasher_string, comparator_string);
+        printf("_loadRaw_texture(): could not read %s\n", fileName);
+        return NULL;
     }
 
-    // See if the texture has already been loaded
-    texture* t = get_hashtable(textureTable, (void*) fileName);
-    if (t)
+    texture* t = malloc(sizeof(texture));
+    if (!t)
     {
-        return t->textureId;
+        free(chain);
+        return NULL;
     }
+    *t = (texture) { width, height, levelCount, chain, false };
+
+    return t;
+}
+
+/*
+Builds the mip levels a texture is missing, so it has one for every level of an atlas page
+
+Arguments
+    texture* t: The texture to complete
+
+Returns
+    Returns false if memory allocation failed
+*/
+bool _completeMipmaps_texture(texture* t)
+{
+    if (t->levelCount >= ATLAS_LEVEL_COUNT)
+    {
+        return true;
+    }
+
+    uint8_t* chain = malloc(getSize_rawTexture(t->width, t->height, ATLAS_LEVEL_COUNT));
+    if (!chain)
+    {
+        return false;
+    }
+
+    memcpy(chain, t->texels, getSize_rawTexture(t->width, t->height, t->levelCount));
+    buildMipmaps_rawTexture(chain, t->width, t->height, t->levelCount, ATLAS_LEVEL_COUNT);
+
+    if (!t->isMapped)
+    {
+        free(t->texels);
+    }
+
+    t->texels = chain;
+    t->levelCount = ATLAS_LEVEL_COUNT;
+    t->isMapped = false;
+
+    return true;
+}
 
-    // Load the texture by extension
-    const char* extension = &fileName[fileNameLen - 3];
-    printf("extension: %s\n", extension);
-    if (strcmp(extension, "png") == 0)
+/*
+Loads a texture from the mounted archive, or from its file by its extension if the archive doesn't have it.
+Cooked textures (.rtex) are read as is, pngs are decoded.
+
+Arguments
+    const char* fileName: The file name of the texture
+
+Returns
+    Returns the texture with every mip level of an atlas page, or NULL if it could not be loaded
+*/
+texture* _load_texture(const char* fileName)
+{
+    texture* t = NULL;
+
+    size_t width, height, levelCount;
+    const uint8_t* texels = getTexture_archive(fileName, &width, &height, &levelCount);
+    const char* extension = strrchr(fileName, '.');
+    if (texels)
+    {
+        t = malloc(sizeof(texture));
+        if (t)
+        {
+            *t = (texture) { width, height, levelCount, (uint8_t*) texels, true };
+        }
+    }
+    else if (extension && strcmp(extension, ".rtex") == 0)
+    {
+        t = _loadRaw_texture(fileName);
+    }
+    else if (extension && strcmp(extension, ".png") == 0)
     {
         t = _loadPng_texture(fileName);
     }
 
+    if (t && !_completeMipmaps_texture(t))
+    {
+        _free_texture(t);
+        return NULL;
+    }
+
+    return t;
+}
+
+/*
+Gets the size of every resident atlas page
+
+Returns
+    Returns the size in bytes
+*/
+size_t _getGpuBytes_texture()
+{
+    size_t bytes = 0;
+    for (size_t i = 0; i < atlasPagesCount; i++)
+    {
+        bytes += getSize_rawTexture(atlasPages[i].width, atlasPages[i].height, ATLAS_LEVEL_COUNT);
+    }
+
+    return bytes;
+}
+
+/*
+Evicts an atlas page. Every texture packed into it shows the placeholder until it is loaded again.
+
+Arguments
+    size_t index: The index of the page in atlasPages
+*/
+void _evictPage_texture(size_t index)
+{
+    atlasPage* page = &atlasPages[index];
+
+    // The workers change the state of the entries they decode
+    pthread_mutex_lock(&requestMutex);
+    for (size_t i = 0; i < textureEntriesCapacity; i++)
+    {
+        textureEntry* entry = textureEntries[i];
+        if (entry && entry->state == TEXTURE_LOADED && entry->region.textureId == page->textureId)
+        {
+            entry->state = TEXTURE_EVICTED;
+            entry->region = placeholderRegion;
+        }
+    }
+    pthread_mutex_unlock(&requestMutex);
+
+    get_renderBackend()->deleteTexture(page->textureId);
+    free_atlas(page->packer);
+
+    atlasPages[index] = atlasPages[atlasPagesCount - 1];
+    atlasPagesCount--;
+    evictions++;
+}
+
+/*
+Evicts the least recently used atlas pages until there is room for a new page within the GPU budget,
+or until every page left has been used too recently to be evicted
+
+Arguments
+    size_t neededBytes: The size of the new page
+*/
+void _evict_texture(size_t neededBytes)
+{
+    if (gpuBudget == 0)
+    {
+        return;
+    }
+
+    size_t gpuBytes = _getGpuBytes_texture();
+    while (gpuBytes + neededBytes > gpuBudget)
+    {
+        // The placeholder's page is never evicted, every evicted texture falls back to it
+        size_t oldest = atlasPagesCount;
+        for (size_t i = 0; i < atlasPagesCount; i++)
+        {
+            atlasPage* page = &atlasPages[i];
+            if (page->textureId == placeholderRegion.textureId || page->lastUsedFrame + EVICTION_DELAY_FRAMES > currentFrame)
+            {
+                continue;
+            }
+
+            if (oldest == atlasPagesCount || page->lastUsedFrame < atlasPages[oldest].lastUsedFrame)
+            {
+                oldest = i;
+            }
+        }
+
+        if (oldest == atlasPagesCount)
+        {
+            return;
+        }
+
+        gpuBytes -= getSize_rawTexture(atlasPages[oldest].width, atlasPages[oldest].height, ATLAS_LEVEL_COUNT);
+        _evictPage_texture(oldest);
+    }
+}
+
+/*
+Creates a new, empty atlas page
+
+Arguments
+    size_t width: The width of the page
+
+    size_t height: The height of the page
+
+Returns
+    Returns the new page or NULL if it could not be created
+*/
+atlasPage* _createPage_texture(size_t width, size_t height)
+{
+    _evict_texture(getSize_rawTexture(width, height, ATLAS_LEVEL_COUNT));
+
+    if (atlasPagesCount == atlasPagesCapacity)
+    {
+        size_t capacity = atlasPagesCapacity ? atlasPagesCapacity * 2 : 4;
+        atlasPage* pages = realloc(atlasPages, sizeof(atlasPage) * capacity);
+        if (!pages)
+        {
+            return NULL;
+        }
+
+        atlasPages = pages;
+        atlasPagesCapacity = capacity;
+    }
+
+    atlasPage* page = &atlasPages[atlasPagesCount];
+    page->width = width;
+    page->height = height;
+    page->packer = create_atlas(width, height);
+    if (!page->packer)
+    {
+        return NULL;
+    }
+
+    // New textures are transparent, so the padding between textures is too
+    page->textureId = get_renderBackend()->createTexture(width, height, ATLAS_LEVEL_COUNT);
+    if (page->textureId == 0)
+    {
+        free_atlas(page->packer);
+        return NULL;
+    }
+
+    page->lastUsedFrame = currentFrame;
+    atlasPagesCount++;
+
+    return page;
+}
+
+/*
+Rounds a size up to the next multiple of ATLAS_ALIGNMENT
+*/
+size_t _align_texture(size_t size)
+{
+    return (size + ATLAS_ALIGNMENT - 1) / ATLAS_ALIGNMENT * ATLAS_ALIGNMENT;
+}
+
+/*
+Packs a texture into the first atlas page with room for it, creating a new page if none has room
+
+Arguments
+    texture* t: The texture to pack
+
+    textureRegion* outRegion: The region the texture was packed into
+
+Returns
+    Returns false if the texture could not be packed
+*/
+bool _pack_texture(texture* t, textureRegion* outRegion)
+{
+    size_t paddedWidth = _align_texture(t->width + ATLAS_PADDING * 2);
+    size_t paddedHeight = _align_texture(t->height + ATLAS_PADDING * 2);
+
+    size_t x, y;
+    atlasPage* page = NULL;
+    for (size_t i = 0; i < atlasPagesCount; i++)
+    {
+        if (pack_atlas(atlasPages[i].packer, paddedWidth, paddedHeight, &x, &y))
+        {
+            page = &atlasPages[i];
+            break;
+        }
+    }
+
+    if (!page)
+    {
+        // Textures larger than a page get a page of their own
+        page = _createPage_texture(
+            paddedWidth > ATLAS_PAGE_SIZE ? paddedWidth : ATLAS_PAGE_SIZE,
+            paddedHeight > ATLAS_PAGE_SIZE ? paddedHeight : ATLAS_PAGE_SIZE);
+
+        if (!page || !pack_atlas(page->packer, paddedWidth, paddedHeight, &x, &y))
+        {
+            return false;
+        }
+    }
+
+    x += ATLAS_PADDING;
+    y += ATLAS_PADDING;
+
+    // Copy every level into its spot on the matching level of the page
+    const uint8_t* level = t->texels;
+    for (size_t i = 0; i < ATLAS_LEVEL_COUNT; i++)
+    {
+        size_t levelWidth, levelHeight;
+        getLevelSize_rawTexture(t->width, t->height, i, &levelWidth, &levelHeight);
+        get_renderBackend()->updateTexture(page->textureId, i, x >> i, y >> i, levelWidth, levelHeight, level);
+
+        level += levelWidth * levelHeight * TEXEL_SIZE;
+    }
+
+    outRegion->textureId = page->textureId;
+    outRegion->uvMin = to_vec2f((float) x / page->width, (float) y / page->height);
+    outRegion->uvMax = to_vec2f((float) (x + t->width) / page->width, (float) (y + t->height) / page->height);
+
+    return true;
+}
+
+/*
+Appends an entry to the end of a queue
+
+Arguments
+    textureQueue* q: The queue to append to
+
+    textureEntry* entry: The entry to append
+*/
+void _push_textureQueue(textureQueue* q, textureEntry* entry)
+{
+    entry->next = NULL;
+    if (q->tail)
+    {
+        q->tail->next = entry;
+    }
+    else
+    {
+        q->head = entry;
+    }
+    q->tail = entry;
+}
+
+/*
+Removes an entry from a queue
+
+Arguments
+    textureQueue* q: The queue to remove from
+
+    textureEntry* entry: The entry to remove, or NULL to remove the oldest entry
+
+Returns
+    Returns the removed entry, or NULL if it is not in the queue
+*/
+textureEntry* _remove_textureQueue(textureQueue* q, textureEntry* entry)
+{
+    textureEntry* prev = NULL;
+    textureEntry* it = q->head;
+    while (it && entry && it != entry)
+    {
+        prev = it;
+        it = it->next;
+    }
+
+    if (!it)
+    {
+        return NULL;
+    }
+
+    if (prev)
+    {
+        prev->next = it->next;
+    }
+    else
+    {
+        q->head = it->next;
+    }
+
+    if (q->tail == it)
+    {
+        q->tail = prev;
+    }
+
+    it->next = NULL;
+
+    return it;
+}
+
+/*
+Hands a decoded texture over to be uploaded. Must be called with requestMutex held.
+
+Arguments
+    textureEntry* entry: The entry that was decoded
+
+    texture* t: The decoded texture, or NULL if it could not be decoded
+*/
+void _finishDecode_texture(textureEntry* entry, texture* t)
+{
+    if (t)
+    {
+        cpuBytes += getSize_rawTexture(t->width, t->height, t->levelCount);
+    }
+
+    entry->decoded = t;
+    entry->state = TEXTURE_DECODED;
+    _push_textureQueue(&uploadQueue, entry);
+    pthread_cond_broadcast(&decodeFinished);
+}
+
+/*
+Decodes requested textures until the program exits
+
+Arguments
+    void* unused: Unused
+
+Returns
+    Never returns
+*/
+void* _decode_texture(void* unused)
+{
+    pthread_mutex_lock(&requestMutex);
+    while (true)
+    {
+        // Stop decoding while the decoded textures are over budget, until they are uploaded
+        bool isOverBudget = cpuBudget != 0 && cpuBytes >= cpuBudget;
+        textureEntry* entry = isOverBudget ? NULL : _remove_textureQueue(&decodeQueue, NULL);
+        if (!entry)
+        {
+            pthread_cond_wait(&decodeRequested, &requestMutex);
+            continue;
+        }
+
+        // The file name never changes, so it can be read without the lock
+        pthread_mutex_unlock(&requestMutex);
+        texture* t = _load_texture(entry->fileName);
+        pthread_mutex_lock(&requestMutex);
+
+        _finishDecode_texture(entry, t);
+    }
+
+    return NULL;
+}
+
+/*
+Starts the decode workers, the first time it is called. The workers live as long as the program,
+like the textures they decode. Must be called with requestMutex held.
+
+Returns
+    Returns false if no worker could be started
+*/
+bool _startWorkers_texture()
+{
+    if (hasWorkers)
+    {
+        return true;
+    }
+
+    // Leave a core for the main thread
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t threadCount = processors > 1 ? processors - 1 : 1;
+    if (threadCount > MAX_DECODE_THREADS)
+    {
+        threadCount = MAX_DECODE_THREADS;
+    }
+
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        pthread_t worker;
+        if (pthread_create(&worker, NULL, _decode_texture, NULL) == 0)
+        {
+            pthread_detach(worker);
+            hasWorkers = true;
+        }
+    }
+
+    return hasWorkers;
+}
+
+/*
+Gets the region of the placeholder texture, packing it into an atlas page the first time it is called
+
+Returns
+    Returns the placeholder's region. The region's textureId is 0 if it could not be packed
+*/
+textureRegion _getPlaceholder_texture()
+{
+    if (placeholderRegion.textureId != 0)
+    {
+        return placeholderRegion;
+    }
+
+    uint8_t texels[PLACEHOLDER_SIZE * PLACEHOLDER_SIZE * sizeof(PLACEHOLDER_TEXEL)];
+    for (size_t i = 0; i < PLACEHOLDER_SIZE * PLACEHOLDER_SIZE; i++)
+    {
+        memcpy(&texels[i * sizeof(PLACEHOLDER_TEXEL)], PLACEHOLDER_TEXEL, sizeof(PLACEHOLDER_TEXEL));
+    }
+
+    // The texels are on the stack, so they are marked as not to be freed
+    texture t = { PLACEHOLDER_SIZE, PLACEHOLDER_SIZE, 1, texels, true };
+    bool isPacked = _completeMipmaps_texture(&t) && _pack_texture(&t, &placeholderRegion);
+
+    // Only the mip chain was allocated
+    if (t.texels != texels)
+    {
+        free(t.texels);
+    }
+
+    if (!isPacked)
+    {
+        printf("_getPlaceholder_texture(): could not pack the placeholder texture\n");
+        placeholderRegion = (textureRegion) { 0 };
+    }
+
+    return placeholderRegion;
+}
+
+/*
+Gets the entry of a texture
+
+Arguments
+    assetHandle asset: The asset handle of the texture
+
+Returns
+    Returns the entry, or NULL if the texture has never been loaded or requested
+*/
+textureEntry* _getEntry_texture(assetHandle asset)
+{
+    return asset < textureEntriesCapacity ? textureEntries[asset] : NULL;
+}
+
+/*
+Creates an entry for a texture and adds it to the texture entries
+
+Arguments
+    assetHandle asset: The asset handle of the texture, which must have no entry yet
+
+    textureState state: The state of the new entry
+
+Returns
+    Returns the new entry or NULL if memory allocation failed
+*/
+textureEntry* _createEntry_texture(assetHandle asset, textureState state)
+{
+    if (asset >= textureEntriesCapacity)
+    {
+        // Sized for every handle interned so far, so textures loaded in a row resize the array once
+        size_t capacity = getCount_asset() + 1;
+        if (capacity < textureEntriesCapacity * 2)
+        {
+            capacity = textureEntriesCapacity * 2;
+        }
+
+        textureEntry** entries = realloc(textureEntries, sizeof(textureEntry*) * capacity);
+        if (!entries)
+        {
+            return NULL;
+        }
+
+        memset(&entries[textureEntriesCapacity], 0, sizeof(textureEntry*) * (capacity - textureEntriesCapacity));
+        textureEntries = entries;
+        textureEntriesCapacity = capacity;
+    }
+
+    textureEntry* entry = calloc(1, sizeof(textureEntry));
+    if (!entry)
+    {
+        return NULL;
+    }
+
+    entry->asset = asset;
+    entry->fileName = getFileName_asset(asset);
+    entry->state = state;
+
+    textureEntries[asset] = entry;
+
+    return entry;
+}
+
+/*
+Packs a decoded texture into an atlas page and points its entry's region at it
+
+Arguments
+    textureEntry* entry: The decoded entry, which has been removed from the upload queue
+*/
+void _upload_texture(textureEntry* entry)
+{
+    texture* t = entry->decoded;
+    entry->decoded = NULL;
+
+    textureRegion region;
+    if (t && _pack_texture(t, &region))
+    {
+        entry->region = region;
+        entry->state = TEXTURE_LOADED;
+
+        if (entry->wasEvicted)
+        {
+            entry->wasEvicted = false;
+            reloads++;
+        }
+    }
+    else
+    {
+        printf("_upload_texture(): could not load texture %s\n", entry->fileName);
+        entry->state = TEXTURE_FAILED;
+    }
+
+    size_t bytes = 0;
+    if (t)
+    {
+        bytes = getSize_rawTexture(t->width, t->height, t->levelCount);
+        _free_texture(t);
+    }
+
+    // Workers waiting on the CPU budget may have room now
+    pthread_mutex_lock(&requestMutex);
+    cpuBytes -= bytes;
+    pendingCount--;
+    pthread_cond_broadcast(&decodeRequested);
+    pthread_mutex_unlock(&requestMutex);
+}
+
+/*
+Queues an entry to be decoded by the workers
+
+Arguments
+    textureEntry* entry: The entry to decode, whose state is TEXTURE_DECODING
+*/
+void _queue_texture(textureEntry* entry)
+{
+    pthread_mutex_lock(&requestMutex);
+    pendingCount++;
+    if (_startWorkers_texture())
+    {
+        _push_textureQueue(&decodeQueue, entry);
+        pthread_cond_signal(&decodeRequested);
+    }
+    else
+    {
+        // Nothing can decode it, so it fails on the next upload
+        entry->state = TEXTURE_DECODED;
+        _push_textureQueue(&uploadQueue, entry);
+    }
+    pthread_mutex_unlock(&requestMutex);
+}
+
+textureRegion get_texture(const char* fileName)
+{
+    if (!fileName)
+    {
+        return (textureRegion) { 0 };
+    }
+
+    return getByAsset_texture(intern_asset(fileName));
+}
+
+textureRegion getByAsset_texture(assetHandle asset)
+{
+    textureRegion region = { 0 };
+
+    const char* fileName = getFileName_asset(asset);
+    if (!fileName)
+    {
+        return region;
+    }
+
+    // See if the texture has already been loaded or requested
+    textureEntry* entry = _getEntry_texture(asset);
+    if (entry && entry->state == TEXTURE_EVICTED)
+    {
+        texture* t = _load_texture(fileName);
+        bool isPacked = t && _pack_texture(t, &region);
+        _free_texture(t);
+
+        if (!isPacked)
+        {
+            printf("get_texture(): could not reload texture %s\n", fileName);
+            return (textureRegion) { 0 };
+        }
+
+        entry->region = region;
+        entry->state = TEXTURE_LOADED;
+        reloads++;
+
+        return region;
+    }
+
+    if (entry)
+    {
+        pthread_mutex_lock(&requestMutex);
+
+        // Decode it here if no worker has started on it, since the workers may be waiting on the CPU budget
+        if (entry->state == TEXTURE_DECODING && _remove_textureQueue(&decodeQueue, entry))
+        {
+            pthread_mutex_unlock(&requestMutex);
+            texture* t = _load_texture(fileName);
+            pthread_mutex_lock(&requestMutex);
+
+            _finishDecode_texture(entry, t);
+        }
+
+        while (entry->state == TEXTURE_DECODING)
+        {
+            pthread_cond_wait(&decodeFinished, &requestMutex);
+        }
+
+        // Upload it now instead of waiting for its turn
+        bool isDecoded = entry->state == TEXTURE_DECODED;
+        if (isDecoded)
+        {
+            _remove_textureQueue(&uploadQueue, entry);
+        }
+        pthread_mutex_unlock(&requestMutex);
+
+        if (isDecoded)
+        {
+            _upload_texture(entry);
+        }
+
+        return entry->state == TEXTURE_LOADED ? entry->region : region;
+    }
+
     // Were we able to load the texture?
+    texture* t = _load_texture(fileName);
     if (!t)
     {
         printf("get_texture(): could not get texture %s\n", fileName);
-        return 0;
+        return region;
+    }
+
+    // The texels live on the atlas page once they are packed
+    bool isPacked = _pack_texture(t, &region);
+    _free_texture(t);
+
+    if (!isPacked)
+    {
+        printf("get_texture(): could not pack texture %s\n", fileName);
+        return (textureRegion) { 0 };
+    }
+
+    // Save the region in the global texture table
+    entry = _createEntry_texture(asset, TEXTURE_LOADED);
+    if (entry)
+    {
+        entry->region = region;
+    }
+
+    return region;
+}
+
+const textureRegion* request_texture(const char* fileName)
+{
+    if (!fileName)
+    {
+        return NULL;
+    }
+
+    return requestByAsset_texture(intern_asset(fileName));
+}
+
+const textureRegion* requestByAsset_texture(assetHandle asset)
+{
+    if (!getFileName_asset(asset))
+    {
+        return NULL;
+    }
+
+    textureEntry* entry = _getEntry_texture(asset);
+    if (entry && entry->state == TEXTURE_EVICTED)
+    {
+        // It keeps showing the placeholder it fell back to until it is uploaded again
+        entry->state = TEXTURE_DECODING;
+        entry->wasEvicted = true;
+        _queue_texture(entry);
+    }
+
+    if (entry)
+    {
+        return &entry->region;
+    }
+
+    entry = _createEntry_texture(asset, TEXTURE_DECODING);
+    if (!entry)
+    {
+        return NULL;
+    }
+    entry->region = _getPlaceholder_texture();
+
+    _queue_texture(entry);
+
+    return &entry->region;
+}
+
+size_t uploadRequested_texture(size_t maxUploads)
+{
+    size_t uploaded = 0;
+    while (uploaded < maxUploads)
+    {
+        pthread_mutex_lock(&requestMutex);
+        textureEntry* entry = _remove_textureQueue(&uploadQueue, NULL);
+        pthread_mutex_unlock(&requestMutex);
+
+        if (!entry)
+        {
+            break;
+        }
+
+        _upload_texture(entry);
+        uploaded++;
     }
 
-    // Create the OpenGL texture
-    glGenTextures(1, &t->textureId);
+    return uploaded;
+}
 
-    glBindTexture(GL_TEXTURE_2D, t->textureId);
+size_t getPendingCount_texture()
+{
+    pthread_mutex_lock(&requestMutex);
+    size_t count = pendingCount;
+    pthread_mutex_unlock(&requestMutex);
 
-    // Linear interpolation
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return count;
+}
 
-    // Don't tile the texture
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+void setBudget_texture(size_t gpuBytes, size_t cpuBytes)
+{
+    gpuBudget = gpuBytes;
 
-    // Link the texels to the OpenGL texture
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, t->width, t->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, t->texels);
+    pthread_mutex_lock(&requestMutex);
+    cpuBudget = cpuBytes;
+    pthread_cond_broadcast(&decodeRequested);
+    pthread_mutex_unlock(&requestMutex);
+}
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+void use_texture(uint32_t textureId)
+{
+    for (size_t i = 0; i < atlasPagesCount; i++)
+    {
+        if (atlasPages[i].textureId == textureId)
+        {
+            atlasPages[i].lastUsedFrame = currentFrame;
+            return;
+        }
+    }
+}
+
+void nextFrame_texture()
+{
+    currentFrame++;
+}
+
+textureStats getStats_texture()
+{
+    textureStats stats = { 0 };
+
+    stats.gpuBytes = _getGpuBytes_texture();
+    stats.gpuBudget = gpuBudget;
+    stats.pages = atlasPagesCount;
+    stats.evictions = evictions;
+    stats.reloads = reloads;
+
+    pthread_mutex_lock(&requestMutex);
+    for (size_t i = 0; i < textureEntriesCapacity; i++)
+    {
+        if (!textureEntries[i])
+        {
+            continue;
+        }
+
+        if (textureEntries[i]->state == TEXTURE_LOADED)
+        {
+            stats.loaded++;
+        }
+        else if (textureEntries[i]->state == TEXTURE_EVICTED)
+        {
+            stats.evicted++;
+        }
+    }
 
-    // Save the texture in the global textrue table
-    set_hashtable(textureTable, (void*) fileName, t);
+    stats.cpuBytes = cpuBytes;
+    stats.cpuBudget = cpuBudget;
+    pthread_mutex_unlock(&requestMutex);
 
-    return t->textureId;
+    return stats;
 }
@@ -0,0 +1,214 @@
+#include "engine/unit/archive.unit.h"
+
+#include "engine/archive.h"
+#include "engine/program.h"
+#include "engine/renderBackend.h"
+#include "engine/renderBackendNull.h"
+#include "engine/texture.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char* ARCHIVE_TEST_FILE = "/tmp/archive_test.pack";
+static const char ARCHIVE_TEST_SHADER[] = "in mat3 instanceModel;";
+static const uint8_t ARCHIVE_TEST_TEXELS[2 * 2 * 4] = {
+    255, 0, 0, 255,   0, 255, 0, 255,
+    0, 0, 255, 255,   255, 255, 255, 255,
+};
+
+/*
+Writes an archive with a shader, a texture and a polygon to ARCHIVE_TEST_FILE. None of them exist on disk.
+
+Returns
+    Returns false if the archive could not be written
+*/
+bool _write_archiveTest()
+{
+    static vec2f vertices[3] = { to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 0.0f), to_vec2f(0.0f, 1.0f) };
+
+    // Out of name order, since the index must be sorted when it is written
+    archiveSource sources[3] = {
+        { "archived/shape.poly", ARCHIVE_POLYGON, 3, 0, 0, vertices, sizeof(vertices) },
+        { "archived/shader.vert", ARCHIVE_SHADER, 0, 0, 0, ARCHIVE_TEST_SHADER, sizeof(ARCHIVE_TEST_SHADER) },
+        { "archived/image.png", ARCHIVE_TEXTURE, 2, 2, 1, ARCHIVE_TEST_TEXELS, sizeof(ARCHIVE_TEST_TEXELS) },
+    };
+
+    return write_archive(ARCHIVE_TEST_FILE, sources, 3);
+}
+
+// bool write_archive(const char* fileName, const archiveSource* sources, size_t count)
+IMPLEMENT_TEST(write_archive)
+{
+    if (!_write_archiveTest())
+    {
+        FAIL_TEST("Could not write the archive");
+    }
+
+    archive* a = open_archive(ARCHIVE_TEST_FILE);
+    if (!a)
+    {
+        remove(ARCHIVE_TEST_FILE);
+        FAIL_TEST("Could not open the archive that was written");
+    }
+
+    const archiveEntry* texture = find_archive(a, "archived/image.png");
+    const archiveEntry* shader = find_archive(a, "archived/shader.vert");
+    const archiveEntry* shape = find_archive(a, "archived/shape.poly");
+    const archiveEntry* missing = find_archive(a, "archived/missing.png");
+
+    bool isFound = texture && shader && shape && !missing;
+    bool isAligned = isFound && texture->offset % 16 == 0 && shader->offset % 16 == 0 && shape->offset % 16 == 0;
+    bool isTextureEqual = isFound && texture->type == ARCHIVE_TEXTURE && texture->width == 2 && texture->height == 2 &&
+        memcmp(getData_archive(a, texture), ARCHIVE_TEST_TEXELS, sizeof(ARCHIVE_TEST_TEXELS)) == 0;
+    bool isShaderEqual = isFound && shader->type == ARCHIVE_SHADER &&
+        strcmp(getData_archive(a, shader), ARCHIVE_TEST_SHADER) == 0;
+
+    close_archive(a);
+
+    // A file that isn't an archive is rejected
+    archive* notArchive = open_archive("resources/shaders/instanced.vert");
+    close_archive(notArchive);
+
+    remove(ARCHIVE_TEST_FILE);
+
+    if (!isFound)
+    {
+        FAIL_TEST("The entries of the archive could not be found by name");
+    }
+
+    if (!isAligned)
+    {
+        FAIL_TEST("The data of the entries is not aligned");
+    }
+
+    if (!isTextureEqual || !isShaderEqual)
+    {
+        FAIL_TEST("The data of the entries was not written as given");
+    }
+
+    if (notArchive)
+    {
+        FAIL_TEST("A file that isn't an archive was opened");
+    }
+
+    PASS_TEST();
+}
+
+// void mount_archive(archive* a)
+IMPLEMENT_TEST(mount_archive)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    if (!_write_archiveTest())
+    {
+        FAIL_TEST("Could not write the archive");
+    }
+
+    archive* a = open_archive(ARCHIVE_TEST_FILE);
+    if (!a)
+    {
+        remove(ARCHIVE_TEST_FILE);
+        FAIL_TEST("Could not open the archive that was written");
+    }
+
+    mount_archive(a);
+
+    // Every resource is loaded from the archive, since none of the files exist
+    textureRegion region = get_texture("archived/image.png");
+
+    program p;
+    memset(&p, 0, sizeof(p));
+    bool isDescribed = describeProgram_renderBackend(&p, "archived/shader.vert");
+
+    polygon shape;
+    bool hasShape = getPolygon_archive("archived/shape.poly", &shape);
+
+    // An entry of another type isn't returned
+    polygon notShape;
+    bool hasNotShape = getPolygon_archive("archived/shader.vert", &notShape);
+
+    close_archive(a);
+    bool isUnmounted = getMounted_archive() == NULL && getShader_archive("archived/shader.vert") == NULL;
+
+    remove(ARCHIVE_TEST_FILE);
+
+    if (region.textureId == 0)
+    {
+        FAIL_TEST("The texture was not loaded from the mounted archive");
+    }
+
+    if (!isDescribed || !p.isInstanced)
+    {
+        FAIL_TEST("The shader was not read from the mounted archive");
+    }
+
+    if (!hasShape || shape.vertexCount != 3 || hasNotShape)
+    {
+        FAIL_TEST("The polygon was not read from the mounted archive");
+    }
+
+    if (!isUnmounted)
+    {
+        FAIL_TEST("Closing the mounted archive did not unmount it");
+    }
+
+    PASS_TEST();
+}
+
+// bool readPolygon_archive(const char* fileName, polygon* outPoly)
+IMPLEMENT_TEST(readPolygon_archive)
+{
+    const char* fileName = "/tmp/readPolygon_archive.poly";
+
+    // More vertices than the first allocation holds, so the vertices have to grow
+    FILE* file = fopen(fileName, "w");
+    if (!file)
+    {
+        FAIL_TEST("Could not write the polygon file");
+    }
+
+    for (int i = 0; i < 10; i++)
+    {
+        fprintf(file, "%d %d.5\n", i, i * 2);
+    }
+    fclose(file);
+
+    polygon shape;
+    bool isRead = readPolygon_archive(fileName, &shape);
+    bool isEqual = isRead && shape.vertexCount == 10;
+    for (int i = 0; isEqual && i < shape.vertexCount; i++)
+    {
+        isEqual = GET_X(shape.vertices[i]) == (float) i && GET_Y(shape.vertices[i]) == i * 2 + 0.5f;
+    }
+
+    if (isRead)
+    {
+        free_polygon(&shape);
+    }
+
+    // A line isn't a shape
+    file = fopen(fileName, "w");
+    if (file)
+    {
+        fprintf(file, "0 0\n1 1\n");
+        fclose(file);
+    }
+
+    polygon line;
+    bool isLineRead = readPolygon_archive(fileName, &line);
+
+    remove(fileName);
+
+    if (!isEqual)
+    {
+        FAIL_TEST("The vertices were not read from the file");
+    }
+
+    if (isLineRead)
+    {
+        FAIL_TEST("A file with fewer than 3 vertices was read");
+    }
+
+    PASS_TEST();
+}
@@ -0,0 +1,48 @@
+#include "engine/unit/asset.unit.h"
+
+#include "engine/asset.h"
+
+#include <string.h>
+
+// assetHandle intern_asset(const char* fileName)
+IMPLEMENT_TEST(intern_asset)
+{
+    char fileName[64];
+    strcpy(fileName, "resources/unit/intern_asset.png");
+
+    assetHandle asset = intern_asset(fileName);
+    if (asset == INVALID_ASSET)
+    {
+        FAIL_TEST("Could not intern a file name");
+    }
+
+    // The file name is copied, so changing the caller's buffer doesn't change the interned name
+    strcpy(fileName, "resources/unit/intern_asset.vert");
+    if (strcmp(getFileName_asset(asset), "resources/unit/intern_asset.png") != 0)
+    {
+        FAIL_TEST("The interned file name changed with the caller's buffer");
+    }
+
+    if (intern_asset("resources/unit/intern_asset.png") != asset)
+    {
+        FAIL_TEST("Interning the same file name twice gave different handles");
+    }
+
+    assetHandle other = intern_asset(fileName);
+    if (other == INVALID_ASSET || other == asset)
+    {
+        FAIL_TEST("Different file names were interned as the same handle");
+    }
+
+    if (asset > getCount_asset() || other > getCount_asset())
+    {
+        FAIL_TEST("A handle is greater than the number of interned file names");
+    }
+
+    if (intern_asset(NULL) != INVALID_ASSET || getFileName_asset(INVALID_ASSET) || getFileName_asset(getCount_asset() + 1))
+    {
+        FAIL_TEST("An invalid file name or handle was accepted");
+    }
+
+    PASS_TEST();
+}
@@ -0,0 +1,121 @@
+#include "engine/unit/atlas.unit.h"
+
+#include "engine/atlas.h"
+
+// atlas* create_atlas(size_t width, size_t height)
+IMPLEMENT_TEST(create_atlas)
+{
+    if (create_atlas(0, 16) || create_atlas(16, 0))
+    {
+        FAIL_TEST("Created a packer for an empty page");
+    }
+
+    atlas* a = create_atlas(16, 16);
+    if (!a)
+    {
+        FAIL_TEST("Could not create a packer with the required arguments");
+    }
+
+    free_atlas(a);
+
+    PASS_TEST();
+}
+
+// bool pack_atlas(atlas* a, size_t width, size_t height, size_t* outX, size_t* outY)
+IMPLEMENT_TEST(pack_atlas)
+{
+    atlas* a = create_atlas(16, 16);
+    if (!a)
+    {
+        FAIL_TEST("Could not create a packer with the required arguments");
+    }
+
+    const size_t sizes[5][2] = {
+        { 8, 4 },
+        { 4, 8 },
+        { 4, 2 },
+        { 12, 4 },
+        { 3, 3 },
+    };
+    size_t placements[5][2];
+
+    for (int i = 0; i < 5; i++)
+    {
+        if (!pack_atlas(a, sizes[i][0], sizes[i][1], &placements[i][0], &placements[i][1]))
+        {
+            free_atlas(a);
+            FAIL_TEST("Could not pack a rectangle that fits");
+        }
+
+        if (placements[i][0] + sizes[i][0] > 16 || placements[i][1] + sizes[i][1] > 16)
+        {
+            free_atlas(a);
+            FAIL_TEST("Packed a rectangle outside of the page");
+        }
+    }
+
+    // The first rectangles are placed along the bottom of the page, left to right
+    if (placements[0][0] != 0 || placements[0][1] != 0 || placements[1][0] != 8 || placements[1][1] != 0)
+    {
+        free_atlas(a);
+        FAIL_TEST("The rectangles were not packed bottom left first");
+    }
+
+    for (int i = 0; i < 5; i++)
+    {
+        for (int j = i + 1; j < 5; j++)
+        {
+            bool separate = placements[i][0] + sizes[i][0] <= placements[j][0] ||
+                placements[j][0] + sizes[j][0] <= placements[i][0] ||
+                placements[i][1] + sizes[i][1] <= placements[j][1] ||
+                placements[j][1] + sizes[j][1] <= placements[i][1];
+
+            if (!separate)
+            {
+                free_atlas(a);
+                FAIL_TEST("Packed rectangles overlap");
+            }
+        }
+    }
+
+    free_atlas(a);
+
+    PASS_TEST();
+}
+
+// bool pack_atlas(atlas* a, size_t width, size_t height, size_t* outX, size_t* outY)
+IMPLEMENT_TEST(pack_atlas_full)
+{
+    atlas* a = create_atlas(8, 8);
+    if (!a)
+    {
+        FAIL_TEST("Could not create a packer with the required arguments");
+    }
+
+    size_t x, y;
+    if (pack_atlas(a, 9, 1, &x, &y) || pack_atlas(a, 1, 9, &x, &y))
+    {
+        free_atlas(a);
+        FAIL_TEST("Packed a rectangle larger than the page");
+    }
+
+    // Sixteen 2x2 rectangles fill the page exactly
+    for (int i = 0; i < 16; i++)
+    {
+        if (!pack_atlas(a, 2, 2, &x, &y))
+        {
+            free_atlas(a);
+            FAIL_TEST("Could not pack a rectangle that fits");
+        }
+    }
+
+    if (pack_atlas(a, 1, 1, &x, &y))
+    {
+        free_atlas(a);
+        FAIL_TEST("Packed a rectangle into a full page");
+    }
+
+    free_atlas(a);
+
+    PASS_TEST();
+}
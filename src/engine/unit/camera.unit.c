@@ -0,0 +1,129 @@
+#include "engine/unit/camera.unit.h"
+
+#include "engine/camera.h"
+#include "engine/math/float.h"
+#include "engine/math/transform.h"
+
+#include <stdio.h>
+
+/*
+Applies a 3x3 matrix to a 2d point
+*/
+vec2f _apply_camera(MATRIX_TYPE(3, 3)* m, vec2f p)
+{
+    return to_vec2f(
+        m->data[0][0] * GET_X(p) + m->data[0][1] * GET_Y(p) + m->data[0][2],
+        m->data[1][0] * GET_X(p) + m->data[1][1] * GET_Y(p) + m->data[1][2]);
+}
+
+// MATRIX_TYPE(3, 3) getView_camera(camera* c)
+IMPLEMENT_TEST(getView_camera)
+{
+    char resultMessage[120];
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Scenario: Default camera
+    ///////////////////////////////////////////////////////////////////////////
+    camera c = create_camera();
+    MATRIX_TYPE(3, 3) view = getView_camera(&c);
+
+    for (size_t row = 0; row < 3; row++)
+    {
+        for (size_t col = 0; col < 3; col++)
+        {
+            if (!equal_f(view.data[row][col], row == col ? 1.0f : 0.0f, DEFAULT_TOLERANCE))
+            {
+                sprintf(resultMessage, "Scenario 1: matrix[%zu][%zu] is not the identity. Actual value: %.3f", row, col, view.data[row][col]);
+                FAIL_TEST(resultMessage);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Scenario: Moved, rotated and zoomed camera
+    ///////////////////////////////////////////////////////////////////////////
+    c.position = to_vec2f(2.0f, -1.0f);
+    c.rotation = 0.5f;
+    c.zoom = 2.0f;
+    view = getView_camera(&c);
+
+    // The camera's position is always at the center of the view
+    vec2f center = _apply_camera(&view, c.position);
+    if (!equal_f(GET_X(center), 0.0f, DEFAULT_TOLERANCE) || !equal_f(GET_Y(center), 0.0f, DEFAULT_TOLERANCE))
+    {
+        FAIL_TEST("Scenario 2: the camera position is not at the center of the view");
+    }
+
+    // The view undoes the camera's transform, so a point placed by the camera's transform comes back zoomed in
+    transform t = { c.position, c.rotation, to_vec2f(1.0f, 1.0f) };
+    MATRIX_TYPE(3, 3) cameraMat = getMatrix_transform(&t);
+    vec2f p = _apply_camera(&view, _apply_camera(&cameraMat, to_vec2f(0.25f, 0.5f)));
+    if (!equal_f(GET_X(p), 0.5f, DEFAULT_TOLERANCE) || !equal_f(GET_Y(p), 1.0f, DEFAULT_TOLERANCE))
+    {
+        sprintf(resultMessage, "Scenario 2: the view is not the inverse of the camera. Actual value: (%.3f, %.3f)", GET_X(p), GET_Y(p));
+        FAIL_TEST(resultMessage);
+    }
+
+    PASS_TEST();
+}
+
+// void getBounds_camera(camera* c, float aspect, vec2f* outMin, vec2f* outMax)
+IMPLEMENT_TEST(getBounds_camera)
+{
+    vec2f min;
+    vec2f max;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Scenario: Moved and zoomed camera
+    ///////////////////////////////////////////////////////////////////////////
+    camera c = create_camera();
+    c.position = to_vec2f(3.0f, 1.0f);
+    c.zoom = 2.0f;
+
+    getBounds_camera(&c, 0.5f, &min, &max);
+
+    // The edges of the bounds must be exactly on the edges of clip space
+    MATRIX_TYPE(3, 3) viewProjection = getViewProjection_camera(&c, 0.5f);
+    vec2f clipMin = _apply_camera(&viewProjection, min);
+    vec2f clipMax = _apply_camera(&viewProjection, max);
+    if (!equal_f(GET_X(clipMin), -1.0f, DEFAULT_TOLERANCE) || !equal_f(GET_Y(clipMin), -1.0f, DEFAULT_TOLERANCE) ||
+        !equal_f(GET_X(clipMax), 1.0f, DEFAULT_TOLERANCE) || !equal_f(GET_Y(clipMax), 1.0f, DEFAULT_TOLERANCE))
+    {
+        FAIL_TEST("Scenario 1: the bounds do not match the screen");
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Scenario: Rotated camera
+    ///////////////////////////////////////////////////////////////////////////
+    c = create_camera();
+    c.rotation = 1.5707963f;
+
+    getBounds_camera(&c, 0.5f, &min, &max);
+
+    // A quarter turn swaps the width and height of the screen
+    if (!equal_f(GET_X(min), -1.0f, DEFAULT_TOLERANCE) || !equal_f(GET_Y(min), -2.0f, DEFAULT_TOLERANCE) ||
+        !equal_f(GET_X(max), 1.0f, DEFAULT_TOLERANCE) || !equal_f(GET_Y(max), 2.0f, DEFAULT_TOLERANCE))
+    {
+        FAIL_TEST("Scenario 2: the bounds of a rotated camera are not correct");
+    }
+
+    PASS_TEST();
+}
+
+// MATRIX_TYPE(3, 3) getViewProjection_camera(camera* c, float aspect)
+IMPLEMENT_TEST(getViewProjection_camera)
+{
+    camera c = create_camera();
+    c.position = to_vec2f(1.0f, 1.0f);
+
+    MATRIX_TYPE(3, 3) viewProjection = getViewProjection_camera(&c, 0.5f);
+
+    // Only the x axis is scaled by the aspect ratio
+    vec2f p = _apply_camera(&viewProjection, to_vec2f(2.0f, 2.0f));
+    if (!equal_f(GET_X(p), 0.5f, DEFAULT_TOLERANCE) || !equal_f(GET_Y(p), 1.0f, DEFAULT_TOLERANCE))
+    {
+        FAIL_TEST("The projection was not applied after the view");
+    }
+
+    PASS_TEST();
+}
@@ -159,6 +159,49 @@ DEFINE_TEST(create_collider_quad)
     PASS_TEST();
 }
 
+DEFINE_TEST(createWithOptions_collider_simplified)
+{
+    transform zeroTransform = {
+        to_vec2f(0.0f, 0.0f), // position
+        0.0f,                 // rotation
+        to_vec2f(1.0f, 1.0f), // scale
+    };
+
+    // A traced square, with nearly collinear vertices along its sides
+    vec2f vertices[] = {
+        to_vec2f(-1.0f, -1.0f), to_vec2f(0.0f, -1.001f), to_vec2f(1.0f, -1.0f), to_vec2f(1.001f, 0.0f),
+        to_vec2f(1.0f, 1.0f), to_vec2f(0.0f, 0.999f), to_vec2f(-1.0f, 1.0f), to_vec2f(-0.999f, 0.0f)
+    };
+    polygon square;
+    square.vertexCount = 8;
+    square.vertices = vertices;
+
+    colliderOptions options = DEFAULT_COLLIDER_OPTIONS;
+    options.simplifyTolerance = 0.01f;
+
+    collider* c = createWithOptions_collider(&zeroTransform, &square, &options);
+    if (!c)
+    {
+        FAIL_TEST("Could not create a simplified collider");
+    }
+
+    int polygonCount = c->polygonCount;
+    int vertexCount = polygonCount > 0 ? c->polygons[0].vertexCount : 0;
+    free_collider(c);
+
+    if (polygonCount != 1)
+    {
+        FAIL_TEST("The simplified square was decomposed into more than 1 internal polygon");
+    }
+
+    if (vertexCount != 4)
+    {
+        FAIL_TEST("The nearly collinear vertices were not dropped");
+    }
+
+    PASS_TEST();
+}
+
 DEFINE_TEST(detectCollision_collider)
 {
     FAIL_TEST("stub");
@@ -0,0 +1,117 @@
+#include "engine/unit/components.unit.h"
+
+#include "engine/components.h"
+#include "engine/gameObject.h"
+#include "engine/math/float.h"
+
+// bool push_components(components* c, gameObject* g)
+IMPLEMENT_TEST(push_components)
+{
+    // Start small so the storage has to grow
+    components c;
+    if (!create_components(&c, 1))
+    {
+        FAIL_TEST("Could not create a components storage with the required arguments");
+    }
+
+    gameObject* g1 = create_gameObject(1);
+    gameObject* g2 = create_gameObject(2);
+    if (!g1 || !g2 || !push_components(&c, g1) || !push_components(&c, g2))
+    {
+        free_gameObject(g1);
+        free_gameObject(g2);
+        free_components(&c);
+        FAIL_TEST("Could not push gameObjects into the storage");
+    }
+
+    if (c.count != 2 || c.types[0] != 1 || c.types[1] != 2)
+    {
+        free_gameObject(g1);
+        free_gameObject(g2);
+        free_components(&c);
+        FAIL_TEST("The pushed gameObjects are not stored in order");
+    }
+
+    // Changes to a pushed gameObject must be written through to the storage
+    transform t = getTransform_gameObject(g2);
+    t.position = to_vec2f(3.0f, 4.0f);
+    t.rotation = 1.0f;
+    setTransform_gameObject(g2, t);
+
+    if (!equal_f(GET_X(c.positions[1]), 3.0f, DEFAULT_TOLERANCE) ||
+        !equal_f(GET_Y(c.positions[1]), 4.0f, DEFAULT_TOLERANCE) ||
+        !equal_f(c.rotations[1], 1.0f, DEFAULT_TOLERANCE))
+    {
+        free_gameObject(g1);
+        free_gameObject(g2);
+        free_components(&c);
+        FAIL_TEST("setTransform_gameObject() was not written through to the storage");
+    }
+
+    if (c.radii[1] != 0.0f || c.colliders[1] || c.renders[1])
+    {
+        free_gameObject(g1);
+        free_gameObject(g2);
+        free_components(&c);
+        FAIL_TEST("A gameObject without a collider or render has bounds");
+    }
+
+    free_gameObject(g1);
+    free_gameObject(g2);
+    free_components(&c);
+
+    PASS_TEST();
+}
+
+// bool swapRemove_components(components* c, size_t index)
+IMPLEMENT_TEST(swapRemove_components)
+{
+    components c;
+    if (!create_components(&c, 4))
+    {
+        FAIL_TEST("Could not create a components storage with the required arguments");
+    }
+
+    gameObject* gameObjects[3] = { create_gameObject(1), create_gameObject(2), create_gameObject(3) };
+    for (int i = 0; i < 3; i++)
+    {
+        if (!gameObjects[i] || !push_components(&c, gameObjects[i]))
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                free_gameObject(gameObjects[j]);
+            }
+            free_components(&c);
+            FAIL_TEST("Could not push gameObjects into the storage");
+        }
+    }
+
+    if (swapRemove_components(&c, 3))
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            free_gameObject(gameObjects[i]);
+        }
+        free_components(&c);
+        FAIL_TEST("Removed an index that is out of bounds");
+    }
+
+    // The last components must fill the hole
+    if (!swapRemove_components(&c, 0) || c.count != 2 || c.types[0] != 3 || c.types[1] != 2)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            free_gameObject(gameObjects[i]);
+        }
+        free_components(&c);
+        FAIL_TEST("The last components did not fill the removed index");
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        free_gameObject(gameObjects[i]);
+    }
+    free_components(&c);
+
+    PASS_TEST();
+}
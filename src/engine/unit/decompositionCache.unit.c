@@ -0,0 +1,318 @@
+#include "engine/unit/decompositionCache.unit.h"
+
+#include "engine/decompositionCache.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// A concave arrow, which is decomposed into more than one piece
+static vec2f arrowVertices[] = {
+    to_vec2f(0.0f, 0.0f), to_vec2f(2.0f, 1.0f), to_vec2f(4.0f, 0.0f), to_vec2f(2.0f, 4.0f)
+};
+
+/*
+Checks whether two decompositions have exactly the same pieces
+*/
+bool _isEqual_decompositionCacheTest(polygon* a, int aCount, polygon* b, int bCount)
+{
+    if (aCount != bCount)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < aCount; i++)
+    {
+        if (a[i].vertexCount != b[i].vertexCount)
+        {
+            return false;
+        }
+
+        for (int j = 0; j < a[i].vertexCount; j++)
+        {
+            if (!equal_vec2f(a[i].vertices[j], b[i].vertices[j], 0.0001f))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+Frees a decomposition
+*/
+void _free_decompositionCacheTest(polygon* pieces, int count)
+{
+    for (int i = 0; pieces && i < count; i++)
+    {
+        free_polygon(&pieces[i]);
+    }
+    free(pieces);
+}
+
+// bool decompose_decompositionCache(polygon* in, polygon** out, int* outCount)
+IMPLEMENT_TEST(decompose_decompositionCache)
+{
+    polygon arrow = { arrowVertices, sizeof(arrowVertices) / sizeof(vec2f) };
+    clear_decompositionCache();
+
+    polygon* expected;
+    int expectedCount;
+    decompose_polygon(&arrow, &expected, &expectedCount);
+
+    polygon* first;
+    int firstCount;
+    bool isFirstDecomposed = decompose_decompositionCache(&arrow, &first, &firstCount);
+    decompositionCacheStats afterFirst = getStats_decompositionCache();
+
+    polygon* second;
+    int secondCount;
+    bool isSecondDecomposed = decompose_decompositionCache(&arrow, &second, &secondCount);
+    decompositionCacheStats afterSecond = getStats_decompositionCache();
+
+    bool isFirstEqual = isFirstDecomposed && _isEqual_decompositionCacheTest(first, firstCount, expected, expectedCount);
+    bool isSecondEqual = isSecondDecomposed && _isEqual_decompositionCacheTest(second, secondCount, expected, expectedCount);
+
+    // Each caller owns its own copy of the pieces
+    bool isCopied = isFirstDecomposed && isSecondDecomposed && first[0].vertices != second[0].vertices;
+
+    _free_decompositionCacheTest(expected, expectedCount);
+    _free_decompositionCacheTest(first, firstCount);
+    _free_decompositionCacheTest(second, secondCount);
+    clear_decompositionCache();
+
+    if (expectedCount < 2)
+    {
+        FAIL_TEST("The test polygon is not concave");
+    }
+
+    if (!isFirstEqual || !isSecondEqual)
+    {
+        FAIL_TEST("The cached decomposition differs from decompose_polygon()");
+    }
+
+    if (afterFirst.misses != 1 || afterFirst.entries != 1 || afterSecond.hits != 1 || afterSecond.misses != 1)
+    {
+        FAIL_TEST("The second decomposition was not copied from the cache");
+    }
+
+    if (!isCopied)
+    {
+        FAIL_TEST("Both callers were given the same pieces");
+    }
+
+    PASS_TEST();
+}
+
+// bool decomposeWithMode_decompositionCache(polygon* in, decompositionMode mode, polygon** out, int* outCount)
+IMPLEMENT_TEST(decomposeWithMode_decompositionCache)
+{
+    polygon arrow = { arrowVertices, sizeof(arrowVertices) / sizeof(vec2f) };
+    clear_decompositionCache();
+
+    polygon* expected;
+    int expectedCount;
+    decomposeMinimum_polygon(&arrow, &expected, &expectedCount);
+
+    polygon* fast;
+    int fastCount;
+    bool isFastDecomposed = decomposeWithMode_decompositionCache(&arrow, DECOMPOSITION_FAST, &fast, &fastCount);
+
+    polygon* first;
+    int firstCount;
+    bool isFirstDecomposed = decomposeWithMode_decompositionCache(&arrow, DECOMPOSITION_MINIMUM, &first, &firstCount);
+    decompositionCacheStats afterFirst = getStats_decompositionCache();
+
+    polygon* second;
+    int secondCount;
+    bool isSecondDecomposed = decomposeWithMode_decompositionCache(&arrow, DECOMPOSITION_MINIMUM, &second, &secondCount);
+    decompositionCacheStats afterSecond = getStats_decompositionCache();
+
+    bool isFirstEqual = isFirstDecomposed && _isEqual_decompositionCacheTest(first, firstCount, expected, expectedCount);
+    bool isSecondEqual = isSecondDecomposed && _isEqual_decompositionCacheTest(second, secondCount, expected, expectedCount);
+
+    _free_decompositionCacheTest(expected, expectedCount);
+    _free_decompositionCacheTest(fast, fastCount);
+    _free_decompositionCacheTest(first, firstCount);
+    _free_decompositionCacheTest(second, secondCount);
+    clear_decompositionCache();
+
+    if (!isFastDecomposed || !isFirstEqual || !isSecondEqual)
+    {
+        FAIL_TEST("The cached decomposition differs from decomposeMinimum_polygon()");
+    }
+
+    // The fast decomposition of the same polygon must not be returned for the minimum one
+    if (afterFirst.misses != 2 || afterFirst.entries != 2)
+    {
+        FAIL_TEST("Both modes were not cached separately");
+    }
+
+    if (afterSecond.hits != 1 || afterSecond.misses != 2)
+    {
+        FAIL_TEST("The second decomposition was not copied from the cache");
+    }
+
+    PASS_TEST();
+}
+
+// bool load_decompositionCache(const char* fileName)
+IMPLEMENT_TEST(load_decompositionCache)
+{
+    const char* fileName = "/tmp/load_decompositionCache.cache";
+    polygon arrow = { arrowVertices, sizeof(arrowVertices) / sizeof(vec2f) };
+    clear_decompositionCache();
+
+    polygon* saved;
+    int savedCount;
+    decompose_decompositionCache(&arrow, &saved, &savedCount);
+    bool isSaved = save_decompositionCache(fileName);
+
+    // Each corrupted file below starts from a fresh copy of the saved one
+    polygon* resaved;
+    int resavedCount;
+
+    clear_decompositionCache();
+    bool isLoaded = load_decompositionCache(fileName);
+
+    polygon* loaded;
+    int loadedCount;
+    bool isDecomposed = decompose_decompositionCache(&arrow, &loaded, &loadedCount);
+    decompositionCacheStats stats = getStats_decompositionCache();
+
+    bool isEqual = isDecomposed && _isEqual_decompositionCacheTest(loaded, loadedCount, saved, savedCount);
+
+    _free_decompositionCacheTest(saved, savedCount);
+    if (isDecomposed)
+    {
+        _free_decompositionCacheTest(loaded, loadedCount);
+    }
+
+    // A file written with another vertex size in its header is rejected instead of misread
+    FILE* resized = fopen(fileName, "r+b");
+    if (resized)
+    {
+        uint32_t vertexSize = 12;
+        fseek(resized, 12, SEEK_SET); // After the magic, version and record size
+        fwrite(&vertexSize, sizeof(uint32_t), 1, resized);
+        fclose(resized);
+    }
+
+    clear_decompositionCache();
+    bool isResizedLoaded = load_decompositionCache(fileName);
+    size_t resizedEntries = getStats_decompositionCache().entries;
+
+    // A record whose counts are larger than the rest of the file is rejected before they are allocated
+    clear_decompositionCache();
+    decompose_decompositionCache(&arrow, &resaved, &resavedCount);
+    _free_decompositionCacheTest(resaved, resavedCount);
+    save_decompositionCache(fileName);
+
+    FILE* corrupted = fopen(fileName, "r+b");
+    if (corrupted)
+    {
+        uint32_t counts[2] = { INT_MAX, INT_MAX / 2 }; // The record's vertex and piece counts
+        fseek(corrupted, 32, SEEK_SET); // After the header and the record's key
+        fwrite(counts, sizeof(uint32_t), 2, corrupted);
+        fclose(corrupted);
+    }
+
+    clear_decompositionCache();
+    bool isCorruptedLoaded = load_decompositionCache(fileName);
+    size_t corruptedEntries = getStats_decompositionCache().entries;
+
+    // A truncated file is rejected without adding anything
+    clear_decompositionCache();
+    decompose_decompositionCache(&arrow, &resaved, &resavedCount);
+    _free_decompositionCacheTest(resaved, resavedCount);
+    save_decompositionCache(fileName);
+
+    FILE* truncated = fopen(fileName, "r+b");
+    if (truncated)
+    {
+        fseek(truncated, 0, SEEK_END);
+        long size = ftell(truncated);
+        fclose(truncated);
+        truncate(fileName, size - 4);
+    }
+
+    clear_decompositionCache();
+    bool isTruncatedLoaded = load_decompositionCache(fileName);
+    size_t truncatedEntries = getStats_decompositionCache().entries;
+
+    clear_decompositionCache();
+    remove(fileName);
+
+    if (!isSaved || !isLoaded)
+    {
+        FAIL_TEST("Could not save and load the cache");
+    }
+
+    if (!isEqual || stats.hits != 1 || stats.misses != 0)
+    {
+        FAIL_TEST("The loaded decomposition was not copied from the cache");
+    }
+
+    if (isResizedLoaded || resizedEntries != 0)
+    {
+        FAIL_TEST("A cache file with another vertex layout was loaded");
+    }
+
+    if (isCorruptedLoaded || corruptedEntries != 0)
+    {
+        FAIL_TEST("A cache file with corrupt counts was loaded");
+    }
+
+    if (isTruncatedLoaded || truncatedEntries != 0)
+    {
+        FAIL_TEST("A truncated cache file was loaded");
+    }
+
+    PASS_TEST();
+}
+
+// void setCapacity_decompositionCache(size_t maxEntries)
+IMPLEMENT_TEST(setCapacity_decompositionCache)
+{
+    vec2f flippedVertices[] = {
+        to_vec2f(0.0f, 0.0f), to_vec2f(2.0f, -1.0f), to_vec2f(4.0f, 0.0f), to_vec2f(2.0f, -4.0f)
+    };
+    polygon shapes[2] = {
+        { arrowVertices, sizeof(arrowVertices) / sizeof(vec2f) },
+        { flippedVertices, sizeof(flippedVertices) / sizeof(vec2f) },
+    };
+    clear_decompositionCache();
+    setCapacity_decompositionCache(1);
+
+    // The second shape is still decomposed once the cache is full, it just isn't cached
+    bool isDecomposed = true;
+    for (int i = 0; i < 4; i++)
+    {
+        polygon* pieces;
+        int pieceCount;
+        isDecomposed = decompose_decompositionCache(&shapes[i % 2], &pieces, &pieceCount) && pieceCount > 0 && isDecomposed;
+        if (isDecomposed)
+        {
+            _free_decompositionCacheTest(pieces, pieceCount);
+        }
+    }
+    decompositionCacheStats stats = getStats_decompositionCache();
+
+    setCapacity_decompositionCache(DEFAULT_DECOMPOSITION_CACHE_CAPACITY);
+    clear_decompositionCache();
+
+    if (!isDecomposed)
+    {
+        FAIL_TEST("A polygon could not be decomposed once the cache was full");
+    }
+
+    if (stats.entries != 1 || stats.hits != 1 || stats.misses != 3)
+    {
+        FAIL_TEST("The cache grew past its capacity");
+    }
+
+    PASS_TEST();
+}
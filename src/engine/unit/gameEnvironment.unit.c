@@ -0,0 +1,276 @@
+#include "engine/unit/gameEnvironment.unit.h"
+
+#include "engine/gameEnvironment.h"
+#include "engine/gameObject.h"
+#include "engine/render.h"
+#include "engine/renderBackend.h"
+#include "engine/renderBackendNull.h"
+#include "engine/renderBackendSoftware.h"
+#include "engine/staticBatch.h"
+#include "engine/texture.h"
+#include "engine/unit/texture.unit.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+// How many steps the test waits for the decode workers, one millisecond apart
+#define DECODE_TIMEOUT 5000
+
+void _onCollision_gameEnvironmentTest(gameEnvironment* env, gameObject* g1, gameObject* g2, collision* c) {}
+void _onRenderStart_gameEnvironmentTest(gameEnvironment* env) {}
+void _onRenderEnd_gameEnvironmentTest(gameEnvironment* env) {}
+void _onRemoveGameObject_gameEnvironmentTest(gameEnvironment* env, gameObject* g) {}
+
+// void run_gameEnvironment(gameEnvironment* env)
+IMPLEMENT_TEST(run_gameEnvironment_evictions)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    const char* fileNames[2] = {
+        "/tmp/run_gameEnvironment_evictions0.png",
+        "/tmp/run_gameEnvironment_evictions1.png",
+    };
+
+    for (int i = 0; i < 2; i++)
+    {
+        if (!_writeWide_textureTest(fileNames[i]))
+        {
+            FAIL_TEST("Could not write the test textures");
+        }
+    }
+
+    gameEvents ge = {
+        NULL,
+        _onCollision_gameEnvironmentTest,
+        _onRenderStart_gameEnvironmentTest,
+        _onRenderEnd_gameEnvironmentTest,
+        _onRemoveGameObject_gameEnvironmentTest
+    };
+    gameSettings gs = { 1.0f, 0 };
+    gameEnvironment* env = create_gameEnvironment(ge, gs);
+    if (!env)
+    {
+        FAIL_TEST("Could not create the gameEnvironment");
+    }
+
+    textureStats before = getStats_texture();
+    textureRegion first = get_texture(fileNames[0]);
+
+    // No room for another page, and nothing in the environment uses the first one
+    setBudget_texture(getStats_texture().gpuBytes, 0);
+
+    for (int step = 0; step < 5; step++)
+    {
+        run_gameEnvironment(env);
+    }
+
+    // The second page is uploaded by the steps, which must evict the first to stay within the budget
+    const textureRegion* second = request_texture(fileNames[1]);
+    for (int waited = 0; getPendingCount_texture() > 0 && waited < DECODE_TIMEOUT; waited++)
+    {
+        run_gameEnvironment(env);
+        usleep(1000);
+    }
+    textureStats after = getStats_texture();
+
+    setBudget_texture(0, 0);
+    free_gameEnvironment(env);
+    for (int i = 0; i < 2; i++)
+    {
+        remove(fileNames[i]);
+    }
+
+    if (first.textureId == 0 || !second)
+    {
+        FAIL_TEST("Could not load the test textures");
+    }
+
+    if (getPendingCount_texture() != 0)
+    {
+        FAIL_TEST("The requested texture was not uploaded");
+    }
+
+    if (after.evictions <= before.evictions)
+    {
+        FAIL_TEST("Running the environment over budget did not evict the unused page");
+    }
+
+    PASS_TEST();
+}
+
+// bool setRender_gameObject(gameObject* g, renderInfo rI)
+IMPLEMENT_TEST(setRender_gameObject_static)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    gameEvents ge = {
+        NULL,
+        _onCollision_gameEnvironmentTest,
+        _onRenderStart_gameEnvironmentTest,
+        _onRenderEnd_gameEnvironmentTest,
+        _onRemoveGameObject_gameEnvironmentTest
+    };
+    gameSettings gs = { 1.0f, 0 };
+    gameEnvironment* env = create_gameEnvironment(ge, gs);
+    if (!env)
+    {
+        FAIL_TEST("Could not create the gameEnvironment");
+    }
+
+    textureRegion region = { 1, to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 1.0f) };
+    renderInfo rI = { to_vec2f(1.0f, 1.0f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", region };
+
+    gameObject* staticObject = createGameObject_gameEnvironment(env, 0);
+    gameObject* dynamicObject = createGameObject_gameEnvironment(env, 0);
+    setStatic_gameObject(staticObject, true);
+    addGameObject_gameEnvironment(env, staticObject);
+    addGameObject_gameEnvironment(env, dynamicObject);
+    run_gameEnvironment(env);
+
+    // The static batches were already built without it, so the render could never be drawn
+    bool isStaticSet = setRender_gameObject(staticObject, rI);
+    bool isDynamicSet = setRender_gameObject(dynamicObject, rI);
+
+    free_gameEnvironment(env);
+
+    if (isStaticSet)
+    {
+        FAIL_TEST("A render was set on a static gameObject that was already added");
+    }
+
+    if (!isDynamicSet)
+    {
+        FAIL_TEST("A render could not be set on a gameObject that was already added");
+    }
+
+    PASS_TEST();
+}
+
+// void run_gameEnvironment(gameEnvironment* env)
+IMPLEMENT_TEST(run_gameEnvironment_staticRenders)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    gameEvents ge = {
+        NULL,
+        _onCollision_gameEnvironmentTest,
+        _onRenderStart_gameEnvironmentTest,
+        _onRenderEnd_gameEnvironmentTest,
+        _onRemoveGameObject_gameEnvironmentTest
+    };
+    gameSettings gs = { 1.0f, 0 };
+    gameEnvironment* env = create_gameEnvironment(ge, gs);
+    if (!env)
+    {
+        FAIL_TEST("Could not create the gameEnvironment");
+    }
+
+    // One static render that can be batched, and one whose program reads its own transform
+    textureRegion region = { 1, to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 1.0f) };
+    renderInfo infos[2] = {
+        { to_vec2f(1.0f, 1.0f), STATIC_VERTEX_SHADER, STATIC_FRAGMENT_SHADER, region },
+        { to_vec2f(1.0f, 1.0f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", region },
+    };
+
+    bool isCreated = true;
+    for (int i = 0; i < 2; i++)
+    {
+        gameObject* g = createGameObject_gameEnvironment(env, 0);
+        isCreated = g && setRender_gameObject(g, infos[i]) && setStatic_gameObject(g, true) &&
+            addGameObject_gameEnvironment(env, g) && isCreated;
+    }
+
+    resetStats_nullRenderBackend();
+    run_gameEnvironment(env);
+    nullRenderBackendStats stats = getStats_nullRenderBackend();
+
+    free_gameEnvironment(env);
+
+    if (!isCreated)
+    {
+        FAIL_TEST("Could not create the static gameObjects");
+    }
+
+    if (stats.batchDraws != 1 || stats.instances != 1)
+    {
+        FAIL_TEST("The static render that can't be batched was not drawn like any other render");
+    }
+
+    PASS_TEST();
+}
+
+// void run_gameEnvironment(gameEnvironment* env)
+IMPLEMENT_TEST(run_gameEnvironment_staticLayers)
+{
+    const renderBackend* backend = getSoftware_renderBackend();
+    set_renderBackend(backend);
+
+    if (!init_softwareRenderBackend(8, 8, 1))
+    {
+        set_renderBackend(NULL);
+        FAIL_TEST("Could not create the software framebuffer");
+    }
+
+    gameEvents ge = {
+        NULL,
+        _onCollision_gameEnvironmentTest,
+        _onRenderStart_gameEnvironmentTest,
+        _onRenderEnd_gameEnvironmentTest,
+        _onRemoveGameObject_gameEnvironmentTest
+    };
+    gameSettings gs = { 1.0f, 0 };
+    gameEnvironment* env = create_gameEnvironment(ge, gs);
+    if (!env)
+    {
+        free_softwareRenderBackend();
+        set_renderBackend(NULL);
+        FAIL_TEST("Could not create the gameEnvironment");
+    }
+
+    const uint8_t white[2 * 2 * 4] = {
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+    };
+    uint32_t textureId = backend->createTexture(2, 2, 1);
+    backend->updateTexture(textureId, 0, 0, 0, 2, 2, white);
+    textureRegion region = { textureId, to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 1.0f) };
+
+    // A red static render on layer 5, under which a green dynamic render on layer 0 covers the same pixels
+    renderInfo infos[2] = {
+        { to_vec2f(4.0f, 4.0f), STATIC_VERTEX_SHADER, STATIC_FRAGMENT_SHADER, region },
+        { to_vec2f(4.0f, 4.0f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", region },
+    };
+    const uint8_t layers[2] = { 5, 0 };
+    const vec3f colors[2] = { to_vec3f(1.0f, 0.0f, 0.0f), to_vec3f(0.0f, 1.0f, 0.0f) };
+
+    bool isCreated = true;
+    for (int i = 0; i < 2; i++)
+    {
+        gameObject* g = createGameObject_gameEnvironment(env, 0);
+        isCreated = g && setRender_gameObject(g, infos[i]) && setStatic_gameObject(g, i == 0) &&
+            setLayer_render(getRender_gameObject(g), layers[i]) && setColor_render(getRender_gameObject(g), colors[i]) &&
+            addGameObject_gameEnvironment(env, g) && isCreated;
+    }
+
+    run_gameEnvironment(env);
+
+    size_t width, height;
+    const uint8_t* center = &getFramebuffer_softwareRenderBackend(&width, &height)[(4 * 8 + 4) * 4];
+    bool isStaticOnTop = center[0] == 255 && center[1] == 0;
+
+    free_gameEnvironment(env);
+    free_softwareRenderBackend();
+    set_renderBackend(NULL);
+
+    if (!isCreated)
+    {
+        FAIL_TEST("Could not create the gameObjects");
+    }
+
+    if (!isStaticOnTop)
+    {
+        FAIL_TEST("A static render on a higher layer was drawn under a dynamic render");
+    }
+
+    PASS_TEST();
+}
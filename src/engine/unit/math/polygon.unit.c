@@ -1,5 +1,6 @@
 #include "engine/unit/math/polygon.unit.h"
 
+#include <math.h>
 #include <stdlib.h>
 
 #include "engine/util.h"
@@ -425,6 +426,57 @@ bool verifyDiagonals(int diagonalCount, vertexDiagonal** actualDiagonals, vertex
     return true;
 }
 
+// Vertices placed with trigonometry are rounded, so a convex corner may turn very slightly the wrong way
+static const float CONVEX_TOLERANCE = 0.0001f;
+static const float AREA_TOLERANCE = 0.01f;
+
+// Gets the area of a polygon with the shoelace formula, which is positive for counter clockwise vertices
+static float getArea(polygon* poly)
+{
+    float area = 0.0f;
+    for (int i = 0; i < poly->vertexCount; i++)
+    {
+        vec2f a = poly->vertices[i];
+        vec2f b = poly->vertices[(i + 1) % poly->vertexCount];
+        area += (GET_X(a) * GET_Y(b) - GET_X(b) * GET_Y(a)) / 2.0f;
+    }
+
+    return area;
+}
+
+// Checks that the pieces a polygon was decomposed into are convex and cover its area.
+// resultMsg should be at least 80 characters pre-allocated memory
+static bool verifyConvexPieces(polygon* pieces, int pieceCount, float expectedArea, char resultMsg[80])
+{
+    float area = 0.0f;
+    for (int i = 0; i < pieceCount; i++)
+    {
+        polygon* piece = &pieces[i];
+        for (int j = 0; j < piece->vertexCount; j++)
+        {
+            vec2f a = piece->vertices[j];
+            vec2f b = piece->vertices[(j + 1) % piece->vertexCount];
+            vec2f c = piece->vertices[(j + 2) % piece->vertexCount];
+
+            if ((GET_X(b) - GET_X(a)) * (GET_Y(c) - GET_Y(a)) - (GET_X(c) - GET_X(a)) * (GET_Y(b) - GET_Y(a)) < -CONVEX_TOLERANCE)
+            {
+                sprintf(resultMsg, "Polygon %d is not convex at vertex %d", i, (j + 1) % piece->vertexCount);
+                return false;
+            }
+        }
+
+        area += getArea(piece);
+    }
+
+    if (!equal_f(area, expectedArea, AREA_TOLERANCE))
+    {
+        sprintf(resultMsg, "The polygons cover an area of %f instead of %f", area, expectedArea);
+        return false;
+    }
+
+    return true;
+}
+
 // vertexDiagonal** _triangulate_polygon(polygon* poly, vertexDiagonal** diagonalPool)
 IMPLEMENT_TEST(_triangulate_polygon_quad)
 {
@@ -654,6 +706,172 @@ IMPLEMENT_TEST(_triangulate_polygon_complexReflex)
     }
 }
 
+/*
+Triangulates a counter clockwise polygon with _triangulateMonotone_polygon() and removes the inessential diagonals,
+the same as decompose_polygon() does for large polygons, and checks that the remaining diagonals split it into
+convex pieces. resultMsg should be at least 80 characters pre-allocated memory.
+*/
+static bool verifyMonotoneDecomposition(polygon* poly, char resultMsg[80])
+{
+    vertexDiagonal* diagonalPool;
+    vertexDiagonal** diagonals = _triangulateMonotone_polygon(poly, &diagonalPool);
+    if (!diagonals)
+    {
+        sprintf(resultMsg, "Memory allocation failure");
+        return false;
+    }
+
+    // A triangulation has vertexCount - 3 diagonals, and every diagonal is in the list of both of its ends
+    int diagonalEndCount = 0;
+    bool isLinked = true;
+    for (int i = 0; i < poly->vertexCount; i++)
+    {
+        vertexDiagonal* diagonal = diagonals[i];
+        while (diagonal && diagonal->prev)
+        {
+            diagonal = diagonal->prev;
+        }
+
+        for (; diagonal; diagonal = diagonal->next)
+        {
+            diagonalEndCount++;
+
+            if (diagonal->index != i || diagonal->opposite->opposite != diagonal ||
+                (diagonal->next && diagonal->next->prev != diagonal))
+            {
+                isLinked = false;
+            }
+        }
+    }
+
+    // Removing the inessential diagonals must still leave convex polygons that cover the shape
+    int essentialDiagonalCount = _removeInessentialDiagonals_vertexDiagonals(poly, diagonals);
+    polygon* convexPolygons = _generateConvexPolygons_vertexDiagonals(poly, diagonals, essentialDiagonalCount);
+
+    bool isConvex = convexPolygons &&
+        verifyConvexPieces(convexPolygons, essentialDiagonalCount + 1, getArea(poly), resultMsg);
+    for (int i = 0; convexPolygons && i <= essentialDiagonalCount; i++)
+    {
+        free_polygon(&convexPolygons[i]);
+    }
+
+    free(convexPolygons);
+    free(diagonalPool);
+    free(diagonals);
+
+    if (diagonalEndCount != (poly->vertexCount - 3) * 2)
+    {
+        sprintf(resultMsg, "The polygon was not fully triangulated");
+        return false;
+    }
+
+    if (!isLinked)
+    {
+        sprintf(resultMsg, "The diagonals are not linked to each other");
+        return false;
+    }
+
+    if (!convexPolygons)
+    {
+        sprintf(resultMsg, "The diagonals did not decompose the polygon into convex polygons");
+        return false;
+    }
+
+    return isConvex;
+}
+
+// vertexDiagonal** _triangulateMonotone_polygon(polygon* poly, vertexDiagonal** diagonalPool)
+IMPLEMENT_TEST(_triangulateMonotone_polygon_quad)
+{
+    // The same shape as decompose_polygon_quad
+    vec2f vertices[4] = {to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 0.0f), to_vec2f(1.0f, 1.0f), to_vec2f(0.0f, 1.0f)};
+    polygon poly;
+    poly.vertexCount = 4;
+    poly.vertices = vertices;
+
+    char resultMsg[80];
+    if (!verifyMonotoneDecomposition(&poly, resultMsg))
+    {
+        FAIL_TEST(resultMsg);
+    }
+
+    PASS_TEST();
+}
+
+// vertexDiagonal** _triangulateMonotone_polygon(polygon* poly, vertexDiagonal** diagonalPool)
+IMPLEMENT_TEST(_triangulateMonotone_polygon_quadReflex)
+{
+    // The same shape as decompose_polygon_quadReflex
+    vec2f vertices[4] = {to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 1.0f), to_vec2f(2.0f, 0.0f), to_vec2f(1.0f, 2.0f)};
+    polygon poly;
+    poly.vertexCount = 4;
+    poly.vertices = vertices;
+
+    char resultMsg[80];
+    if (!verifyMonotoneDecomposition(&poly, resultMsg))
+    {
+        FAIL_TEST(resultMsg);
+    }
+
+    PASS_TEST();
+}
+
+// vertexDiagonal** _triangulateMonotone_polygon(polygon* poly, vertexDiagonal** diagonalPool)
+IMPLEMENT_TEST(_triangulateMonotone_polygon_complexReflex)
+{
+    // The same shape as decompose_polygon_complexReflex
+    vec2f vertices[6] = {to_vec2f(-2.0f, 0.0f), to_vec2f(-2.0f, -2.0f), to_vec2f(3.0f, -1.0f), to_vec2f(2.0f, -1.0f), to_vec2f(-2.0f, 5.0f), to_vec2f(0.0f, 1.0f)};
+    polygon poly;
+    poly.vertexCount = 6;
+    poly.vertices = vertices;
+
+    char resultMsg[80];
+    if (!verifyMonotoneDecomposition(&poly, resultMsg))
+    {
+        FAIL_TEST(resultMsg);
+    }
+
+    PASS_TEST();
+}
+
+// vertexDiagonal** _triangulateMonotone_polygon(polygon* poly, vertexDiagonal** diagonalPool)
+IMPLEMENT_TEST(_triangulateMonotone_polygon_fewTowers)
+{
+    // The same shape as decompose_polygon_fewTowers
+    vec2f vertices[8] = {to_vec2f(0.0f, 0.0f), to_vec2f(4.0f, -4.0f), to_vec2f(7.0f, -1.0f), to_vec2f(10.0f, -4.0f),
+                         to_vec2f(14.0f, 0.0f), to_vec2f(10.0f, 4.0f), to_vec2f(7.0f, 1.0f), to_vec2f(4.0f, 4.0f)};
+    polygon poly;
+    poly.vertexCount = 8;
+    poly.vertices = vertices;
+
+    char resultMsg[80];
+    if (!verifyMonotoneDecomposition(&poly, resultMsg))
+    {
+        FAIL_TEST(resultMsg);
+    }
+
+    PASS_TEST();
+}
+
+// vertexDiagonal** _triangulateMonotone_polygon(polygon* poly, vertexDiagonal** diagonalPool)
+IMPLEMENT_TEST(_triangulateMonotone_polygon_towers)
+{
+    // The same shape as decompose_polygon_towers
+    vec2f vertices[16] = {to_vec2f(0.0f, 0.0f), to_vec2f(4.0f, -4.0f), to_vec2f(7.0f, -1.0f), to_vec2f(10.0f, -4.0f), to_vec2f(12.0f, -2.0f), to_vec2f(14.0f, -4.0f), to_vec2f(17.0f, -1.0f), to_vec2f(20.0f, -4.0f),
+                        to_vec2f(24.0f, 0.0f), to_vec2f(20.0f, 4.0f), to_vec2f(17.0f, 1.0f), to_vec2f(14.0f, 4.0f), to_vec2f(12.0f, 2.0f), to_vec2f(10.0f, 4.0f), to_vec2f(7.0f, 1.0f), to_vec2f(4.0f, 4.0f)};
+    polygon poly;
+    poly.vertexCount = 16;
+    poly.vertices = vertices;
+
+    char resultMsg[80];
+    if (!verifyMonotoneDecomposition(&poly, resultMsg))
+    {
+        FAIL_TEST(resultMsg);
+    }
+
+    PASS_TEST();
+}
+
 // bool _isEssential_vertexDiagonal(polygon* poly, vertexDiagonal* base)
 IMPLEMENT_TEST(_isEssential_vertexDiagonal)
 {
@@ -1253,6 +1471,171 @@ IMPLEMENT_TEST(decompose_polygon_towers)
     }
 }
 
+// bool decompose_polygon(polygon* in, polygon** out, int* outCount)
+IMPLEMENT_TEST(decompose_polygon_star)
+{
+    // A star with 40 points is large enough to be triangulated by _triangulateMonotone_polygon()
+    vec2f vertices[80];
+    polygon poly;
+    poly.vertexCount = 80;
+    poly.vertices = vertices;
+
+    for (int i = 0; i < poly.vertexCount; i++)
+    {
+        float angle = 2.0f * M_PI * i / poly.vertexCount;
+        float radius = i % 2 == 0 ? 4.0f : 2.0f;
+        vertices[i] = to_vec2f(radius * cosf(angle), radius * sinf(angle));
+    }
+
+    polygon* actual;
+    int actualCount;
+
+    if (!decompose_polygon(&poly, &actual, &actualCount))
+    {
+        FAIL_TEST("Memory allocation failure");
+    }
+
+    char resultMsg[80];
+    bool isConvex = verifyConvexPieces(actual, actualCount, getArea(&poly), resultMsg);
+    for (int i = 0; i < actualCount; i++)
+    {
+        free_polygon(&actual[i]);
+    }
+
+    free(actual);
+
+    // Every point needs its own polygon, and none of them can be merged with the center
+    if (actualCount < 40)
+    {
+        FAIL_TEST("The star was decomposed into too few polygons");
+    }
+
+    if (!isConvex)
+    {
+        FAIL_TEST(resultMsg);
+    }
+
+    PASS_TEST();
+}
+
+// bool decomposeMinimum_polygon(polygon* in, polygon** out, int* outCount)
+IMPLEMENT_TEST(decomposeMinimum_polygon_towers)
+{
+    // The same shape as decompose_polygon_towers, which decompose_polygon() splits into 8 polygons
+    vec2f vertices[16] = {to_vec2f(0.0f, 0.0f), to_vec2f(4.0f, -4.0f), to_vec2f(7.0f, -1.0f), to_vec2f(10.0f, -4.0f), to_vec2f(12.0f, -2.0f), to_vec2f(14.0f, -4.0f), to_vec2f(17.0f, -1.0f), to_vec2f(20.0f, -4.0f),
+                        to_vec2f(24.0f, 0.0f), to_vec2f(20.0f, 4.0f), to_vec2f(17.0f, 1.0f), to_vec2f(14.0f, 4.0f), to_vec2f(12.0f, 2.0f), to_vec2f(10.0f, 4.0f), to_vec2f(7.0f, 1.0f), to_vec2f(4.0f, 4.0f)};
+    polygon poly;
+    poly.vertexCount = 16;
+    poly.vertices = vertices;
+
+    polygon* actual;
+    int actualCount;
+
+    if (!decomposeMinimum_polygon(&poly, &actual, &actualCount))
+    {
+        FAIL_TEST("Memory allocation failure");
+    }
+
+    char resultMsg[80];
+    bool isConvex = verifyConvexPieces(actual, actualCount, getArea(&poly), resultMsg);
+    for (int i = 0; i < actualCount; i++)
+    {
+        free_polygon(&actual[i]);
+    }
+
+    free(actual);
+
+    if (actualCount >= 8)
+    {
+        FAIL_TEST("The towers were not decomposed into fewer polygons than decompose_polygon()");
+    }
+
+    if (!isConvex)
+    {
+        FAIL_TEST(resultMsg);
+    }
+
+    PASS_TEST();
+}
+
+// bool simplify_polygon(polygon* in, polygon* out, float tolerance)
+IMPLEMENT_TEST(simplify_polygon)
+{
+    /*
+        A square with a traced bottom side and a notch in its top side. Only vertex 8 is exactly collinear.
+
+            11-10     6--5
+            |   |     |  |
+            |   9--8--7  |
+            |            |
+            0--1--2--3---4
+    */
+    vec2f vertices[] = {to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 0.001f), to_vec2f(2.0f, -0.001f), to_vec2f(3.0f, 0.0f), to_vec2f(4.0f, 0.0f),
+                        to_vec2f(4.0f, 4.0f), to_vec2f(3.0f, 4.0f), to_vec2f(3.0f, 3.0f), to_vec2f(2.0f, 3.0f), to_vec2f(1.0f, 3.0f), to_vec2f(1.0f, 4.0f), to_vec2f(0.0f, 4.0f)};
+    polygon poly;
+    poly.vertexCount = sizeof(vertices) / sizeof(vec2f);
+    poly.vertices = vertices;
+
+    vec2f expectedVertices[] = {to_vec2f(0.0f, 0.0f), to_vec2f(4.0f, 0.0f), to_vec2f(4.0f, 4.0f), to_vec2f(3.0f, 4.0f),
+                                to_vec2f(3.0f, 3.0f), to_vec2f(1.0f, 3.0f), to_vec2f(1.0f, 4.0f), to_vec2f(0.0f, 4.0f)};
+    polygon expected;
+    expected.vertexCount = sizeof(expectedVertices) / sizeof(vec2f);
+    expected.vertices = expectedVertices;
+
+    char resultMsg[320];
+    polygon actual;
+
+    // -------------------------------------------------------------------------
+    // Test 1: The traced and collinear vertices are dropped, the notch is kept
+    // -------------------------------------------------------------------------
+    if (!simplify_polygon(&poly, &actual, 0.01f))
+    {
+        FAIL_TEST("Memory allocation failure");
+    }
+
+    bool result = verifyPolygon(&actual, &expected, resultMsg, 0);
+    free_polygon(&actual);
+
+    if (!result)
+    {
+        FAIL_TEST(resultMsg);
+    }
+
+    // -------------------------------------------------------------------------
+    // Test 2: A tolerance of 0 only drops collinear vertices
+    // -------------------------------------------------------------------------
+    if (!simplify_polygon(&poly, &actual, 0.0f))
+    {
+        FAIL_TEST("Memory allocation failure");
+    }
+
+    int zeroToleranceCount = actual.vertexCount;
+    free_polygon(&actual);
+
+    if (zeroToleranceCount != poly.vertexCount - 1)
+    {
+        FAIL_TEST("A tolerance of 0 did not drop exactly the collinear vertex");
+    }
+
+    // -------------------------------------------------------------------------
+    // Test 3: A tolerance larger than the polygon keeps it as it is
+    // -------------------------------------------------------------------------
+    if (!simplify_polygon(&poly, &actual, 100.0f))
+    {
+        FAIL_TEST("Memory allocation failure");
+    }
+
+    result = verifyPolygon(&actual, &poly, resultMsg, 0);
+    free_polygon(&actual);
+
+    if (!result)
+    {
+        FAIL_TEST(resultMsg);
+    }
+
+    PASS_TEST();
+}
+
 // bool project_polygon(polygon* poly, vec2f vecSlope, vec2f* projectionResult, float* projectionDistanceSqrd)
 IMPLEMENT_TEST(project_polygon)
 {
@@ -364,3 +364,47 @@ IMPLEMENT_TEST(applyTransform_polygon)
 
 	PASS_TEST();
 }
+
+// void getBounds_transform(transform* t, vec2f size, vec2f* outMin, vec2f* outMax)
+IMPLEMENT_TEST(getBounds_transform)
+{
+	vec2f min;
+	vec2f max;
+
+	///////////////////////////////////////////////////////////////////////////
+	// Scenario: Moved and scaled
+	///////////////////////////////////////////////////////////////////////////
+	transform t = {
+		to_vec2f(1.0f, -1.0f), // position
+		0.0f, // rotation
+		to_vec2f(2.0f, -1.0f), //scale
+	};
+
+	getBounds_transform(&t, to_vec2f(1.0f, 2.0f), &min, &max);
+
+	if (!equal_f(GET_X(min), 0.0f, DEFAULT_TOLERANCE) || !equal_f(GET_Y(min), -2.0f, DEFAULT_TOLERANCE) ||
+		!equal_f(GET_X(max), 2.0f, DEFAULT_TOLERANCE) || !equal_f(GET_Y(max), 0.0f, DEFAULT_TOLERANCE))
+	{
+		FAIL_TEST("Scenario 1: bounds not computed correctly");
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// Scenario: Rotated by 45 degrees
+	///////////////////////////////////////////////////////////////////////////
+	t = (transform) {
+		to_vec2f(0.0f, 0.0f), // position
+		M_PI / 4, // rotation
+		to_vec2f(1.0f, 1.0f), //scale
+	};
+
+	getBounds_transform(&t, to_vec2f(2.0f, 2.0f), &min, &max);
+
+	// The corners of the square end up on the axes
+	if (!equal_f(GET_X(min), -1.414f, DEFAULT_TOLERANCE) || !equal_f(GET_Y(min), -1.414f, DEFAULT_TOLERANCE) ||
+		!equal_f(GET_X(max), 1.414f, DEFAULT_TOLERANCE) || !equal_f(GET_Y(max), 1.414f, DEFAULT_TOLERANCE))
+	{
+		FAIL_TEST("Scenario 2: rotated bounds not computed correctly");
+	}
+
+	PASS_TEST();
+}
@@ -0,0 +1,91 @@
+#include "engine/unit/programCache.unit.h"
+
+#include "engine/programCache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// uint64_t hash_programCache(const char** sources, size_t count, const char* driver)
+IMPLEMENT_TEST(hash_programCache)
+{
+    const char* sources[2] = { "void main() {}", "out vec4 color;" };
+    const char* sameSources[2] = { "void main() {}", "out vec4 color;" };
+    const char* editedSources[2] = { "void main() { }", "out vec4 color;" };
+    const char* movedSources[2] = { "void main() {}out vec4 color;", "" };
+
+    uint64_t key = hash_programCache(sources, 2, "vendor|renderer|1.0");
+
+    if (hash_programCache(sameSources, 2, "vendor|renderer|1.0") != key)
+    {
+        FAIL_TEST("The same sources and driver have different keys");
+    }
+
+    if (hash_programCache(editedSources, 2, "vendor|renderer|1.0") == key)
+    {
+        FAIL_TEST("Editing a shader did not change the key");
+    }
+
+    if (hash_programCache(movedSources, 2, "vendor|renderer|1.0") == key)
+    {
+        FAIL_TEST("Moving source from one shader to another did not change the key");
+    }
+
+    if (hash_programCache(sources, 2, "vendor|renderer|1.1") == key)
+    {
+        FAIL_TEST("Updating the driver did not change the key");
+    }
+
+    PASS_TEST();
+}
+
+// bool store_programCache(uint64_t key, uint32_t format, const void* binary, size_t size)
+IMPLEMENT_TEST(store_programCache)
+{
+    const uint8_t binary[5] = { 1, 2, 3, 4, 5 };
+    uint32_t format;
+    size_t size;
+
+    // The cache is disabled until it has a directory
+    setDirectory_programCache(NULL);
+    bool isStoredWhileDisabled = store_programCache(1, 7, binary, sizeof(binary));
+
+    setDirectory_programCache("/tmp/store_programCache");
+    bool isStored = store_programCache(1, 7, binary, sizeof(binary));
+
+    void* loaded = load_programCache(1, &format, &size);
+    bool isEqual = loaded && format == 7 && size == sizeof(binary) && memcmp(loaded, binary, sizeof(binary)) == 0;
+    free(loaded);
+
+    void* missing = load_programCache(2, &format, &size);
+    free(missing);
+
+    bool isRemoved = remove_programCache(1);
+    void* removed = load_programCache(1, &format, &size);
+    free(removed);
+
+    setDirectory_programCache(NULL);
+    remove("/tmp/store_programCache");
+
+    if (isStoredWhileDisabled)
+    {
+        FAIL_TEST("A binary was stored while the cache was disabled");
+    }
+
+    if (!isStored || !isEqual)
+    {
+        FAIL_TEST("The binary was not loaded as it was stored");
+    }
+
+    if (missing)
+    {
+        FAIL_TEST("A binary was loaded for a key that was never stored");
+    }
+
+    if (!isRemoved || removed)
+    {
+        FAIL_TEST("The binary was loaded after it was removed");
+    }
+
+    PASS_TEST();
+}
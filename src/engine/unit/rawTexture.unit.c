@@ -0,0 +1,100 @@
+#include "engine/unit/rawTexture.unit.h"
+
+#include "engine/rawTexture.h"
+#include "engine/renderBackend.h"
+#include "engine/renderBackendNull.h"
+#include "engine/texture.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// bool buildMipmaps_rawTexture(uint8_t* chain, size_t width, size_t height, size_t firstMissing, size_t levelCount)
+IMPLEMENT_TEST(buildMipmaps_rawTexture)
+{
+    // A 4x2 texture has a 2x1 and a 1x1 level
+    if (getLevelCount_rawTexture(4, 2) != 3 || getSize_rawTexture(4, 2, 3) != (8 + 2 + 1) * 4)
+    {
+        FAIL_TEST("The mip chain of a 4x2 texture is not 4x2, 2x1 and 1x1");
+    }
+
+    uint8_t chain[(8 + 2 + 1) * 4] = {
+        0, 0, 0, 0,         100, 100, 100, 100,     200, 200, 200, 200,     40, 40, 40, 40,
+        0, 0, 0, 0,         100, 100, 100, 100,     200, 200, 200, 200,     40, 40, 40, 40,
+    };
+
+    if (!buildMipmaps_rawTexture(chain, 4, 2, 1, 3))
+    {
+        FAIL_TEST("Could not build the mip chain");
+    }
+
+    // Every texel is the rounded average of the 2x2 texels it covers
+    const uint8_t* second = &chain[8 * 4];
+    const uint8_t* third = &chain[(8 + 2) * 4];
+    if (second[0] != 50 || second[4] != 120 || third[0] != 85)
+    {
+        FAIL_TEST("The mip levels are not the averages of the levels before them");
+    }
+
+    if (buildMipmaps_rawTexture(chain, 4, 2, 0, 3))
+    {
+        FAIL_TEST("The first level was built, even though it has nothing to be built from");
+    }
+
+    PASS_TEST();
+}
+
+// uint8_t* read_rawTexture(const char* fileName, size_t* outWidth, size_t* outHeight, size_t* outLevelCount)
+IMPLEMENT_TEST(read_rawTexture)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    const char* fileName = "/tmp/read_rawTexture.rtex";
+
+    uint8_t texels[4 * 4 * 4];
+    for (size_t i = 0; i < sizeof(texels); i++)
+    {
+        texels[i] = i;
+    }
+
+    if (!write_rawTexture(fileName, texels, 4, 4))
+    {
+        FAIL_TEST("Could not write the raw texture");
+    }
+
+    size_t width, height, levelCount;
+    uint8_t* chain = read_rawTexture(fileName, &width, &height, &levelCount);
+    bool isEqual = chain && width == 4 && height == 4 && levelCount == 3 && memcmp(chain, texels, sizeof(texels)) == 0;
+    free(chain);
+
+    // The texture is picked by its extension, and every level of the page is filled in
+    nullRenderBackendStats before = getStats_nullRenderBackend();
+    textureRegion region = get_texture(fileName);
+    nullRenderBackendStats after = getStats_nullRenderBackend();
+
+    bool isPng = read_rawTexture("resources/media/test.png", &width, &height, &levelCount) != NULL;
+
+    remove(fileName);
+
+    if (!isEqual)
+    {
+        FAIL_TEST("The raw texture was not read as it was written");
+    }
+
+    if (region.textureId == 0)
+    {
+        FAIL_TEST("The raw texture could not be loaded by get_texture()");
+    }
+
+    if (after.mipUpdates <= before.mipUpdates)
+    {
+        FAIL_TEST("The mip levels of the raw texture were not uploaded");
+    }
+
+    if (isPng)
+    {
+        FAIL_TEST("A png was read as a raw texture");
+    }
+
+    PASS_TEST();
+}
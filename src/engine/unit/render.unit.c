@@ -0,0 +1,317 @@
+#include "engine/unit/render.unit.h"
+
+#include "datastructures/arena.h"
+#include "engine/math/transform.h"
+#include "engine/render.h"
+#include "engine/renderBackendNull.h"
+#include "engine/renderBackendSoftware.h"
+#include "engine/renderQueue.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// const renderBackend* get_renderBackend()
+IMPLEMENT_TEST(get_renderBackend)
+{
+    set_renderBackend(NULL);
+    if (get_renderBackend() != getNull_renderBackend())
+    {
+        FAIL_TEST("The null backend is not the default backend");
+    }
+
+    PASS_TEST();
+}
+
+// void renderAll_render(const renderQueue* q, arena* a)
+IMPLEMENT_TEST(renderAll_render)
+{
+    set_renderBackend(getNull_renderBackend());
+    size_t programs = getStats_nullRenderBackend().programs;
+
+    arena* a = create_arena(4096);
+    if (!a)
+    {
+        FAIL_TEST("Could not create an arena");
+    }
+
+    transform t = { to_vec2f(0.0f, 0.0f), 0.0f, to_vec2f(1.0f, 1.0f) };
+    textureRegion first = { 1, to_vec2f(0.0f, 0.0f), to_vec2f(0.5f, 0.5f) };
+    textureRegion second = { 2, to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 1.0f) };
+
+    // Three instanced renders on one texture, one on another, then two renders that can't be instanced
+    renderInfo infos[6] = {
+        { to_vec2f(1.0f, 1.0f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", first },
+        { to_vec2f(1.0f, 1.0f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", first },
+        { to_vec2f(1.0f, 1.0f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", first },
+        { to_vec2f(1.0f, 1.0f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", second },
+        { to_vec2f(1.0f, 1.0f), "resources/shaders/triangles.vert", "resources/shaders/triangles.frag", first },
+        { to_vec2f(1.0f, 1.0f), "resources/shaders/triangles.vert", "resources/shaders/triangles.frag", first },
+    };
+
+    render* renders[6];
+    renderQueue q;
+    if (!create_renderQueue(&q, 6, a))
+    {
+        free_arena(a);
+        FAIL_TEST("Could not create a render queue");
+    }
+
+    for (int i = 0; i < 6; i++)
+    {
+        renders[i] = create_render(&t, infos[i]);
+        if (!renders[i])
+        {
+            for (int j = 0; j < i; j++)
+            {
+                free_render(renders[j]);
+            }
+            free_arena(a);
+            FAIL_TEST("Could not create a render with the null backend");
+        }
+
+        push_renderQueue(&q, i, renders[i]);
+    }
+
+    if (getStats_nullRenderBackend().programs != programs + 2)
+    {
+        for (int i = 0; i < 6; i++)
+        {
+            free_render(renders[i]);
+        }
+        free_arena(a);
+        FAIL_TEST("Renders that use the same shaders don't share a program");
+    }
+
+    resetStats_nullRenderBackend();
+    renderAll_render(&q, a);
+    nullRenderBackendStats stats = getStats_nullRenderBackend();
+
+    for (int i = 0; i < 6; i++)
+    {
+        free_render(renders[i]);
+    }
+    free_arena(a);
+
+    if (stats.programSwitches != 2 || stats.textureBinds != 3)
+    {
+        FAIL_TEST("The program or texture was changed when it was already active");
+    }
+
+    // One draw per instanced batch, and one draw per render for everything else
+    if (stats.draws != 4 || stats.instances != 6)
+    {
+        FAIL_TEST("The renders were not drawn in batches");
+    }
+
+    if (getStats_nullRenderBackend().programs != programs)
+    {
+        FAIL_TEST("The programs were not deleted along with the renders");
+    }
+
+    PASS_TEST();
+}
+
+/*
+Draws a single frame of quads with the software backend
+
+Arguments
+    const renderBackend* backend: The software backend
+
+    render** renders: The renders to draw
+
+    size_t count: The size of renders
+
+    arena* a: Temporary memory for the frame
+*/
+void _drawFrame_render(const renderBackend* backend, render** renders, size_t count, arena* a)
+{
+    MATRIX_TYPE(3, 3) identity = {{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+    }};
+
+    renderQueue q;
+    create_renderQueue(&q, count, a);
+    for (size_t i = 0; i < count; i++)
+    {
+        push_renderQueue(&q, i, renders[i]);
+    }
+
+    backend->clear(0.0f, 0.0f, 1.0f, 1.0f);
+    setViewProjection_render(&identity);
+    renderAll_render(&q, a);
+    backend->present();
+}
+
+// const uint8_t* getFramebuffer_softwareRenderBackend(size_t* outWidth, size_t* outHeight)
+IMPLEMENT_TEST(getFramebuffer_softwareRenderBackend)
+{
+    const renderBackend* backend = getSoftware_renderBackend();
+    set_renderBackend(backend);
+
+    if (!init_softwareRenderBackend(8, 8, 1))
+    {
+        set_renderBackend(NULL);
+        FAIL_TEST("Could not create the software framebuffer");
+    }
+
+    arena* a = create_arena(4096);
+
+    // A white texture, drawn red over the middle half of the screen
+    const uint8_t white[2 * 2 * 4] = {
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+    };
+    uint32_t textureId = backend->createTexture(2, 2, 1);
+    backend->updateTexture(textureId, 0, 0, 0, 2, 2, white);
+
+    transform t = { to_vec2f(0.0f, 0.0f), 0.0f, to_vec2f(1.0f, 1.0f) };
+    textureRegion region = { textureId, to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 1.0f) };
+    renderInfo rI = { to_vec2f(1.0f, 1.0f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", region };
+
+    render* r = create_render(&t, rI);
+    if (!a || !r)
+    {
+        free_render(r);
+        free_arena(a);
+        free_softwareRenderBackend();
+        set_renderBackend(NULL);
+        FAIL_TEST("Could not create a render with the software backend");
+    }
+    setColor_render(r, to_vec3f(1.0f, 0.0f, 0.0f));
+
+    _drawFrame_render(backend, &r, 1, a);
+
+    size_t width, height;
+    const uint8_t* pixels = getFramebuffer_softwareRenderBackend(&width, &height);
+
+    const uint8_t* center = &pixels[(4 * width + 4) * 4];
+    const uint8_t* corner = &pixels[0];
+    bool isCenterRed = center[0] == 255 && center[1] == 0 && center[2] == 0 && center[3] == 255;
+    bool isCornerClear = corner[0] == 0 && corner[1] == 0 && corner[2] == 255 && corner[3] == 255;
+
+    free_render(r);
+    free_arena(a);
+    free_softwareRenderBackend();
+    set_renderBackend(NULL);
+
+    if (width != 8 || height != 8)
+    {
+        FAIL_TEST("The framebuffer is not the size it was created with");
+    }
+
+    if (!isCenterRed)
+    {
+        FAIL_TEST("The quad was not filled with its color multiplied by its texture");
+    }
+
+    if (!isCornerClear)
+    {
+        FAIL_TEST("The framebuffer was not cleared outside of the quad");
+    }
+
+    PASS_TEST();
+}
+
+// bool init_softwareRenderBackend(size_t width, size_t height, size_t threadCount)
+IMPLEMENT_TEST(init_softwareRenderBackend)
+{
+    const renderBackend* backend = getSoftware_renderBackend();
+    set_renderBackend(backend);
+
+    if (init_softwareRenderBackend(0, 8, 1))
+    {
+        set_renderBackend(NULL);
+        FAIL_TEST("Created an empty framebuffer");
+    }
+
+    const size_t width = 200;
+    const size_t height = 150;
+    const uint8_t checker[2 * 2 * 4] = {
+        255, 0, 0, 255, 0, 255, 0, 255,
+        0, 0, 255, 255, 255, 255, 255, 128,
+    };
+
+    arena* a = create_arena(4096);
+    transform transforms[4] = {
+        { to_vec2f(0.0f, 0.0f), 0.3f, to_vec2f(1.0f, 1.0f) },
+        { to_vec2f(-0.5f, 0.25f), -1.0f, to_vec2f(2.0f, 0.5f) },
+        { to_vec2f(0.7f, -0.6f), 2.0f, to_vec2f(1.0f, 1.0f) },
+        { to_vec2f(0.9f, 0.9f), 0.0f, to_vec2f(1.0f, 1.0f) },
+    };
+
+    // Every thread count must produce the exact same frame
+    uint8_t* frames[2] = { NULL, NULL };
+    const size_t threadCounts[2] = { 1, 4 };
+    for (int frame = 0; frame < 2; frame++)
+    {
+        init_softwareRenderBackend(width, height, threadCounts[frame]);
+
+        uint32_t textureId = backend->createTexture(2, 2, 1);
+        backend->updateTexture(textureId, 0, 0, 0, 2, 2, checker);
+        textureRegion region = { textureId, to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 1.0f) };
+        renderInfo rI = { to_vec2f(0.8f, 0.6f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", region };
+
+        render* renders[4] = { NULL };
+        for (int i = 0; i < 4; i++)
+        {
+            renders[i] = create_render(&transforms[i], rI);
+        }
+
+        if (a && renders[0] && renders[1] && renders[2] && renders[3])
+        {
+            _drawFrame_render(backend, renders, 4, a);
+
+            frames[frame] = malloc(width * height * 4);
+            if (frames[frame])
+            {
+                memcpy(frames[frame], getFramebuffer_softwareRenderBackend(NULL, NULL), width * height * 4);
+            }
+        }
+
+        for (int i = 0; i < 4; i++)
+        {
+            free_render(renders[i]);
+        }
+        free_softwareRenderBackend();
+        reset_arena(a);
+    }
+
+    set_renderBackend(NULL);
+    free_arena(a);
+
+    if (!frames[0] || !frames[1])
+    {
+        free(frames[0]);
+        free(frames[1]);
+        FAIL_TEST("Could not draw a frame with the software backend");
+    }
+
+    bool isSame = memcmp(frames[0], frames[1], width * height * 4) == 0;
+
+    // Something other than the clear color must have been drawn
+    bool hasDrawn = false;
+    for (size_t i = 0; i < width * height; i++)
+    {
+        if (frames[0][i * 4 + 2] != 255)
+        {
+            hasDrawn = true;
+        }
+    }
+
+    free(frames[0]);
+    free(frames[1]);
+
+    if (!hasDrawn)
+    {
+        FAIL_TEST("Nothing was drawn");
+    }
+
+    if (!isSame)
+    {
+        FAIL_TEST("The frame depends on the number of threads");
+    }
+
+    PASS_TEST();
+}
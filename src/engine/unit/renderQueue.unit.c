@@ -0,0 +1,99 @@
+#include "engine/unit/renderQueue.unit.h"
+
+#include "datastructures/arena.h"
+#include "engine/renderQueue.h"
+
+// bool push_renderQueue(renderQueue* q, uint64_t key, render* r)
+IMPLEMENT_TEST(push_renderQueue)
+{
+    arena* a = create_arena(1024);
+    if (!a)
+    {
+        FAIL_TEST("Could not create an arena");
+    }
+
+    renderQueue q;
+    if (!create_renderQueue(&q, 2, a))
+    {
+        free_arena(a);
+        FAIL_TEST("Could not create a render queue with the required arguments");
+    }
+
+    // The queue never dereferences renders, so any non NULL pointer will do
+    char renders[3];
+    if (!push_renderQueue(&q, 1, (render*) &renders[0]) || !push_renderQueue(&q, 2, (render*) &renders[1]))
+    {
+        free_arena(a);
+        FAIL_TEST("Could not push renders into the queue");
+    }
+
+    if (push_renderQueue(&q, 3, (render*) &renders[2]))
+    {
+        free_arena(a);
+        FAIL_TEST("Pushed a render into a full queue");
+    }
+
+    if (q.count != 2 || q.commands[1].key != 2 || q.commands[1].r != (render*) &renders[1])
+    {
+        free_arena(a);
+        FAIL_TEST("The renders were not pushed in order");
+    }
+
+    free_arena(a);
+
+    PASS_TEST();
+}
+
+// bool sort_renderQueue(renderQueue* q, arena* a)
+IMPLEMENT_TEST(sort_renderQueue)
+{
+    arena* a = create_arena(1024);
+    if (!a)
+    {
+        FAIL_TEST("Could not create an arena");
+    }
+
+    // Keys that differ in the most and least significant bytes, with a pair of equal keys
+    const uint64_t keys[6] = {
+        0xFF00000000000001ull,
+        0x0000000000000002ull,
+        0x0100000000000000ull,
+        0x0000000000000002ull,
+        0x0000000000000001ull,
+        0xFF00000000000000ull,
+    };
+    const int sortedOrder[6] = { 4, 1, 3, 2, 5, 0 };
+
+    renderQueue q;
+    if (!create_renderQueue(&q, 6, a))
+    {
+        free_arena(a);
+        FAIL_TEST("Could not create a render queue with the required arguments");
+    }
+
+    char renders[6];
+    for (int i = 0; i < 6; i++)
+    {
+        push_renderQueue(&q, keys[i], (render*) &renders[i]);
+    }
+
+    if (!sort_renderQueue(&q, a))
+    {
+        free_arena(a);
+        FAIL_TEST("Could not sort the render queue");
+    }
+
+    // Equal keys must keep the order they were pushed in
+    for (int i = 0; i < 6; i++)
+    {
+        if (q.commands[i].r != (render*) &renders[sortedOrder[i]] || q.commands[i].key != keys[sortedOrder[i]])
+        {
+            free_arena(a);
+            FAIL_TEST("The render queue is not sorted by key");
+        }
+    }
+
+    free_arena(a);
+
+    PASS_TEST();
+}
@@ -0,0 +1,244 @@
+#include "engine/unit/renderThread.unit.h"
+
+#include "datastructures/arena.h"
+#include "engine/math/transform.h"
+#include "engine/render.h"
+#include "engine/renderBackend.h"
+#include "engine/renderBackendNull.h"
+#include "engine/renderBackendSoftware.h"
+#include "engine/renderThread.h"
+#include "engine/staticBatch.h"
+
+#include <stdatomic.h>
+
+typedef struct _renderThreadCounts
+{
+    atomic_int starts;
+    atomic_int presents;
+    atomic_int stops;
+} renderThreadCounts;
+
+void _onStart_renderThreadTest(void* userdata)
+{
+    renderThreadCounts* counts = userdata;
+    atomic_fetch_add(&counts->starts, 1);
+}
+
+void _onPresent_renderThreadTest(void* userdata)
+{
+    renderThreadCounts* counts = userdata;
+    atomic_fetch_add(&counts->presents, 1);
+}
+
+void _onStop_renderThreadTest(void* userdata)
+{
+    renderThreadCounts* counts = userdata;
+    atomic_fetch_add(&counts->stops, 1);
+}
+
+// renderThread* create_renderThread(renderThreadEvents events, void* userdata)
+IMPLEMENT_TEST(create_renderThread)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    renderThreadCounts counts = { 0, 0, 0 };
+    renderThreadEvents events = { _onStart_renderThreadTest, _onPresent_renderThreadTest, _onStop_renderThreadTest };
+
+    renderThread* rt = create_renderThread(events, &counts);
+    if (!rt)
+    {
+        FAIL_TEST("Could not start a render thread");
+    }
+
+    if (get_renderBackend() == getNull_renderBackend())
+    {
+        free_renderThread(rt);
+        FAIL_TEST("Backend calls are not forwarded to the render thread");
+    }
+
+    renderThread* second = create_renderThread(events, &counts);
+    if (second)
+    {
+        free_renderThread(second);
+        free_renderThread(rt);
+        FAIL_TEST("A second render thread was started");
+    }
+
+    free_renderThread(rt);
+
+    if (get_renderBackend() != getNull_renderBackend())
+    {
+        FAIL_TEST("The backend was not restored when the render thread stopped");
+    }
+
+    if (counts.starts != 1 || counts.stops != 1 || counts.presents != 0)
+    {
+        FAIL_TEST("The render thread events were not called once each");
+    }
+
+    PASS_TEST();
+}
+
+// bool submit_renderThread(renderThread* rt)
+IMPLEMENT_TEST(submit_renderThread)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    renderThreadCounts counts = { 0, 0, 0 };
+    renderThreadEvents events = { NULL, _onPresent_renderThreadTest, NULL };
+
+    renderThread* rt = create_renderThread(events, &counts);
+    if (!rt)
+    {
+        FAIL_TEST("Could not start a render thread");
+    }
+
+    // Renders are created through the forwarding backend
+    transform t = { to_vec2f(0.0f, 0.0f), 0.0f, to_vec2f(1.0f, 1.0f) };
+    textureRegion region = { 1, to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 1.0f) };
+    renderInfo rI = { to_vec2f(1.0f, 1.0f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", region };
+
+    render* renders[3];
+    for (int i = 0; i < 3; i++)
+    {
+        renders[i] = create_render(&t, rI);
+        if (!renders[i])
+        {
+            for (int j = 0; j < i; j++)
+            {
+                free_render(renders[j]);
+            }
+            free_renderThread(rt);
+            FAIL_TEST("Could not create a render through the render thread");
+        }
+    }
+
+    MATRIX_TYPE(3, 3) identity = {{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+    }};
+
+    resetStats_nullRenderBackend();
+
+    // Three frames of one, two and three renders
+    bool isSubmitted = true;
+    for (int frameIndex = 0; frameIndex < 3; frameIndex++)
+    {
+        renderFrame* frame = beginFrame_renderThread(rt);
+        setViewProjection_renderFrame(frame, &identity);
+        for (int i = 0; i <= frameIndex; i++)
+        {
+            push_renderFrame(frame, renders[i]);
+        }
+
+        isSubmitted = submit_renderThread(rt) && isSubmitted;
+    }
+
+    // The renders may be freed while their frames are still being drawn
+    for (int i = 0; i < 3; i++)
+    {
+        free_render(renders[i]);
+    }
+
+    free_renderThread(rt);
+    nullRenderBackendStats stats = getStats_nullRenderBackend();
+
+    if (!isSubmitted)
+    {
+        FAIL_TEST("A recorded frame could not be submitted");
+    }
+
+    if (stats.frames != 3 || counts.presents != 3)
+    {
+        FAIL_TEST("Not every submitted frame was drawn before the render thread stopped");
+    }
+
+    // Every frame shares one program and texture, so each is a single batch
+    if (stats.draws != 3 || stats.instances != 6)
+    {
+        FAIL_TEST("The frames were not drawn in batches");
+    }
+
+    PASS_TEST();
+}
+
+// bool pushBatch_renderFrame(renderFrame* f, renderBatchCommand batch)
+IMPLEMENT_TEST(pushBatch_renderFrame)
+{
+    set_renderBackend(getSoftware_renderBackend());
+    if (!init_softwareRenderBackend(8, 8, 1))
+    {
+        set_renderBackend(NULL);
+        FAIL_TEST("Could not create the software framebuffer");
+    }
+
+    renderThreadEvents events = { NULL, NULL, NULL };
+    renderThread* rt = create_renderThread(events, NULL);
+    arena* a = create_arena(4096);
+    staticBatches* sb = create_staticBatches();
+    if (!rt || !a || !sb)
+    {
+        free_staticBatches(sb);
+        free_arena(a);
+        free_renderThread(rt);
+        free_softwareRenderBackend();
+        set_renderBackend(NULL);
+        FAIL_TEST("Could not start a render thread");
+    }
+
+    const uint8_t white[2 * 2 * 4] = {
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+    };
+    uint32_t textureId = get_renderBackend()->createTexture(2, 2, 1);
+    get_renderBackend()->updateTexture(textureId, 0, 0, 0, 2, 2, white);
+
+    // A green render, and a red static batch over the same pixels
+    transform t = { to_vec2f(0.0f, 0.0f), 0.0f, to_vec2f(1.0f, 1.0f) };
+    textureRegion region = { textureId, to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 1.0f) };
+    renderInfo renderI = { to_vec2f(4.0f, 4.0f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", region };
+    renderInfo batchI = { to_vec2f(4.0f, 4.0f), STATIC_VERTEX_SHADER, STATIC_FRAGMENT_SHADER, region };
+
+    render* r = create_render(&t, renderI);
+    render* batched = create_render(&t, batchI);
+    setColor_render(r, to_vec3f(0.0f, 1.0f, 0.0f));
+    setColor_render(batched, to_vec3f(1.0f, 0.0f, 0.0f));
+    bool isBuilt = add_staticBatches(sb, batched) && build_staticBatches(sb, a);
+
+    MATRIX_TYPE(3, 3) identity = {{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+    }};
+
+    // The batch is recorded after the render, so it must be drawn on top of it
+    renderFrame* frame = beginFrame_renderThread(rt);
+    setViewProjection_renderFrame(frame, &identity);
+    bool isRecorded = push_renderFrame(frame, r) && record_staticBatches(sb, frame);
+    submit_renderThread(rt);
+
+    free_render(r);
+    free_render(batched);
+    free_staticBatches(sb);
+    free_arena(a);
+    free_renderThread(rt);
+
+    const uint8_t* center = &getFramebuffer_softwareRenderBackend(NULL, NULL)[(4 * 8 + 4) * 4];
+    bool isBatchOnTop = center[0] == 255 && center[1] == 0;
+
+    free_softwareRenderBackend();
+    set_renderBackend(NULL);
+
+    if (!isBuilt || !isRecorded)
+    {
+        FAIL_TEST("Could not record the render and the static batch");
+    }
+
+    if (!isBatchOnTop)
+    {
+        FAIL_TEST("A static batch was not drawn in the order it was recorded");
+    }
+
+    PASS_TEST();
+}
@@ -0,0 +1,184 @@
+#include "engine/unit/staticBatch.unit.h"
+
+#include "datastructures/arena.h"
+#include "engine/math/transform.h"
+#include "engine/render.h"
+#include "engine/renderBackend.h"
+#include "engine/renderBackendNull.h"
+#include "engine/renderBackendSoftware.h"
+#include "engine/staticBatch.h"
+
+// bool build_staticBatches(staticBatches* sb, arena* a)
+IMPLEMENT_TEST(build_staticBatches)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    arena* a = create_arena(4096);
+    staticBatches* sb = create_staticBatches();
+    if (!a || !sb)
+    {
+        free_staticBatches(sb);
+        free_arena(a);
+        FAIL_TEST("Could not create the static batches");
+    }
+
+    transform t = { to_vec2f(0.0f, 0.0f), 0.0f, to_vec2f(1.0f, 1.0f) };
+    textureRegion first = { 1, to_vec2f(0.0f, 0.0f), to_vec2f(0.5f, 0.5f) };
+    textureRegion second = { 2, to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 1.0f) };
+
+    // Two renders on one texture, one on another, and one on the first texture with another program
+    renderInfo infos[4] = {
+        { to_vec2f(1.0f, 1.0f), STATIC_VERTEX_SHADER, STATIC_FRAGMENT_SHADER, first },
+        { to_vec2f(1.0f, 1.0f), STATIC_VERTEX_SHADER, STATIC_FRAGMENT_SHADER, second },
+        { to_vec2f(1.0f, 1.0f), STATIC_VERTEX_SHADER, "resources/shaders/triangles.frag", first },
+        { to_vec2f(1.0f, 1.0f), STATIC_VERTEX_SHADER, STATIC_FRAGMENT_SHADER, first },
+    };
+
+    render* renders[4];
+    for (int i = 0; i < 4; i++)
+    {
+        renders[i] = create_render(&t, infos[i]);
+        add_staticBatches(sb, renders[i]);
+    }
+
+    // A render whose program reads its own transform can't be drawn from a batch
+    renderInfo instancedInfo = { to_vec2f(1.0f, 1.0f), "resources/shaders/instanced.vert", "resources/shaders/instanced.frag", first };
+    render* instanced = create_render(&t, instancedInfo);
+    bool isInstancedAdded = add_staticBatches(sb, instanced);
+    free_render(instanced);
+
+    size_t batches = getStats_nullRenderBackend().batches;
+
+    bool isBuilt = build_staticBatches(sb, a);
+    size_t builtCount = getCount_staticBatches(sb);
+    size_t builtBatches = getStats_nullRenderBackend().batches - batches;
+
+    // Nothing changed, so nothing is rebuilt
+    bool isRebuilt = build_staticBatches(sb, a) && getStats_nullRenderBackend().batches - batches != builtBatches;
+
+    remove_staticBatches(sb, renders[1]);
+    build_staticBatches(sb, a);
+    size_t removedCount = getCount_staticBatches(sb);
+
+    for (int i = 0; i < 4; i++)
+    {
+        free_render(renders[i]);
+    }
+    free_staticBatches(sb);
+    free_arena(a);
+
+    if (!isBuilt || builtCount != 3 || builtBatches != 3)
+    {
+        FAIL_TEST("The renders were not built into one batch per program and texture");
+    }
+
+    if (isInstancedAdded)
+    {
+        FAIL_TEST("A render that can't be batched was added");
+    }
+
+    if (isRebuilt)
+    {
+        FAIL_TEST("The batches were rebuilt when no render was added or removed");
+    }
+
+    if (removedCount != 2)
+    {
+        FAIL_TEST("The batches were not rebuilt after a render was removed");
+    }
+
+    if (getStats_nullRenderBackend().batches != batches)
+    {
+        FAIL_TEST("The batches were not deleted along with the static batches");
+    }
+
+    PASS_TEST();
+}
+
+// void renderAll_staticBatches(staticBatches* sb)
+IMPLEMENT_TEST(renderAll_staticBatches)
+{
+    const renderBackend* backend = getSoftware_renderBackend();
+    set_renderBackend(backend);
+
+    if (!init_softwareRenderBackend(8, 8, 1))
+    {
+        set_renderBackend(NULL);
+        FAIL_TEST("Could not create the software framebuffer");
+    }
+
+    arena* a = create_arena(4096);
+    staticBatches* sb = create_staticBatches();
+
+    const uint8_t white[2 * 2 * 4] = {
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+    };
+    uint32_t textureId = backend->createTexture(2, 2, 1);
+    backend->updateTexture(textureId, 0, 0, 0, 2, 2, white);
+
+    // Two red quads, rotated and moved, that together cover the middle of the screen
+    transform transforms[2] = {
+        { to_vec2f(-0.25f, 0.0f), 1.57079633f, to_vec2f(1.0f, 1.0f) },
+        { to_vec2f(0.25f, 0.0f), 0.0f, to_vec2f(0.5f, 1.0f) },
+    };
+    textureRegion region = { textureId, to_vec2f(0.0f, 0.0f), to_vec2f(1.0f, 1.0f) };
+    renderInfo rI = { to_vec2f(1.0f, 0.5f), STATIC_VERTEX_SHADER, STATIC_FRAGMENT_SHADER, region };
+
+    render* renders[2];
+    for (int i = 0; i < 2; i++)
+    {
+        renders[i] = create_render(&transforms[i], rI);
+        setColor_render(renders[i], to_vec3f(1.0f, 0.0f, 0.0f));
+        add_staticBatches(sb, renders[i]);
+    }
+
+    MATRIX_TYPE(3, 3) identity = {{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+    }};
+
+    bool isBuilt = a && sb && renders[0] && renders[1] && build_staticBatches(sb, a);
+    if (isBuilt)
+    {
+        backend->clear(0.0f, 0.0f, 1.0f, 1.0f);
+        setViewProjection_render(&identity);
+        renderAll_staticBatches(sb);
+        backend->present();
+    }
+
+    size_t width, height;
+    const uint8_t* pixels = getFramebuffer_softwareRenderBackend(&width, &height);
+
+    // Pixel centers a quarter of the way in from each side, and the corner
+    bool isLeftRed = pixels[(4 * width + 2) * 4] == 255 && pixels[(4 * width + 2) * 4 + 2] == 0;
+    bool isRightRed = pixels[(4 * width + 5) * 4] == 255 && pixels[(4 * width + 5) * 4 + 2] == 0;
+    bool isCornerClear = pixels[0] == 0 && pixels[2] == 255;
+
+    for (int i = 0; i < 2; i++)
+    {
+        free_render(renders[i]);
+    }
+    free_staticBatches(sb);
+    free_arena(a);
+    free_softwareRenderBackend();
+    set_renderBackend(NULL);
+
+    if (!isBuilt)
+    {
+        FAIL_TEST("Could not build the static batches with the software backend");
+    }
+
+    if (!isLeftRed || !isRightRed)
+    {
+        FAIL_TEST("The pre-transformed quads were not drawn where their renders are");
+    }
+
+    if (!isCornerClear)
+    {
+        FAIL_TEST("A static batch was drawn outside of its quads");
+    }
+
+    PASS_TEST();
+}
@@ -0,0 +1,260 @@
+#include "engine/unit/texture.unit.h"
+
+#include "engine/renderBackend.h"
+#include "engine/renderBackendNull.h"
+#include "engine/texture.h"
+
+#include <png.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// How long the tests wait for the decode workers, in milliseconds
+#define DECODE_TIMEOUT 5000
+
+/*
+Writes an opaque white png that is wider than an atlas page and over half as tall, so it is packed into a page of its own
+
+Arguments
+    const char* fileName: The file to write
+
+Returns
+    Returns false if the file could not be written
+*/
+bool _writeWide_textureTest(const char* fileName)
+{
+    const size_t width = 2100;
+    const size_t height = 1100;
+
+    uint8_t* texels = malloc(width * height * 4);
+    if (!texels)
+    {
+        return false;
+    }
+    memset(texels, 255, width * height * 4);
+
+    png_image image;
+    memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+    image.width = width;
+    image.height = height;
+    image.format = PNG_FORMAT_RGBA;
+
+    bool isWritten = png_image_write_to_file(&image, fileName, 0, texels, 0, NULL) != 0;
+    free(texels);
+
+    return isWritten;
+}
+
+// const textureRegion* request_texture(const char* fileName)
+IMPLEMENT_TEST(request_texture)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    const textureRegion* region = request_texture("resources/media/test.png");
+    if (!region)
+    {
+        FAIL_TEST("Could not request a texture");
+    }
+
+    if (region->textureId == 0)
+    {
+        FAIL_TEST("The placeholder is not shown while the texture loads");
+    }
+    textureRegion placeholder = *region;
+
+    if (request_texture("resources/media/test.png") != region)
+    {
+        FAIL_TEST("Requesting a texture twice gave different regions");
+    }
+
+    for (int waited = 0; getPendingCount_texture() > 0 && waited < DECODE_TIMEOUT; waited++)
+    {
+        uploadRequested_texture(1);
+        usleep(1000);
+    }
+
+    if (getPendingCount_texture() != 0)
+    {
+        FAIL_TEST("The texture was never uploaded");
+    }
+
+    if (region->textureId == 0 || equal_vec2f(region->uvMax, placeholder.uvMax, 0.0001f))
+    {
+        FAIL_TEST("The region still shows the placeholder after the texture was uploaded");
+    }
+
+    textureRegion loaded = get_texture("resources/media/test.png");
+    if (loaded.textureId != region->textureId || !equal_vec2f(loaded.uvMin, region->uvMin, 0.0001f))
+    {
+        FAIL_TEST("get_texture() loaded the requested texture again");
+    }
+
+    PASS_TEST();
+}
+
+// textureRegion getByAsset_texture(assetHandle asset)
+IMPLEMENT_TEST(getByAsset_texture)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    assetHandle asset = intern_asset("resources/media/test.png");
+    textureRegion region = getByAsset_texture(asset);
+    if (region.textureId == 0)
+    {
+        FAIL_TEST("Could not get a texture by its handle");
+    }
+
+    textureRegion byName = get_texture("resources/media/test.png");
+    if (byName.textureId != region.textureId || !equal_vec2f(byName.uvMin, region.uvMin, 0.0001f))
+    {
+        FAIL_TEST("The texture was loaded again when it was gotten by name");
+    }
+
+    if (requestByAsset_texture(asset) != request_texture("resources/media/test.png"))
+    {
+        FAIL_TEST("Requesting a texture by handle and by name gave different regions");
+    }
+
+    if (getByAsset_texture(INVALID_ASSET).textureId != 0 || requestByAsset_texture(INVALID_ASSET))
+    {
+        FAIL_TEST("An invalid handle was loaded");
+    }
+
+    PASS_TEST();
+}
+
+// size_t uploadRequested_texture(size_t maxUploads)
+IMPLEMENT_TEST(uploadRequested_texture)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    const char* fileNames[3] = {
+        "resources/media/missing0.png",
+        "resources/media/missing1.png",
+        "resources/media/missing2.png",
+    };
+
+    const textureRegion* regions[3];
+    for (int i = 0; i < 3; i++)
+    {
+        regions[i] = request_texture(fileNames[i]);
+    }
+
+    if (!regions[0] || !regions[1] || !regions[2] || getPendingCount_texture() != 3)
+    {
+        FAIL_TEST("Could not request the textures");
+    }
+
+    textureRegion placeholder = *regions[0];
+
+    size_t uploaded = 0;
+    for (int waited = 0; uploaded < 3 && waited < DECODE_TIMEOUT; waited++)
+    {
+        size_t count = uploadRequested_texture(1);
+        if (count > 1)
+        {
+            FAIL_TEST("More textures were uploaded than the budget allows");
+        }
+
+        uploaded += count;
+        usleep(1000);
+    }
+
+    if (uploaded != 3 || getPendingCount_texture() != 0)
+    {
+        FAIL_TEST("Textures that failed to load are still pending");
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (regions[i]->textureId != placeholder.textureId || !equal_vec2f(regions[i]->uvMax, placeholder.uvMax, 0.0001f))
+        {
+            FAIL_TEST("A texture that failed to load doesn't keep the placeholder");
+        }
+    }
+
+    PASS_TEST();
+}
+
+// void setBudget_texture(size_t gpuBytes, size_t cpuBytes)
+IMPLEMENT_TEST(setBudget_texture)
+{
+    set_renderBackend(getNull_renderBackend());
+
+    const char* fileNames[3] = {
+        "/tmp/setBudget_texture0.png",
+        "/tmp/setBudget_texture1.png",
+        "/tmp/setBudget_texture2.png",
+    };
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (!_writeWide_textureTest(fileNames[i]))
+        {
+            FAIL_TEST("Could not write the test textures");
+        }
+    }
+
+    // Pages left unused by earlier tests are evicted while loading the first, so they can't make room later
+    for (int frame = 0; frame < 4; frame++)
+    {
+        nextFrame_texture();
+    }
+    setBudget_texture(1, 0);
+    textureRegion first = get_texture(fileNames[0]);
+    textureStats before = getStats_texture();
+
+    // No room for another page
+    setBudget_texture(getStats_texture().gpuBytes, 0);
+
+    // The first page is still used, so it can't make room for the second
+    for (int frame = 0; frame < 4; frame++)
+    {
+        nextFrame_texture();
+        use_texture(first.textureId);
+    }
+    textureRegion second = get_texture(fileNames[1]);
+    textureStats whileUsed = getStats_texture();
+
+    // Once the first page is unused, it is evicted to make room for the third
+    for (int frame = 0; frame < 4; frame++)
+    {
+        nextFrame_texture();
+        use_texture(second.textureId);
+    }
+    get_texture(fileNames[2]);
+    textureStats afterUnused = getStats_texture();
+
+    textureRegion reloaded = get_texture(fileNames[0]);
+    textureStats afterReload = getStats_texture();
+
+    setBudget_texture(0, 0);
+    for (int i = 0; i < 3; i++)
+    {
+        remove(fileNames[i]);
+    }
+
+    if (first.textureId == 0 || second.textureId == 0 || reloaded.textureId == 0)
+    {
+        FAIL_TEST("Could not load the test textures");
+    }
+
+    if (whileUsed.evictions != before.evictions)
+    {
+        FAIL_TEST("A page that is still used was evicted");
+    }
+
+    if (afterUnused.evictions != before.evictions + 1 || afterUnused.evicted != before.evicted + 1)
+    {
+        FAIL_TEST("The least recently used page was not evicted to stay within the budget");
+    }
+
+    if (afterReload.reloads != before.reloads + 1 || afterReload.evicted != before.evicted)
+    {
+        FAIL_TEST("An evicted texture was not reloaded by get_texture()");
+    }
+
+    PASS_TEST();
+}
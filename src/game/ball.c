@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "engine/collision.h"
+#include "engine/gameEnvironment.h"
 #include "engine/gameObject.h"
 #include "engine/render.h"
 #include "engine/texture.h"
@@ -24,12 +25,12 @@ vec2f ballDirection;
 float ballMagnitude;
 const float ballAcceleration = 0.001f;
 
-gameObject* create_ball()
+gameObject* create_ball(gameEnvironment* env)
 {
 	ballDirection = normalize_vec2f(to_vec2f(1.0f, -1.0f));
 	ballMagnitude = 0.0075f;
 
-	gameObject* ball = create_gameObject(GameObject_Ball);
+	gameObject* ball = createGameObject_gameEnvironment(env, GameObject_Ball);
 	transform t = getTransform_gameObject(ball);
 	t.position = to_vec2f(0.0f, 0.0f);
 	setTransform_gameObject(ball, t);
@@ -37,10 +38,11 @@ gameObject* create_ball()
     renderInfo rI = {
         to_vec2f(0.02f, 0.02f), // size
 
-        "resources/shaders/triangles.vert",
-        "resources/shaders/triangles.frag",
+        "resources/shaders/instanced.vert",
+        "resources/shaders/instanced.frag",
 
-        get_texture("resources/media/test.png"),
+        { 0 }, // texture, which is loaded in the background instead
+        request_texture("resources/media/test.png"),
     };
 
     setRender_gameObject(ball, rI);
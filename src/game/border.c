@@ -2,6 +2,7 @@
 
 #include <stdlib.h>
 
+#include "engine/gameEnvironment.h"
 #include "engine/gameObject.h"
 #include "engine/texture.h"
 
@@ -27,7 +28,7 @@ polygon horizontalBorder = {
 vec2f verticalBorderSize;
 vec2f horizontalBorderSize;
 
-border create_border()
+border create_border(gameEnvironment* env)
 {
 	verticalBorderSize = add_vec2f(verticalBorderVertices[2], verticalBorderVertices[0]);
 	horizontalBorderSize = add_vec2f(horizontalBorderVertices[2], horizontalBorderVertices[0]);
@@ -36,7 +37,8 @@ border create_border()
 	transform t;
 
 	// Left border
-	b.left = create_gameObject(GameObject_Border);
+	b.left = createGameObject_gameEnvironment(env, GameObject_Border);
+	setStatic_gameObject(b.left, true);
 	t = getTransform_gameObject(b.left);
 	t.position = to_vec2f(-0.1f - aspect, 0.0f);
 	setTransform_gameObject(b.left, t);
@@ -44,7 +46,8 @@ border create_border()
     setUserdata_gameObject(b.left, &verticalBorderSize);
 
 	// Right border
-	b.right = create_gameObject(GameObject_Border);
+	b.right = createGameObject_gameEnvironment(env, GameObject_Border);
+	setStatic_gameObject(b.right, true);
 	t = getTransform_gameObject(b.right);
 	t.position = to_vec2f(0.1f + aspect, 0.0f);
 	setTransform_gameObject(b.right, t);
@@ -52,7 +55,8 @@ border create_border()
     setUserdata_gameObject(b.left, &verticalBorderSize);
 
 	// Top border
-	b.top = create_gameObject(GameObject_Border);
+	b.top = createGameObject_gameEnvironment(env, GameObject_Border);
+	setStatic_gameObject(b.top, true);
 	t = getTransform_gameObject(b.top);
 	t.position = to_vec2f(0.0f, 1.1f);
 	setTransform_gameObject(b.top, t);
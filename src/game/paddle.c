@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "engine/collision.h"
+#include "engine/gameEnvironment.h"
 #include "engine/gameObject.h"
 #include "engine/render.h"
 #include "engine/texture.h"
@@ -20,9 +21,9 @@ static polygon colliderTemplate = {
 	sizeof(colliderTemplateVertices) / sizeof(vec2f), // vertexCount
 };
 
-gameObject* create_paddle()
+gameObject* create_paddle(gameEnvironment* env)
 {
-	gameObject* paddle = create_gameObject(GameObject_Paddle);
+	gameObject* paddle = createGameObject_gameEnvironment(env, GameObject_Paddle);
 	transform t = getTransform_gameObject(paddle);
 	GET_Y(t.position) = -0.85f;
 	setTransform_gameObject(paddle, t);
@@ -30,10 +31,11 @@ gameObject* create_paddle()
     renderInfo rI = {
         to_vec2f(0.2f, 0.1f), // size
 
-        "resources/shaders/triangles.vert",
-        "resources/shaders/triangles.frag",
+        "resources/shaders/instanced.vert",
+        "resources/shaders/instanced.frag",
 
-        get_texture("resources/media/test.png"),
+        { 0 }, // texture, which is loaded in the background instead
+        request_texture("resources/media/test.png"),
     };
 
     setRender_gameObject(paddle, rI);
@@ -4,9 +4,13 @@
 
 #include "SDL2/SDL.h"
 
+#include "engine/archive.h"
 #include "engine/collision.h"
+#include "engine/decompositionCache.h"
 #include "engine/gameEnvironment.h"
 #include "engine/gameObject.h"
+#include "engine/programCache.h"
+#include "engine/renderBackendGL.h"
 
 #include "game/gameObjectTypes.h"
 
@@ -16,16 +20,19 @@
 
 SDL_Window *win;
 
-void onUpdate(gameEnvironment* env, gameObject* g)
+void onUpdate_paddles(gameEnvironment* env, gameObject** paddles, size_t first, size_t count)
 {
-    switch (getType_gameObject(g))
+    for (size_t i = 0; i < count; i++)
     {
-        case GameObject_Paddle:
-            update_paddle(g);
-            break;
-        case GameObject_Ball:
-            update_ball(g);
-            break;
+        update_paddle(paddles[i]);
+    }
+}
+
+void onUpdate_balls(gameEnvironment* env, gameObject** balls, size_t first, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        update_ball(balls[i]);
     }
 }
 
@@ -53,6 +60,11 @@ void onRenderEnd(gameEnvironment* env)
     SDL_GL_SwapWindow(win);
 }
 
+void onRemoveGameObject(gameEnvironment* env, gameObject* g)
+{
+    free_gameObject(g);
+}
+
 int main(int argc, char* argv[])
 {
     if(SDL_Init(SDL_INIT_EVERYTHING) < 0)
@@ -61,7 +73,7 @@ int main(int argc, char* argv[])
     }
 
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 2);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
     win = SDL_CreateWindow("Basic Pong Game", 100, 100, 1024, 768, SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN);
     if (win == NULL)
@@ -79,20 +91,36 @@ int main(int argc, char* argv[])
         return -1;
     }
 
-    gameEvents ge = { onUpdate, onCollision, onRenderStart, onRenderEnd };
+    // The context is current, so everything can be drawn with OpenGL
+    set_renderBackend(getGL_renderBackend());
+
+    // Programs are compiled once per machine and driver, after that their linked binaries are loaded
+    setDirectory_programCache("bin/shaderCache");
+
+    // Load resources from the packed archive when there is one (see make packResources), otherwise from their files
+    archive* resources = open_archive("bin/resources.pack");
+    mount_archive(resources);
+
+    // Collider shapes decomposed ahead of time (see make decomposeShapes) are copied instead of decomposed
+    load_decompositionCache("bin/colliders.cache");
+
+    // Every gameObject type that needs updating has its own update handler, so onUpdate isn't needed
+    gameEvents ge = { NULL, onCollision, onRenderStart, onRenderEnd, onRemoveGameObject };
     gameSettings gs = { 768.0f / 1024.0f };
 
     gameEnvironment* env = create_gameEnvironment(ge, gs);
+    setUpdateHandler_gameEnvironment(env, GameObject_Paddle, onUpdate_paddles);
+    setUpdateHandler_gameEnvironment(env, GameObject_Ball, onUpdate_balls);
 
-    gameObject* paddle = create_paddle();
+    gameObject* paddle = create_paddle(env);
     addGameObject_gameEnvironment(env, paddle);
 
-    border b = create_border();
+    border b = create_border(env);
     addGameObject_gameEnvironment(env, b.left);
     addGameObject_gameEnvironment(env, b.right);
     addGameObject_gameEnvironment(env, b.top);
 
-    gameObject* ball = create_ball();
+    gameObject* ball = create_ball(env);
     addGameObject_gameEnvironment(env, ball);
 
     bool isRunning = true;
@@ -115,12 +143,10 @@ int main(int argc, char* argv[])
         run_gameEnvironment(env);
     }
 
-    free_gameObject(ball);
-    free_gameObject(b.left);
-    free_gameObject(b.right);
-    free_gameObject(b.top);
-    free_gameObject(paddle);
+    // Every gameObject was created by the gameEnvironment, so they are freed along with it
     free_gameEnvironment(env);
+    close_archive(resources);
+    setDirectory_programCache(NULL);
 
     SDL_GL_DeleteContext(glcontext);
     SDL_Quit();
@@ -1,6 +1,23 @@
 #include "engine/unit/math.unit.h"
+#include "engine/unit/archive.unit.h"
+#include "engine/unit/asset.unit.h"
+#include "engine/unit/atlas.unit.h"
+#include "engine/unit/camera.unit.h"
 #include "engine/unit/collision.unit.h"
+#include "engine/unit/components.unit.h"
+#include "engine/unit/decompositionCache.unit.h"
+#include "engine/unit/gameEnvironment.unit.h"
+#include "engine/unit/programCache.unit.h"
+#include "engine/unit/rawTexture.unit.h"
+#include "engine/unit/render.unit.h"
+#include "engine/unit/renderQueue.unit.h"
+#include "engine/unit/renderThread.unit.h"
+#include "engine/unit/staticBatch.unit.h"
+#include "engine/unit/texture.unit.h"
+#include "datastructures/unit/arena.unit.h"
 #include "datastructures/unit/hashtable.unit.h"
+#include "datastructures/unit/pool.unit.h"
+#include "datastructures/unit/slotmap.unit.h"
 
 FILE* UNIT_TEST_OUT;
 FILE* UNIT_TEST_ERR;
@@ -33,6 +50,9 @@ void run_engine_math_tests()
     RUN_TEST(decompose_polygon_complexReflex);
     RUN_TEST(decompose_polygon_fewTowers);
     RUN_TEST(decompose_polygon_towers);
+    RUN_TEST(decompose_polygon_star);
+    RUN_TEST(decomposeMinimum_polygon_towers);
+    RUN_TEST(simplify_polygon);
     RUN_TEST(project_polygon);
     RUN_TEST(_isDiagonal_polygon);
     RUN_TEST(_create_referenceVertices);
@@ -41,6 +61,11 @@ void run_engine_math_tests()
     RUN_TEST(_triangulate_polygon_quadReflex);
     RUN_TEST(_triangulate_polygon_pentagon);
     RUN_TEST(_triangulate_polygon_complexReflex);
+    RUN_TEST(_triangulateMonotone_polygon_quad);
+    RUN_TEST(_triangulateMonotone_polygon_quadReflex);
+    RUN_TEST(_triangulateMonotone_polygon_complexReflex);
+    RUN_TEST(_triangulateMonotone_polygon_fewTowers);
+    RUN_TEST(_triangulateMonotone_polygon_towers);
     RUN_TEST(_isEssential_vertexDiagonal);
     RUN_TEST(_isInessential_vertexDiagonal);
 
@@ -48,6 +73,7 @@ void run_engine_math_tests()
     RUN_TEST(getMatrix_transform);
     RUN_TEST(_applymMatrix_vec2f);
     RUN_TEST(applyTransform_polygon);
+    RUN_TEST(getBounds_transform);
 
     // matrix
     RUN_TEST(TRANSPOSE_MATRIX_FN(3, 1));
@@ -68,15 +94,133 @@ void run_engine_collision_tests()
 
     // Public function tests
     RUN_TEST(create_collider_quad);
+    RUN_TEST(createWithOptions_collider_simplified);
     RUN_TEST(detectCollision_collider);
 }
 
+void run_engine_atlas_tests()
+{
+    RUN_TEST(create_atlas);
+    RUN_TEST(pack_atlas);
+    RUN_TEST(pack_atlas_full);
+}
+
+void run_engine_camera_tests()
+{
+    RUN_TEST(getView_camera);
+    RUN_TEST(getViewProjection_camera);
+    RUN_TEST(getBounds_camera);
+}
+
+void run_engine_archive_tests()
+{
+    RUN_TEST(write_archive);
+    RUN_TEST(mount_archive);
+    RUN_TEST(readPolygon_archive);
+}
+
+void run_engine_asset_tests()
+{
+    RUN_TEST(intern_asset);
+}
+
+void run_engine_components_tests()
+{
+    RUN_TEST(push_components);
+    RUN_TEST(swapRemove_components);
+}
+
+void run_engine_decompositionCache_tests()
+{
+    RUN_TEST(decompose_decompositionCache);
+    RUN_TEST(decomposeWithMode_decompositionCache);
+    RUN_TEST(load_decompositionCache);
+    RUN_TEST(setCapacity_decompositionCache);
+}
+
+void run_engine_gameEnvironment_tests()
+{
+    RUN_TEST(run_gameEnvironment_evictions);
+    RUN_TEST(setRender_gameObject_static);
+    RUN_TEST(run_gameEnvironment_staticRenders);
+    RUN_TEST(run_gameEnvironment_staticLayers);
+}
+
+void run_engine_programCache_tests()
+{
+    RUN_TEST(hash_programCache);
+    RUN_TEST(store_programCache);
+}
+
+void run_engine_rawTexture_tests()
+{
+    RUN_TEST(buildMipmaps_rawTexture);
+    RUN_TEST(read_rawTexture);
+}
+
+void run_engine_render_tests()
+{
+    RUN_TEST(get_renderBackend);
+    RUN_TEST(renderAll_render);
+    RUN_TEST(getFramebuffer_softwareRenderBackend);
+    RUN_TEST(init_softwareRenderBackend);
+}
+
+void run_engine_renderQueue_tests()
+{
+    RUN_TEST(push_renderQueue);
+    RUN_TEST(sort_renderQueue);
+}
+
+void run_engine_renderThread_tests()
+{
+    RUN_TEST(create_renderThread);
+    RUN_TEST(submit_renderThread);
+    RUN_TEST(pushBatch_renderFrame);
+}
+
+void run_engine_staticBatch_tests()
+{
+    RUN_TEST(build_staticBatches);
+    RUN_TEST(renderAll_staticBatches);
+}
+
+void run_engine_texture_tests()
+{
+    RUN_TEST(request_texture);
+    RUN_TEST(getByAsset_texture);
+    RUN_TEST(uploadRequested_texture);
+    RUN_TEST(setBudget_texture);
+}
+
 void run_hashtable_tests()
 {
     RUN_TEST(create_hashtable);
     RUN_TEST(setGet_hashtable);
 }
 
+void run_arena_tests()
+{
+    RUN_TEST(create_arena);
+    RUN_TEST(alloc_arena);
+    RUN_TEST(reset_arena);
+}
+
+void run_pool_tests()
+{
+    RUN_TEST(create_pool);
+    RUN_TEST(allocRelease_pool);
+    RUN_TEST(clear_pool);
+}
+
+void run_slotmap_tests()
+{
+    RUN_TEST(create_slotmap);
+    RUN_TEST(insertGet_slotmap);
+    RUN_TEST(remove_slotmap);
+    RUN_TEST(swap_slotmap);
+}
+
 int main(int argc, char* argv[])
 {
     UNIT_TEST_OUT = stdout;
@@ -88,8 +232,59 @@ int main(int argc, char* argv[])
     // engine/collision
     run_engine_collision_tests();
 
+    // engine/archive
+    run_engine_archive_tests();
+
+    // engine/asset
+    run_engine_asset_tests();
+
+    // engine/atlas
+    run_engine_atlas_tests();
+
+    // engine/camera
+    run_engine_camera_tests();
+
+    // engine/components
+    run_engine_components_tests();
+
+    // engine/decompositionCache
+    run_engine_decompositionCache_tests();
+
+    // engine/gameEnvironment
+    run_engine_gameEnvironment_tests();
+
+    // engine/programCache
+    run_engine_programCache_tests();
+
+    // engine/rawTexture
+    run_engine_rawTexture_tests();
+
+    // engine/render
+    run_engine_render_tests();
+
+    // engine/renderQueue
+    run_engine_renderQueue_tests();
+
+    // engine/renderThread
+    run_engine_renderThread_tests();
+
+    // engine/staticBatch
+    run_engine_staticBatch_tests();
+
+    // engine/texture
+    run_engine_texture_tests();
+
     // datastructures/hashtable
     run_hashtable_tests();
 
+    // datastructures/arena
+    run_arena_tests();
+
+    // datastructures/pool
+    run_pool_tests();
+
+    // datastructures/slotmap
+    run_slotmap_tests();
+
     writeUnitTestReport();
 }
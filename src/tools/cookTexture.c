@@ -0,0 +1,70 @@
+/*
+Cooks pngs into raw textures with a full mip chain, see engine/rawTexture.h
+
+Usage
+    cookTexture.out <png> <rtex> [<png> <rtex> ...]
+
+Cooked textures are loaded by get_texture() and request_texture() by their .rtex file name, which skips the
+png decode and the mip chain build at runtime.
+*/
+#include "engine/rawTexture.h"
+
+#include <png.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+Decodes a png and writes it as a raw texture
+
+Returns
+    Returns false if the png could not be decoded or the raw texture could not be written
+*/
+bool _cook(const char* pngFileName, const char* rawFileName)
+{
+    png_image image;
+    memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+
+    if (png_image_begin_read_from_file(&image, pngFileName) == 0)
+    {
+        return false;
+    }
+
+    image.format = PNG_FORMAT_RGBA;
+    png_bytep texels = malloc(PNG_IMAGE_SIZE(image));
+    if (!texels)
+    {
+        png_image_free(&image);
+        return false;
+    }
+
+    bool isCooked = png_image_finish_read(&image, NULL, texels, 0, NULL) != 0 &&
+        write_rawTexture(rawFileName, texels, image.width, image.height);
+
+    free(texels);
+
+    return isCooked;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3 || argc % 2 == 0)
+    {
+        printf("Usage: %s <png> <rtex> [<png> <rtex> ...]\n", argv[0]);
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i += 2)
+    {
+        if (!_cook(argv[i], argv[i + 1]))
+        {
+            printf("Could not cook %s\n", argv[i]);
+            return 1;
+        }
+
+        printf("Cooked %s into %s\n", argv[i], argv[i + 1]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+Decomposes collider shapes ahead of time into a decomposition cache file, see engine/decompositionCache.h
+
+Usage
+    decomposePolygons.out [--minimum] [--simplify <tolerance>] <cache> [<poly> ...]
+
+Each .poly file is written as one "x y" vertex per line, the same as the shapes packed by packArchive. When
+the game loads the cache file, colliders created from these shapes are copied from it instead of being
+decomposed at load.
+
+--minimum decomposes with DECOMPOSITION_MINIMUM instead, for colliders created with that decomposition
+(see colliderOptions). It is slow, which is why it is worth doing here rather than at load.
+
+--simplify simplifies each shape first, the same as a collider created with that simplifyTolerance, so the
+cached decomposition is found for it.
+*/
+#include "engine/archive.h"
+#include "engine/decompositionCache.h"
+#include "engine/math/polygon.h"
+#include "engine/math/vec.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char* argv[])
+{
+    decompositionMode mode = DECOMPOSITION_FAST;
+    float tolerance = 0.0f;
+    int firstArgument = 1;
+    while (firstArgument < argc)
+    {
+        if (strcmp(argv[firstArgument], "--minimum") == 0)
+        {
+            mode = DECOMPOSITION_MINIMUM;
+            firstArgument++;
+        }
+        else if (strcmp(argv[firstArgument], "--simplify") == 0)
+        {
+            // Without a tolerance there is no cache file either, which prints the usage below
+            tolerance = firstArgument + 1 < argc ? strtof(argv[firstArgument + 1], NULL) : 0.0f;
+            firstArgument += 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (argc < firstArgument + 1)
+    {
+        printf("Usage: %s [--minimum] [--simplify <tolerance>] <cache> [<poly> ...]\n", argv[0]);
+        return 1;
+    }
+
+    const char* cacheFileName = argv[firstArgument];
+
+    // Every shape given is saved, however many there are
+    setCapacity_decompositionCache(SIZE_MAX);
+
+    for (int i = firstArgument + 1; i < argc; i++)
+    {
+        polygon shape;
+        if (!readPolygon_archive(argv[i], &shape))
+        {
+            printf("Could not read %s\n", argv[i]);
+            return 1;
+        }
+
+        if (tolerance > 0.0f)
+        {
+            polygon simplified;
+            bool isSimplified = simplify_polygon(&shape, &simplified, tolerance);
+            free_polygon(&shape);
+
+            if (!isSimplified)
+            {
+                printf("Could not simplify %s\n", argv[i]);
+                return 1;
+            }
+
+            shape = simplified;
+        }
+
+        polygon* pieces;
+        int pieceCount;
+        bool isDecomposed = decomposeWithMode_decompositionCache(&shape, mode, &pieces, &pieceCount);
+        free_polygon(&shape);
+
+        if (!isDecomposed)
+        {
+            printf("Could not decompose %s\n", argv[i]);
+            return 1;
+        }
+
+        printf("Decomposed %s into %d pieces\n", argv[i], pieceCount);
+
+        for (int j = 0; pieces && j < pieceCount; j++)
+        {
+            free_polygon(&pieces[j]);
+        }
+        free(pieces);
+    }
+
+    if (!save_decompositionCache(cacheFileName))
+    {
+        return 1;
+    }
+
+    printf("Saved %zu decompositions into %s\n", getStats_decompositionCache().entries, cacheFileName);
+
+    return 0;
+}
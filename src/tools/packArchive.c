@@ -0,0 +1,291 @@
+/*
+Packs a resources directory into a single archive the engine can memory map, see engine/archive.h
+
+Usage
+    packArchive.out <resources directory> <archive>
+
+Every file is packed under its path, starting with the resources directory as given, so packing "resources"
+names the entries the same as the file names the game already loads (e.g. resources/media/test.png).
+
+    .vert, .frag    Shaders, packed as their null terminated source
+    .png            Textures, packed as decoded RGBA texels with a full mip chain
+    .rtex           Cooked textures (see engine/rawTexture.h), packed as their mip chain
+    .poly           Collider shapes, written as one "x y" vertex per line and packed as vec2f
+
+Every other file is skipped.
+*/
+#include "engine/archive.h"
+#include "engine/math/vec.h"
+#include "engine/rawTexture.h"
+#include "util/file.h"
+
+#include <dirent.h>
+#include <png.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+typedef struct _sourceList
+{
+    archiveSource* sources; // The data of every source is owned by the list
+    size_t count;
+    size_t capacity;
+} sourceList;
+
+/*
+Appends a source to the list, which takes ownership of its data
+
+Returns
+    Returns false if memory allocation failed
+*/
+bool _push_sourceList(sourceList* list, const char* name, archiveEntryType type, uint32_t width, uint32_t height, uint32_t levelCount, void* data, size_t size)
+{
+    if (list->count == list->capacity)
+    {
+        size_t capacity = list->capacity ? list->capacity * 2 : 16;
+        archiveSource* sources = realloc(list->sources, sizeof(archiveSource) * capacity);
+        if (!sources)
+        {
+            return false;
+        }
+
+        list->sources = sources;
+        list->capacity = capacity;
+    }
+
+    char* ownedName = malloc(strlen(name) + 1);
+    if (!ownedName)
+    {
+        return false;
+    }
+    strcpy(ownedName, name);
+
+    list->sources[list->count++] = (archiveSource) { ownedName, type, width, height, levelCount, data, size };
+
+    return true;
+}
+
+void _free_sourceList(sourceList* list)
+{
+    for (size_t i = 0; i < list->count; i++)
+    {
+        free((void*) list->sources[i].name);
+        free((void*) list->sources[i].data);
+    }
+
+    free(list->sources);
+}
+
+/*
+Reads a shader, including a null terminator
+*/
+bool _packShader(sourceList* list, const char* path)
+{
+    size_t length;
+    char* source = read_file(path, &length);
+    if (!source)
+    {
+        return false;
+    }
+
+    if (!_push_sourceList(list, path, ARCHIVE_SHADER, 0, 0, 0, source, length + 1))
+    {
+        free(source);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+Decodes a png into RGBA texels, followed by the rest of its mip chain
+*/
+bool _packPng(sourceList* list, const char* path)
+{
+    png_image image;
+    memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+
+    if (png_image_begin_read_from_file(&image, path) == 0)
+    {
+        return false;
+    }
+
+    image.format = PNG_FORMAT_RGBA;
+    size_t levelCount = getLevelCount_rawTexture(image.width, image.height);
+    size_t size = getSize_rawTexture(image.width, image.height, levelCount);
+    png_bytep chain = malloc(size);
+    if (!chain)
+    {
+        png_image_free(&image);
+        return false;
+    }
+
+    if (png_image_finish_read(&image, NULL, chain, 0, NULL) == 0 ||
+        !buildMipmaps_rawTexture(chain, image.width, image.height, 1, levelCount) ||
+        !_push_sourceList(list, path, ARCHIVE_TEXTURE, image.width, image.height, levelCount, chain, size))
+    {
+        free(chain);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+Reads the mip chain of a cooked texture
+*/
+bool _packRaw(sourceList* list, const char* path)
+{
+    size_t width, height, levelCount;
+    uint8_t* chain = read_rawTexture(path, &width, &height, &levelCount);
+    if (!chain)
+    {
+        return false;
+    }
+
+    if (!_push_sourceList(list, path, ARCHIVE_TEXTURE, width, height, levelCount, chain, getSize_rawTexture(width, height, levelCount)))
+    {
+        free(chain);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+Reads the vertices of a collider shape, see readPolygon_archive()
+*/
+bool _packPolygon(sourceList* list, const char* path)
+{
+    polygon shape;
+    if (!readPolygon_archive(path, &shape))
+    {
+        return false;
+    }
+
+    if (!_push_sourceList(list, path, ARCHIVE_POLYGON, shape.vertexCount, 0, 0, shape.vertices, sizeof(vec2f) * shape.vertexCount))
+    {
+        free(shape.vertices);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+Checks whether a path ends with an extension, e.g. ".png"
+*/
+bool _hasExtension(const char* path, const char* extension)
+{
+    size_t pathLength = strlen(path);
+    size_t extensionLength = strlen(extension);
+
+    return pathLength > extensionLength && strcmp(&path[pathLength - extensionLength], extension) == 0;
+}
+
+/*
+Packs every file in a directory and its subdirectories
+
+Returns
+    Returns false if a file could not be packed
+*/
+bool _packDirectory(sourceList* list, const char* directory)
+{
+    DIR* dir = opendir(directory);
+    if (!dir)
+    {
+        printf("Could not open %s\n", directory);
+        return false;
+    }
+
+    bool isPacked = true;
+    struct dirent* child;
+    while (isPacked && (child = readdir(dir)))
+    {
+        // Skips ., .. and hidden files
+        if (child->d_name[0] == '.')
+        {
+            continue;
+        }
+
+        char path[ARCHIVE_NAME_SIZE];
+        if ((size_t) snprintf(path, sizeof(path), "%s/%s", directory, child->d_name) >= sizeof(path))
+        {
+            printf("%s/%s is too long to be packed\n", directory, child->d_name);
+            isPacked = false;
+            break;
+        }
+
+        struct stat info;
+        if (stat(path, &info) != 0)
+        {
+            continue;
+        }
+
+        if (S_ISDIR(info.st_mode))
+        {
+            isPacked = _packDirectory(list, path);
+            continue;
+        }
+
+        if (_hasExtension(path, ".vert") || _hasExtension(path, ".frag"))
+        {
+            isPacked = _packShader(list, path);
+        }
+        else if (_hasExtension(path, ".png"))
+        {
+            isPacked = _packPng(list, path);
+        }
+        else if (_hasExtension(path, ".rtex"))
+        {
+            isPacked = _packRaw(list, path);
+        }
+        else if (_hasExtension(path, ".poly"))
+        {
+            isPacked = _packPolygon(list, path);
+        }
+        else
+        {
+            continue;
+        }
+
+        if (!isPacked)
+        {
+            printf("Could not pack %s\n", path);
+        }
+    }
+
+    closedir(dir);
+
+    return isPacked;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        printf("Usage: %s <resources directory> <archive>\n", argv[0]);
+        return 1;
+    }
+
+    // Entries are named by path, so a trailing slash would change every name
+    size_t length = strlen(argv[1]);
+    while (length > 1 && argv[1][length - 1] == '/')
+    {
+        argv[1][--length] = '\0';
+    }
+
+    sourceList list = { NULL, 0, 0 };
+    if (!_packDirectory(&list, argv[1]) || !write_archive(argv[2], list.sources, list.count))
+    {
+        _free_sourceList(&list);
+        return 1;
+    }
+
+    printf("Packed %zu resources into %s\n", list.count, argv[2]);
+    _free_sourceList(&list);
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+#include "util/file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+char* read_file(const char* fileName, size_t* outSize)
+{
+    FILE* file = fopen(fileName, "rb");
+    if (!file)
+    {
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* contents = length >= 0 ? malloc(length + 1) : NULL;
+    if (!contents)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    size_t read = fread(contents, 1, length, file);
+    contents[read] = '\0';
+    fclose(file);
+
+    if (outSize)
+    {
+        *outSize = read;
+    }
+
+    return contents;
+}
@@ -1,30 +1,88 @@
 #include "util/loadShaders.h"
 
+#include "engine/archive.h"
+#include "engine/programCache.h"
+#include "util/file.h"
+
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-// Reads a shader from a file and stores it in dynamically allocated memory
-static const GLchar* readShader(const char* filename)
+// The most shaders a single program can be linked from
+#define MAX_SHADERS 8
+
+// Frees the sources that were read from files
+static void freeSources(const GLchar** fileSources, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        free((void*) fileSources[i]);
+    }
+}
+
+// Identifies the driver, since a program binary is only valid for the driver that linked it
+static void getDriver(char* driver, size_t size)
 {
-    FILE* infile = fopen(filename, "rb");
+    snprintf(driver, size, "%s|%s|%s",
+        (const char*) glGetString(GL_VENDOR),
+        (const char*) glGetString(GL_RENDERER),
+        (const char*) glGetString(GL_VERSION));
+}
 
-    if (!infile)
+// Creates a program from a cached binary, or returns zero if there is none or the driver rejects it
+static GLuint loadBinary(uint64_t key)
+{
+    uint32_t format;
+    size_t size;
+    void* binary = load_programCache(key, &format, &size);
+    if (binary == NULL)
     {
-        return NULL;
+        return 0;
     }
 
-    fseek( infile, 0, SEEK_END );
-    int len = ftell(infile);
-    fseek( infile, 0, SEEK_SET );
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, format, binary, size);
+    free(binary);
 
-    GLchar* source = malloc(sizeof(GLchar) * (len + 1));
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        // Drivers may reject binaries at any time, e.g. after an update. The program is compiled from source instead.
+        glDeleteProgram(program);
+        remove_programCache(key);
 
-    fread(source, 1, len, infile);
-    fclose(infile);
+        return 0;
+    }
+
+    return program;
+}
 
-    source[len] = 0;
+// Caches the binary of a linked program
+static void storeBinary(GLuint program, uint64_t key)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    void* binary = malloc(length);
+    if (binary == NULL)
+    {
+        return;
+    }
+
+    GLsizei written = 0;
+    GLenum format;
+    glGetProgramBinary(program, length, &written, &format, binary);
+    if (written > 0)
+    {
+        store_programCache(key, format, binary, written);
+    }
 
-    return (const GLchar*) source;
+    free(binary);
 }
 
 GLuint loadShaders(ShaderInfo* shaders)
@@ -34,33 +92,68 @@ GLuint loadShaders(ShaderInfo* shaders)
         return 0;
     }
 
-    GLuint program = glCreateProgram();
+    // Read every source up front, since together they are the key of the program's cached binary
+    const GLchar* sources[MAX_SHADERS];
+    const GLchar* fileSources[MAX_SHADERS];
+    size_t count = 0;
 
-    ShaderInfo* entry = shaders;
-    while (entry->type != GL_NONE)
+    ShaderInfo* entry;
+    for (entry = shaders; entry->type != GL_NONE; ++entry)
     {
-        GLuint shader = glCreateShader(entry->type);
+        entry->shader = 0;
 
-        entry->shader = shader;
+        if (count == MAX_SHADERS)
+        {
+            printf("Too many shaders, at most %d can be linked\n", MAX_SHADERS);
+            freeSources(fileSources, count);
+            return 0;
+        }
 
-        // Load the shader into a string
-        const GLchar* source = readShader(entry->filename);
-        if (source == NULL)
+        // Load the shader into a string, unless it can be read in place from the mounted archive
+        sources[count] = getShader_archive(entry->filename);
+        fileSources[count] = NULL;
+        if (sources[count] == NULL)
         {
-            for (entry = shaders; entry->type != GL_NONE; ++entry)
-            {
-                glDeleteShader(entry->shader);
-                entry->shader = 0;
-            }
+            sources[count] = fileSources[count] = read_file(entry->filename, NULL);
+        }
 
+        if (sources[count] == NULL)
+        {
             printf("Could not read shader %s\n", entry->filename);
-
+            freeSources(fileSources, count);
             return 0;
         }
 
+        count++;
+    }
+
+    // A cached binary skips compiling and linking entirely
+    uint64_t key = 0;
+    if (isEnabled_programCache())
+    {
+        char driver[512];
+        getDriver(driver, sizeof(driver));
+        key = hash_programCache((const char**) sources, count, driver);
+
+        GLuint program = loadBinary(key);
+        if (program != 0)
+        {
+            freeSources(fileSources, count);
+            return program;
+        }
+    }
+
+    GLuint program = glCreateProgram();
+
+    size_t i = 0;
+    for (entry = shaders; entry->type != GL_NONE; ++entry, ++i)
+    {
+        GLuint shader = glCreateShader(entry->type);
+
+        entry->shader = shader;
+
         // Give the string to OpenGL
-        glShaderSource(shader, 1, &source, NULL);
-        free((void*) source);
+        glShaderSource(shader, 1, &sources[i], NULL);
 
         // Compile the shader
         glCompileShader(shader);
@@ -79,13 +172,20 @@ GLuint loadShaders(ShaderInfo* shaders)
             printf("%s\n", log);
 
             free(log);
+            freeSources(fileSources, count);
             return 0;
         }
 
         // Attach the current shader to the program
         glAttachShader(program, shader);
+    }
 
-        ++entry;
+    freeSources(fileSources, count);
+
+    // The binary can only be retrieved after linking if it was asked for before
+    if (isEnabled_programCache())
+    {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     }
 
     // Compile all attached shaders
@@ -114,6 +214,11 @@ GLuint loadShaders(ShaderInfo* shaders)
         return 0;
     }
 
+    if (isEnabled_programCache())
+    {
+        storeBinary(program, key);
+    }
+
     return program;
 }
 